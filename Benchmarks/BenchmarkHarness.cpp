@@ -0,0 +1,164 @@
+#include "BenchmarkHarness.h"
+#include "../Source/DSP/SimdKernels.h"
+#include <iostream>
+
+juce::var BenchmarkHarness::Result::toVar() const
+{
+    auto result = std::make_unique<juce::DynamicObject>();
+    result->setProperty("suite", suite);
+    result->setProperty("name", name);
+    result->setProperty("sampleRate", sampleRate);
+    result->setProperty("blockSize", blockSize);
+    result->setProperty("numChannels", numChannels);
+    result->setProperty("nsPerSample", nsPerSample);
+    result->setProperty("realtimeFactor", realtimeFactor);
+    return juce::var(result.release());
+}
+
+BenchmarkHarness::BenchmarkHarness(const Settings& settingsToUse)
+    : settings(settingsToUse)
+{
+}
+
+juce::AudioBuffer<float> BenchmarkHarness::createTestSignal(double sampleRate, int numChannels)
+{
+    return HeadlessSupport::makeSignal(numChannels, juce::roundToInt(sampleRate), sampleRate, 220.0, 0.25f, 0.05f);
+}
+
+bool BenchmarkHarness::processesSignal(const ProcessFunction& process, double sampleRate, int blockSize, int numChannels)
+{
+    const auto input = createTestSignal(sampleRate, numChannels);
+    juce::AudioBuffer<float> block(numChannels, blockSize);
+    double inputEnergy = 0.0, outputEnergy = 0.0, differenceEnergy = 0.0;
+
+    // A few blocks, so processors that start from silence still show
+    for (int position = 0; position + blockSize <= juce::jmin(input.getNumSamples(), 8 * blockSize); position += blockSize)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            block.copyFrom(ch, 0, input, ch, position, blockSize);
+
+        process(block);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const double in = input.getSample(ch, position + i);
+                const double out = block.getSample(ch, i);
+                inputEnergy += in * in;
+                outputEnergy += out * out;
+                differenceEnergy += (out - in) * (out - in);
+            }
+        }
+    }
+
+    return outputEnergy > 1.0e-6 * inputEnergy && differenceEnergy > 1.0e-6 * inputEnergy;
+}
+
+void BenchmarkHarness::run(const juce::String& suite, const juce::String& name, Factory factory, int numChannels)
+{
+    if (settings.filter.isNotEmpty() && !(suite + "/" + name).containsIgnoreCase(settings.filter))
+        return;
+
+    for (auto sampleRate : settings.sampleRates)
+    {
+        const auto input = createTestSignal(sampleRate, numChannels);
+
+        for (auto blockSize : settings.blockSizes)
+        {
+            auto process = factory(sampleRate, blockSize);
+            juce::AudioBuffer<float> block(numChannels, blockSize);
+            int position = 0;
+
+            auto processNextBlock = [&]
+            {
+                if (position + blockSize > input.getNumSamples())
+                    position = 0;
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    block.copyFrom(ch, 0, input, ch, position, blockSize);
+
+                process(block);
+                position += blockSize;
+            };
+
+            const int blocksPerRun = juce::jmax(1, juce::roundToInt(settings.secondsPerRun * sampleRate / blockSize));
+
+            // Fill delay lines, settle envelopes and warm the caches
+            for (int i = 0; i < juce::jmax(16, blocksPerRun / 10); ++i)
+                processNextBlock();
+
+            double fastestSeconds = std::numeric_limits<double>::max();
+
+            for (int runIndex = 0; runIndex < juce::jmax(1, settings.numRuns); ++runIndex)
+            {
+                const auto start = juce::Time::getHighResolutionTicks();
+
+                for (int i = 0; i < blocksPerRun; ++i)
+                    processNextBlock();
+
+                const auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+                fastestSeconds = juce::jmin(fastestSeconds, elapsed);
+            }
+
+            fastestSeconds = juce::jmax(fastestSeconds, 1.0e-9);
+            const double numSamples = static_cast<double>(blocksPerRun) * blockSize;
+
+            Result result;
+            result.suite = suite;
+            result.name = name;
+            result.sampleRate = sampleRate;
+            result.blockSize = blockSize;
+            result.numChannels = numChannels;
+            result.nsPerSample = fastestSeconds * 1.0e9 / numSamples;
+            result.realtimeFactor = (numSamples / sampleRate) / fastestSeconds;
+            results.push_back(result);
+
+            std::cout << (suite + "/" + name).paddedRight(' ', 36)
+                      << juce::String(sampleRate / 1000.0, 1).paddedLeft(' ', 6) << " kHz"
+                      << juce::String(blockSize).paddedLeft(' ', 6)
+                      << juce::String(result.nsPerSample, 2).paddedLeft(' ', 12) << " ns/sample"
+                      << juce::String(result.realtimeFactor, 1).paddedLeft(' ', 10) << "x realtime"
+                      << std::endl;
+        }
+    }
+}
+
+juce::var BenchmarkHarness::getMachineInfo()
+{
+    auto machine = std::make_unique<juce::DynamicObject>();
+    machine->setProperty("cpu", juce::SystemStats::getCpuModel());
+    machine->setProperty("numCpus", juce::SystemStats::getNumCpus());
+    machine->setProperty("numPhysicalCpus", juce::SystemStats::getNumPhysicalCpus());
+    machine->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    machine->setProperty("simdKernels", auralis::simd::getKernels().name);
+   #if JUCE_DEBUG
+    machine->setProperty("build", "Debug");
+   #else
+    machine->setProperty("build", "Release");
+   #endif
+    return juce::var(machine.release());
+}
+
+bool BenchmarkHarness::writeJson(const juce::File& file) const
+{
+    juce::Array<juce::var> resultList;
+    for (const auto& result : results)
+        resultList.add(result.toVar());
+
+    auto root = std::make_unique<juce::DynamicObject>();
+    root->setProperty("version", 1);
+    root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("machine", getMachineInfo());
+    root->setProperty("secondsPerRun", settings.secondsPerRun);
+    root->setProperty("numRuns", settings.numRuns);
+    root->setProperty("results", resultList);
+
+    if (!file.replaceWithText(juce::JSON::toString(juce::var(root.release()))))
+    {
+        juce::Logger::writeToLog("BenchmarkHarness: can't write " + file.getFullPathName());
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "../Tests/HeadlessSupport.h"
+
+/**
+ * BenchmarkHarness - Times block processing under a fixed, repeatable load
+ *
+ * Every case is fed the same signal: a 220 Hz sine plus noise from a fixed
+ * seed, copied into the block before each call so in-place processors never
+ * feed on their own output. A case is rebuilt for every sample rate and
+ * block size in the matrix, warmed up, then timed over several runs of a
+ * fixed audio duration. The fastest run is kept, as the one least disturbed
+ * by the scheduler.
+ */
+class BenchmarkHarness
+{
+public:
+    struct Settings
+    {
+        std::vector<double> sampleRates { 44100.0, 48000.0, 96000.0 };
+        std::vector<int> blockSizes { 32, 64, 128, 256, 512, 1024, 2048 };
+        double secondsPerRun = 1.0;     // Audio processed per timed run
+        int numRuns = 5;
+        juce::String filter;            // Only run cases whose "suite/name" contains this
+    };
+
+    struct Result
+    {
+        juce::String suite;
+        juce::String name;
+        double sampleRate = 0.0;
+        int blockSize = 0;
+        int numChannels = 0;
+        double nsPerSample = 0.0;       // Per sample frame, all channels together
+        double realtimeFactor = 0.0;    // Seconds of audio processed per second of wall time
+
+        juce::var toVar() const;
+    };
+
+    /** Processes one block in place. */
+    using ProcessFunction = HeadlessSupport::ProcessFunction;
+
+    /** Builds and prepares a fresh case for one sample rate and block size. */
+    using Factory = std::function<ProcessFunction(double sampleRate, int blockSize)>;
+
+    explicit BenchmarkHarness(const Settings& settings);
+
+    /** Time one case across the whole sample rate x block size matrix. */
+    void run(const juce::String& suite, const juce::String& name, Factory factory, int numChannels = 2);
+
+    const Settings& getSettings() const { return settings; }
+    const std::vector<Result>& getResults() const { return results; }
+
+    /** Results plus the machine and build they came from, for regression tracking. */
+    bool writeJson(const juce::File& file) const;
+
+    /** One second of the benchmark signal, identical on every run and every machine. */
+    static juce::AudioBuffer<float> createTestSignal(double sampleRate, int numChannels);
+
+    /** False if a case leaves the benchmark signal silent or untouched: its
+        timings would be of a processor that does nothing. */
+    static bool processesSignal(const ProcessFunction& process, double sampleRate, int blockSize, int numChannels = 2);
+
+    /** CPU, OS and build type, to tell whose numbers are whose. */
+    static juce::var getMachineInfo();
+
+private:
+    Settings settings;
+    std::vector<Result> results;
+};
@@ -0,0 +1,98 @@
+#include <JuceHeader.h>
+#include <iostream>
+#include "BenchmarkHarness.h"
+#include "DSPBenchmarks.h"
+#include "EngineStressBenchmark.h"
+#include "../Tests/HeadlessSupport.h"
+
+/*
+ * AuralisBenchmarks [--json=<file>] [--filter=<text>] [--quick] [--verbose]
+ * AuralisBenchmarks --engine [--rate=48000] [--buffer=64] [--target=0.7] [--seconds=5] [--json=<file>]
+ *
+ *   --json     where to write the results (default: benchmark-results.json)
+ *   --filter   only run cases whose "suite/name" contains the text
+ *   --quick    48 kHz at 64 and 512 samples only, shorter runs
+ *   --verbose  keep the processors' own log output
+ *   --engine   full-engine stress test instead: the most channels that stay
+ *              under the target DSP load at one rate and buffer size
+ */
+
+int main(int argc, char* argv[])
+{
+    // The channel strip's AudioProcessorGraph expects a message thread
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    HeadlessSupport::SilentLogger silentLogger;
+    if (!args.containsOption("--verbose"))
+        juce::Logger::setCurrentLogger(&silentLogger);
+
+    auto jsonPath = args.getValueForOption("--json");
+    if (jsonPath.isEmpty())
+        jsonPath = "benchmark-results.json";
+
+    const auto jsonFile = juce::File::getCurrentWorkingDirectory().getChildFile(jsonPath);
+
+   #if JUCE_DEBUG
+    std::cout << "Warning: debug build; numbers are not comparable with release builds" << std::endl;
+   #endif
+
+    bool written = false;
+
+    if (args.containsOption("--engine"))
+    {
+        EngineStressBenchmark::Settings settings;
+
+        if (args.containsOption("--rate"))
+            settings.sampleRate = args.getValueForOption("--rate").getDoubleValue();
+        if (args.containsOption("--buffer"))
+            settings.bufferSize = args.getValueForOption("--buffer").getIntValue();
+        if (args.containsOption("--target"))
+            settings.targetLoad = args.getValueForOption("--target").getDoubleValue();
+        if (args.containsOption("--seconds"))
+            settings.secondsPerConfiguration = args.getValueForOption("--seconds").getDoubleValue();
+        else if (args.containsOption("--quick"))
+            settings.secondsPerConfiguration = 1.0;
+
+        if (settings.sampleRate <= 0.0 || settings.bufferSize <= 0 || settings.targetLoad <= 0.0)
+        {
+            std::cerr << "--rate, --buffer and --target must be positive" << std::endl;
+            return 1;
+        }
+
+        EngineStressBenchmark benchmark(settings);
+        benchmark.run();
+
+        juce::Logger::setCurrentLogger(nullptr);
+        written = benchmark.writeJson(jsonFile);
+    }
+    else
+    {
+        BenchmarkHarness::Settings settings;
+        settings.filter = args.getValueForOption("--filter");
+
+        if (args.containsOption("--quick"))
+        {
+            settings.sampleRates = { 48000.0 };
+            settings.blockSizes = { 64, 512 };
+            settings.secondsPerRun = 0.25;
+            settings.numRuns = 3;
+        }
+
+        BenchmarkHarness harness(settings);
+        runDSPBenchmarks(harness);
+
+        juce::Logger::setCurrentLogger(nullptr);
+        written = harness.writeJson(jsonFile);
+    }
+
+    if (!written)
+    {
+        std::cerr << "Can't write " << jsonFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Results written to " << jsonFile.getFullPathName() << std::endl;
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include "DSPBenchmarks.h"
+#include "../Source/Audio/ChannelProcessor.h"
+#include "../Source/Audio/GroupBusProcessor.h"
+#include "../Source/Audio/MultibandCompressorProcessor.h"
+#include "../Source/Audio/TruePeakLimiterProcessor.h"
+#include "../Source/DSP/SimdKernels.h"
+#include <iostream>
+
+namespace
+{
+    /** A stereo juce::AudioProcessor, rebuilt for every rate and block size. */
+    template <typename Processor>
+    BenchmarkHarness::Factory processorCase(std::function<void(Processor&)> configure = nullptr)
+    {
+        return [configure](double sampleRate, int blockSize)
+        {
+            return HeadlessSupport::prepareProcessor<Processor>(sampleRate, blockSize, configure);
+        };
+    }
+
+    /**
+     * The per-sample SIMD kernels of every table this CPU runs, as the
+     * "kernels" suite, to see what dispatch buys. The straight-line gain and
+     * reduction kernels are left out: they only ever wait on memory.
+     */
+    void runKernelBenchmarks(BenchmarkHarness& harness)
+    {
+        using namespace auralis::simd;
+
+        for (const auto* table : getAvailableKernels())
+        {
+            const juce::String isa = juce::String(" (") + table->name + ")";
+
+            harness.run("kernels", "biquadCascadeStereo" + isa, [table](double sampleRate, int) -> BenchmarkHarness::ProcessFunction
+            {
+                using ArrayCoefs = juce::dsp::IIR::ArrayCoefficients<float>;
+                auto stages = std::make_shared<std::array<BiquadCoefficients, 4>>();
+                (*stages)[0] = makeBiquad(ArrayCoefs::makeLowShelf(sampleRate, 80.0f, 0.7f, 2.0f));
+                (*stages)[1] = makeBiquad(ArrayCoefs::makePeakFilter(sampleRate, 300.0f, 0.7f, 0.6f));
+                (*stages)[2] = makeBiquad(ArrayCoefs::makePeakFilter(sampleRate, 3000.0f, 0.7f, 1.4f));
+                (*stages)[3] = makeBiquad(ArrayCoefs::makeHighShelf(sampleRate, 8000.0f, 0.7f, 0.8f));
+                auto state = std::make_shared<std::array<BiquadState, 8>>();
+
+                return [table, stages, state](juce::AudioBuffer<float>& buffer)
+                {
+                    table->biquadCascadeStereo(buffer.getWritePointer(0), buffer.getWritePointer(1), buffer.getNumSamples(),
+                                               stages->data(), state->data(), 4);
+                };
+            });
+
+            harness.run("kernels", "envelopeFollowerStereo" + isa, [table](double, int blockSize) -> BenchmarkHarness::ProcessFunction
+            {
+                auto envelope = std::make_shared<juce::AudioBuffer<float>>(2, blockSize);
+                auto state = std::make_shared<std::array<float, 2>>();
+
+                return [table, envelope, state](juce::AudioBuffer<float>& buffer)
+                {
+                    table->envelopeFollowerStereo(buffer.getReadPointer(0), buffer.getReadPointer(1),
+                                                  envelope->getWritePointer(0), envelope->getWritePointer(1),
+                                                  buffer.getNumSamples(), 0.99f, 0.999f, state->data());
+                };
+            });
+
+            // The filter reads back truePeakTaps - 1 samples, so those come off the block
+            harness.run("kernels", "oversampledPeak" + isa, [table](double, int) -> BenchmarkHarness::ProcessFunction
+            {
+                return [table](juce::AudioBuffer<float>& buffer)
+                {
+                    const int numOutputs = buffer.getNumSamples() - (truePeakTaps - 1);
+                    for (int ch = 0; ch < buffer.getNumChannels() && numOutputs > 0; ++ch)
+                        juce::ignoreUnused(table->oversampledPeak(buffer.getReadPointer(ch), numOutputs));
+                };
+            });
+        }
+    }
+}
+
+void runDSPBenchmarks(BenchmarkHarness& harness)
+{
+    // What the harness itself costs: copying the input into the block
+    harness.run("dsp", "Baseline", [](double, int) -> BenchmarkHarness::ProcessFunction
+    {
+        return [](juce::AudioBuffer<float>&) {};
+    });
+
+    // Channel strip stages
+    harness.run("dsp", "GateProcessor", processorCase<GateProcessor>());
+
+    harness.run("dsp", "EQProcessor", processorCase<EQProcessor>([](EQProcessor& eq)
+    {
+        eq.setGains({ 3.0f, -2.0f, 2.5f, -1.5f });
+    }));
+
+    harness.run("dsp", "CompressorProcessor", processorCase<CompressorProcessor>([](CompressorProcessor& comp)
+    {
+        comp.setThreshold(-24.0f);
+        comp.setRatio(4.0f);
+        comp.setMakeupGainAuto(true);
+    }));
+
+    harness.run("dsp", "TunerProcessor", processorCase<auralis::TunerProcessor>([](auralis::TunerProcessor& tuner)
+    {
+        tuner.setStrength(0.5f);
+    }));
+
+    // FX bus stages
+    harness.run("dsp", "DelayProcessor", processorCase<DelayProcessor>());
+    harness.run("dsp", "ReverbProcessor", processorCase<ReverbProcessor>());
+
+    // Group bus EQ
+    harness.run("dsp", "BusEQProcessor", processorCase<BusEQProcessor>([](BusEQProcessor& eq)
+    {
+        eq.setGains(2.0f, -1.5f, 1.0f);
+    }));
+
+    // Master bus stages
+    harness.run("dsp", "MultibandCompressorProcessor", [](double sampleRate, int blockSize) -> BenchmarkHarness::ProcessFunction
+    {
+        auto compressor = std::make_shared<MultibandCompressorProcessor>();
+        compressor->prepare(sampleRate, blockSize);
+        return [compressor](juce::AudioBuffer<float>& buffer) { compressor->process(buffer); };
+    });
+
+    harness.run("dsp", "TruePeakLimiterProcessor", processorCase<auralis::TruePeakLimiterProcessor>());
+
+    // The whole channel strip graph: trim, gate, EQ, compressor and tuner
+    harness.run("dsp", "ChannelProcessor", [](double sampleRate, int blockSize) -> BenchmarkHarness::ProcessFunction
+    {
+        auto channel = std::make_shared<ChannelProcessor>(0, ChannelProcessor::ChannelType::Vocal);
+        channel->prepareToPlay(sampleRate, blockSize);
+        channel->setEQGains({ 3.0f, -2.0f, 2.5f, -1.5f });
+
+        auto midi = std::make_shared<juce::MidiBuffer>();
+        BenchmarkHarness::ProcessFunction process = [channel, midi](juce::AudioBuffer<float>& buffer) { channel->processBlock(buffer, *midi); };
+
+        // An empty or unconnected graph would time nothing at all
+        if (!BenchmarkHarness::processesSignal(process, sampleRate, blockSize))
+        {
+            std::cerr << "ChannelProcessor: the strip doesn't change the signal, its timings are meaningless" << std::endl;
+            jassertfalse;
+        }
+
+        return process;
+    });
+
+    runKernelBenchmarks(harness);
+}
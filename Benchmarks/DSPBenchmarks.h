@@ -0,0 +1,11 @@
+#pragma once
+
+#include "BenchmarkHarness.h"
+
+/**
+ * Per-processor throughput: each channel, group and master bus processor on
+ * its own, plus the complete channel strip graph, as the "dsp" suite. The
+ * "kernels" suite times the recursive and filtering SIMD kernels of every
+ * instruction set the CPU runs, scalar included.
+ */
+void runDSPBenchmarks(BenchmarkHarness& harness);
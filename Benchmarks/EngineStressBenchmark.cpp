@@ -0,0 +1,315 @@
+#include "EngineStressBenchmark.h"
+#include "BenchmarkHarness.h"
+#include "../Source/Audio/AudioEngine.h"
+#include <iostream>
+
+namespace
+{
+    using Tier = EngineStressBenchmark::Tier;
+
+    /**
+     * A device with no hardware behind it: each call to processNextBlock()
+     * is one device period, fed from the benchmark signal and timed.
+     */
+    class BenchmarkAudioDevice : public juce::AudioIODevice
+    {
+    public:
+        BenchmarkAudioDevice(double rate, int blockSize, int inputs)
+            : juce::AudioIODevice("Benchmark", "Benchmark"),
+              sampleRate(rate), bufferSize(blockSize), numInputs(inputs),
+              input(BenchmarkHarness::createTestSignal(rate, inputs)),
+              output(2, blockSize),
+              inputPointers((size_t) inputs)
+        {
+        }
+
+        juce::StringArray getOutputChannelNames() override { return { "Left", "Right" }; }
+
+        juce::StringArray getInputChannelNames() override
+        {
+            juce::StringArray names;
+            for (int i = 0; i < numInputs; ++i)
+                names.add("Input " + juce::String(i + 1));
+            return names;
+        }
+
+        juce::Array<double> getAvailableSampleRates() override { return { sampleRate }; }
+        juce::Array<int> getAvailableBufferSizes() override { return { bufferSize }; }
+        int getDefaultBufferSize() override { return bufferSize; }
+
+        juce::String open(const juce::BigInteger&, const juce::BigInteger&, double, int) override
+        {
+            opened = true;
+            return {};
+        }
+
+        void close() override { opened = false; }
+        bool isOpen() override { return opened; }
+
+        void start(juce::AudioIODeviceCallback* newCallback) override
+        {
+            callback = newCallback;
+            if (callback != nullptr)
+                callback->audioDeviceAboutToStart(this);
+        }
+
+        void stop() override
+        {
+            if (callback != nullptr)
+                callback->audioDeviceStopped();
+            callback = nullptr;
+        }
+
+        bool isPlaying() override { return callback != nullptr; }
+        juce::String getLastError() override { return {}; }
+        int getCurrentBufferSizeSamples() override { return bufferSize; }
+        double getCurrentSampleRate() override { return sampleRate; }
+        int getCurrentBitDepth() override { return 32; }
+
+        juce::BigInteger getActiveOutputChannels() const override
+        {
+            juce::BigInteger channels;
+            channels.setRange(0, 2, true);
+            return channels;
+        }
+
+        juce::BigInteger getActiveInputChannels() const override
+        {
+            juce::BigInteger channels;
+            channels.setRange(0, numInputs, true);
+            return channels;
+        }
+
+        int getOutputLatencyInSamples() override { return 0; }
+        int getInputLatencyInSamples() override { return 0; }
+
+        /** Run one device period; returns how long the callback took, in seconds. */
+        double processNextBlock()
+        {
+            if (position + bufferSize > input.getNumSamples())
+                position = 0;
+
+            for (int ch = 0; ch < numInputs; ++ch)
+                inputPointers[(size_t) ch] = input.getReadPointer(ch, position);
+
+            position += bufferSize;
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            callback->audioDeviceIOCallbackWithContext(inputPointers.data(), numInputs,
+                                                       output.getArrayOfWritePointers(), output.getNumChannels(),
+                                                       bufferSize, context);
+            return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        }
+
+    private:
+        const double sampleRate;
+        const int bufferSize;
+        const int numInputs;
+
+        const juce::AudioBuffer<float> input;
+        juce::AudioBuffer<float> output;
+        std::vector<const float*> inputPointers;
+        int position = 0;
+
+        juce::AudioIODeviceCallback* callback = nullptr;
+        juce::AudioIODeviceCallbackContext context {};
+        bool opened = false;
+    };
+
+    /** Switch the mixer to a tier and patch the first numActive channels to inputs. */
+    void configure(AudioEngine& engine, Tier tier, int numActive)
+    {
+        const bool processing = tier != Tier::Minimal;
+        auto& routing = engine.getRoutingManager();
+
+        for (int i = 0; i < engine.getNumChannels(); ++i)
+        {
+            auto* channel = engine.getChannelProcessor(i);
+            channel->setGateEnabled(processing);
+            channel->setEqEnabled(processing);
+            channel->setCompressorEnabled(processing);
+            channel->setTunerEnabled(tier == Tier::Full);
+            channel->setFxSendLevel(processing ? 0.3f : 0.0f);
+
+            routing.assignPhysicalInput(i, i < numActive ? i : -1);
+        }
+
+        for (int i = 0; i < engine.getNumGroupBuses(); ++i)
+        {
+            auto* bus = engine.getGroupBusProcessor(i);
+            bus->setEQEnabled(processing);
+            bus->setCompEnabled(processing);
+        }
+
+        for (int i = 0; i < engine.getNumFXBuses(); ++i)
+            engine.getFXBusProcessor(i)->setBypass(!processing);
+
+        engine.getMasterBusProcessor()->setCompressorEnabled(processing);
+        engine.getMasterBusProcessor()->setLimiterEnabled(processing);
+    }
+
+    std::vector<int> getChannelSteps(int numChannels)
+    {
+        std::vector<int> steps { 1, 2, 4 };
+        for (int n = 8; n < numChannels; n += 4)
+            steps.push_back(n);
+        steps.push_back(numChannels);
+        return steps;
+    }
+}
+
+juce::var EngineStressBenchmark::Measurement::toVar() const
+{
+    juce::Array<juce::var> histogram;
+    for (auto count : loadHistogram)
+        histogram.add(count);
+
+    auto measurement = std::make_unique<juce::DynamicObject>();
+    measurement->setProperty("tier", getTierName(tier));
+    measurement->setProperty("numChannels", numChannels);
+    measurement->setProperty("p50Micros", p50Micros);
+    measurement->setProperty("p99Micros", p99Micros);
+    measurement->setProperty("p999Micros", p999Micros);
+    measurement->setProperty("maxMicros", maxMicros);
+    measurement->setProperty("p999Load", p999Load);
+    measurement->setProperty("loadHistogram", histogram);
+    return juce::var(measurement.release());
+}
+
+EngineStressBenchmark::EngineStressBenchmark(const Settings& settingsToUse)
+    : settings(settingsToUse)
+{
+}
+
+juce::String EngineStressBenchmark::getTierName(Tier tier)
+{
+    switch (tier)
+    {
+        case Tier::Minimal:  return "Minimal";
+        case Tier::Standard: return "Standard";
+        case Tier::Full:     return "Full";
+    }
+    return {};
+}
+
+int EngineStressBenchmark::getMaxChannels(Tier tier) const
+{
+    return maxChannels[(size_t) tier];
+}
+
+void EngineStressBenchmark::run()
+{
+    // The engine is driven only by the fake device below
+    AudioEngine engine(false);
+    engine.initializeRouting();
+
+    BenchmarkAudioDevice device(settings.sampleRate, settings.bufferSize, engine.getNumChannels());
+    device.open({}, {}, settings.sampleRate, settings.bufferSize);
+    device.start(&engine);
+
+    const double periodMicros = 1.0e6 * settings.bufferSize / settings.sampleRate;
+    const int numCallbacks = juce::jmax(1000, juce::roundToInt(settings.secondsPerConfiguration * settings.sampleRate / settings.bufferSize));
+    std::vector<double> durations((size_t) numCallbacks);
+
+    measurements.clear();
+    maxChannels.fill(0);
+
+    for (auto tier : { Tier::Minimal, Tier::Standard, Tier::Full })
+    {
+        // A processing tier sizes hardware only if its strips really process
+        if (tier != Tier::Minimal)
+        {
+            configure(engine, tier, 1);
+            auto* channel = engine.getChannelProcessor(0);
+            juce::MidiBuffer midi;
+
+            if (!BenchmarkHarness::processesSignal([&](juce::AudioBuffer<float>& block) { channel->processBlock(block, midi); },
+                                                   settings.sampleRate, settings.bufferSize))
+            {
+                std::cout << getTierName(tier) << ": the channel strips don't change the signal, tier skipped" << std::endl;
+                continue;
+            }
+        }
+
+        for (auto numChannels : getChannelSteps(engine.getNumChannels()))
+        {
+            configure(engine, tier, numChannels);
+
+            // Settle envelopes, fill delay lines and land the new routing
+            for (int i = 0; i < numCallbacks / 10; ++i)
+                device.processNextBlock();
+
+            for (auto& duration : durations)
+                duration = device.processNextBlock() * 1.0e6;
+
+            std::sort(durations.begin(), durations.end());
+            auto percentile = [&](double p) { return durations[juce::jmin(durations.size() - 1, (size_t) (p * (double) durations.size()))]; };
+
+            Measurement measurement;
+            measurement.tier = tier;
+            measurement.numChannels = numChannels;
+            measurement.p50Micros = percentile(0.5);
+            measurement.p99Micros = percentile(0.99);
+            measurement.p999Micros = percentile(0.999);
+            measurement.maxMicros = durations.back();
+            measurement.p999Load = measurement.p999Micros / periodMicros;
+
+            for (auto duration : durations)
+                ++measurement.loadHistogram[(size_t) juce::jmin(10, (int) (duration / periodMicros * 10.0))];
+
+            measurements.push_back(measurement);
+
+            std::cout << ("engine/" + getTierName(tier)).paddedRight(' ', 18)
+                      << juce::String(numChannels).paddedLeft(' ', 4) << " ch"
+                      << "   p50 " << juce::String(measurement.p50Micros, 1).paddedLeft(' ', 8)
+                      << "   p99 " << juce::String(measurement.p99Micros, 1).paddedLeft(' ', 8)
+                      << "   p99.9 " << juce::String(measurement.p999Micros, 1).paddedLeft(' ', 8)
+                      << "   max " << juce::String(measurement.maxMicros, 1).paddedLeft(' ', 8) << " us"
+                      << "   load " << juce::String(measurement.p999Load * 100.0, 1).paddedLeft(' ', 6) << "%"
+                      << std::endl;
+
+            // Past the target, more channels only get slower
+            if (measurement.p999Load > settings.targetLoad)
+                break;
+
+            maxChannels[(size_t) tier] = numChannels;
+        }
+
+        std::cout << getTierName(tier) << ": " << maxChannels[(size_t) tier] << " channels under "
+                  << juce::roundToInt(settings.targetLoad * 100.0) << "% load at " << settings.bufferSize
+                  << " samples, " << settings.sampleRate / 1000.0 << " kHz" << std::endl;
+    }
+
+    device.stop();
+    device.close();
+}
+
+bool EngineStressBenchmark::writeJson(const juce::File& file) const
+{
+    auto maxima = std::make_unique<juce::DynamicObject>();
+    for (auto tier : { Tier::Minimal, Tier::Standard, Tier::Full })
+        maxima->setProperty(getTierName(tier), getMaxChannels(tier));
+
+    juce::Array<juce::var> measurementList;
+    for (const auto& measurement : measurements)
+        measurementList.add(measurement.toVar());
+
+    auto root = std::make_unique<juce::DynamicObject>();
+    root->setProperty("version", 1);
+    root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("machine", BenchmarkHarness::getMachineInfo());
+    root->setProperty("sampleRate", settings.sampleRate);
+    root->setProperty("bufferSize", settings.bufferSize);
+    root->setProperty("targetLoad", settings.targetLoad);
+    root->setProperty("secondsPerConfiguration", settings.secondsPerConfiguration);
+    root->setProperty("maxChannels", juce::var(maxima.release()));
+    root->setProperty("measurements", measurementList);
+
+    if (!file.replaceWithText(juce::JSON::toString(juce::var(root.release()))))
+    {
+        juce::Logger::writeToLog("EngineStressBenchmark: can't write " + file.getFullPathName());
+        return false;
+    }
+
+    return true;
+}
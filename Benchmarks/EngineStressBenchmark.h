@@ -0,0 +1,70 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+/**
+ * EngineStressBenchmark - How much mixer fits in one device buffer
+ *
+ * Drives a headless AudioEngine through its real device callback from a fake
+ * device at a chosen rate and buffer size, so routing, scenes and all the bus
+ * processing are included. For each processing tier the number of patched
+ * channels is ramped up; every callback is timed, and the largest channel
+ * count whose 99.9th percentile stays under the target DSP load is reported.
+ *
+ * Callbacks run back to back rather than on the device clock, so a
+ * configuration takes its load times the audio duration in wall time.
+ */
+class EngineStressBenchmark
+{
+public:
+    struct Settings
+    {
+        double sampleRate = 48000.0;
+        int bufferSize = 64;
+        double targetLoad = 0.7;                // Fraction of the buffer period
+        double secondsPerConfiguration = 5.0;   // Audio per measurement
+    };
+
+    /** How much of the mixer is switched on. */
+    enum class Tier
+    {
+        Minimal,    // Channel strips and buses bypassed: routing and summing only
+        Standard,   // Gate, EQ and compressor, FX sends, group and master processing
+        Full        // Standard plus the tuner on every channel
+    };
+
+    struct Measurement
+    {
+        Tier tier = Tier::Minimal;
+        int numChannels = 0;
+        double p50Micros = 0.0;
+        double p99Micros = 0.0;
+        double p999Micros = 0.0;
+        double maxMicros = 0.0;
+        double p999Load = 0.0;                  // p99.9 over the buffer period
+        std::array<int, 11> loadHistogram {};   // 10% bins; the last counts overruns
+
+        juce::var toVar() const;
+    };
+
+    explicit EngineStressBenchmark(const Settings& settings);
+
+    /** Ramp every tier; prints as it goes. */
+    void run();
+
+    /** Largest channel count under the target load, 0 if even one channel is over. */
+    int getMaxChannels(Tier tier) const;
+
+    const std::vector<Measurement>& getMeasurements() const { return measurements; }
+
+    bool writeJson(const juce::File& file) const;
+
+    static juce::String getTierName(Tier tier);
+
+private:
+    Settings settings;
+    std::vector<Measurement> measurements;
+    std::array<int, 3> maxChannels {};
+};
@@ -1,4 +1,5 @@
 #include "AudioEngine.h"
+#include "../Soundcheck/SoundcheckEngine.h"
 
 // Helper class for sine wave testing
 class SineWaveTestProcessor : public juce::AudioProcessor
@@ -67,7 +68,8 @@ private:
     float angleIncrement = 0.0f;
 };
 
-AudioEngine::AudioEngine()
+AudioEngine::AudioEngine(bool openAudioDevice)
+    : usesAudioDevice(openAudioDevice)
 {
     juce::Logger::writeToLog("AudioEngine constructor start");
     
@@ -135,8 +137,18 @@ AudioEngine::AudioEngine()
             throw std::runtime_error("Failed to create master bus processor");
         }
         
+        attachLoadProfiler();
+        
+        // A headless engine (offline rendering) is routed by whoever drives it
+        if (!usesAudioDevice)
+        {
+            juce::Logger::writeToLog("AudioEngine constructor done (headless)");
+            return;
+        }
+        
         // Initialize routing manager
-        getRoutingManager().initialize(channelProcessors, fxBusProcessors);
+        initializeRouting();
+        getRoutingManager().setAudioDeviceManager(&deviceManager);
         
         // Create a test sine wave source on Channel 1
         testSineWave = std::make_unique<SineWaveTestProcessor>();
@@ -153,6 +165,10 @@ AudioEngine::AudioEngine()
             throw std::runtime_error("Failed to set up audio devices");
         }
         
+        // Watch the callback's deadline, with the driver's own xrun count alongside
+        overloadGuard.setDeviceXRunSource([this] { return deviceManager.getXRunCount(); });
+        overloadGuard.start();
+        
         juce::Logger::writeToLog("AudioEngine constructor done");
     }
     catch (const std::exception& e)
@@ -169,10 +185,37 @@ AudioEngine::AudioEngine()
 
 AudioEngine::~AudioEngine()
 {
+    if (!usesAudioDevice)
+        return;
+    
     deviceManager.removeAudioCallback(this);
+    getRoutingManager().setAudioDeviceManager(nullptr);
     saveAudioDeviceState();
 }
 
+void AudioEngine::attachLoadProfiler()
+{
+    using SlotType = DSPLoadProfiler::SlotType;
+    
+    callbackLoad = &loadProfiler.addSlot("Audio callback", SlotType::Callback);
+    
+    for (auto& processor : channelProcessors)
+        processor->attachLoadProfiler(loadProfiler);
+    
+    for (int i = 0; i < numGroupBuses; ++i)
+        groupBusLoad.push_back(&loadProfiler.addSlot(groupBusProcessors[i]->getBusName() + " group", SlotType::GroupBus, i));
+    
+    for (int i = 0; i < numFXBuses; ++i)
+        fxBusLoad.push_back(&loadProfiler.addSlot(fxBusProcessors[i]->getBusName(), SlotType::FXBus, i));
+    
+    masterBusLoad = &loadProfiler.addSlot("Master", SlotType::MasterBus);
+}
+
+void AudioEngine::initializeRouting()
+{
+    getRoutingManager().initialize(channelProcessors, fxBusProcessors, numGroupBuses);
+}
+
 void AudioEngine::audioDeviceIOCallbackWithContext(const float* const* inputChannelData, 
                                                  int numInputChannels,
                                                  float* const* outputChannelData, 
@@ -180,127 +223,202 @@ void AudioEngine::audioDeviceIOCallbackWithContext(const float* const* inputChan
                                                  int numSamples,
                                                  const juce::AudioIODeviceCallbackContext& context)
 {
-    juce::Logger::writeToLog("audioDeviceIOCallbackWithContext: start");
-    // Clear output buffers
-    for (int channel = 0; channel < numOutputChannels; ++channel)
+    DSPLoadProfiler::ScopedTimer loadTimer(callbackLoad, numSamples);
+    const auto callbackStart = juce::Time::getHighResolutionTicks();
+    
+    // Scene changes land on a block boundary, before any channel is processed
+    sceneDeltaQueue.processBlock(numSamples);
+    sceneStore.processBlock(numSamples);
+    
+    // One routing table for the whole block; a repatch lands at the next one
+    const auto& routing = getRoutingManager().acquireTable();
+    
+    // A recorded take stands in for the live inputs while it plays
+    const bool playingBack = player.beginBlock();
+    if (playingBack)
+        inputChannelData = player.substituteInputs(routing, inputChannelData, numInputChannels, numSamples);
+    
+    // Feed the raw inputs, live or played back, to the soundcheck while it is measuring
+    auto& soundcheck = SoundcheckEngine::getInstance();
+    if (soundcheck.isRunning())
+        soundcheck.captureAudio(inputChannelData, numInputChannels, numSamples);
+    
+    // Raw inputs and the master mix to disk while a take is running
+    const bool recording = recorder.beginBlock();
+    if (recording)
+        recorder.pushInputs(routing, inputChannelData, numInputChannels, numSamples);
+    
+    for (int i = 0; i < numChannels; ++i)
+        processChannel(i, routing, inputChannelData, numInputChannels, numSamples);
+    
+    const auto& mix = mixBuses(routing, numSamples);
+    
+    if (recording)
     {
-        std::fill(outputChannelData[channel], outputChannelData[channel] + numSamples, 0.0f);
+        recorder.pushMaster(mix, numSamples);
+        recorder.endBlock();
     }
     
-    // Prepare temp buffer
-    tempBuffer.setSize(2, numSamples, false, false, true);
-    tempBuffer.clear();
+    if (playingBack)
+        player.endBlock();
     
-    // Prepare group bus buffer
-    groupBusBuffer.setSize(2, numSamples, false, false, true);
-    groupBusBuffer.clear();
+    // Output the master bus to the audio device
+    for (int channel = 0; channel < numOutputChannels; ++channel)
+    {
+        if (channel < mix.getNumChannels())
+            std::memcpy(outputChannelData[channel], mix.getReadPointer(channel), sizeof(float) * numSamples);
+        else
+            std::fill(outputChannelData[channel], outputChannelData[channel] + numSamples, 0.0f);
+    }
     
-    // Prepare FX bus buffer
-    fxBusBuffer.setSize(2, numSamples, false, false, true);
-    fxBusBuffer.clear();
+    overloadGuard.recordBlock(juce::Time::getHighResolutionTicks() - callbackStart, numSamples);
+}
+
+void AudioEngine::processChannel(int channelIndex, const auralis::RoutingTable& routing,
+                                 const float* const* inputChannelData, int numInputChannels, int numSamples)
+{
+    auto& buffer = channelBuffers[channelIndex];
+    channelActive[channelIndex] = 0;
     
-    // Prepare master buffer
-    masterBuffer.setSize(2, numSamples, false, false, true);
-    masterBuffer.clear();
+    if (channelIndex >= routing.numChannels)
+        return;
+    
+    buffer.setSize(2, numSamples, false, false, true);
     
-    // TESTING: Generate sine wave for Channel 1 (index 0)
     juce::MidiBuffer dummyMidi;
-    if (testSineWave)
+    const int input = routing.inputForChannel[channelIndex];
+    
+    if (input >= 0 && input < numInputChannels && inputChannelData[input] != nullptr)
     {
-        testSineWave->processBlock(tempBuffer, dummyMidi);
-        channelProcessors[0]->processBlock(tempBuffer, dummyMidi);
+        buffer.copyFrom(0, 0, inputChannelData[input], numSamples);
+        buffer.copyFrom(1, 0, inputChannelData[input], numSamples);
+    }
+    else if (channelIndex == 0 && testSineWave)
+    {
+        // TESTING: an unpatched Channel 1 plays the sine wave
+        testSineWave->processBlock(buffer, dummyMidi);
     }
     else
     {
-        // Normal flow for other channels - copy input to temp buffer
-        for (int channel = 0; channel < juce::jmin(2, numInputChannels); ++channel)
+        // Nothing patched: skip the channel's processing entirely
+        return;
+    }
+    
+    channelProcessors[channelIndex]->processBlock(buffer, dummyMidi);
+    channelActive[channelIndex] = 1;
+}
+
+void AudioEngine::mixInto(juce::AudioBuffer<float>& destination, const juce::AudioBuffer<float>& source, int numSamples, float gain)
+{
+    for (int ch = 0; ch < 2; ++ch)
+        kernels.addWithGain(destination.getWritePointer(ch), source.getReadPointer(ch), numSamples, gain);
+}
+
+const juce::AudioBuffer<float>& AudioEngine::mixBuses(const auralis::RoutingTable& routing, int numSamples)
+{
+    for (auto& buffer : groupBuffers)
+    {
+        buffer.setSize(2, numSamples, false, false, true);
+        buffer.clear();
+    }
+    
+    for (auto& buffer : fxBuffers)
+    {
+        buffer.setSize(2, numSamples, false, false, true);
+        buffer.clear();
+    }
+    
+    masterBuffer.setSize(2, numSamples, false, false, true);
+    masterBuffer.clear();
+    
+    juce::MidiBuffer dummyMidi;
+    
+    // Sum each processed channel into its group and FX send
+    for (int i = 0; i < numChannels && i < routing.numChannels; ++i)
+    {
+        auto* channelProcessor = channelProcessors[i].get();
+        if (!channelActive[i] || channelProcessor->isMuted())
+            continue;
+        
+        const auto& channelBuffer = channelBuffers[i];
+        
+        const int group = routing.groupForChannel[i];
+        if (group >= 0 && group < static_cast<int>(groupBuffers.size()))
         {
-            tempBuffer.copyFrom(channel, 0, inputChannelData[channel], numSamples);
+            mixInto(groupBuffers[group], channelBuffer, numSamples, 1.0f);
         }
         
-        // Process each channel
-        for (int i = 0; i < numChannels && i < numInputChannels; ++i)
+        const int fxBus = routing.fxBusForChannel[i];
+        const float sendLevel = channelProcessor->getFxSendLevel();
+        if (fxBus >= 0 && fxBus < static_cast<int>(fxBuffers.size()) && sendLevel > 0.0f)
         {
-            channelProcessors[i]->processBlock(tempBuffer, dummyMidi);
+            mixInto(fxBuffers[fxBus], channelBuffer, numSamples, sendLevel);
         }
     }
     
-    // Route channels to their respective group buses
-    for (int i = 0; i < numChannels; ++i)
+    // Process the group buses and sum those patched to the master
+    for (int i = 0; i < static_cast<int>(groupBuffers.size()); ++i)
     {
-        auto* channelProcessor = channelProcessors[i].get();
-        
-        // Determine which group bus this channel should go to based on channel type
-        GroupBusProcessor* targetGroupBus = nullptr;
-        
-        switch (channelProcessor->getChannelType())
         {
-            case ChannelProcessor::ChannelType::Vocal:
-                targetGroupBus = groupBusProcessors[0].get(); // Vocals
-                break;
-            case ChannelProcessor::ChannelType::Instrument:
-                targetGroupBus = groupBusProcessors[1].get(); // Instruments
-                break;
-            case ChannelProcessor::ChannelType::Drums:
-                targetGroupBus = groupBusProcessors[2].get(); // Drums
-                break;
-            case ChannelProcessor::ChannelType::Other:
-                targetGroupBus = groupBusProcessors[3].get(); // Speech (mapped to Other)
-                break;
-            default:
-                // Unsupported channel type, skip
-                continue;
+            DSPLoadProfiler::ScopedTimer loadTimer(groupBusLoad[i], numSamples);
+            groupBusProcessors[i]->processBlock(groupBuffers[i], dummyMidi);
         }
         
-        // Copy the processed channel audio to the group bus buffer for further processing
-        if (targetGroupBus)
+        if (routing.groupToMaster[i])
         {
-            // We'll use a separate buffer for each group bus to avoid interference
-            tempBuffer.clear();
-            
-            // Get the processed audio from the channel processor
-            // In a real implementation, this would involve more sophisticated routing
-            // but for now, we'll just use the global temp buffer
-            
-            // Process the group bus
-            targetGroupBus->processBlock(tempBuffer, dummyMidi);
-            
-            // Add to the group bus buffer
-            groupBusBuffer.addFrom(0, 0, tempBuffer, 0, 0, numSamples);
-            groupBusBuffer.addFrom(1, 0, tempBuffer, 1, 0, numSamples);
+            mixInto(masterBuffer, groupBuffers[i], numSamples, 1.0f);
         }
     }
     
-    // Sum the processed group buses to the FX bus
-    fxBusBuffer.addFrom(0, 0, groupBusBuffer, 0, 0, numSamples);
-    fxBusBuffer.addFrom(1, 0, groupBusBuffer, 1, 0, numSamples);
-    
-    // Process FX buses
-    for (int i = 0; i < numFXBuses; ++i)
+    // Process the FX buses and return them to the master
+    for (int i = 0; i < static_cast<int>(fxBuffers.size()); ++i)
     {
-        fxBusProcessors[i]->processBlock(fxBusBuffer, dummyMidi);
+        {
+            DSPLoadProfiler::ScopedTimer loadTimer(fxBusLoad[i], numSamples);
+            fxBusProcessors[i]->processBlock(fxBuffers[i], dummyMidi);
+        }
+        mixInto(masterBuffer, fxBuffers[i], numSamples, 1.0f);
     }
     
-    // Add FX bus output to master
-    masterBuffer.addFrom(0, 0, fxBusBuffer, 0, 0, numSamples);
-    masterBuffer.addFrom(1, 0, fxBusBuffer, 1, 0, numSamples);
-    
     // Process master bus
-    masterBusProcessor->processBlock(masterBuffer, dummyMidi);
-    
-    // Output the master bus to the audio device
-    for (int channel = 0; channel < juce::jmin(numOutputChannels, 2); ++channel)
     {
-        std::memcpy(outputChannelData[channel], masterBuffer.getReadPointer(channel), sizeof(float) * numSamples);
+        DSPLoadProfiler::ScopedTimer loadTimer(masterBusLoad, numSamples);
+        masterBusProcessor->processBlock(masterBuffer, dummyMidi);
     }
-    juce::Logger::writeToLog("audioDeviceIOCallbackWithContext: end");
+    return masterBuffer;
 }
 
 void AudioEngine::audioDeviceAboutToStart(juce::AudioIODevice* device)
 {
-    // Get the sample rate and buffer size from the device
-    sampleRate = device->getCurrentSampleRate();
-    bufferSize = device->getCurrentBufferSizeSamples();
+    // Soundcheck analysis follows the device rate
+    SoundcheckEngine::getInstance().setSampleRate(device->getCurrentSampleRate());
+    
+    prepareToPlay(device->getCurrentSampleRate(), device->getCurrentBufferSizeSamples());
+    
+    sceneDeltaQueue.prepare(sampleRate, numChannels);
+    sceneStore.prepare(sampleRate);
+    getRoutingManager().prepare();
+}
+
+void AudioEngine::audioDeviceStopped()
+{
+    // Land any scene change that was still in flight
+    sceneDeltaQueue.released();
+    sceneStore.released();
+    getRoutingManager().released();
+    
+    releaseResources();
+}
+
+void AudioEngine::prepareToPlay(double newSampleRate, int maximumBlockSize)
+{
+    sampleRate = newSampleRate;
+    bufferSize = maximumBlockSize;
+    
+    loadProfiler.prepare(sampleRate);
+    overloadGuard.prepare(sampleRate);
+    recorder.prepare(sampleRate);
+    player.prepare(sampleRate, bufferSize);
     
     // Prepare the test sine wave source
     if (testSineWave)
@@ -329,13 +447,21 @@ void AudioEngine::audioDeviceAboutToStart(juce::AudioIODevice* device)
     // Prepare the master bus processor
     masterBusProcessor->prepareToPlay(sampleRate, bufferSize);
     
-    // Prepare the buffers
-    tempBuffer.setSize(2, bufferSize);
-    fxBusBuffer.setSize(2, bufferSize);
+    // Prepare the buffers so processing never allocates
+    channelBuffers.resize(channelProcessors.size());
+    for (auto& buffer : channelBuffers)
+        buffer.setSize(2, bufferSize);
+    channelActive.assign(channelProcessors.size(), 0);
+    groupBuffers.resize(groupBusProcessors.size());
+    for (auto& buffer : groupBuffers)
+        buffer.setSize(2, bufferSize);
+    fxBuffers.resize(fxBusProcessors.size());
+    for (auto& buffer : fxBuffers)
+        buffer.setSize(2, bufferSize);
     masterBuffer.setSize(2, bufferSize);
 }
 
-void AudioEngine::audioDeviceStopped()
+void AudioEngine::releaseResources()
 {
     // Release resources from the test sine wave
     if (testSineWave)
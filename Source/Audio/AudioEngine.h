@@ -5,12 +5,21 @@
 #include "FXBusProcessor.h"
 #include "MasterBusProcessor.h"
 #include "GroupBusProcessor.h"
+#include "SceneDelta.h"
+#include "SceneStore.h"
+#include "DSPLoadProfiler.h"
+#include "OverloadGuard.h"
 #include "../Routing/RoutingManager.h"
+#include "../Recording/MultitrackPlayer.h"
+#include "../Recording/MultitrackRecorder.h"
+#include "../DSP/SimdKernels.h"
 
 class AudioEngine : public juce::AudioIODeviceCallback
 {
 public:
-    AudioEngine();
+    /** Pass false for a headless engine that never opens a device or touches
+        the shared RoutingManager, e.g. for offline rendering. */
+    explicit AudioEngine(bool openAudioDevice = true);
     ~AudioEngine() override;
     
     // AudioIODeviceCallback interface implementation
@@ -24,6 +33,18 @@ public:
     void audioDeviceAboutToStart(juce::AudioIODevice* device) override;
     void audioDeviceStopped() override;
     
+    // Device-independent processing, shared by the device callback and offline rendering
+    void prepareToPlay(double sampleRate, int maximumBlockSize);
+    void releaseResources();
+    
+    /** Run one channel strip on its patched input into the channel's own buffer.
+        Different channels may be processed in parallel. */
+    void processChannel(int channelIndex, const auralis::RoutingTable& routing,
+                        const float* const* inputChannelData, int numInputChannels, int numSamples);
+    
+    /** Sum the processed channels through the group, FX and master buses. */
+    const juce::AudioBuffer<float>& mixBuses(const auralis::RoutingTable& routing, int numSamples);
+    
     // Get a ChannelProcessor for a specific channel
     ChannelProcessor* getChannelProcessor(int channelIndex);
     
@@ -32,12 +53,40 @@ public:
     GroupBusProcessor* getGroupBusProcessor(int busIndex);
     MasterBusProcessor* getMasterBusProcessor();
     
+    // Processor counts
+    int getNumChannels() const { return numChannels; }
+    int getNumGroupBuses() const { return numGroupBuses; }
+    int getNumFXBuses() const { return numFXBuses; }
+    
     // Get all group bus processors
     std::vector<GroupBusProcessor*> getAllGroupBusProcessors();
     
+    // Bulk channel changes applied by the audio thread in one step
+    SceneDeltaQueue& getSceneDeltaQueue() { return sceneDeltaQueue; }
+    
+    // In-memory scenes for recall between song segments
+    SceneStore& getSceneStore() { return sceneStore; }
+    
+    // Per-processor DSP load; off until enabled, e.g. while the profiler panel is showing
+    DSPLoadProfiler& getLoadProfiler() { return loadProfiler; }
+    
+    // Callback deadline watch and the quality steps it takes under overload
+    OverloadGuard& getOverloadGuard() { return overloadGuard; }
+    
+    // Every channel's raw input and the master to disk
+    MultitrackRecorder& getRecorder() { return recorder; }
+    
+    // A recorded take played into the channels in place of the live inputs
+    MultitrackPlayer& getPlayer() { return player; }
+    
     // Get the routing manager
     auralis::RoutingManager& getRoutingManager() { return auralis::RoutingManager::getInstance(); }
     
+    /** Hand this engine's processors to the shared RoutingManager. An engine
+        with a device does this itself; a headless engine driven through the
+        device callback, e.g. by the stress benchmark, calls it explicitly. */
+    void initializeRouting();
+    
     // Get the audio device manager
     juce::AudioDeviceManager& getAudioDeviceManager() { return deviceManager; }
     
@@ -61,20 +110,40 @@ private:
     static constexpr int numFXBuses = 3; // Vocal, Instrument, Drum
     static constexpr int numGroupBuses = 4; // Vocals, Instruments, Drums, Speech
     
+    // Outlives the processors below, which hold pointers to its slots
+    DSPLoadProfiler loadProfiler;
+    DSPLoadProfiler::Slot* callbackLoad = nullptr;
+    std::vector<DSPLoadProfiler::Slot*> groupBusLoad;
+    std::vector<DSPLoadProfiler::Slot*> fxBusLoad;
+    DSPLoadProfiler::Slot* masterBusLoad = nullptr;
+    void attachLoadProfiler();
+    
     std::vector<std::unique_ptr<ChannelProcessor>> channelProcessors;
     std::vector<std::unique_ptr<GroupBusProcessor>> groupBusProcessors;
     std::vector<std::unique_ptr<FXBusProcessor>> fxBusProcessors;
     std::unique_ptr<MasterBusProcessor> masterBusProcessor;
     
+    SceneDeltaQueue sceneDeltaQueue;
+    SceneStore sceneStore { *this };
+    OverloadGuard overloadGuard { *this };
+    MultitrackRecorder recorder { numChannels };
+    MultitrackPlayer player { numChannels };
+    
     // Test sine wave generator
     std::unique_ptr<juce::AudioProcessor> testSineWave;
     
     juce::AudioDeviceManager deviceManager;
-    juce::AudioBuffer<float> tempBuffer;
-    juce::AudioBuffer<float> groupBusBuffer;
-    juce::AudioBuffer<float> fxBusBuffer;
+    std::vector<juce::AudioBuffer<float>> channelBuffers;  // One per channel
+    std::vector<juce::uint8> channelActive;                // Set by processChannel()
+    std::vector<juce::AudioBuffer<float>> groupBuffers;    // One per group bus
+    std::vector<juce::AudioBuffer<float>> fxBuffers;       // One per FX bus
     juce::AudioBuffer<float> masterBuffer;
     
+    // Bus summing, in this CPU's vector kernels
+    const auralis::simd::KernelTable& kernels { auralis::simd::getKernels() };
+    void mixInto(juce::AudioBuffer<float>& destination, const juce::AudioBuffer<float>& source, int numSamples, float gain);
+    
+    const bool usesAudioDevice;
     double sampleRate = 44100.0;
     int bufferSize = 512;
 }; 
\ No newline at end of file
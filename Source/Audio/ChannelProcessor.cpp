@@ -32,7 +32,7 @@ ChannelProcessor::ChannelProcessor(int index, ChannelType type, AudioEngine* eng
     updateNodeBypass(gateNode, gateBypass);
     updateNodeBypass(eqNode, eqBypass);
     updateNodeBypass(compNode, compressorBypass);
-    updateNodeBypass(tunerNode, tunerBypass);
+    updateNodeBypass(tunerNode, tunerBypass || tunerSuspended);
 }
 
 ChannelProcessor::~ChannelProcessor()
@@ -83,8 +83,10 @@ void ChannelProcessor::connectNodes()
 {
     // Connect nodes in this order: Input -> Trim -> Gate -> EQ -> Comp -> Tuner -> Output
     
-    // Clear any existing connections
-    processorGraph->clear();
+    // Clear any existing connections. AudioProcessorGraph::clear() would also
+    // delete the nodes, and with them the processors trim..tuner point to.
+    for (const auto& connection : processorGraph->getConnections())
+        processorGraph->removeConnection(connection);
     
     // Connect input to trim
     for (int channel = 0; channel < 2; ++channel)
@@ -141,6 +143,8 @@ void ChannelProcessor::prepareToPlay(double sampleRate, int maximumExpectedSampl
 
 void ChannelProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    DSPLoadProfiler::ScopedTimer loadTimer(stripLoad, buffer.getNumSamples());
+    
     // Process the buffer through the graph
     processorGraph->processBlock(buffer, midiMessages);
 }
@@ -150,6 +154,19 @@ void ChannelProcessor::releaseResources()
     processorGraph->releaseResources();
 }
 
+void ChannelProcessor::attachLoadProfiler(DSPLoadProfiler& profiler)
+{
+    using SlotType = DSPLoadProfiler::SlotType;
+    const juce::String name = "Ch " + juce::String(channelIndex + 1);
+    
+    stripLoad = &profiler.addSlot(name, SlotType::ChannelStrip, channelIndex);
+    trim->setLoadSlot(&profiler.addSlot(name + " Trim", SlotType::ChannelStage, channelIndex));
+    gate->setLoadSlot(&profiler.addSlot(name + " Gate", SlotType::ChannelStage, channelIndex));
+    eq->setLoadSlot(&profiler.addSlot(name + " EQ", SlotType::ChannelStage, channelIndex));
+    comp->setLoadSlot(&profiler.addSlot(name + " Compressor", SlotType::ChannelStage, channelIndex));
+    tuner->setLoadSlot(&profiler.addSlot(name + " Tuner", SlotType::ChannelStage, channelIndex));
+}
+
 void ChannelProcessor::setTrimGain(float gainInDecibels)
 {
     trimGainDecibels = gainInDecibels;
@@ -189,7 +206,22 @@ void ChannelProcessor::setFxSendLevel(float level)
 void ChannelProcessor::setTunerEnabled(bool enabled)
 {
     tunerBypass = !enabled;
-    updateNodeBypass(tunerNode, tunerBypass);
+    updateNodeBypass(tunerNode, tunerBypass || tunerSuspended);
+}
+
+void ChannelProcessor::setTunerSuspended(bool shouldBeSuspended)
+{
+    tunerSuspended = shouldBeSuspended;
+    updateNodeBypass(tunerNode, tunerBypass || tunerSuspended);
+}
+
+void ChannelProcessor::setTunerReducedQuality(bool shouldBeReduced)
+{
+    // The overload guard reaches the tuner through this pointer: it must still be the graph's
+    jassert(processorGraph->getNodeForId(tunerNode->nodeID) == tunerNode.get());
+
+    if (tuner != nullptr)
+        tuner->setReducedQuality(shouldBeReduced);
 }
 
 void ChannelProcessor::setTunerStrength(float strength)
@@ -224,6 +256,14 @@ void ChannelProcessor::setEQBandGain(EQProcessor::Band band, float gainInDb)
     }
 }
 
+void ChannelProcessor::setEQGains(const std::array<float, 4>& gainsInDb)
+{
+    if (eq != nullptr)
+    {
+        eq->setGains(gainsInDb);
+    }
+}
+
 void ChannelProcessor::setCompressorRatio(float ratio)
 {
     if (comp != nullptr)
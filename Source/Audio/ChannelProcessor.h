@@ -7,6 +7,7 @@
 #include "../FX/CompressorProcessor.h"
 #include "TunerProcessor.h"
 #include "FXBusProcessor.h"
+#include "DSPLoadProfiler.h"
 
 // Forward declaration to avoid circular dependency
 class AudioEngine;
@@ -42,10 +43,17 @@ public:
     void setTunerStrength(float strength); // 0.0 to 1.0
     void setMuted(bool shouldBeMuted) { muted = shouldBeMuted; }
     void setSolo(bool shouldBeSolo) { solo = shouldBeSolo; }
+    void setLowPriority(bool shouldBeLowPriority) { lowPriority = shouldBeLowPriority; }
+    
+    /** Overload shedding: bypass the tuner, or resample it more cheaply, without
+        touching its setting, so sessions and the UI never see the change. */
+    void setTunerSuspended(bool shouldBeSuspended);
+    void setTunerReducedQuality(bool shouldBeReduced);
     
     // New methods for soundcheck corrections
     void setGateThreshold(float thresholdInDb);
     void setEQBandGain(EQProcessor::Band band, float gainInDb);
+    void setEQGains(const std::array<float, 4>& gainsInDb);
     void setCompressorRatio(float ratio);
     void setCompressorThreshold(float thresholdInDb);
     
@@ -59,6 +67,9 @@ public:
     float getTunerStrength() const { return tuner ? tuner->getStrength() : 0.0f; }
     bool isMuted() const { return muted; }
     bool isSolo() const { return solo; }
+    bool isLowPriority() const { return lowPriority; }    // First to lose its tuner under overload
+    bool isTunerSuspended() const { return tunerSuspended; }
+    bool isTunerReducedQuality() const { return tuner != nullptr && tuner->isReducedQuality(); }
     
     // New get methods for soundcheck parameters
     float getGateThreshold() const;
@@ -76,6 +87,9 @@ public:
     void setChannelType(ChannelType type) { channelType = type; }
     void setAudioEngine(AudioEngine* engine) { audioEngine = engine; }
     void setFxBusProcessor(FXBusProcessor* bus) { fxSendBus = bus; }
+    
+    /** Give the strip and each of its stages a slot in the engine's load profiler. */
+    void attachLoadProfiler(DSPLoadProfiler& profiler);
 
 private:
     // Channel identification
@@ -92,6 +106,8 @@ private:
     float fxSendLevel = 0.0f;
     bool muted = false;
     bool solo = false;
+    bool lowPriority = false;
+    bool tunerSuspended = false;
     
     // Individual processors - these are pointers to processors owned by the graph
     TrimProcessor* trim = nullptr;
@@ -101,6 +117,9 @@ private:
     FXBusProcessor* fxSendBus = nullptr;  // Assigned by RoutingManager
     auralis::TunerProcessor* tuner = nullptr;          // Owned by the graph
     
+    // Whole-strip cost, graph overhead included; the stages time themselves
+    DSPLoadProfiler::Slot* stripLoad = nullptr;
+    
     // AudioProcessorGraph for connecting the processors
     std::unique_ptr<juce::AudioProcessorGraph> processorGraph;
     juce::AudioProcessorGraph::Node::Ptr inputNode;
@@ -0,0 +1,138 @@
+#include "DSPLoadProfiler.h"
+
+juce::var DSPLoadProfiler::Statistics::toVar() const
+{
+    auto statistics = std::make_unique<juce::DynamicObject>();
+    statistics->setProperty("minLoad", minLoad);
+    statistics->setProperty("averageLoad", averageLoad);
+    statistics->setProperty("maxLoad", maxLoad);
+    statistics->setProperty("overallLoad", overallLoad);
+    statistics->setProperty("worstLoad", worstLoad);
+    statistics->setProperty("numBlocks", numBlocks);
+    return juce::var(statistics.release());
+}
+
+DSPLoadProfiler::Slot::Slot(const DSPLoadProfiler& ownerToUse, const juce::String& slotName, SlotType slotType, int slotIndex)
+    : owner(ownerToUse), name(slotName), type(slotType), index(slotIndex)
+{
+}
+
+void DSPLoadProfiler::Slot::record(juce::int64 ticks, int numSamples) noexcept
+{
+    if (numSamples <= 0 || owner.ticksPerSample <= 0.0)
+        return;
+
+    // A reset from the message thread lands here, on the thread that owns the figures
+    const auto generation = owner.resetGeneration.load(std::memory_order_relaxed);
+    if (generation != seenResetGeneration.load(std::memory_order_relaxed))
+    {
+        windowTicks = windowSamples = 0;
+        totalTicks = totalSamples = blocks = 0;
+        worst = 0.0f;
+        seenResetGeneration.store(generation, std::memory_order_relaxed);
+    }
+
+    const auto load = static_cast<float>(static_cast<double>(ticks) / (numSamples * owner.ticksPerSample));
+
+    windowMin = windowSamples == 0 ? load : juce::jmin(windowMin, load);
+    windowMax = windowSamples == 0 ? load : juce::jmax(windowMax, load);
+    windowTicks += ticks;
+    windowSamples += numSamples;
+
+    totalTicks += ticks;
+    totalSamples += numSamples;
+    worst = juce::jmax(worst, load);
+    ++blocks;
+
+    worstLoad.store(worst, std::memory_order_relaxed);
+    numBlocks.store(blocks, std::memory_order_relaxed);
+
+    if (windowSamples < owner.windowLength)
+        return;
+
+    // Average over the window's samples, not its blocks, so odd block sizes weigh right
+    minLoad.store(windowMin, std::memory_order_relaxed);
+    averageLoad.store(static_cast<float>(static_cast<double>(windowTicks) / (static_cast<double>(windowSamples) * owner.ticksPerSample)),
+                      std::memory_order_relaxed);
+    maxLoad.store(windowMax, std::memory_order_relaxed);
+    overallLoad.store(static_cast<float>(static_cast<double>(totalTicks) / (static_cast<double>(totalSamples) * owner.ticksPerSample)),
+                      std::memory_order_relaxed);
+
+    windowTicks = windowSamples = 0;
+}
+
+DSPLoadProfiler::Statistics DSPLoadProfiler::Slot::getStatistics() const noexcept
+{
+    if (seenResetGeneration.load(std::memory_order_relaxed) != owner.resetGeneration.load(std::memory_order_relaxed))
+        return {};
+
+    Statistics statistics;
+    statistics.minLoad = minLoad.load(std::memory_order_relaxed);
+    statistics.averageLoad = averageLoad.load(std::memory_order_relaxed);
+    statistics.maxLoad = maxLoad.load(std::memory_order_relaxed);
+    statistics.overallLoad = overallLoad.load(std::memory_order_relaxed);
+    statistics.worstLoad = worstLoad.load(std::memory_order_relaxed);
+    statistics.numBlocks = numBlocks.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+DSPLoadProfiler::DSPLoadProfiler()
+{
+    prepare(sampleRate);
+}
+
+DSPLoadProfiler::Slot& DSPLoadProfiler::addSlot(const juce::String& name, SlotType type, int index)
+{
+    slots.push_back(std::make_unique<Slot>(*this, name, type, index));
+    return *slots.back();
+}
+
+void DSPLoadProfiler::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    ticksPerSample = static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()) / sampleRate;
+    windowLength = juce::jmax<juce::int64>(1, static_cast<juce::int64>(windowSeconds * sampleRate));
+}
+
+juce::String DSPLoadProfiler::getTypeName(SlotType type)
+{
+    switch (type)
+    {
+        case SlotType::Callback:     return "Callback";
+        case SlotType::ChannelStrip: return "ChannelStrip";
+        case SlotType::ChannelStage: return "ChannelStage";
+        case SlotType::GroupBus:     return "GroupBus";
+        case SlotType::FXBus:        return "FXBus";
+        case SlotType::MasterBus:    return "MasterBus";
+    }
+    return {};
+}
+
+bool DSPLoadProfiler::writeReport(const juce::File& file) const
+{
+    juce::Array<juce::var> slotList;
+    for (const auto& slot : slots)
+    {
+        auto entry = slot->getStatistics().toVar();
+        entry.getDynamicObject()->setProperty("name", slot->getName());
+        entry.getDynamicObject()->setProperty("type", getTypeName(slot->getType()));
+        entry.getDynamicObject()->setProperty("index", slot->getIndex());
+        slotList.add(entry);
+    }
+
+    auto root = std::make_unique<juce::DynamicObject>();
+    root->setProperty("version", 1);
+    root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("sampleRate", sampleRate);
+    root->setProperty("windowSeconds", windowSeconds);
+    root->setProperty("compiledIn", isCompiledIn);
+    root->setProperty("slots", slotList);
+
+    if (!file.replaceWithText(juce::JSON::toString(juce::var(root.release()))))
+    {
+        juce::Logger::writeToLog("DSPLoadProfiler: can't write " + file.getFullPathName());
+        return false;
+    }
+
+    return true;
+}
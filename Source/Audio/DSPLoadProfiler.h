@@ -0,0 +1,177 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Set to 0 (cmake -DAURALIS_DSP_PROFILER=OFF) to compile the timers out entirely
+#ifndef AURALIS_DSP_PROFILER
+ #define AURALIS_DSP_PROFILER 1
+#endif
+
+/**
+ * DSPLoadProfiler - Where the audio callback's time goes
+ *
+ * Every channel strip, each of its stages, each group and FX bus, the master
+ * bus and the whole callback own a slot. A ScopedTimer around a processor's
+ * block adds its cost to the slot as a fraction of the block's real-time
+ * budget, so 0.25 means a quarter of the time the device allows.
+ *
+ * A slot is only ever written by the thread running its processor, one block
+ * at a time (channel strips may run on different threads, but never the same
+ * strip twice at once), so recording takes no locks and no read-modify-write
+ * atomics; slots are cache-line aligned so parallel strips don't share lines.
+ * Every half second of audio the slot publishes the min, average and max of
+ * that window, plus the average and worst block since the last reset, for
+ * the profiler panel or a report file to read from any thread.
+ *
+ * Timing is off until setEnabled(true); while off a timer costs one relaxed
+ * load. Strips, buses and the callback are a few dozen timers a block; the
+ * stages inside the strips are four times as many again, so they are timed
+ * only after setStagesEnabled(true). Built with AURALIS_DSP_PROFILER=0 the
+ * timers are empty and cost nothing; the slots and their names stay, always
+ * reading zero.
+ */
+class DSPLoadProfiler
+{
+public:
+    static constexpr bool isCompiledIn = AURALIS_DSP_PROFILER != 0;
+
+    enum class SlotType
+    {
+        Callback,       // The whole device callback
+        ChannelStrip,
+        ChannelStage,   // Trim, gate, EQ, compressor or tuner inside a strip
+        GroupBus,
+        FXBus,
+        MasterBus
+    };
+
+    /** Loads as fractions of the block's real-time budget. */
+    struct Statistics
+    {
+        float minLoad = 0.0f;           // Last window
+        float averageLoad = 0.0f;
+        float maxLoad = 0.0f;
+        float overallLoad = 0.0f;       // Since the last reset
+        float worstLoad = 0.0f;
+        juce::int64 numBlocks = 0;
+
+        juce::var toVar() const;
+    };
+
+    class alignas(64) Slot
+    {
+    public:
+        Slot(const DSPLoadProfiler& owner, const juce::String& name, SlotType type, int index);
+
+        const juce::String& getName() const { return name; }
+        SlotType getType() const { return type; }
+        int getIndex() const { return index; }          // Channel or bus index, -1 for the callback
+
+        /** Audio thread: one block of this processor took this many high-resolution ticks. */
+        void record(juce::int64 ticks, int numSamples) noexcept;
+
+        /** Any thread: the last published figures; zero after a reset until the slot runs again. */
+        Statistics getStatistics() const noexcept;
+
+        bool isTiming() const noexcept
+        {
+            return owner.isEnabled() && (type != SlotType::ChannelStage || owner.areStagesEnabled());
+        }
+
+    private:
+        const DSPLoadProfiler& owner;
+        const juce::String name;
+        const SlotType type;
+        const int index;
+
+        // Written only by the thread running the processor
+        std::atomic<juce::uint32> seenResetGeneration { 0 };
+        juce::int64 windowTicks = 0;
+        juce::int64 windowSamples = 0;
+        float windowMin = 0.0f, windowMax = 0.0f;
+        juce::int64 totalTicks = 0;
+        juce::int64 totalSamples = 0;
+        juce::int64 blocks = 0;
+        float worst = 0.0f;
+
+        // Published for readers
+        std::atomic<float> minLoad { 0.0f }, averageLoad { 0.0f }, maxLoad { 0.0f };
+        std::atomic<float> overallLoad { 0.0f }, worstLoad { 0.0f };
+        std::atomic<juce::int64> numBlocks { 0 };
+
+        JUCE_DECLARE_NON_COPYABLE(Slot)
+    };
+
+    /** Times the rest of the scope into a slot; does nothing for a null slot or while disabled. */
+    class ScopedTimer
+    {
+    public:
+       #if AURALIS_DSP_PROFILER
+        ScopedTimer(Slot* slotToUse, int numSamplesInBlock) noexcept
+            : slot(slotToUse != nullptr && slotToUse->isTiming() ? slotToUse : nullptr),
+              numSamples(numSamplesInBlock),
+              start(slot != nullptr ? juce::Time::getHighResolutionTicks() : 0)
+        {
+        }
+
+        ~ScopedTimer()
+        {
+            if (slot != nullptr)
+                slot->record(juce::Time::getHighResolutionTicks() - start, numSamples);
+        }
+
+    private:
+        Slot* const slot;
+        const int numSamples;
+        const juce::int64 start;
+       #else
+        ScopedTimer(Slot*, int) noexcept {}
+       #endif
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedTimer)
+    };
+
+    DSPLoadProfiler();
+
+    /** Message thread, before audio starts: slots live as long as the profiler. */
+    Slot& addSlot(const juce::String& name, SlotType type, int index = -1);
+
+    int getNumSlots() const { return static_cast<int>(slots.size()); }
+    const Slot& getSlot(int slotIndex) const { return *slots[(size_t) slotIndex]; }
+
+    /** Call before processing starts at a new rate. */
+    void prepare(double sampleRate);
+
+    void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled && isCompiledIn, std::memory_order_relaxed); }
+    bool isEnabled() const noexcept { return enabled.load(std::memory_order_relaxed); }
+
+    /** Also time each stage inside the channel strips. */
+    void setStagesEnabled(bool shouldBeEnabled) { stagesEnabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool areStagesEnabled() const noexcept { return stagesEnabled.load(std::memory_order_relaxed); }
+
+    /** Clears every slot's figures; each slot picks this up on its next block. */
+    void reset() { resetGeneration.fetch_add(1, std::memory_order_relaxed); }
+
+    /** Every slot's statistics as JSON, e.g. to attach to a bug report. */
+    bool writeReport(const juce::File& file) const;
+
+    static juce::String getTypeName(SlotType type);
+
+private:
+    std::vector<std::unique_ptr<Slot>> slots;
+
+    double sampleRate = 44100.0;
+    double ticksPerSample = 0.0;
+    juce::int64 windowLength = 0;       // Samples per published window
+
+    std::atomic<bool> enabled { false };
+    std::atomic<bool> stagesEnabled { false };
+    std::atomic<juce::uint32> resetGeneration { 0 };
+
+    static constexpr double windowSeconds = 0.5;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DSPLoadProfiler)
+};
@@ -8,10 +8,12 @@ FXBusProcessor::FXBusProcessor(BusType type)
     
     // Create the effect processors
     reverb = std::make_unique<ReverbProcessor>();
+    convolutionReverb = std::make_unique<ConvolutionReverbProcessor>();
     delay = std::make_unique<DelayProcessor>();
     
     // Set default wet levels
     reverb->setWetLevel(reverbWetLevel);
+    convolutionReverb->setWetLevel(reverbWetLevel);
     delay->setWetLevel(delayWetLevel);
 }
 
@@ -27,6 +29,7 @@ void FXBusProcessor::prepareToPlay(double sampleRate, int maximumExpectedSamples
     
     // Reset the processors
     reverb->releaseResources();
+    convolutionReverb->releaseResources();
     delay->releaseResources();
     
     // Configure the processor graph
@@ -55,6 +58,11 @@ void FXBusProcessor::prepareToPlay(double sampleRate, int maximumExpectedSamples
     delayNode = processorGraph->addNode(std::move(delay),
                                       juce::AudioProcessorGraph::NodeID(4));
     
+    // Add the convolution reverb node beside the algorithmic reverb with node ID 5
+    convolutionReverb->prepareToPlay(sampleRate, maximumExpectedSamplesPerBlock);
+    convolutionNode = processorGraph->addNode(std::move(convolutionReverb),
+                                            juce::AudioProcessorGraph::NodeID(5));
+    
     // Set up the node connections
     updateConnections();
     
@@ -65,9 +73,15 @@ void FXBusProcessor::prepareToPlay(double sampleRate, int maximumExpectedSamples
 
 void FXBusProcessor::updateConnections()
 {
-    // Clear all existing connections
-    processorGraph->clear();
-    
+    // Nodes are only created in prepareToPlay
+    if (inputNode == nullptr || outputNode == nullptr)
+        return;
+
+    // Clear all existing connections. AudioProcessorGraph::clear() would also
+    // delete the nodes, so remove the connections one by one instead.
+    for (const auto& connection : processorGraph->getConnections())
+        processorGraph->removeConnection(connection);
+
     // If bypassed, connect input directly to output
     if (bypassed)
     {
@@ -79,6 +93,9 @@ void FXBusProcessor::updateConnections()
         return;
     }
     
+    // Pick the reverb engine for the current mode
+    auto activeReverbNode = reverbMode == ReverbMode::Convolution && !reducedQuality ? convolutionNode : reverbNode;
+    
     // Connect nodes in series: Input -> Reverb -> Delay -> Output
     for (int channel = 0; channel < 2; ++channel)
     {
@@ -86,12 +103,12 @@ void FXBusProcessor::updateConnections()
         if (!reverbBypass)
         {
             processorGraph->addConnection({ { inputNode->nodeID, channel }, 
-                                          { reverbNode->nodeID, channel } });
+                                          { activeReverbNode->nodeID, channel } });
             
             // Connect reverb to delay (or output if delay is bypassed)
             if (!delayBypass)
             {
-                processorGraph->addConnection({ { reverbNode->nodeID, channel }, 
+                processorGraph->addConnection({ { activeReverbNode->nodeID, channel }, 
                                               { delayNode->nodeID, channel } });
                 
                 // Connect delay to output
@@ -101,7 +118,7 @@ void FXBusProcessor::updateConnections()
             else
             {
                 // If delay is bypassed, connect reverb directly to output
-                processorGraph->addConnection({ { reverbNode->nodeID, channel }, 
+                processorGraph->addConnection({ { activeReverbNode->nodeID, channel }, 
                                               { outputNode->nodeID, channel } });
             }
         }
@@ -169,6 +186,12 @@ void FXBusProcessor::setReverbWetLevel(float level)
         }
     }
     
+    // Keep the convolution reverb in step so switching modes doesn't jump
+    if (auto* convolutionProcessor = getConvolutionReverb())
+    {
+        convolutionProcessor->setWetLevel(reverbWetLevel);
+    }
+    
     juce::Logger::writeToLog(getBusName() + " reverb wet level: " + juce::String(reverbWetLevel));
 }
 
@@ -197,6 +220,59 @@ void FXBusProcessor::setBypass(bool shouldBypass)
     updateConnections();
 }
 
+void FXBusProcessor::setReverbMode(ReverbMode mode)
+{
+    reverbMode = mode;
+    juce::Logger::writeToLog(getBusName() + " reverb mode: " +
+                             (mode == ReverbMode::Convolution ? "convolution" : "algorithmic"));
+    
+    // Update connections
+    updateConnections();
+}
+
+void FXBusProcessor::setReducedQuality(bool shouldBeReduced)
+{
+    if (reducedQuality == shouldBeReduced)
+        return;
+    
+    reducedQuality = shouldBeReduced;
+    
+    // Only a convolution bus plays anything different
+    if (reverbMode == ReverbMode::Convolution)
+        updateConnections();
+}
+
+bool FXBusProcessor::loadImpulseResponse(const juce::File& impulseResponseFile)
+{
+    auto* convolutionProcessor = getConvolutionReverb();
+    if (convolutionProcessor == nullptr)
+        return false;
+    
+    // Loading is asynchronous; the bus keeps playing the old IR until the new one is ready
+    if (!convolutionProcessor->loadImpulseResponse(impulseResponseFile))
+        return false;
+    
+    setReverbMode(ReverbMode::Convolution);
+    return true;
+}
+
+juce::File FXBusProcessor::getImpulseResponseFile() const
+{
+    if (auto* convolutionProcessor = getConvolutionReverb())
+        return convolutionProcessor->getImpulseResponseFile();
+    
+    return {};
+}
+
+ConvolutionReverbProcessor* FXBusProcessor::getConvolutionReverb() const
+{
+    // Before prepareToPlay the processor is still owned here; afterwards the graph owns it
+    if (convolutionNode != nullptr)
+        return dynamic_cast<ConvolutionReverbProcessor*>(convolutionNode->getProcessor());
+    
+    return convolutionReverb.get();
+}
+
 void FXBusProcessor::addInputChannel(int channelIndex, float sendLevel)
 {
     // Store the send level for this channel
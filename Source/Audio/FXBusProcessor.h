@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "../FX/ReverbProcessor.h"
+#include "../FX/ConvolutionReverbProcessor.h"
 #include "../FX/DelayProcessor.h"
 
 class FXBusProcessor
@@ -14,6 +15,13 @@ public:
         DrumFX
     };
 
+    // Which reverb engine feeds the bus
+    enum class ReverbMode
+    {
+        Algorithmic,   // ReverbProcessor (juce::dsp::Reverb)
+        Convolution    // ConvolutionReverbProcessor (loaded impulse response)
+    };
+
     // Default constructor
     FXBusProcessor() : FXBusProcessor(BusType::VocalFX) {}
     
@@ -31,6 +39,15 @@ public:
     void setReverbWetLevel(float level); // 0.0 to 1.0
     void setDelayWetLevel(float level);  // 0.0 to 1.0
     void setBypass(bool shouldBypass);
+    void setReverbMode(ReverbMode mode);
+    
+    // Overload shedding: play the algorithmic reverb in place of the convolution
+    // one without changing the bus's mode. Rebuilds the graph; message thread.
+    void setReducedQuality(bool shouldBeReduced);
+    
+    // Load a room impulse response (WAV) for convolution mode. The file is read
+    // and resampled off the audio thread.
+    bool loadImpulseResponse(const juce::File& impulseResponseFile);
     
     // Channel routing
     void addInputChannel(int channelIndex, float sendLevel);
@@ -41,6 +58,9 @@ public:
     float getReverbWetLevel() const { return reverbWetLevel; }
     float getDelayWetLevel() const { return delayWetLevel; }
     bool isBypassed() const { return bypassed; }
+    ReverbMode getReverbMode() const { return reverbMode; }
+    bool isReducedQuality() const { return reducedQuality; }
+    juce::File getImpulseResponseFile() const;
     BusType getBusType() const { return busType; }
     juce::String getBusName() const;
 
@@ -54,8 +74,10 @@ private:
     
     // Effect processors (owned by the graph after preparation)
     std::unique_ptr<ReverbProcessor> reverb;
+    std::unique_ptr<ConvolutionReverbProcessor> convolutionReverb;
     std::unique_ptr<DelayProcessor> delay;
     juce::AudioProcessorGraph::Node::Ptr reverbNode;
+    juce::AudioProcessorGraph::Node::Ptr convolutionNode;
     juce::AudioProcessorGraph::Node::Ptr delayNode;
     
     // Internal parameters
@@ -64,6 +86,8 @@ private:
     float reverbWetLevel = 0.5f;
     float delayWetLevel = 0.5f;
     bool bypassed = false;
+    ReverbMode reverbMode = ReverbMode::Algorithmic;
+    bool reducedQuality = false;
     
     // Map of channel indices to send levels
     std::map<int, float> channelSendLevels;
@@ -71,6 +95,9 @@ private:
     // Updates connections in the processor graph
     void updateConnections();
     
+    // Returns the convolution reverb whether or not it has been moved into the graph yet
+    ConvolutionReverbProcessor* getConvolutionReverb() const;
+    
     // Audio settings
     double currentSampleRate = 44100.0;
     int currentBlockSize = 512;
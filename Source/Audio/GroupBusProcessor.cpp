@@ -100,6 +100,12 @@ void GroupBusProcessor::setEQHighGain(float dB)
     }
 }
 
+void GroupBusProcessor::setEQGains(float lowDb, float midDb, float highDb)
+{
+    if (eqProcessor)
+        eqProcessor->setGains(lowDb, midDb, highDb);
+}
+
 void GroupBusProcessor::setCompEnabled(bool enabled)
 {
     compEnabled = enabled;
@@ -131,6 +137,18 @@ void GroupBusProcessor::setOutputGain(float gain)
     DBG("Group Bus " + getBusName() + " - Output gain set to " + juce::String(juce::Decibels::gainToDecibels(gain)) + " dB");
 }
 
+void GroupBusProcessor::setGainAndSwitches(float gain, bool eqOn, bool compOn)
+{
+    if (outputGain != gain)
+    {
+        outputGain = gain;
+        gainProcessor.setGainLinear(gain);
+    }
+    
+    eqEnabled = eqOn;
+    compEnabled = compOn;
+}
+
 float GroupBusProcessor::getOutputGain() const
 {
     return outputGain;
@@ -184,16 +202,11 @@ void BusEQProcessor::prepareToPlay(double sampleRate, int maximumExpectedSamples
 {
     this->sampleRate = sampleRate;
     
-    // Update the filters with the new sample rate
+    // Update the filters with the new sample rate; nothing is filtering yet, so every set starts with them
     updateFilters();
+    coefficientSets.fill(coefficientSets[static_cast<size_t>(waitingSet.load() & ~newSetFlag)]);
     
-    // Prepare the processor chain
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = maximumExpectedSamplesPerBlock;
-    spec.numChannels = 2;
-    
-    processorChain.prepare(spec);
+    filterState.fill({});
 }
 
 void BusEQProcessor::releaseResources()
@@ -203,11 +216,17 @@ void BusEQProcessor::releaseResources()
 
 void BusEQProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
+    if (buffer.getNumChannels() == 0)
+        return;
+    
+    // Take the newest coefficients once per block, if updateFilters() has finished any
+    if ((waitingSet.load(std::memory_order_acquire) & newSetFlag) != 0)
+        filterSet = waitingSet.exchange(filterSet, std::memory_order_acq_rel) & ~newSetFlag;
     
-    // Process through the entire chain
-    processorChain.process(context);
+    // Band by band over the block, both channels in one vector
+    float* right = buffer.getNumChannels() > 1 ? buffer.getWritePointer(1) : nullptr;
+    kernels.biquadCascadeStereo(buffer.getWritePointer(0), right, buffer.getNumSamples(),
+                                coefficientSets[static_cast<size_t>(filterSet)].data(), filterState.data(), numBands);
 }
 
 void BusEQProcessor::setLowGain(float gainInDecibels)
@@ -231,32 +250,33 @@ void BusEQProcessor::setHighGain(float gainInDecibels)
     updateFilters();
 }
 
+void BusEQProcessor::setGains(float lowDb, float midDb, float highDb)
+{
+    lowShelfGain = juce::jlimit(-12.0f, 12.0f, lowDb);
+    midPeakGain = juce::jlimit(-12.0f, 12.0f, midDb);
+    highShelfGain = juce::jlimit(-12.0f, 12.0f, highDb);
+    updateFilters();
+}
+
 void BusEQProcessor::updateFilters()
 {
-    // Create coefficients for low shelf filter (100 Hz)
-    auto lowShelfCoefs = IIRCoefs::makeLowShelf(sampleRate, lowShelfFrequency, 0.707f, juce::Decibels::decibelsToGain(lowShelfGain));
+    using ArrayCoefs = juce::dsp::IIR::ArrayCoefficients<float>;
+    using auralis::simd::makeBiquad;
+    
+    // Designed as plain arrays, so scene fades can call this from the audio thread
+    auto& bandCoefficients = coefficientSets[static_cast<size_t>(designSet)];
     
-    // Create coefficients for mid peak filter (900 Hz)
-    auto midPeakCoefs = IIRCoefs::makePeakFilter(sampleRate, midPeakFrequency, midQ, juce::Decibels::decibelsToGain(midPeakGain));
+    // Low shelf filter (100 Hz)
+    bandCoefficients[0] = makeBiquad(ArrayCoefs::makeLowShelf(sampleRate, lowShelfFrequency, 0.707f, juce::Decibels::decibelsToGain(lowShelfGain)));
     
-    // Create coefficients for high shelf filter (8 kHz)
-    auto highShelfCoefs = IIRCoefs::makeHighShelf(sampleRate, highShelfFrequency, 0.707f, juce::Decibels::decibelsToGain(highShelfGain));
+    // Mid peak filter (900 Hz)
+    bandCoefficients[1] = makeBiquad(ArrayCoefs::makePeakFilter(sampleRate, midPeakFrequency, midQ, juce::Decibels::decibelsToGain(midPeakGain)));
     
-    // Get the filters from the processor chain and update their coefficients
-    auto& lowShelfL = processorChain.get<0>().get<0>();
-    auto& lowShelfR = processorChain.get<0>().get<1>();
-    auto& midPeakL = processorChain.get<1>().get<0>();
-    auto& midPeakR = processorChain.get<1>().get<1>();
-    auto& highShelfL = processorChain.get<2>().get<0>();
-    auto& highShelfR = processorChain.get<2>().get<1>();
+    // High shelf filter (8 kHz)
+    bandCoefficients[2] = makeBiquad(ArrayCoefs::makeHighShelf(sampleRate, highShelfFrequency, 0.707f, juce::Decibels::decibelsToGain(highShelfGain)));
     
-    // Update the coefficients for each filter
-    *lowShelfL.coefficients = *lowShelfCoefs;
-    *lowShelfR.coefficients = *lowShelfCoefs;
-    *midPeakL.coefficients = *midPeakCoefs;
-    *midPeakR.coefficients = *midPeakCoefs;
-    *highShelfL.coefficients = *highShelfCoefs;
-    *highShelfR.coefficients = *highShelfCoefs;
+    // Publish the finished set and design into whichever one was waiting next time
+    designSet = waitingSet.exchange(designSet | newSetFlag, std::memory_order_acq_rel) & ~newSetFlag;
 }
 
 //==============================================================================
@@ -307,7 +327,7 @@ void BusGlueCompressorProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     float inputLevel = 0.0f;
     for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
     {
-        inputLevel += buffer.getMagnitude(channel, 0, buffer.getNumSamples());
+        inputLevel += kernels.findPeak(buffer.getReadPointer(channel), buffer.getNumSamples());
     }
     inputLevel /= buffer.getNumChannels();
     
@@ -320,7 +340,7 @@ void BusGlueCompressorProcessor::processBlock(juce::AudioBuffer<float>& buffer,
     float outputLevel = 0.0f;
     for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
     {
-        outputLevel += buffer.getMagnitude(channel, 0, buffer.getNumSamples());
+        outputLevel += kernels.findPeak(buffer.getReadPointer(channel), buffer.getNumSamples());
     }
     outputLevel /= buffer.getNumChannels();
     
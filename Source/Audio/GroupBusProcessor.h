@@ -1,6 +1,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "../DSP/SimdKernels.h"
 
 // Forward declarations
 class BusEQProcessor;
@@ -50,6 +51,7 @@ public:
     void setEQLowGain(float dB);
     void setEQMidGain(float dB);
     void setEQHighGain(float dB);
+    void setEQGains(float lowDb, float midDb, float highDb); // One filter update for all three bands
     void setCompEnabled(bool enabled);
     void setEQEnabled(bool enabled);
     
@@ -64,6 +66,9 @@ public:
     void setOutputGain(float gain);
     float getOutputGain() const;
     
+    // Output gain and both switches at once, without logging: scene recalls call this on the audio thread
+    void setGainAndSwitches(float gain, bool eqOn, bool compOn);
+    
     // Access to the bus type
     BusType getBusType() const { return busType; }
     
@@ -130,6 +135,7 @@ public:
     void setLowGain(float gainInDecibels);
     void setMidGain(float gainInDecibels);
     void setHighGain(float gainInDecibels);
+    void setGains(float lowDb, float midDb, float highDb);
     
     float getLowGain() const { return lowShelfGain; }
     float getMidGain() const { return midPeakGain; }
@@ -152,15 +158,23 @@ private:
     // The Q factor for the mid peak
     static constexpr float midQ = 0.7f;
     
-    // IIR Filters for stereo processing
-    using IIRFilter = juce::dsp::IIR::Filter<float>;
-    using IIRCoefs = juce::dsp::IIR::Coefficients<float>;
+    static constexpr int numBands = 3;
+    
+    // One section per band, shared by both channels: low shelf, mid peak, high shelf
+    using BandCoefficients = std::array<auralis::simd::BiquadCoefficients, numBands>;
     
-    // Create a stereo filter using two mono filters
-    using StereoFilter = juce::dsp::ProcessorChain<IIRFilter, IIRFilter>;
+    // Handed to the audio thread the way EQProcessor does: filter, design and waiting sets
+    static constexpr int numCoefficientSets = 3;
+    static constexpr int newSetFlag = 4;
+    std::array<BandCoefficients, numCoefficientSets> coefficientSets;
+    int designSet = 0;                  // updateFilters() only
+    int filterSet = 1;                  // Audio thread only
+    std::atomic<int> waitingSet { 2 };  // Plus newSetFlag until the audio thread takes it
     
-    // Three bands of stereo filters: low shelf, mid peak, high shelf
-    juce::dsp::ProcessorChain<StereoFilter, StereoFilter, StereoFilter> processorChain;
+    // Each band's filter state, left and right side by side
+    std::array<auralis::simd::BiquadState, numBands * 2> filterState;
+    
+    const auralis::simd::KernelTable& kernels { auralis::simd::getKernels() };
     
     // Sample rate for coefficient calculations
     double sampleRate = 44100.0;
@@ -228,6 +242,9 @@ private:
     // To store the current gain reduction amount
     float currentGainReduction = 0.0f;
     
+    // Peak reductions for the gain reduction estimate
+    const auralis::simd::KernelTable& kernels { auralis::simd::getKernels() };
+    
     double sampleRate = 44100.0;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BusGlueCompressorProcessor)
@@ -1,7 +1,8 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "../UI/LoudnessMeterComponent.h"
+#include "MeterTarget.h"
+#include "../DSP/SimdKernels.h"
 #include "TruePeakLimiterProcessor.h"
 
 // Forward declarations for internal processors
@@ -51,7 +52,7 @@ public:
     void setCompressorEnabled(bool enabled);
     void setLimiterEnabled(bool enabled);
     void setStreamTarget(StreamTarget target);
-    void setMeterTarget(auralis::LoudnessMeterComponent* m) { meter = m; }
+    void setMeterTarget(auralis::MeterTarget* m) { meter = m; }
     
     // Getters for enabled states
     bool isLimiterEnabled() const { return limiterEnabled; }
@@ -72,13 +73,14 @@ private:
     // Internal processors
     std::unique_ptr<MultibandCompressorProcessor> compressor;
     std::unique_ptr<auralis::TruePeakLimiterProcessor> limiter;
-    auralis::LoudnessMeterComponent* meter { nullptr };
+    auralis::MeterTarget* meter { nullptr };
 
     // Filters used for K-weighted loudness measurement
     juce::dsp::IIR::Filter<float> hpFilters[2];
     juce::dsp::IIR::Filter<float> shelfFilters[2];
     juce::ReferenceCountedObjectPtr<juce::dsp::IIR::Coefficients<float>> hpCoeffs;
     juce::ReferenceCountedObjectPtr<juce::dsp::IIR::Coefficients<float>> shelfCoeffs;
+    const auralis::simd::KernelTable& kernels { auralis::simd::getKernels() };
     
     // Current state
     std::atomic<float> targetLufs{kLUFS_Youtube};
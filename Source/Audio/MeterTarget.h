@@ -0,0 +1,17 @@
+#pragma once
+#include <JuceHeader.h>
+
+namespace auralis
+{
+    /**  Receives the master bus output once per block, on the audio thread.
+
+         Lets a meter (the loudness display, for one) watch the master bus
+         without the engine knowing anything about the view behind it. */
+    class MeterTarget
+    {
+    public:
+        virtual ~MeterTarget() = default;
+
+        virtual void pushSamples (const juce::AudioBuffer<float>& buffer) = 0;
+    };
+}
@@ -0,0 +1,189 @@
+#include "MultibandCompressorProcessor.h"
+
+MultibandCompressorProcessor::MultibandCompressorProcessor()
+{
+    juce::Logger::writeToLog("MultibandCompressorProcessor constructor");
+}
+
+void MultibandCompressorProcessor::prepare(double sampleRate, int maximumBlockSize)
+{
+    juce::Logger::writeToLog("MultibandCompressorProcessor::prepare: start");
+
+    // Update filters and prepare DSP objects
+    updateFilters(sampleRate);
+
+    juce::Logger::writeToLog("Preparing compressors and filters");
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = sampleRate;
+    spec.maximumBlockSize = static_cast<juce::uint32>(maximumBlockSize);
+    spec.numChannels = 2;
+
+    // Sanity check - this processor only supports up to stereo
+    jassert(spec.numChannels <= 2);
+    if (spec.numChannels > 2)
+        spec.numChannels = 2;
+
+    // Prepare filter banks
+    for (auto& filter : lowFilters)
+        filter.prepare(spec);
+    for (auto& filter : highFilters)
+        filter.prepare(spec);
+    for (auto& filter : midLowFilters)
+        filter.prepare(spec);
+    for (auto& filter : midHighFilters)
+        filter.prepare(spec);
+
+    // Prepare compressors
+    for (auto& comp : compressors)
+        comp.prepare(spec);
+
+    juce::Logger::writeToLog("MultibandCompressorProcessor::prepare: end");
+}
+
+void MultibandCompressorProcessor::process(juce::AudioBuffer<float>& buffer)
+{
+    // Runs on the audio thread every block: no logging here
+
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples = buffer.getNumSamples();
+
+    // Only stereo is supported
+    jassert(numChannels <= 2);
+    if (numChannels > 2)
+        return;
+
+    // Create temporary buffers for each band
+    juce::AudioBuffer<float> lowBand(numChannels, numSamples);
+    juce::AudioBuffer<float> midBand(numChannels, numSamples);
+    juce::AudioBuffer<float> highBand(numChannels, numSamples);
+
+    // Copy input to all bands
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        lowBand.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+        midBand.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+        highBand.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+    }
+
+    // Split each channel into bands
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        // Process low band
+        juce::dsp::AudioBlock<float> lowBlock(lowBand);
+        auto lowSingle = lowBlock.getSingleChannelBlock((size_t)ch);
+        juce::dsp::ProcessContextReplacing<float> lowContext(lowSingle);
+        lowFilters[ch].process(lowContext);
+
+        // Process high band
+        juce::dsp::AudioBlock<float> highBlock(highBand);
+        auto highSingle = highBlock.getSingleChannelBlock((size_t)ch);
+        juce::dsp::ProcessContextReplacing<float> highContext(highSingle);
+        highFilters[ch].process(highContext);
+
+        // Process mid band
+        juce::dsp::AudioBlock<float> midBlock(midBand);
+        auto midSingle = midBlock.getSingleChannelBlock((size_t)ch);
+        juce::dsp::ProcessContextReplacing<float> midContext(midSingle);
+        midHighFilters[ch].process(midContext);
+        midLowFilters[ch].process(midContext);
+    }
+
+    // Process each band with its compressor
+    processBand(lowBand, compressors[0]);
+    processBand(midBand, compressors[1]);
+    processBand(highBand, compressors[2]);
+
+    // Mix bands back together, every channel
+    buffer.clear();
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        buffer.addFrom(ch, 0, lowBand, ch, 0, numSamples);
+        buffer.addFrom(ch, 0, midBand, ch, 0, numSamples);
+        buffer.addFrom(ch, 0, highBand, ch, 0, numSamples);
+    }
+}
+
+void MultibandCompressorProcessor::reset()
+{
+    for (auto& comp : compressors)
+        comp.reset();
+
+    for (auto& filter : lowFilters)
+        filter.reset();
+    for (auto& filter : highFilters)
+        filter.reset();
+    for (auto& filter : midLowFilters)
+        filter.reset();
+    for (auto& filter : midHighFilters)
+        filter.reset();
+}
+
+void MultibandCompressorProcessor::updateFilters(double sampleRate)
+{
+    juce::Logger::writeToLog("updateFilters: Creating filter coefficients");
+    lowLP  = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, lowCrossoverHz);
+    highHP = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, highCrossoverHz);
+    midHP  = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, lowCrossoverHz);
+    midLP  = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, highCrossoverHz);
+
+    bool coeffsValid = true;
+    if (lowLP == nullptr)
+    {
+        juce::Logger::writeToLog("updateFilters error: lowLP is null");
+        coeffsValid = false;
+    }
+
+    if (highHP == nullptr)
+    {
+        juce::Logger::writeToLog("updateFilters error: highHP is null");
+        coeffsValid = false;
+    }
+
+    if (midHP == nullptr)
+    {
+        juce::Logger::writeToLog("updateFilters error: midHP is null");
+        coeffsValid = false;
+    }
+
+    if (midLP == nullptr)
+    {
+        juce::Logger::writeToLog("updateFilters error: midLP is null");
+        coeffsValid = false;
+    }
+
+    if (! coeffsValid)
+    {
+        juce::Logger::writeToLog("updateFilters: failed to create filter coefficients");
+        return;
+    }
+
+    jassert(lowLP  != nullptr);
+    jassert(highHP != nullptr);
+    jassert(midHP  != nullptr);
+    jassert(midLP  != nullptr);
+
+    juce::Logger::writeToLog("updateFilters: Assigning coefficients to filters");
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        lowFilters[ch].state = *lowLP;
+        highFilters[ch].state = *highHP;
+        midLowFilters[ch].state = *midLP;
+        midHighFilters[ch].state = *midHP;
+        lowFilters[ch].reset();
+        highFilters[ch].reset();
+        midLowFilters[ch].reset();
+        midHighFilters[ch].reset();
+    }
+    juce::Logger::writeToLog("Low/high crossover: "
+        + juce::String(lowCrossoverHz) + " / "
+        + juce::String(highCrossoverHz));
+    juce::Logger::writeToLog("updateFilters: initialization complete");
+    juce::Logger::writeToLog("updateFilters: end");
+}
+
+void MultibandCompressorProcessor::processBand (juce::AudioBuffer<float>& bandBuffer, juce::dsp::Compressor<float>& comp)
+{
+    juce::dsp::AudioBlock<float> block (bandBuffer);
+    juce::dsp::ProcessContextReplacing<float> context (block);
+    comp.process (context);
+}
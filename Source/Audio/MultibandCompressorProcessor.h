@@ -0,0 +1,39 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+// Three-band compressor used by the master bus
+//==============================================================================
+class MultibandCompressorProcessor
+{
+public:
+    MultibandCompressorProcessor();
+
+    void prepare(double sampleRate, int maximumBlockSize);
+    void process(juce::AudioBuffer<float>& buffer);
+    void reset();
+
+    void setEnabled (bool enabled) noexcept  { isEnabled = enabled; }
+
+private:
+    void updateFilters(double sampleRate);
+
+    static void processBand (juce::AudioBuffer<float>& bandBuffer, juce::dsp::Compressor<float>& comp);
+
+    static constexpr float lowCrossoverHz  = 200.0f;
+    static constexpr float highCrossoverHz = 2000.0f;
+    using Filter = juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>>;
+    Filter lowFilters [2];
+    Filter highFilters[2];
+    Filter midLowFilters [2];
+    Filter midHighFilters[2];
+    juce::dsp::Compressor<float> compressors[3];
+    bool isEnabled { true };
+    juce::ReferenceCountedObjectPtr<juce::dsp::IIR::Coefficients<float>> lowLP;
+    juce::ReferenceCountedObjectPtr<juce::dsp::IIR::Coefficients<float>> highHP;
+    juce::ReferenceCountedObjectPtr<juce::dsp::IIR::Coefficients<float>> midHP;
+    juce::ReferenceCountedObjectPtr<juce::dsp::IIR::Coefficients<float>> midLP;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultibandCompressorProcessor)
+};
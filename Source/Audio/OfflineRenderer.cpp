@@ -0,0 +1,323 @@
+#include "OfflineRenderer.h"
+#include "AudioEngine.h"
+#include "../DSP/SimdKernels.h"
+
+namespace
+{
+    /**
+     * BS.1770-4 loudness: K-weighting, 400 ms blocks every 100 ms,
+     * absolute gate at -70 LUFS and relative gate 10 LU below.
+     */
+    class LoudnessAnalyser
+    {
+    public:
+        explicit LoudnessAnalyser(double sampleRate)
+            : hopSamples(juce::roundToInt(sampleRate * 0.1))
+        {
+            // Stage 1: high shelf modelling the head
+            {
+                const double k = std::tan(juce::MathConstants<double>::pi * 1681.974450955533 / sampleRate);
+                const double q = 0.7071752369554196;
+                const double vh = std::pow(10.0, 3.999843853973347 / 20.0);
+                const double vb = std::pow(vh, 0.4996667741545416);
+                const double a0 = 1.0 + k / q + k * k;
+
+                shelf = { (vh + vb * k / q + k * k) / a0, 2.0 * (k * k - vh) / a0, (vh - vb * k / q + k * k) / a0,
+                          2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0 };
+            }
+
+            // Stage 2: RLB high-pass
+            {
+                const double k = std::tan(juce::MathConstants<double>::pi * 38.13547087602444 / sampleRate);
+                const double q = 0.5003270373238773;
+                const double a0 = 1.0 + k / q + k * k;
+
+                highPass = { 1.0, -2.0, 1.0, 2.0 * (k * k - 1.0) / a0, (1.0 - k / q + k * k) / a0 };
+            }
+        }
+
+        void process(const juce::AudioBuffer<float>& buffer, int numSamples)
+        {
+            const int numChannels = juce::jmin(buffer.getNumChannels(), 2);
+            const auto& kernels = auralis::simd::getKernels();
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                const float* data = buffer.getReadPointer(ch);
+                peak = juce::jmax(peak, static_cast<double>(kernels.findPeak(data, numSamples)));
+                truePeak = juce::jmax(truePeak, static_cast<double>(truePeakDetectors[ch].process(data, numSamples)));
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    const double x = buffer.getSample(ch, i);
+                    const double y = highPass.process(shelf.process(x, shelfState[ch]), highPassState[ch]);
+                    hopSum += y * y;
+                }
+
+                if (++hopPosition == hopSamples)
+                {
+                    hopPowers.push_back(hopSum / hopSamples);
+                    hopSum = 0.0;
+                    hopPosition = 0;
+                }
+            }
+
+            totalSamples += numSamples;
+        }
+
+        OfflineRenderer::LoudnessReport getReport(double sampleRate) const
+        {
+            OfflineRenderer::LoudnessReport report;
+            report.durationSeconds = static_cast<double>(totalSamples) / sampleRate;
+            report.samplePeakDb = juce::Decibels::gainToDecibels(peak, -100.0);
+            report.truePeakDb = juce::Decibels::gainToDecibels(truePeak, -100.0);
+
+            // 400 ms blocks: four consecutive 100 ms hops
+            std::vector<double> blockPowers;
+            for (size_t i = 3; i < hopPowers.size(); ++i)
+                blockPowers.push_back((hopPowers[i - 3] + hopPowers[i - 2] + hopPowers[i - 1] + hopPowers[i]) / 4.0);
+
+            auto toLufs = [](double power) { return power > 0.0 ? -0.691 + 10.0 * std::log10(power) : -100.0; };
+            auto gatedMean = [&](double gateLufs)
+            {
+                double sum = 0.0;
+                int count = 0;
+                for (auto power : blockPowers)
+                    if (toLufs(power) > gateLufs) { sum += power; ++count; }
+                return count > 0 ? sum / count : 0.0;
+            };
+
+            for (auto power : blockPowers)
+                report.maxMomentaryLufs = juce::jmax(report.maxMomentaryLufs, toLufs(power));
+
+            const double absoluteGated = gatedMean(-70.0);
+            if (absoluteGated > 0.0)
+                report.integratedLufs = juce::jmax(-70.0, toLufs(gatedMean(toLufs(absoluteGated) - 10.0)));
+
+            return report;
+        }
+
+    private:
+        struct Biquad
+        {
+            double b0, b1, b2, a1, a2;
+
+            double process(double x, std::array<double, 2>& z) const
+            {
+                // Transposed direct form II
+                const double y = b0 * x + z[0];
+                z[0] = b1 * x - a1 * y + z[1];
+                z[1] = b2 * x - a2 * y;
+                return y;
+            }
+        };
+
+        Biquad shelf {}, highPass {};
+        std::array<double, 2> shelfState[2] {}, highPassState[2] {};
+
+        const int hopSamples;
+        int hopPosition = 0;
+        double hopSum = 0.0;
+        std::vector<double> hopPowers;
+        double peak = 0.0;
+        auralis::simd::TruePeakDetector truePeakDetectors[2];
+        double truePeak = 0.0;
+        juce::int64 totalSamples = 0;
+    };
+
+    OfflineRenderer::Result failure(const juce::String& message)
+    {
+        juce::Logger::writeToLog("OfflineRenderer: " + message);
+
+        OfflineRenderer::Result result;
+        result.errorMessage = message;
+        return result;
+    }
+}
+
+juce::var OfflineRenderer::LoudnessReport::toVar() const
+{
+    auto report = std::make_unique<juce::DynamicObject>();
+    report->setProperty("integratedLufs", integratedLufs);
+    report->setProperty("maxMomentaryLufs", maxMomentaryLufs);
+    report->setProperty("samplePeakDb", samplePeakDb);
+    report->setProperty("truePeakDb", truePeakDb);
+    report->setProperty("durationSeconds", durationSeconds);
+    report->setProperty("renderSeconds", renderSeconds);
+    return juce::var(report.release());
+}
+
+juce::File OfflineRenderer::getReportFile(const juce::File& output)
+{
+    return output.getSiblingFile(output.getFileNameWithoutExtension() + "-loudness.json");
+}
+
+OfflineRenderer::Result OfflineRenderer::render(const Settings& settings, ProgressCallback progress)
+{
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    // Open every stem; they must share one sample rate
+    std::vector<std::unique_ptr<juce::AudioFormatReader>> readers;
+    double sampleRate = 0.0;
+    juce::int64 lengthInSamples = 0;
+
+    for (const auto& stem : settings.stems)
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(stem));
+        if (reader == nullptr)
+            return failure("Can't read stem " + stem.getFullPathName());
+
+        if (sampleRate == 0.0)
+            sampleRate = reader->sampleRate;
+        else if (reader->sampleRate != sampleRate)
+            return failure("Stem " + stem.getFileName() + " is at " + juce::String(reader->sampleRate)
+                           + " Hz; the others are at " + juce::String(sampleRate) + " Hz");
+
+        lengthInSamples = juce::jmax(lengthInSamples, reader->lengthInSamples);
+        readers.push_back(std::move(reader));
+    }
+
+    if (readers.empty())
+        return failure("No stems to render");
+
+    // Same processing as the live mix, without a device
+    AudioEngine engine(false);
+
+    const int numStems = static_cast<int>(readers.size());
+    if (numStems > engine.getNumChannels())
+        return failure(juce::String(numStems) + " stems but only " + juce::String(engine.getNumChannels()) + " channels");
+
+    if (settings.mixerState.has_value())
+        settings.mixerState->apply(engine);
+
+    auto routing = settings.routing.value_or(auralis::RoutingManager::createDefaultTable(engine));
+    for (int i = 0; i < routing.numChannels; ++i)
+        routing.inputForChannel[i] = i < numStems ? i : -1;
+
+    // Output writer, by extension
+    auto* format = formats.findFormatForFileExtension(settings.output.getFileExtension());
+    if (format == nullptr)
+        return failure("Unsupported output format " + settings.output.getFileExtension());
+
+    settings.output.deleteFile();
+    std::unique_ptr<juce::OutputStream> stream(settings.output.createOutputStream());
+    if (stream == nullptr)
+        return failure("Can't write " + settings.output.getFullPathName());
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(), sampleRate, 2,
+                                                                            settings.bitDepth, {}, 0));
+    if (writer == nullptr)
+        return failure("Can't create a " + format->getFormatName() + " writer");
+
+    stream.release();   // Now owned by the writer
+
+    const int blockSize = juce::jmax(64, settings.blockSize);
+    engine.prepareToPlay(sampleRate, blockSize);
+    
+    // Loads come out as shares of real time, since nothing here runs on the clock
+    const bool profiling = settings.profileReport != juce::File();
+    engine.getLoadProfiler().setEnabled(profiling);
+    engine.getLoadProfiler().setStagesEnabled(profiling);
+
+    // Per-stem input buffers; channel n reads input n
+    std::vector<juce::AudioBuffer<float>> stemBuffers(readers.size());
+    std::vector<const float*> inputs(readers.size());
+    for (size_t i = 0; i < stemBuffers.size(); ++i)
+    {
+        stemBuffers[i].setSize(2, blockSize);
+        inputs[i] = stemBuffers[i].getReadPointer(0);
+    }
+
+    const int numThreads = settings.numThreads > 0 ? settings.numThreads : juce::SystemStats::getNumCpus();
+    
+    // The rendering thread works too, so one thread needs no pool at all
+    std::unique_ptr<juce::ThreadPool> pool;
+    if (numThreads > 1)
+        pool = std::make_unique<juce::ThreadPool>(numThreads - 1);
+
+    LoudnessAnalyser loudness(sampleRate);
+    const auto totalSamples = lengthInSamples + static_cast<juce::int64>(settings.tailSeconds * sampleRate);
+    const int numChannels = engine.getNumChannels();
+
+    for (juce::int64 position = 0; position < totalSamples; position += blockSize)
+    {
+        const int numSamples = static_cast<int>(juce::jmin<juce::int64>(blockSize, totalSamples - position));
+
+        // Channels pull work from a shared counter: read the stem, run the strip
+        std::atomic<int> nextChannel { 0 };
+        auto processChannels = [&]
+        {
+            for (int i; (i = nextChannel.fetch_add(1)) < numChannels;)
+            {
+                if (i < numStems)
+                {
+                    auto& buffer = stemBuffers[(size_t) i];
+                    readers[(size_t) i]->read(&buffer, 0, numSamples, position, true, true);
+
+                    // Fold stereo stems to the channel's mono input
+                    if (readers[(size_t) i]->numChannels > 1)
+                    {
+                        buffer.addFrom(0, 0, buffer, 1, 0, numSamples);
+                        buffer.applyGain(0, 0, numSamples, 0.5f);
+                    }
+                }
+
+                engine.processChannel(i, routing, inputs.data(), numStems, numSamples);
+            }
+        };
+
+        const int numJobs = pool != nullptr ? pool->getNumThreads() : 0;
+        std::atomic<int> jobsRemaining { numJobs };
+        juce::WaitableEvent jobsDone;
+
+        for (int j = 0; j < numJobs; ++j)
+        {
+            pool->addJob([&]
+            {
+                processChannels();
+                if (--jobsRemaining == 0)
+                    jobsDone.signal();
+                return juce::ThreadPoolJob::jobHasFinished;
+            });
+        }
+
+        processChannels();
+
+        if (numJobs > 0)
+            jobsDone.wait();
+
+        const auto& mix = engine.mixBuses(routing, numSamples);
+        loudness.process(mix, numSamples);
+
+        if (!writer->writeFromAudioSampleBuffer(mix, 0, numSamples))
+            return failure("Write failed at sample " + juce::String(position));
+
+        if (progress != nullptr && !progress(static_cast<double>(position + numSamples) / static_cast<double>(totalSamples)))
+            return failure("Render cancelled");
+    }
+
+    writer.reset();
+    engine.releaseResources();
+
+    Result result;
+    result.success = true;
+    result.loudness = loudness.getReport(sampleRate);
+    result.loudness.renderSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+
+    result.reportFile = getReportFile(settings.output);
+    result.reportFile.replaceWithText(juce::JSON::toString(result.loudness.toVar()));
+    
+    if (profiling)
+        engine.getLoadProfiler().writeReport(settings.profileReport);
+
+    juce::Logger::writeToLog("OfflineRenderer: rendered " + juce::String(result.loudness.durationSeconds, 1)
+                             + " s in " + juce::String(result.loudness.renderSeconds, 1) + " s, "
+                             + juce::String(result.loudness.integratedLufs, 1) + " LUFS");
+    return result;
+}
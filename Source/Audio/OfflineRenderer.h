@@ -0,0 +1,70 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <optional>
+#include "../Routing/RoutingManager.h"
+#include "../State/SessionSnapshot.h"
+
+/**
+ * OfflineRenderer - Renders multitrack stems through the mixer without a device
+ *
+ * Builds a headless AudioEngine, so the stems go through exactly the same
+ * channel, group, FX and master processing as the live mix. Stem n feeds
+ * channel n. Each block, the stems are read and their channel strips run in
+ * parallel on a thread pool (or one after another on the rendering thread
+ * when numThreads is 1); the buses are then summed on the rendering thread. Nothing waits on a clock, so a render runs as fast as the cores allow.
+ *
+ * The stereo mix is written as WAV or FLAC (by the output file's extension)
+ * along with a loudness report: BS.1770 integrated loudness, maximum momentary
+ * loudness, sample peak and true peak.
+ */
+class OfflineRenderer
+{
+public:
+    struct LoudnessReport
+    {
+        double integratedLufs = -70.0;      // Gated, BS.1770-4
+        double maxMomentaryLufs = -70.0;    // 400 ms windows
+        double samplePeakDb = -100.0;
+        double truePeakDb = -100.0;         // 4x oversampled, BS.1770-4 Annex 2
+        double durationSeconds = 0.0;
+        double renderSeconds = 0.0;
+
+        juce::var toVar() const;
+    };
+
+    struct Settings
+    {
+        juce::Array<juce::File> stems;      // Stem n feeds channel n
+        juce::File output;                  // .wav or .flac
+        int blockSize = 4096;
+        double tailSeconds = 2.0;           // Let reverbs and delays ring out
+        int numThreads = 0;                 // 0 = one per CPU core; 1 renders without a pool
+        int bitDepth = 24;
+        juce::File profileReport;           // Per-processor DSP load as JSON, if set
+
+        // Mixer state to render with; the engine's defaults if not set
+        std::optional<auralis::SessionSnapshot> mixerState;
+
+        // Routing to render with; stem inputs are patched over it. Defaults if not set
+        std::optional<auralis::RoutingTable> routing;
+    };
+
+    struct Result
+    {
+        bool success = false;
+        juce::String errorMessage;
+        LoudnessReport loudness;
+        juce::File reportFile;
+    };
+
+    /** Called between blocks with progress 0..1; return false to cancel. */
+    using ProgressCallback = std::function<bool(double progress)>;
+
+    /** Render synchronously on the calling thread (plus the pool). Call from
+        a background thread when there is a UI to keep responsive. */
+    static Result render(const Settings& settings, ProgressCallback progress = nullptr);
+
+    /** The report file written next to a mix, e.g. "mix-loudness.json". */
+    static juce::File getReportFile(const juce::File& output);
+};
@@ -0,0 +1,318 @@
+#include "OverloadGuard.h"
+#include "AudioEngine.h"
+
+juce::var OverloadGuard::Event::toVar() const
+{
+    auto event = std::make_unique<juce::DynamicObject>();
+    event->setProperty("type", getTypeName(type));
+    event->setProperty("time", juce::Time(time).toISO8601(true));
+    event->setProperty("load", load);
+
+    if (type == Type::Degraded || type == Type::Restored)
+        event->setProperty("step", getStepName(static_cast<Step>(detail)));
+    else
+        event->setProperty("detail", detail);
+
+    return juce::var(event.release());
+}
+
+OverloadGuard::OverloadGuard(AudioEngine& engineToUse)
+    : engine(engineToUse)
+{
+    prepare(44100.0);
+}
+
+OverloadGuard::~OverloadGuard()
+{
+    stopTimer();
+}
+
+void OverloadGuard::setPolicy(const Policy& newPolicy)
+{
+    // Steps already taken stay until the load lets them go
+    policy = newPolicy;
+    nearMissLoad.store(policy.degradeLoad, std::memory_order_relaxed);
+}
+
+void OverloadGuard::setEnabled(bool shouldBeEnabled)
+{
+    enabled = shouldBeEnabled;
+
+    if (!enabled)
+        restoreAll();
+}
+
+void OverloadGuard::prepare(double sampleRate)
+{
+    ticksPerSample = static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()) / sampleRate;
+    releasePerSample = 1.0 / (0.5 * sampleRate);
+    inNearMiss = false;
+    recentLoad.store(0.0f, std::memory_order_relaxed);
+}
+
+void OverloadGuard::recordBlock(juce::int64 ticks, int numSamples) noexcept
+{
+    if (numSamples <= 0 || ticksPerSample <= 0.0)
+        return;
+
+    const auto load = static_cast<float>(static_cast<double>(ticks) / (numSamples * ticksPerSample));
+
+    // Jumps straight to a spike, then lets go over about half a second
+    const auto decay = static_cast<float>(std::exp(-numSamples * releasePerSample));
+    recentLoad.store(juce::jmax(load, recentLoad.load(std::memory_order_relaxed) * decay), std::memory_order_relaxed);
+
+    const float threshold = nearMissLoad.load(std::memory_order_relaxed);
+    const bool wasInNearMiss = inNearMiss;
+    inNearMiss = load >= threshold;
+
+    Event event;
+    event.load = load;
+
+    // Every overrun is kept; a run of near misses only once, as it starts
+    if (load >= 1.0f)
+        event.type = Event::Type::Overrun;
+    else if (inNearMiss && !wasInNearMiss)
+        event.type = Event::Type::NearMiss;
+    else
+        return;
+
+    event.time = juce::Time::currentTimeMillis();
+
+    const auto scope = pendingFifo.write(1);
+    if (scope.blockSize1 > 0)
+        pendingEvents[(size_t) scope.startIndex1] = event;
+    else
+        numDroppedEvents.fetch_add(1, std::memory_order_relaxed);
+}
+
+void OverloadGuard::update(double nowMs)
+{
+    bool overran = false;
+
+    {
+        const auto scope = pendingFifo.read(pendingFifo.getNumReady());
+        scope.forEach([this, &overran](int index)
+        {
+            const auto& event = pendingEvents[(size_t) index];
+            if (event.type == Event::Type::Overrun)
+            {
+                ++numOverruns;
+                overran = true;
+            }
+            addEvent(event);
+        });
+    }
+
+    // Only overruns can come fast enough to fill the FIFO
+    if (const int dropped = numDroppedEvents.exchange(0, std::memory_order_relaxed); dropped > 0)
+    {
+        numOverruns += dropped;
+        overran = true;
+    }
+
+    if (deviceXRunSource)
+    {
+        // The count starts again with each device, so only a rise means anything
+        const int deviceXRuns = deviceXRunSource();
+        if (lastDeviceXRuns >= 0 && deviceXRuns > lastDeviceXRuns)
+        {
+            addEvent({ Event::Type::DeviceXRun, juce::Time::currentTimeMillis(), getRecentLoad(), deviceXRuns - lastDeviceXRuns });
+            overran = true;
+        }
+        lastDeviceXRuns = deviceXRuns;
+    }
+
+    if (!enabled)
+        return;
+
+    const float load = getRecentLoad();
+
+    if (overran || load >= policy.degradeLoad)
+    {
+        calmSinceMs = -1.0;
+
+        if (!activeSteps.empty() && nowMs - lastStepDownMs < policy.settleSeconds * 1000.0)
+            return;
+
+        for (int i = 0; i < static_cast<int>(Step::numSteps); ++i)
+        {
+            const auto step = static_cast<Step>(i);
+            if (!policy.stepEnabled[(size_t) i] || std::find(activeSteps.begin(), activeSteps.end(), step) != activeSteps.end())
+                continue;
+
+            if (applyStep(step, true))
+            {
+                activeSteps.push_back(step);
+                lastStepDownMs = nowMs;
+                addEvent({ Event::Type::Degraded, juce::Time::currentTimeMillis(), load, i });
+                juce::Logger::writeToLog("OverloadGuard: stepped down (" + getStepName(step) + ") at " + juce::String(load * 100.0f, 0) + "% load");
+                break;
+            }
+        }
+        return;
+    }
+
+    if (load >= policy.restoreLoad || activeSteps.empty())
+    {
+        calmSinceMs = -1.0;
+        return;
+    }
+
+    if (calmSinceMs < 0.0)
+    {
+        calmSinceMs = nowMs;
+        return;
+    }
+
+    if (nowMs - calmSinceMs < policy.restoreHoldSeconds * 1000.0)
+        return;
+
+    // Undo the last step; the next one waits for another full hold
+    const auto step = activeSteps.back();
+    activeSteps.pop_back();
+    applyStep(step, false);
+    addEvent({ Event::Type::Restored, juce::Time::currentTimeMillis(), load, static_cast<int>(step) });
+    juce::Logger::writeToLog("OverloadGuard: stepped back up (" + getStepName(step) + ")");
+    calmSinceMs = nowMs;
+}
+
+bool OverloadGuard::applyStep(Step step, bool shouldBeApplied)
+{
+    bool changed = false;
+
+    switch (step)
+    {
+        case Step::SuspendLowPriorityTuners:
+            for (int i = 0; i < engine.getNumChannels(); ++i)
+            {
+                auto* channel = engine.getChannelProcessor(i);
+                const bool applies = shouldBeApplied ? channel->isLowPriority() && channel->isTunerEnabled() && !channel->isTunerSuspended()
+                                                     : channel->isTunerSuspended();
+                if (applies)
+                {
+                    channel->setTunerSuspended(shouldBeApplied);
+                    changed = true;
+                }
+            }
+            break;
+
+        case Step::AlgorithmicReverb:
+            for (int i = 0; i < engine.getNumFXBuses(); ++i)
+            {
+                auto* bus = engine.getFXBusProcessor(i);
+                const bool applies = shouldBeApplied ? bus->getReverbMode() == FXBusProcessor::ReverbMode::Convolution
+                                                           && bus->isReverbEnabled() && !bus->isBypassed() && !bus->isReducedQuality()
+                                                     : bus->isReducedQuality();
+                if (applies)
+                {
+                    bus->setReducedQuality(shouldBeApplied);
+                    changed = true;
+                }
+            }
+            break;
+
+        case Step::LinearTunerResampling:
+            for (int i = 0; i < engine.getNumChannels(); ++i)
+            {
+                auto* channel = engine.getChannelProcessor(i);
+                const bool applies = shouldBeApplied ? channel->isTunerEnabled() && !channel->isTunerSuspended() && !channel->isTunerReducedQuality()
+                                                     : channel->isTunerReducedQuality();
+                if (applies)
+                {
+                    channel->setTunerReducedQuality(shouldBeApplied);
+                    changed = true;
+                }
+            }
+            break;
+
+        case Step::numSteps:
+            break;
+    }
+
+    return changed;
+}
+
+void OverloadGuard::restoreAll()
+{
+    while (!activeSteps.empty())
+    {
+        const auto step = activeSteps.back();
+        activeSteps.pop_back();
+        applyStep(step, false);
+        addEvent({ Event::Type::Restored, juce::Time::currentTimeMillis(), getRecentLoad(), static_cast<int>(step) });
+    }
+
+    calmSinceMs = -1.0;
+}
+
+void OverloadGuard::addEvent(const Event& event)
+{
+    history[(size_t) (numEvents % historySize)] = event;
+    ++numEvents;
+}
+
+std::vector<OverloadGuard::Event> OverloadGuard::getEvents() const
+{
+    std::vector<Event> events;
+    const int count = juce::jmin(numEvents, historySize);
+    events.reserve((size_t) count);
+
+    for (int i = numEvents - count; i < numEvents; ++i)
+        events.push_back(history[(size_t) (i % historySize)]);
+
+    return events;
+}
+
+bool OverloadGuard::writeReport(const juce::File& file) const
+{
+    juce::Array<juce::var> eventList;
+    for (const auto& event : getEvents())
+        eventList.add(event.toVar());
+
+    juce::Array<juce::var> stepList;
+    for (auto step : activeSteps)
+        stepList.add(getStepName(step));
+
+    auto root = std::make_unique<juce::DynamicObject>();
+    root->setProperty("version", 1);
+    root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("numOverruns", numOverruns);
+    root->setProperty("numEvents", numEvents);
+    root->setProperty("degradeLoad", policy.degradeLoad);
+    root->setProperty("restoreLoad", policy.restoreLoad);
+    root->setProperty("activeSteps", stepList);
+    root->setProperty("events", eventList);
+
+    if (!file.replaceWithText(juce::JSON::toString(juce::var(root.release()))))
+    {
+        juce::Logger::writeToLog("OverloadGuard: can't write " + file.getFullPathName());
+        return false;
+    }
+
+    return true;
+}
+
+juce::String OverloadGuard::getStepName(Step step)
+{
+    switch (step)
+    {
+        case Step::SuspendLowPriorityTuners: return "Low-priority tuners off";
+        case Step::AlgorithmicReverb:        return "Algorithmic reverb";
+        case Step::LinearTunerResampling:    return "Linear tuner resampling";
+        case Step::numSteps:                 break;
+    }
+    return {};
+}
+
+juce::String OverloadGuard::getTypeName(Event::Type type)
+{
+    switch (type)
+    {
+        case Event::Type::Overrun:    return "Overrun";
+        case Event::Type::NearMiss:   return "NearMiss";
+        case Event::Type::DeviceXRun: return "DeviceXRun";
+        case Event::Type::Degraded:   return "Degraded";
+        case Event::Type::Restored:   return "Restored";
+    }
+    return {};
+}
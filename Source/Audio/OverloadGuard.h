@@ -0,0 +1,150 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+class AudioEngine;
+
+/**
+ * OverloadGuard - Keeps the show running when the callback runs out of time
+ *
+ * The engine reports how long each device callback took. Measured against the
+ * block's deadline, a block at or past it is an overrun and one within the
+ * policy's degrade threshold is a near miss. Both go to an event history for
+ * post-show analysis, along with xruns the device itself reports.
+ *
+ * While the recent load (fast attack, half-second release) sits above the
+ * degrade threshold, or anything overran, the guard sheds one step of work at
+ * a time, in policy order, skipping steps that would change nothing:
+ *   - suspend the tuner on low-priority channels
+ *   - play the algorithmic reverb on convolution FX buses
+ *   - resample every remaining tuner linearly
+ * Once the load stays below the restore threshold for the policy's hold time,
+ * the most recent step is undone, and so on back to full quality. Steps work
+ * beside each processor's own settings rather than through them, so sessions,
+ * scenes and the UI never see a degraded value.
+ *
+ * Measurement runs on the audio thread and only stores atomics or pushes to a
+ * lock-free FIFO. Decisions and the steps themselves, some of which rebuild
+ * a graph, run on the message thread from a 10 Hz timer once start() is
+ * called; a headless engine's driver can call update() itself instead.
+ */
+class OverloadGuard : private juce::Timer
+{
+public:
+    enum class Step
+    {
+        SuspendLowPriorityTuners,
+        AlgorithmicReverb,
+        LinearTunerResampling,
+        numSteps
+    };
+
+    struct Policy
+    {
+        float degradeLoad = 0.8f;           // Callback load, as a share of the deadline
+        float restoreLoad = 0.5f;
+        double restoreHoldSeconds = 10.0;   // Calm needed before each step is undone
+        double settleSeconds = 1.0;         // Between two steps down, for the load to show the first
+        std::array<bool, static_cast<size_t>(Step::numSteps)> stepEnabled { { true, true, true } };
+    };
+
+    struct Event
+    {
+        enum class Type
+        {
+            Overrun,        // A callback took longer than its block lasts
+            NearMiss,       // Load rose past the degrade threshold
+            DeviceXRun,     // The driver reported dropouts; detail is how many
+            Degraded,       // detail is the Step taken
+            Restored        // detail is the Step undone
+        };
+
+        Type type = Type::Overrun;
+        juce::int64 time = 0;       // juce::Time milliseconds
+        float load = 0.0f;
+        int detail = 0;
+
+        juce::var toVar() const;
+    };
+
+    static constexpr int historySize = 1024;
+
+    explicit OverloadGuard(AudioEngine& engine);
+    ~OverloadGuard() override;
+
+    // Message thread
+    void setPolicy(const Policy& newPolicy);
+    const Policy& getPolicy() const { return policy; }
+
+    void setEnabled(bool shouldBeEnabled);
+    bool isEnabled() const { return enabled; }
+
+    /** Where the device's own xrun count comes from, if anywhere. */
+    void setDeviceXRunSource(std::function<int()> source) { deviceXRunSource = std::move(source); }
+
+    /** Run update() from a timer. */
+    void start() { startTimerHz(10); }
+
+    /** Collect the audio thread's events and take or undo a step if due. */
+    void update() { update(juce::Time::getMillisecondCounterHiRes()); }
+    void update(double nowMs);
+
+    /** Steps currently taken, in the order they were taken. */
+    const std::vector<Step>& getActiveSteps() const { return activeSteps; }
+
+    /** Oldest first; at most historySize. */
+    std::vector<Event> getEvents() const;
+    int getNumOverruns() const { return numOverruns; }
+
+    /** Events and counters as JSON. */
+    bool writeReport(const juce::File& file) const;
+
+    static juce::String getStepName(Step step);
+    static juce::String getTypeName(Event::Type type);
+
+    // Audio thread
+    void prepare(double sampleRate);
+    void recordBlock(juce::int64 ticks, int numSamples) noexcept;
+
+    /** Any thread: the recent callback load. */
+    float getRecentLoad() const noexcept { return recentLoad.load(std::memory_order_relaxed); }
+
+private:
+    void timerCallback() override { update(); }
+
+    void addEvent(const Event& event);
+    bool applyStep(Step step, bool shouldBeApplied);
+    void restoreAll();
+
+    AudioEngine& engine;
+    Policy policy;
+    bool enabled = true;
+    std::function<int()> deviceXRunSource;
+
+    // Audio thread to message thread
+    std::atomic<float> recentLoad { 0.0f };
+    std::atomic<float> nearMissLoad { 0.8f };
+    juce::AbstractFifo pendingFifo { 256 };
+    std::array<Event, 256> pendingEvents;
+    std::atomic<int> numDroppedEvents { 0 };
+
+    // Audio thread only
+    double ticksPerSample = 0.0;
+    double releasePerSample = 0.0;
+    bool inNearMiss = false;
+
+    // Message thread only
+    std::array<Event, historySize> history;
+    int numEvents = 0;              // Ever added; the newest is at (numEvents - 1) % historySize
+    int numOverruns = 0;
+    int lastDeviceXRuns = -1;
+    std::vector<Step> activeSteps;
+    double lastStepDownMs = 0.0;
+    double calmSinceMs = -1.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OverloadGuard)
+};
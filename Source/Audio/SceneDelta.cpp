@@ -0,0 +1,229 @@
+#include "SceneDelta.h"
+#include "../State/ParameterRegistry.h"
+
+//==============================================================================
+ChannelSettings ChannelSettings::capture(const ChannelProcessor& processor)
+{
+    ChannelSettings settings;
+    settings.type = processor.getChannelType();
+    settings.trimGainDb = processor.getTrimGain();
+    settings.gateEnabled = processor.isGateEnabled();
+    settings.gateThresholdDb = processor.getGateThreshold();
+    settings.eqEnabled = processor.isEqEnabled();
+
+    for (int band = 0; band < 4; ++band)
+        settings.eqGainsDb[static_cast<size_t>(band)] = processor.getEQBandGain(static_cast<EQProcessor::Band>(band));
+
+    settings.compressorEnabled = processor.isCompressorEnabled();
+    settings.compressorRatio = processor.getCompressorRatio();
+    return settings;
+}
+
+ChannelSettings ChannelSettings::interpolate(const ChannelSettings& from, const ChannelSettings& to, float t)
+{
+    if (t >= 1.0f)
+        return to;
+
+    auto blend = [t](float a, float b) { return a + (b - a) * t; };
+
+    ChannelSettings settings = to;
+    settings.trimGainDb = blend(from.trimGainDb, to.trimGainDb);
+    settings.gateThresholdDb = blend(from.gateThresholdDb, to.gateThresholdDb);
+    settings.compressorRatio = blend(from.compressorRatio, to.compressorRatio);
+
+    for (size_t band = 0; band < settings.eqGainsDb.size(); ++band)
+        settings.eqGainsDb[band] = blend(from.eqGainsDb[band], to.eqGainsDb[band]);
+
+    // Processing switches on as the fade starts and off once it has finished,
+    // so a section never drops out while its parameters are still moving
+    settings.gateEnabled = from.gateEnabled || to.gateEnabled;
+    settings.eqEnabled = from.eqEnabled || to.eqEnabled;
+    settings.compressorEnabled = from.compressorEnabled || to.compressorEnabled;
+    return settings;
+}
+
+void ChannelSettings::applyTo(ChannelProcessor& processor) const
+{
+    if (processor.getChannelType() != type)
+        processor.setChannelType(type);
+
+    if (processor.getTrimGain() != trimGainDb)
+        processor.setTrimGain(trimGainDb);
+
+    if (processor.isGateEnabled() != gateEnabled)
+        processor.setGateEnabled(gateEnabled);
+
+    if (processor.getGateThreshold() != gateThresholdDb)
+        processor.setGateThreshold(gateThresholdDb);
+
+    if (processor.isEqEnabled() != eqEnabled)
+        processor.setEqEnabled(eqEnabled);
+
+    // One coefficient update for all four bands
+    for (int band = 0; band < 4; ++band)
+    {
+        if (processor.getEQBandGain(static_cast<EQProcessor::Band>(band)) != eqGainsDb[static_cast<size_t>(band)])
+        {
+            processor.setEQGains(eqGainsDb);
+            break;
+        }
+    }
+
+    if (processor.isCompressorEnabled() != compressorEnabled)
+        processor.setCompressorEnabled(compressorEnabled);
+
+    if (processor.getCompressorRatio() != compressorRatio)
+        processor.setCompressorRatio(compressorRatio);
+}
+
+//==============================================================================
+SceneDeltaQueue::~SceneDeltaQueue()
+{
+    stopTimer();
+
+    // The audio device has stopped by now; nothing else can hold a delta
+    pendingDelta.store(nullptr);
+    ownedDeltas.clear();
+}
+
+void SceneDeltaQueue::publish(SceneDelta delta)
+{
+    // No audio thread to hand it to: apply it right here
+    if (!running.load())
+    {
+        for (const auto& entry : delta.entries)
+            if (entry.processor != nullptr)
+                entry.target.applyTo(*entry.processor);
+
+        auralis::ParameterRegistry::getInstance().syncFromEngine();
+        return;
+    }
+
+    auto owned = std::make_unique<SceneDelta>(std::move(delta));
+    owned->generation = ++lastGeneration;
+
+    auto* previous = pendingDelta.exchange(owned.get(), std::memory_order_acq_rel);
+    ownedDeltas.push_back(std::move(owned));
+
+    // A delta we just replaced was never seen by the audio thread
+    if (previous != nullptr)
+    {
+        ownedDeltas.erase(std::remove_if(ownedDeltas.begin(), ownedDeltas.end(),
+                                         [previous](const auto& d) { return d.get() == previous; }),
+                          ownedDeltas.end());
+    }
+
+    collectGarbage();
+
+    // Watch for the audio thread finishing it
+    startTimerHz(20);
+}
+
+void SceneDeltaQueue::collectGarbage()
+{
+    // Once the audio thread has picked up a generation it never looks at older ones again
+    const auto acknowledged = acknowledgedGeneration.load(std::memory_order_acquire);
+
+    ownedDeltas.erase(std::remove_if(ownedDeltas.begin(), ownedDeltas.end(),
+                                     [acknowledged](const auto& d) { return d->generation < acknowledged; }),
+                      ownedDeltas.end());
+}
+
+void SceneDeltaQueue::timerCallback()
+{
+    collectGarbage();
+
+    // The processors have reached the newest delta: publish their values
+    if (finishedGeneration.load(std::memory_order_acquire) == lastGeneration)
+    {
+        stopTimer();
+        auralis::ParameterRegistry::getInstance().syncFromEngine();
+    }
+}
+
+void SceneDeltaQueue::prepare(double sampleRate, int maximumChannels)
+{
+    currentSampleRate = sampleRate;
+    fadeStart.resize(static_cast<size_t>(maximumChannels));
+    running.store(true);
+}
+
+void SceneDeltaQueue::released()
+{
+    running.store(false);
+
+    // Finish whatever was in flight so the processors end up at the target
+    if (auto* delta = pendingDelta.exchange(nullptr, std::memory_order_acq_rel))
+    {
+        activeDelta = delta;
+        acknowledgedGeneration.store(delta->generation, std::memory_order_release);
+    }
+
+    if (activeDelta != nullptr)
+    {
+        for (const auto& entry : activeDelta->entries)
+            if (entry.processor != nullptr)
+                entry.target.applyTo(*entry.processor);
+
+        finishedGeneration.store(activeDelta->generation, std::memory_order_release);
+    }
+
+    activeDelta = nullptr;
+    fading.store(false, std::memory_order_relaxed);
+}
+
+void SceneDeltaQueue::processBlock(int numSamples)
+{
+    // Pick up a newly published delta at the block boundary
+    if (auto* delta = pendingDelta.exchange(nullptr, std::memory_order_acq_rel))
+    {
+        activeDelta = delta;
+        acknowledgedGeneration.store(delta->generation, std::memory_order_release);
+
+        fadeSamples = delta->crossfadeSeconds * currentSampleRate;
+        fadePosition = 0.0;
+
+        const bool canFade = fadeSamples >= 1.0 && delta->entries.size() <= fadeStart.size();
+
+        if (canFade)
+        {
+            // Fade from wherever each channel is now, including part-way through another fade
+            for (size_t i = 0; i < delta->entries.size(); ++i)
+                if (auto* processor = delta->entries[i].processor)
+                    fadeStart[i] = ChannelSettings::capture(*processor);
+        }
+        else
+        {
+            // Every channel switches before any audio in this block is processed
+            for (const auto& entry : delta->entries)
+                if (entry.processor != nullptr)
+                    entry.target.applyTo(*entry.processor);
+
+            finishedGeneration.store(delta->generation, std::memory_order_release);
+            activeDelta = nullptr;
+        }
+
+        fading.store(canFade, std::memory_order_relaxed);
+    }
+
+    if (activeDelta == nullptr)
+        return;
+
+    // Advance the fade by one block
+    fadePosition += numSamples;
+    const float t = static_cast<float>(juce::jmin(1.0, fadePosition / fadeSamples));
+
+    for (size_t i = 0; i < activeDelta->entries.size(); ++i)
+    {
+        const auto& entry = activeDelta->entries[i];
+        if (entry.processor != nullptr)
+            ChannelSettings::interpolate(fadeStart[i], entry.target, t).applyTo(*entry.processor);
+    }
+
+    if (t >= 1.0f)
+    {
+        finishedGeneration.store(activeDelta->generation, std::memory_order_release);
+        activeDelta = nullptr;
+        fading.store(false, std::memory_order_relaxed);
+    }
+}
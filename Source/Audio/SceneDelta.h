@@ -0,0 +1,105 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include "ChannelProcessor.h"
+
+/**
+ * ChannelSettings - The channel parameters a scene change can set
+ *
+ * Plain values, so a complete set for every channel can be built on any
+ * thread and then handed to the audio thread in one go.
+ */
+struct ChannelSettings
+{
+    ChannelProcessor::ChannelType type = ChannelProcessor::ChannelType::Other;
+    float trimGainDb = 0.0f;
+    bool gateEnabled = true;
+    float gateThresholdDb = -50.0f;
+    bool eqEnabled = true;
+    std::array<float, 4> eqGainsDb {};
+    bool compressorEnabled = true;
+    float compressorRatio = 3.0f;
+
+    // Read the current settings of a channel
+    static ChannelSettings capture(const ChannelProcessor& processor);
+
+    // Continuous values blended by t (0..1); switches and type come from 'to'
+    static ChannelSettings interpolate(const ChannelSettings& from, const ChannelSettings& to, float t);
+
+    // Push into the processor, skipping setters whose value hasn't changed
+    void applyTo(ChannelProcessor& processor) const;
+};
+
+/**
+ * SceneDelta - Target settings for a set of channels, applied as one event
+ */
+struct SceneDelta
+{
+    struct Entry
+    {
+        ChannelProcessor* processor = nullptr;
+        ChannelSettings target;
+    };
+
+    std::vector<Entry> entries;
+    double crossfadeSeconds = 0.0;     // 0 switches at the next block boundary
+
+    // Set by SceneDeltaQueue
+    juce::uint32 generation = 0;
+};
+
+/**
+ * SceneDeltaQueue - Hands scene deltas to the audio thread
+ *
+ * The message thread publishes a complete delta with a single atomic pointer
+ * exchange. At the start of its next block the audio thread takes it and
+ * applies every channel before processing any audio, optionally ramping the
+ * continuous parameters over the crossfade time. A delta published while
+ * another is fading takes over from wherever the fade has got to.
+ *
+ * Deltas are owned and freed by the message thread; the audio thread only
+ * reports the generation it has picked up, so it never allocates or frees.
+ * Once it reports the newest one finished, the message thread re-reads the
+ * ParameterRegistry from the processors.
+ */
+class SceneDeltaQueue : private juce::Timer
+{
+public:
+    SceneDeltaQueue() = default;
+    ~SceneDeltaQueue();
+
+    // Message thread. When the audio device isn't running the delta is
+    // applied straight away, without a fade.
+    void publish(SceneDelta delta);
+
+    // Audio thread
+    void prepare(double sampleRate, int maximumChannels);
+    void released();
+    void processBlock(int numSamples);
+
+    bool isFading() const { return fading.load(std::memory_order_relaxed); }
+
+private:
+    void collectGarbage();
+    void timerCallback() override;
+
+    // Message thread: every delta the audio thread might still be reading
+    std::vector<std::unique_ptr<SceneDelta>> ownedDeltas;
+    juce::uint32 lastGeneration = 0;
+
+    std::atomic<SceneDelta*> pendingDelta { nullptr };
+    std::atomic<juce::uint32> acknowledgedGeneration { 0 };
+    std::atomic<juce::uint32> finishedGeneration { 0 };
+    std::atomic<bool> running { false };
+    std::atomic<bool> fading { false };
+
+    // Audio thread only
+    SceneDelta* activeDelta = nullptr;
+    std::vector<ChannelSettings> fadeStart;     // Reserved in prepare()
+    double currentSampleRate = 44100.0;
+    double fadeSamples = 0.0;
+    double fadePosition = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SceneDeltaQueue)
+};
@@ -0,0 +1,515 @@
+#include "SceneStore.h"
+#include "AudioEngine.h"
+#include "../State/ParameterRegistry.h"
+#include "../State/SessionSnapshot.h"
+
+namespace
+{
+    using ChannelFlags = auralis::SessionSnapshot::ChannelParameters;
+    using GroupBusFlags = auralis::SessionSnapshot::GroupBusParameters;
+    using FXBusFlags = auralis::SessionSnapshot::FXBusParameters;
+    using MasterFlags = auralis::SessionSnapshot::MasterBusParameters;
+
+    bool hasFlag(juce::uint32 flags, juce::uint32 flag) { return (flags & flag) != 0; }
+    juce::uint32 flagIf(bool condition, juce::uint32 flag) { return condition ? flag : 0; }
+}
+
+SceneStore::SceneStore(AudioEngine& audioEngine)
+    : engine(audioEngine),
+      numChannels(static_cast<size_t>(audioEngine.getNumChannels())),
+      numGroupBuses(static_cast<size_t>(audioEngine.getNumGroupBuses())),
+      numFXBuses(static_cast<size_t>(audioEngine.getNumFXBuses()))
+{
+    channels.resize(maxScenes * numChannels);
+    groupBuses.resize(maxScenes * numGroupBuses);
+    fxBuses.resize(maxScenes * numFXBuses);
+    master.resize(maxScenes);
+    channelSafe.assign(numChannels, 0);
+}
+
+SceneStore::~SceneStore()
+{
+    stopTimer();
+
+    // The audio device has stopped by now; nothing else can hold a recall
+    pendingRecall.store(nullptr);
+    ownedRecalls.clear();
+}
+
+//==============================================================================
+void SceneStore::storeScene(int sceneIndex, const juce::String& name)
+{
+    if (!juce::isPositiveAndBelow(sceneIndex, maxScenes))
+    {
+        jassertfalse;
+        return;
+    }
+
+    auralis::SessionSnapshot snapshot;
+    snapshot.capture(engine);
+
+    const auto scene = static_cast<size_t>(sceneIndex);
+
+    for (size_t i = 0; i < numChannels; ++i)
+    {
+        const auto& p = snapshot.channels[i];
+        const auto row = scene * numChannels + i;
+        auto& values = channels.values;
+
+        values[trimGainDb][row] = p.trimGainDb;
+        values[gateThresholdDb][row] = p.gateThresholdDb;
+        values[eqLowShelfDb][row] = p.eqGainsDb[0];
+        values[eqLowMidDb][row] = p.eqGainsDb[1];
+        values[eqHighMidDb][row] = p.eqGainsDb[2];
+        values[eqHighShelfDb][row] = p.eqGainsDb[3];
+        values[compressorRatio][row] = p.compressorRatio;
+        values[compressorThresholdDb][row] = p.compressorThresholdDb;
+        values[fxSendLevel][row] = p.fxSendLevel;
+        values[tunerStrength][row] = p.tunerStrength;
+        channels.words[channelType][row] = p.type;
+        channels.words[channelFlags][row] = p.flags;
+    }
+
+    for (size_t i = 0; i < numGroupBuses; ++i)
+    {
+        const auto& p = snapshot.groupBuses[i];
+        const auto row = scene * numGroupBuses + i;
+
+        groupBuses.values[busEQLowDb][row] = p.eqLowGain;
+        groupBuses.values[busEQMidDb][row] = p.eqMidGain;
+        groupBuses.values[busEQHighDb][row] = p.eqHighGain;
+        groupBuses.values[busOutputGain][row] = p.outputGain;
+        groupBuses.words[groupBusFlags][row] = p.flags;
+    }
+
+    for (size_t i = 0; i < numFXBuses; ++i)
+    {
+        const auto& p = snapshot.fxBuses[i];
+        const auto row = scene * numFXBuses + i;
+
+        fxBuses.values[reverbWetLevel][row] = p.reverbWetLevel;
+        fxBuses.values[delayWetLevel][row] = p.delayWetLevel;
+        fxBuses.words[reverbMode][row] = p.reverbMode;
+        fxBuses.words[fxBusFlags][row] = p.flags;
+    }
+
+    master.values[targetLufs][scene] = snapshot.master.targetLufs;
+    master.words[platform][scene] = snapshot.master.platform;
+    master.words[masterFlags][scene] = snapshot.master.flags;
+
+    sceneNames[scene] = name;
+    sceneStored[scene] = true;
+}
+
+bool SceneStore::recallScene(int sceneIndex, double crossfadeSeconds)
+{
+    if (!hasScene(sceneIndex))
+        return false;
+
+    const auto scene = static_cast<size_t>(sceneIndex);
+
+    applyMessageThreadSettings(sceneIndex);
+
+    auto recall = std::make_unique<Recall>();
+    recall->channels.resize(numChannels);
+    recall->channels.copyRows(channels, scene * numChannels, 0, numChannels);
+    recall->groupBuses.resize(numGroupBuses);
+    recall->groupBuses.copyRows(groupBuses, scene * numGroupBuses, 0, numGroupBuses);
+    recall->channelSafe = channelSafe;
+    recall->crossfadeSeconds = crossfadeSeconds;
+
+    currentScene = sceneIndex;
+
+    // No audio thread to hand it to: apply it right here
+    if (!running.load())
+    {
+        applyRecall(*recall, 1.0f);
+        auralis::ParameterRegistry::getInstance().syncFromEngine();
+        return true;
+    }
+
+    recall->generation = ++lastGeneration;
+
+    auto* previous = pendingRecall.exchange(recall.get(), std::memory_order_acq_rel);
+    ownedRecalls.push_back(std::move(recall));
+
+    // A recall we just replaced was never seen by the audio thread
+    if (previous != nullptr)
+    {
+        ownedRecalls.erase(std::remove_if(ownedRecalls.begin(), ownedRecalls.end(),
+                                          [previous](const auto& r) { return r.get() == previous; }),
+                           ownedRecalls.end());
+    }
+
+    collectGarbage();
+
+    // Watch for the audio thread finishing it
+    startTimerHz(20);
+    return true;
+}
+
+void SceneStore::clearScene(int sceneIndex)
+{
+    if (!juce::isPositiveAndBelow(sceneIndex, maxScenes))
+        return;
+
+    sceneStored[static_cast<size_t>(sceneIndex)] = false;
+    sceneNames[static_cast<size_t>(sceneIndex)].clear();
+
+    if (currentScene == sceneIndex)
+        currentScene = -1;
+}
+
+bool SceneStore::hasScene(int sceneIndex) const
+{
+    return juce::isPositiveAndBelow(sceneIndex, maxScenes) && sceneStored[static_cast<size_t>(sceneIndex)];
+}
+
+juce::String SceneStore::getSceneName(int sceneIndex) const
+{
+    return hasScene(sceneIndex) ? sceneNames[static_cast<size_t>(sceneIndex)] : juce::String();
+}
+
+void SceneStore::setRecallSafe(int channelIndex, juce::uint32 mask)
+{
+    if (juce::isPositiveAndBelow(channelIndex, static_cast<int>(numChannels)))
+        channelSafe[static_cast<size_t>(channelIndex)] = mask & safeAll;
+}
+
+juce::uint32 SceneStore::getRecallSafe(int channelIndex) const
+{
+    return juce::isPositiveAndBelow(channelIndex, static_cast<int>(numChannels))
+               ? channelSafe[static_cast<size_t>(channelIndex)] : 0;
+}
+
+void SceneStore::applyMessageThreadSettings(int sceneIndex)
+{
+    const auto scene = static_cast<size_t>(sceneIndex);
+
+    // FX sends go through the FX bus, which logs
+    for (size_t i = 0; i < numChannels; ++i)
+    {
+        auto* channel = engine.getChannelProcessor(static_cast<int>(i));
+        if (channel == nullptr || hasFlag(channelSafe[i], safeFxSend))
+            continue;
+
+        const float level = channels.values[fxSendLevel][scene * numChannels + i];
+        if (channel->getFxSendLevel() != level)
+            channel->setFxSendLevel(level);
+    }
+
+    // FX bus switches and reverb mode rebuild the bus graph
+    for (size_t i = 0; i < numFXBuses; ++i)
+    {
+        auto* bus = engine.getFXBusProcessor(static_cast<int>(i));
+        if (bus == nullptr)
+            continue;
+
+        const auto row = scene * numFXBuses + i;
+        const auto flags = fxBuses.words[fxBusFlags][row];
+        const auto mode = static_cast<FXBusProcessor::ReverbMode>(fxBuses.words[reverbMode][row]);
+
+        if (bus->getReverbWetLevel() != fxBuses.values[reverbWetLevel][row])
+            bus->setReverbWetLevel(fxBuses.values[reverbWetLevel][row]);
+
+        if (bus->getDelayWetLevel() != fxBuses.values[delayWetLevel][row])
+            bus->setDelayWetLevel(fxBuses.values[delayWetLevel][row]);
+
+        if (bus->getReverbMode() != mode)
+            bus->setReverbMode(mode);
+
+        if (bus->isReverbEnabled() != hasFlag(flags, FXBusFlags::reverbEnabled))
+            bus->setReverbEnabled(hasFlag(flags, FXBusFlags::reverbEnabled));
+
+        if (bus->isDelayEnabled() != hasFlag(flags, FXBusFlags::delayEnabled))
+            bus->setDelayEnabled(hasFlag(flags, FXBusFlags::delayEnabled));
+
+        if (bus->isBypassed() != hasFlag(flags, FXBusFlags::bypassed))
+            bus->setBypass(hasFlag(flags, FXBusFlags::bypassed));
+    }
+
+    if (auto* masterBus = engine.getMasterBusProcessor())
+    {
+        const auto target = static_cast<StreamTarget>(juce::jlimit<juce::uint32>(0, 2, master.words[platform][scene]));
+        const auto flags = master.words[masterFlags][scene];
+
+        if (masterBus->getStreamTarget() != target)
+            masterBus->setStreamTarget(target);
+
+        if (target == StreamTarget::Custom && masterBus->getTargetLufs() != master.values[targetLufs][scene])
+            masterBus->setTargetLufs(master.values[targetLufs][scene]);
+
+        if (masterBus->isCompressorEnabled() != hasFlag(flags, MasterFlags::compressorEnabled))
+            masterBus->setCompressorEnabled(hasFlag(flags, MasterFlags::compressorEnabled));
+
+        if (masterBus->isLimiterEnabled() != hasFlag(flags, MasterFlags::limiterEnabled))
+            masterBus->setLimiterEnabled(hasFlag(flags, MasterFlags::limiterEnabled));
+    }
+}
+
+//==============================================================================
+void SceneStore::applyRecall(const Recall& recall, float t)
+{
+    const bool finished = t >= 1.0f;
+
+    for (size_t i = 0; i < recall.channelSafe.size(); ++i)
+    {
+        auto* channel = engine.getChannelProcessor(static_cast<int>(i));
+        const auto safe = recall.channelSafe[i];
+
+        if (channel == nullptr || safe == safeAll)
+            continue;
+
+        const auto& target = recall.channels;
+        const auto& start = fadeStartChannels;
+
+        auto value = [&](int parameter)
+        {
+            const float to = target.values[static_cast<size_t>(parameter)][i];
+            if (finished)
+                return to;
+
+            const float from = start.values[static_cast<size_t>(parameter)][i];
+            return from + (to - from) * t;
+        };
+
+        // Processing switches on as the fade starts and off once it has finished
+        auto isOn = [&](juce::uint32 flag)
+        {
+            const bool to = hasFlag(target.words[channelFlags][i], flag);
+            return finished ? to : (to || hasFlag(start.words[channelFlags][i], flag));
+        };
+
+        const auto type = static_cast<ChannelProcessor::ChannelType>(juce::jlimit<juce::uint32>(0, 3, target.words[channelType][i]));
+        if (channel->getChannelType() != type)
+            channel->setChannelType(type);
+
+        if (!hasFlag(safe, safeTrim) && channel->getTrimGain() != value(trimGainDb))
+            channel->setTrimGain(value(trimGainDb));
+
+        if (!hasFlag(safe, safeGate))
+        {
+            if (channel->getGateThreshold() != value(gateThresholdDb))
+                channel->setGateThreshold(value(gateThresholdDb));
+
+            if (channel->isGateEnabled() != isOn(ChannelFlags::gateEnabled))
+                channel->setGateEnabled(isOn(ChannelFlags::gateEnabled));
+        }
+
+        if (!hasFlag(safe, safeEQ))
+        {
+            const std::array<float, 4> gains { value(eqLowShelfDb), value(eqLowMidDb), value(eqHighMidDb), value(eqHighShelfDb) };
+
+            // One coefficient update for all four bands
+            for (int band = 0; band < 4; ++band)
+            {
+                if (channel->getEQBandGain(static_cast<EQProcessor::Band>(band)) != gains[static_cast<size_t>(band)])
+                {
+                    channel->setEQGains(gains);
+                    break;
+                }
+            }
+
+            if (channel->isEqEnabled() != isOn(ChannelFlags::eqEnabled))
+                channel->setEqEnabled(isOn(ChannelFlags::eqEnabled));
+        }
+
+        if (!hasFlag(safe, safeCompressor))
+        {
+            if (channel->getCompressorRatio() != value(compressorRatio))
+                channel->setCompressorRatio(value(compressorRatio));
+
+            if (channel->getCompressorThreshold() != value(compressorThresholdDb))
+                channel->setCompressorThreshold(value(compressorThresholdDb));
+
+            if (channel->isCompressorEnabled() != isOn(ChannelFlags::compressorEnabled))
+                channel->setCompressorEnabled(isOn(ChannelFlags::compressorEnabled));
+        }
+
+        if (!hasFlag(safe, safeTuner))
+        {
+            if (channel->getTunerStrength() != value(tunerStrength))
+                channel->setTunerStrength(value(tunerStrength));
+
+            if (channel->isTunerEnabled() != isOn(ChannelFlags::tunerEnabled))
+                channel->setTunerEnabled(isOn(ChannelFlags::tunerEnabled));
+        }
+
+        // Mutes and solos switch as the recall lands, like a console scene
+        if (!hasFlag(safe, safeMuteSolo))
+        {
+            channel->setMuted(hasFlag(target.words[channelFlags][i], ChannelFlags::muted));
+            channel->setSolo(hasFlag(target.words[channelFlags][i], ChannelFlags::solo));
+        }
+    }
+
+    for (size_t i = 0; i < recall.groupBuses.words[groupBusFlags].size(); ++i)
+    {
+        auto* bus = engine.getGroupBusProcessor(static_cast<int>(i));
+        if (bus == nullptr)
+            continue;
+
+        const auto& target = recall.groupBuses;
+        const auto& start = fadeStartGroupBuses;
+
+        auto value = [&](int parameter)
+        {
+            const float to = target.values[static_cast<size_t>(parameter)][i];
+            if (finished)
+                return to;
+
+            const float from = start.values[static_cast<size_t>(parameter)][i];
+            return from + (to - from) * t;
+        };
+
+        auto isOn = [&](juce::uint32 flag)
+        {
+            const bool to = hasFlag(target.words[groupBusFlags][i], flag);
+            return finished ? to : (to || hasFlag(start.words[groupBusFlags][i], flag));
+        };
+
+        const float low = value(busEQLowDb), mid = value(busEQMidDb), high = value(busEQHighDb);
+        if (bus->getEQLowGain() != low || bus->getEQMidGain() != mid || bus->getEQHighGain() != high)
+            bus->setEQGains(low, mid, high);
+
+        // The single-field setters log, and this can run on the audio thread
+        bus->setGainAndSwitches(value(busOutputGain), isOn(GroupBusFlags::eqEnabled), isOn(GroupBusFlags::compEnabled));
+    }
+}
+
+void SceneStore::captureFadeStart(const Recall& recall)
+{
+    // Fade from wherever each processor is now, including part-way through another fade
+    for (size_t i = 0; i < recall.channelSafe.size(); ++i)
+    {
+        auto* channel = engine.getChannelProcessor(static_cast<int>(i));
+        if (channel == nullptr)
+            continue;
+
+        auto& values = fadeStartChannels.values;
+        values[trimGainDb][i] = channel->getTrimGain();
+        values[gateThresholdDb][i] = channel->getGateThreshold();
+
+        for (int band = 0; band < 4; ++band)
+            values[static_cast<size_t>(eqLowShelfDb + band)][i] = channel->getEQBandGain(static_cast<EQProcessor::Band>(band));
+
+        values[compressorRatio][i] = channel->getCompressorRatio();
+        values[compressorThresholdDb][i] = channel->getCompressorThreshold();
+        values[tunerStrength][i] = channel->getTunerStrength();
+
+        fadeStartChannels.words[channelFlags][i] = flagIf(channel->isGateEnabled(), ChannelFlags::gateEnabled)
+                                                 | flagIf(channel->isEqEnabled(), ChannelFlags::eqEnabled)
+                                                 | flagIf(channel->isCompressorEnabled(), ChannelFlags::compressorEnabled)
+                                                 | flagIf(channel->isTunerEnabled(), ChannelFlags::tunerEnabled);
+    }
+
+    for (size_t i = 0; i < recall.groupBuses.words[groupBusFlags].size(); ++i)
+    {
+        auto* bus = engine.getGroupBusProcessor(static_cast<int>(i));
+        if (bus == nullptr)
+            continue;
+
+        fadeStartGroupBuses.values[busEQLowDb][i] = bus->getEQLowGain();
+        fadeStartGroupBuses.values[busEQMidDb][i] = bus->getEQMidGain();
+        fadeStartGroupBuses.values[busEQHighDb][i] = bus->getEQHighGain();
+        fadeStartGroupBuses.values[busOutputGain][i] = bus->getOutputGain();
+        fadeStartGroupBuses.words[groupBusFlags][i] = flagIf(bus->isEQEnabled(), GroupBusFlags::eqEnabled)
+                                                    | flagIf(bus->isCompEnabled(), GroupBusFlags::compEnabled);
+    }
+}
+
+void SceneStore::collectGarbage()
+{
+    // Once the audio thread has picked up a generation it never looks at older ones again
+    const auto acknowledged = acknowledgedGeneration.load(std::memory_order_acquire);
+
+    ownedRecalls.erase(std::remove_if(ownedRecalls.begin(), ownedRecalls.end(),
+                                      [acknowledged](const auto& r) { return r->generation < acknowledged; }),
+                       ownedRecalls.end());
+}
+
+void SceneStore::timerCallback()
+{
+    collectGarbage();
+
+    // The processors have reached the newest scene: publish their values
+    if (finishedGeneration.load(std::memory_order_acquire) == lastGeneration)
+    {
+        stopTimer();
+        auralis::ParameterRegistry::getInstance().syncFromEngine();
+    }
+}
+
+//==============================================================================
+void SceneStore::prepare(double sampleRate)
+{
+    currentSampleRate = sampleRate;
+    fadeStartChannels.resize(numChannels);
+    fadeStartGroupBuses.resize(numGroupBuses);
+    running.store(true);
+}
+
+void SceneStore::released()
+{
+    running.store(false);
+
+    // Finish whatever was in flight so the processors end up at the scene
+    if (auto* recall = pendingRecall.exchange(nullptr, std::memory_order_acq_rel))
+    {
+        activeRecall = recall;
+        acknowledgedGeneration.store(recall->generation, std::memory_order_release);
+    }
+
+    if (activeRecall != nullptr)
+    {
+        applyRecall(*activeRecall, 1.0f);
+        finishedGeneration.store(activeRecall->generation, std::memory_order_release);
+    }
+
+    activeRecall = nullptr;
+    fading.store(false, std::memory_order_relaxed);
+}
+
+void SceneStore::processBlock(int numSamples)
+{
+    // Pick up a newly recalled scene at the block boundary
+    if (auto* recall = pendingRecall.exchange(nullptr, std::memory_order_acq_rel))
+    {
+        activeRecall = recall;
+        acknowledgedGeneration.store(recall->generation, std::memory_order_release);
+
+        fadeSamples = recall->crossfadeSeconds * currentSampleRate;
+        fadePosition = 0.0;
+
+        const bool canFade = fadeSamples >= 1.0;
+
+        if (canFade)
+        {
+            captureFadeStart(*recall);
+        }
+        else
+        {
+            applyRecall(*recall, 1.0f);
+            finishedGeneration.store(recall->generation, std::memory_order_release);
+            activeRecall = nullptr;
+        }
+
+        fading.store(canFade, std::memory_order_relaxed);
+    }
+
+    if (activeRecall == nullptr)
+        return;
+
+    // Advance the fade by one block
+    fadePosition += numSamples;
+    const float t = static_cast<float>(juce::jmin(1.0, fadePosition / fadeSamples));
+
+    applyRecall(*activeRecall, t);
+
+    if (t >= 1.0f)
+    {
+        finishedGeneration.store(activeRecall->generation, std::memory_order_release);
+        activeRecall = nullptr;
+        fading.store(false, std::memory_order_relaxed);
+    }
+}
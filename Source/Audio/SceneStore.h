@@ -0,0 +1,155 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+class AudioEngine;
+
+/**
+ * SceneStore - In-memory scenes for recall during a show
+ *
+ * Holds up to maxScenes complete snapshots of every channel, group bus, FX
+ * bus and the master bus. Each parameter is a column with one row per scene
+ * and processor, so storing or recalling a scene copies a few contiguous runs.
+ *
+ * Recall hands the scene to the audio thread with one atomic pointer
+ * exchange, the same way SceneDeltaQueue does. Channel and group bus
+ * parameters are crossfaded there block by block; switches turn on as the
+ * fade starts and off once it ends. Settings whose setters rebuild the FX
+ * graph or log (FX sends, FX buses, master bus) change on the message thread
+ * when the recall is made. Once the audio thread has finished the newest
+ * recall, the message thread re-reads the ParameterRegistry from the
+ * processors.
+ *
+ * Each channel has a recall-safe mask. Masked parameters keep their current
+ * values whichever scene is recalled.
+ */
+class SceneStore : private juce::Timer
+{
+public:
+    static constexpr int maxScenes = 64;
+
+    enum RecallSafe : juce::uint32
+    {
+        safeTrim       = 1 << 0,
+        safeGate       = 1 << 1,
+        safeEQ         = 1 << 2,
+        safeCompressor = 1 << 3,
+        safeFxSend     = 1 << 4,
+        safeTuner      = 1 << 5,
+        safeMuteSolo   = 1 << 6,
+        safeAll        = (1 << 7) - 1
+    };
+
+    explicit SceneStore(AudioEngine& engine);
+    ~SceneStore();
+
+    // Message thread
+    void storeScene(int sceneIndex, const juce::String& name);
+    bool recallScene(int sceneIndex, double crossfadeSeconds = 0.0);
+    void clearScene(int sceneIndex);
+
+    bool hasScene(int sceneIndex) const;
+    juce::String getSceneName(int sceneIndex) const;
+    int getCurrentScene() const { return currentScene; }
+
+    void setRecallSafe(int channelIndex, juce::uint32 mask);
+    juce::uint32 getRecallSafe(int channelIndex) const;
+
+    // Audio thread
+    void prepare(double sampleRate);
+    void released();
+    void processBlock(int numSamples);
+
+    bool isFading() const { return fading.load(std::memory_order_relaxed); }
+
+private:
+    // Struct-of-arrays parameter table: values[parameter][row]
+    template <int NumValues, int NumWords>
+    struct Columns
+    {
+        std::array<std::vector<float>, NumValues> values;
+        std::array<std::vector<juce::uint32>, NumWords> words;
+
+        void resize(size_t numRows)
+        {
+            for (auto& column : values) column.assign(numRows, 0.0f);
+            for (auto& column : words)  column.assign(numRows, 0);
+        }
+
+        void copyRows(const Columns& source, size_t sourceRow, size_t destRow, size_t numRows)
+        {
+            for (size_t i = 0; i < values.size(); ++i)
+                std::copy_n(source.values[i].begin() + (std::ptrdiff_t) sourceRow, numRows, values[i].begin() + (std::ptrdiff_t) destRow);
+
+            for (size_t i = 0; i < words.size(); ++i)
+                std::copy_n(source.words[i].begin() + (std::ptrdiff_t) sourceRow, numRows, words[i].begin() + (std::ptrdiff_t) destRow);
+        }
+    };
+
+    enum ChannelValue { trimGainDb, gateThresholdDb, eqLowShelfDb, eqLowMidDb, eqHighMidDb, eqHighShelfDb,
+                        compressorRatio, compressorThresholdDb, fxSendLevel, tunerStrength, numChannelValues };
+    enum ChannelWord  { channelType, channelFlags, numChannelWords };
+
+    enum GroupBusValue { busEQLowDb, busEQMidDb, busEQHighDb, busOutputGain, numGroupBusValues };
+    enum GroupBusWord  { groupBusFlags, numGroupBusWords };
+
+    enum FXBusValue { reverbWetLevel, delayWetLevel, numFXBusValues };
+    enum FXBusWord  { reverbMode, fxBusFlags, numFXBusWords };
+
+    enum MasterValue { targetLufs, numMasterValues };
+    enum MasterWord  { platform, masterFlags, numMasterWords };
+
+    using ChannelColumns = Columns<numChannelValues, numChannelWords>;
+    using GroupBusColumns = Columns<numGroupBusValues, numGroupBusWords>;
+    using FXBusColumns = Columns<numFXBusValues, numFXBusWords>;
+    using MasterColumns = Columns<numMasterValues, numMasterWords>;
+
+    // One scene on its way to the audio thread
+    struct Recall
+    {
+        ChannelColumns channels;
+        GroupBusColumns groupBuses;
+        std::vector<juce::uint32> channelSafe;
+        double crossfadeSeconds = 0.0;
+        juce::uint32 generation = 0;
+    };
+
+    void applyMessageThreadSettings(int sceneIndex);
+    void applyRecall(const Recall& recall, float t);
+    void captureFadeStart(const Recall& recall);
+    void collectGarbage();
+    void timerCallback() override;
+
+    AudioEngine& engine;
+
+    // Message thread
+    const size_t numChannels, numGroupBuses, numFXBuses;
+    ChannelColumns channels;
+    GroupBusColumns groupBuses;
+    FXBusColumns fxBuses;
+    MasterColumns master;
+    std::array<juce::String, maxScenes> sceneNames;
+    std::array<bool, maxScenes> sceneStored {};
+    std::vector<juce::uint32> channelSafe;
+    int currentScene = -1;
+
+    std::vector<std::unique_ptr<Recall>> ownedRecalls;
+    juce::uint32 lastGeneration = 0;
+
+    std::atomic<Recall*> pendingRecall { nullptr };
+    std::atomic<juce::uint32> acknowledgedGeneration { 0 };
+    std::atomic<juce::uint32> finishedGeneration { 0 };
+    std::atomic<bool> running { false };
+    std::atomic<bool> fading { false };
+
+    // Audio thread only
+    Recall* activeRecall = nullptr;
+    ChannelColumns fadeStartChannels;       // Sized in prepare()
+    GroupBusColumns fadeStartGroupBuses;
+    double currentSampleRate = 44100.0;
+    double fadeSamples = 0.0;
+    double fadePosition = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SceneStore)
+};
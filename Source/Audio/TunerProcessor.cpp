@@ -16,13 +16,19 @@ namespace auralis
         interpolators.resize(getTotalNumInputChannels());
         for (auto& interp : interpolators)
             interp.reset();
+        linearInterpolators.resize(getTotalNumInputChannels());
+        for (auto& interp : linearInterpolators)
+            interp.reset();
     }
 
     void TunerProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
     {
+        DSPLoadProfiler::ScopedTimer loadTimer (loadSlot, buffer.getNumSamples());
+
         dryBuffer.makeCopyOf (buffer);
 
         const float currentStrength = strength.load();
+        const bool linear = reducedQuality.load();
         const int numChannels = buffer.getNumChannels();
         const int numSamples  = buffer.getNumSamples();
 
@@ -45,8 +51,17 @@ namespace auralis
             if (ratio <= 0.0f || std::isnan (ratio) || ratio > 4.0f)
                 ratio = 1.0f;
 
-            interpolators[channel].reset();
-            interpolators[channel].process (ratio, dryData, tunedData, numSamples);
+            // Both start afresh each block, so switching between them is seamless
+            if (linear)
+            {
+                linearInterpolators[channel].reset();
+                linearInterpolators[channel].process (ratio, dryData, tunedData, numSamples);
+            }
+            else
+            {
+                interpolators[channel].reset();
+                interpolators[channel].process (ratio, dryData, tunedData, numSamples);
+            }
 
             auto* out = buffer.getWritePointer (channel);
             for (int i = 0; i < numSamples; ++i)
@@ -1,5 +1,6 @@
 #pragma once
 #include <JuceHeader.h>
+#include "DSPLoadProfiler.h"
 
 namespace auralis
 {
@@ -39,12 +40,23 @@ namespace auralis
         void setStrength (float s) noexcept { strength.store (juce::jlimit (0.0f, 1.0f, s)); }
         float getStrength() const noexcept  { return strength.load(); }
 
+        /** Linear rather than Lagrange resampling, several times cheaper, e.g.
+            while the engine is shedding load. Takes effect at the next block. */
+        void setReducedQuality (bool shouldBeReduced) noexcept { reducedQuality.store (shouldBeReduced); }
+        bool isReducedQuality() const noexcept                 { return reducedQuality.load(); }
+
+        // Per-block cost, while the engine's load profiler is on
+        void setLoadSlot (DSPLoadProfiler::Slot* slot) noexcept { loadSlot = slot; }
+
     private:
         std::atomic<float> strength { 0.5f };   // 0 = dry, 1 = full-tune
         juce::AudioBuffer<float> dryBuffer;     // Buffer for storing dry signal
         juce::AudioBuffer<float> tunedBuffer;   // Buffer for tuned signal
         std::vector<juce::LagrangeInterpolator> interpolators; // one per channel
+        std::vector<juce::LinearInterpolator> linearInterpolators;
+        std::atomic<bool> reducedQuality { false };
         double currentSampleRate = 44100.0;
+        DSPLoadProfiler::Slot* loadSlot = nullptr;
 
         float detectPitch (const float* data, int numSamples) const;
 
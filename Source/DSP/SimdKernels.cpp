@@ -0,0 +1,255 @@
+#include "SimdKernels.h"
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace auralis
+{
+namespace simd
+{
+    //==============================================================================
+    // Scalar reference: plain C++ the compiler is free to vectorise for the baseline
+
+    namespace detail
+    {
+        void biquadCascadeMono (float* data, int numSamples, const BiquadCoefficients* stages,
+                                BiquadState* state, int numStages, int stateStride) noexcept
+        {
+            for (int stage = 0; stage < numStages; ++stage)
+            {
+                const auto& c = stages[stage];
+                auto& s = state[stage * stateStride];
+                float z1 = s.z1, z2 = s.z2;
+
+                // Same operation order as juce::dsp::IIR::Filter, so a plain build matches it exactly
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const float x = data[i];
+                    const float y = (c.b0 * x) + z1;
+                    z1 = (c.b1 * x) - (c.a1 * y) + z2;
+                    z2 = (c.b2 * x) - (c.a2 * y);
+                    data[i] = y;
+                }
+
+                s.z1 = snapToZero (z1);
+                s.z2 = snapToZero (z2);
+            }
+        }
+
+        void envelopeFollowerMono (const float* input, float* envelope, int numSamples,
+                                   float attackCoefficient, float releaseCoefficient, float& state) noexcept
+        {
+            float level = state;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float squared = input[i] * input[i];
+                const float coefficient = squared > level ? attackCoefficient : releaseCoefficient;
+                level = coefficient * (level - squared) + squared;
+                envelope[i] = level;
+            }
+
+            state = level;
+        }
+    }
+
+    namespace
+    {
+        void applyGainScalar (float* data, int numSamples, float gain)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                data[i] *= gain;
+        }
+
+        void addWithGainScalar (float* destination, const float* source, int numSamples, float gain)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                destination[i] += source[i] * gain;
+        }
+
+        void biquadCascadeStereoScalar (float* left, float* right, int numSamples,
+                                        const BiquadCoefficients* stages, BiquadState* state, int numStages)
+        {
+            detail::biquadCascadeMono (left, numSamples, stages, state, numStages, 2);
+            if (right != nullptr)
+                detail::biquadCascadeMono (right, numSamples, stages, state + 1, numStages, 2);
+        }
+
+        void envelopeFollowerStereoScalar (const float* left, const float* right,
+                                           float* leftEnvelope, float* rightEnvelope, int numSamples,
+                                           float attackCoefficient, float releaseCoefficient, float* state)
+        {
+            detail::envelopeFollowerMono (left, leftEnvelope, numSamples, attackCoefficient, releaseCoefficient, state[0]);
+            if (right != nullptr)
+                detail::envelopeFollowerMono (right, rightEnvelope, numSamples, attackCoefficient, releaseCoefficient, state[1]);
+        }
+
+        float findPeakScalar (const float* data, int numSamples)
+        {
+            float peak = 0.0f;
+            for (int i = 0; i < numSamples; ++i)
+                peak = std::max (peak, std::abs (data[i]));
+            return peak;
+        }
+
+        double sumOfSquaresScalar (const float* data, int numSamples)
+        {
+            double sum = 0.0;
+            for (int i = 0; i < numSamples; ++i)
+                sum += static_cast<double> (data[i]) * static_cast<double> (data[i]);
+            return sum;
+        }
+
+        float oversampledPeakScalar (const float* window, int numOutputs)
+        {
+            float peak = 0.0f;
+
+            for (int n = 0; n < numOutputs; ++n)
+            {
+                float phases[truePeakPhases] = {};
+
+                for (int tap = 0; tap < truePeakTaps; ++tap)
+                {
+                    const float x = window[n + truePeakTaps - 1 - tap];
+                    for (int phase = 0; phase < truePeakPhases; ++phase)
+                        phases[phase] += truePeakCoefficients[tap][phase] * x;
+                }
+
+                for (auto value : phases)
+                    peak = std::max (peak, std::abs (value));
+            }
+
+            return peak;
+        }
+
+        const KernelTable scalarKernels {
+            InstructionSet::scalar,
+            "scalar",
+            applyGainScalar,
+            addWithGainScalar,
+            biquadCascadeStereoScalar,
+            envelopeFollowerStereoScalar,
+            findPeakScalar,
+            sumOfSquaresScalar,
+            oversampledPeakScalar
+        };
+
+        //==============================================================================
+        bool cpuSupports (InstructionSet instructionSet)
+        {
+            switch (instructionSet)
+            {
+                case InstructionSet::scalar:
+                    return true;
+
+                // Every 64-bit ARM CPU has NEON; the table only exists there
+                case InstructionSet::neon:
+                    return detail::getNeonKernels() != nullptr;
+
+                default:
+                    break;
+            }
+
+           #if (defined (__GNUC__) || defined (__clang__)) && (defined (__x86_64__) || defined (__i386__))
+            // Unlike a bare CPUID check, these also ask the OS (XGETBV) whether
+            // it saves the AVX and AVX-512 registers on a context switch
+            __builtin_cpu_init();
+
+            switch (instructionSet)
+            {
+                case InstructionSet::sse2:   return __builtin_cpu_supports ("sse2");
+                case InstructionSet::avx2:   return __builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma");
+                case InstructionSet::avx512: return __builtin_cpu_supports ("avx512f");
+                default:                     return false;
+            }
+           #else
+            switch (instructionSet)
+            {
+                case InstructionSet::sse2:   return juce::SystemStats::hasSSE2();
+                case InstructionSet::avx2:   return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3();
+                case InstructionSet::avx512: return juce::SystemStats::hasAVX512F();
+                default:                     return false;
+            }
+           #endif
+        }
+
+        const KernelTable& selectKernels()
+        {
+            const auto available = getAvailableKernels();
+            const KernelTable* selected = available.back();
+
+            // AURALIS_SIMD=scalar|sse2|neon|avx2|avx512 caps the choice, to
+            // reproduce a fault seen on an older machine
+            const auto requested = juce::SystemStats::getEnvironmentVariable ("AURALIS_SIMD", {}).trim().toLowerCase();
+            if (requested.isNotEmpty())
+            {
+                auto match = std::find_if (available.begin(), available.end(),
+                                           [&requested] (const KernelTable* table) { return requested == table->name; });
+
+                if (match != available.end())
+                    selected = *match;
+                else
+                    juce::Logger::writeToLog ("SimdKernels: AURALIS_SIMD=" + requested + " isn't available on this CPU");
+            }
+
+            juce::Logger::writeToLog ("SimdKernels: using the " + juce::String (selected->name) + " kernels");
+            return *selected;
+        }
+    }
+
+    //==============================================================================
+    const KernelTable& getKernels() noexcept
+    {
+        static const KernelTable& kernels = selectKernels();
+        return kernels;
+    }
+
+    const KernelTable& getScalarKernels() noexcept
+    {
+        return scalarKernels;
+    }
+
+    std::vector<const KernelTable*> getAvailableKernels()
+    {
+        std::vector<const KernelTable*> tables { &scalarKernels };
+
+        for (auto* table : { detail::getSse2Kernels(), detail::getNeonKernels(),
+                             detail::getAvx2Kernels(), detail::getAvx512Kernels() })
+        {
+            if (table != nullptr && cpuSupports (table->instructionSet))
+                tables.push_back (table);
+        }
+
+        return tables;
+    }
+
+    //==============================================================================
+    void TruePeakDetector::reset() noexcept
+    {
+        std::fill (std::begin (window), std::end (window), 0.0f);
+    }
+
+    float TruePeakDetector::process (const float* data, int numSamples) noexcept
+    {
+        const auto& kernels = getKernels();
+        float peak = 0.0f;
+
+        // The filter reads the previous samples too, so each chunk goes in
+        // after the tail of the one before
+        while (numSamples > 0)
+        {
+            const int numThisTime = std::min (numSamples, chunkSize);
+            std::memcpy (window + historySize, data, sizeof (float) * static_cast<size_t> (numThisTime));
+
+            peak = std::max (peak, kernels.oversampledPeak (window, numThisTime));
+
+            std::memmove (window, window + numThisTime, sizeof (float) * historySize);
+            data += numThisTime;
+            numSamples -= numThisTime;
+        }
+
+        return peak;
+    }
+}
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+/*
+ * SimdKernels - The inner loops of the mixer's DSP, once per instruction set
+ *
+ * One binary runs on an old FOH laptop and on a new workstation: every kernel
+ * is built for plain C++, SSE2 or NEON, AVX2 and AVX-512, and getKernels()
+ * picks the best table this CPU can run the first time it is called. The
+ * AVX2 and AVX-512 kernels live in their own translation units and are
+ * compiled with function target attributes rather than -mavx2, so nothing
+ * else in the binary can pick up instructions the CPU might not have. For
+ * the same reason this header, which those units include, stays free of JUCE.
+ *
+ * Every table computes the same results as the scalar one up to float
+ * rounding (summation order, fused multiply-adds); the kernel tests hold each
+ * table the CPU supports against it.
+ */
+
+namespace auralis
+{
+namespace simd
+{
+    enum class InstructionSet
+    {
+        scalar,
+        sse2,
+        neon,
+        avx2,
+        avx512
+    };
+
+    /** One second-order section, normalised so that a0 = 1. */
+    struct BiquadCoefficients
+    {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+    };
+
+    /** From juce::dsp::IIR::ArrayCoefficients' {b0, b1, b2, a0, a1, a2}, normalised as juce::dsp::IIR does. */
+    inline BiquadCoefficients makeBiquad (const std::array<float, 6>& c) noexcept
+    {
+        const float a0Inverse = 1.0f / c[3];
+        return { c[0] * a0Inverse, c[1] * a0Inverse, c[2] * a0Inverse, c[4] * a0Inverse, c[5] * a0Inverse };
+    }
+
+    /** Transposed direct form II state of one section on one channel. */
+    struct BiquadState
+    {
+        float z1 = 0.0f, z2 = 0.0f;
+    };
+
+    /**
+     * BS.1770-4 Annex 2 true-peak interpolation: 4x oversampling by a 48-tap
+     * FIR, as four 12-tap phases. Stored tap by tap, one phase per column, so
+     * one vector multiply-add advances all four phases.
+     */
+    constexpr int truePeakTaps = 12;
+    constexpr int truePeakPhases = 4;
+
+    alignas (16) inline constexpr float truePeakCoefficients[truePeakTaps][truePeakPhases] = {
+        {  0.0017089843750f, -0.0291748046875f, -0.0189208984375f, -0.0083007812500f },
+        {  0.0109863281250f,  0.0292968750000f,  0.0330810546875f,  0.0148925781250f },
+        { -0.0196533203125f, -0.0517578125000f, -0.0582275390625f, -0.0266113281250f },
+        {  0.0332031250000f,  0.0891113281250f,  0.1015625000000f,  0.0476074218750f },
+        { -0.0594482421875f, -0.1665039062500f, -0.2003173828125f, -0.1022949218750f },
+        {  0.1373291015625f,  0.4650878906250f,  0.7797851562500f,  0.9721679687500f },
+        {  0.9721679687500f,  0.7797851562500f,  0.4650878906250f,  0.1373291015625f },
+        { -0.1022949218750f, -0.2003173828125f, -0.1665039062500f, -0.0594482421875f },
+        {  0.0476074218750f,  0.1015625000000f,  0.0891113281250f,  0.0332031250000f },
+        { -0.0266113281250f, -0.0582275390625f, -0.0517578125000f, -0.0196533203125f },
+        {  0.0148925781250f,  0.0330810546875f,  0.0292968750000f,  0.0109863281250f },
+        { -0.0083007812500f, -0.0189208984375f, -0.0291748046875f,  0.0017089843750f }
+    };
+
+    /**
+     * The kernels of one instruction set. The stereo kernels run the two
+     * channels side by side in one vector; pass nullptr for the right channel
+     * of a mono signal.
+     */
+    struct KernelTable
+    {
+        InstructionSet instructionSet;
+        const char* name;
+
+        /** data[i] *= gain */
+        void (*applyGain) (float* data, int numSamples, float gain);
+
+        /** destination[i] += source[i] * gain */
+        void (*addWithGain) (float* destination, const float* source, int numSamples, float gain);
+
+        /** A cascade of numStages sections, one after the other; state holds [numStages][2 channels]. */
+        void (*biquadCascadeStereo) (float* left, float* right, int numSamples,
+                                     const BiquadCoefficients* stages, BiquadState* state, int numStages);
+
+        /**
+         * Mean-square envelope of each channel: envelope += (1 - c) * (x^2 - envelope),
+         * with the attack coefficient while x^2 is above the envelope and the
+         * release coefficient otherwise. state holds the two envelopes.
+         */
+        void (*envelopeFollowerStereo) (const float* left, const float* right,
+                                        float* leftEnvelope, float* rightEnvelope, int numSamples,
+                                        float attackCoefficient, float releaseCoefficient, float* state);
+
+        /** Largest absolute sample. */
+        float (*findPeak) (const float* data, int numSamples);
+
+        /** Sum of the squared samples, accumulated in double. */
+        double (*sumOfSquares) (const float* data, int numSamples);
+
+        /**
+         * Largest absolute value of the 4x oversampled signal, for numOutputs
+         * input samples. window holds the truePeakTaps - 1 samples before the
+         * first of them, then the numOutputs samples themselves.
+         */
+        float (*oversampledPeak) (const float* window, int numOutputs);
+    };
+
+    /** The fastest table this CPU supports, chosen from CPUID on the first call. */
+    const KernelTable& getKernels() noexcept;
+
+    /** The plain C++ reference the other tables are tested against. */
+    const KernelTable& getScalarKernels() noexcept;
+
+    /** Every table this CPU can run, scalar first, for the tests and benchmarks. */
+    std::vector<const KernelTable*> getAvailableKernels();
+
+    /**
+     * Running true peak of one channel across blocks: keeps the oversampling
+     * filter's history between calls. Allocation-free, so it can run on the
+     * audio thread.
+     */
+    class TruePeakDetector
+    {
+    public:
+        void reset() noexcept;
+
+        /** Feeds a block and returns its true peak (linear). */
+        float process (const float* data, int numSamples) noexcept;
+
+    private:
+        static constexpr int chunkSize = 256;
+        static constexpr int historySize = truePeakTaps - 1;
+
+        float window[historySize + chunkSize] = {};
+    };
+
+    namespace detail
+    {
+        // Each returns nullptr when its instruction set isn't built for this
+        // architecture; whether the CPU can run it is getKernels()'s call
+        const KernelTable* getSse2Kernels() noexcept;
+        const KernelTable* getNeonKernels() noexcept;
+        const KernelTable* getAvx2Kernels() noexcept;
+        const KernelTable* getAvx512Kernels() noexcept;
+
+        // Scalar kernels the vector ones fall back on for a mono signal
+        void biquadCascadeMono (float* data, int numSamples, const BiquadCoefficients* stages,
+                                BiquadState* state, int numStages, int stateStride) noexcept;
+        void envelopeFollowerMono (const float* input, float* envelope, int numSamples,
+                                   float attackCoefficient, float releaseCoefficient, float& state) noexcept;
+
+        /** Flushes a filter state that has decayed into the denormal range, as juce::dsp::IIR does. */
+        inline float snapToZero (float value) noexcept
+        {
+            return (value < -1.0e-8f || value > 1.0e-8f) ? value : 0.0f;
+        }
+    }
+}
+}
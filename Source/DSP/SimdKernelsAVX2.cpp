@@ -0,0 +1,249 @@
+#include "SimdKernels.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined (__x86_64__) || defined (_M_X64) || defined (__i386__) || defined (_M_IX86)
+ #define AURALIS_SIMD_AVX2 1
+ #include <immintrin.h>
+
+ // Only the functions below are built for AVX2; the rest of the binary keeps
+ // the baseline flags and never sees these instructions
+ #if defined (__GNUC__) || defined (__clang__)
+  #define AURALIS_AVX2_TARGET __attribute__ ((target ("avx2,fma")))
+ #else
+  #define AURALIS_AVX2_TARGET
+ #endif
+#endif
+
+/*
+ * AVX2 + FMA: eight samples per vector for the straight-line kernels, two
+ * output samples (eight phases) per vector for the true-peak filter. The
+ * recursive biquad and envelope kernels stay two channels wide and gain
+ * from the fused multiply-adds, which shorten the per-sample dependency chain.
+ */
+
+namespace auralis
+{
+namespace simd
+{
+#if AURALIS_SIMD_AVX2
+    namespace
+    {
+        AURALIS_AVX2_TARGET inline float horizontalMax (__m256 v)
+        {
+            __m128 m = _mm_max_ps (_mm256_castps256_ps128 (v), _mm256_extractf128_ps (v, 1));
+            m = _mm_max_ps (m, _mm_movehl_ps (m, m));
+            m = _mm_max_ps (m, _mm_shuffle_ps (m, m, _MM_SHUFFLE (1, 1, 1, 1)));
+            return _mm_cvtss_f32 (m);
+        }
+
+        AURALIS_AVX2_TARGET inline __m256 absolute (__m256 v)
+        {
+            return _mm256_andnot_ps (_mm256_set1_ps (-0.0f), v);
+        }
+
+        AURALIS_AVX2_TARGET inline __m128 loadPair (const float* left, const float* right, int i)
+        {
+            return _mm_unpacklo_ps (_mm_load_ss (left + i), _mm_load_ss (right + i));
+        }
+
+        AURALIS_AVX2_TARGET inline void storePair (__m128 v, float* left, float* right, int i)
+        {
+            _mm_store_ss (left + i, v);
+            _mm_store_ss (right + i, _mm_shuffle_ps (v, v, _MM_SHUFFLE (1, 1, 1, 1)));
+        }
+
+        AURALIS_AVX2_TARGET void applyGainAvx2 (float* data, int numSamples, float gain)
+        {
+            const __m256 g = _mm256_set1_ps (gain);
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+                _mm256_storeu_ps (data + i, _mm256_mul_ps (_mm256_loadu_ps (data + i), g));
+
+            for (; i < numSamples; ++i)
+                data[i] *= gain;
+        }
+
+        AURALIS_AVX2_TARGET void addWithGainAvx2 (float* destination, const float* source, int numSamples, float gain)
+        {
+            const __m256 g = _mm256_set1_ps (gain);
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+                _mm256_storeu_ps (destination + i, _mm256_fmadd_ps (_mm256_loadu_ps (source + i), g, _mm256_loadu_ps (destination + i)));
+
+            for (; i < numSamples; ++i)
+                destination[i] += source[i] * gain;
+        }
+
+        AURALIS_AVX2_TARGET void biquadCascadeStereoAvx2 (float* left, float* right, int numSamples,
+                                                          const BiquadCoefficients* stages, BiquadState* state, int numStages)
+        {
+            if (right == nullptr)
+            {
+                detail::biquadCascadeMono (left, numSamples, stages, state, numStages, 2);
+                return;
+            }
+
+            for (int stage = 0; stage < numStages; ++stage)
+            {
+                const auto& c = stages[stage];
+                const __m128 b0 = _mm_set1_ps (c.b0), b1 = _mm_set1_ps (c.b1), b2 = _mm_set1_ps (c.b2);
+                const __m128 a1 = _mm_set1_ps (c.a1), a2 = _mm_set1_ps (c.a2);
+
+                auto& leftState = state[stage * 2];
+                auto& rightState = state[stage * 2 + 1];
+                __m128 z1 = _mm_setr_ps (leftState.z1, rightState.z1, 0.0f, 0.0f);
+                __m128 z2 = _mm_setr_ps (leftState.z2, rightState.z2, 0.0f, 0.0f);
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const __m128 x = loadPair (left, right, i);
+                    const __m128 y = _mm_fmadd_ps (b0, x, z1);
+                    z1 = _mm_fnmadd_ps (a1, y, _mm_fmadd_ps (b1, x, z2));
+                    z2 = _mm_fnmadd_ps (a2, y, _mm_mul_ps (b2, x));
+                    storePair (y, left, right, i);
+                }
+
+                alignas (16) float z1Lanes[4], z2Lanes[4];
+                _mm_store_ps (z1Lanes, z1);
+                _mm_store_ps (z2Lanes, z2);
+                leftState = { detail::snapToZero (z1Lanes[0]), detail::snapToZero (z2Lanes[0]) };
+                rightState = { detail::snapToZero (z1Lanes[1]), detail::snapToZero (z2Lanes[1]) };
+            }
+        }
+
+        AURALIS_AVX2_TARGET void envelopeFollowerStereoAvx2 (const float* left, const float* right,
+                                                             float* leftEnvelope, float* rightEnvelope, int numSamples,
+                                                             float attackCoefficient, float releaseCoefficient, float* state)
+        {
+            if (right == nullptr)
+            {
+                detail::envelopeFollowerMono (left, leftEnvelope, numSamples, attackCoefficient, releaseCoefficient, state[0]);
+                return;
+            }
+
+            const __m128 attack = _mm_set1_ps (attackCoefficient);
+            const __m128 release = _mm_set1_ps (releaseCoefficient);
+            __m128 level = _mm_setr_ps (state[0], state[1], 0.0f, 0.0f);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const __m128 x = loadPair (left, right, i);
+                const __m128 squared = _mm_mul_ps (x, x);
+                const __m128 coefficient = _mm_blendv_ps (release, attack, _mm_cmpgt_ps (squared, level));
+                level = _mm_fmadd_ps (coefficient, _mm_sub_ps (level, squared), squared);
+                storePair (level, leftEnvelope, rightEnvelope, i);
+            }
+
+            alignas (16) float lanes[4];
+            _mm_store_ps (lanes, level);
+            state[0] = lanes[0];
+            state[1] = lanes[1];
+        }
+
+        AURALIS_AVX2_TARGET float findPeakAvx2 (const float* data, int numSamples)
+        {
+            __m256 peak = _mm256_setzero_ps();
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+                peak = _mm256_max_ps (peak, absolute (_mm256_loadu_ps (data + i)));
+
+            float result = horizontalMax (peak);
+            for (; i < numSamples; ++i)
+                result = std::max (result, std::abs (data[i]));
+
+            return result;
+        }
+
+        AURALIS_AVX2_TARGET double sumOfSquaresAvx2 (const float* data, int numSamples)
+        {
+            __m256d low = _mm256_setzero_pd(), high = _mm256_setzero_pd();
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+            {
+                const __m256d x0 = _mm256_cvtps_pd (_mm_loadu_ps (data + i));
+                const __m256d x1 = _mm256_cvtps_pd (_mm_loadu_ps (data + i + 4));
+                low = _mm256_fmadd_pd (x0, x0, low);
+                high = _mm256_fmadd_pd (x1, x1, high);
+            }
+
+            alignas (32) double lanes[4];
+            _mm256_store_pd (lanes, _mm256_add_pd (low, high));
+            double sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+            for (; i < numSamples; ++i)
+                sum += static_cast<double> (data[i]) * static_cast<double> (data[i]);
+
+            return sum;
+        }
+
+        AURALIS_AVX2_TARGET float oversampledPeakAvx2 (const float* window, int numOutputs)
+        {
+            // Each tap's four phases twice over: output n in the low half, n + 1 in the high half
+            __m256 coefficients[truePeakTaps];
+            for (int tap = 0; tap < truePeakTaps; ++tap)
+                coefficients[tap] = _mm256_broadcast_ps (reinterpret_cast<const __m128*> (truePeakCoefficients[tap]));
+
+            __m256 peak = _mm256_setzero_ps();
+            int n = 0;
+
+            for (; n + 2 <= numOutputs; n += 2)
+            {
+                __m256 phases = _mm256_setzero_ps();
+                for (int tap = 0; tap < truePeakTaps; ++tap)
+                {
+                    const float* x = window + n + truePeakTaps - 1 - tap;
+                    const __m256 samples = _mm256_insertf128_ps (_mm256_castps128_ps256 (_mm_set1_ps (x[0])), _mm_set1_ps (x[1]), 1);
+                    phases = _mm256_fmadd_ps (coefficients[tap], samples, phases);
+                }
+
+                peak = _mm256_max_ps (peak, absolute (phases));
+            }
+
+            // An odd last output: its four phases in the low half only
+            if (n < numOutputs)
+            {
+                __m256 phases = _mm256_setzero_ps();
+                for (int tap = 0; tap < truePeakTaps; ++tap)
+                {
+                    const __m256 samples = _mm256_insertf128_ps (_mm256_set1_ps (window[n + truePeakTaps - 1 - tap]), _mm_setzero_ps(), 1);
+                    phases = _mm256_fmadd_ps (coefficients[tap], samples, phases);
+                }
+
+                peak = _mm256_max_ps (peak, absolute (phases));
+            }
+
+            return horizontalMax (peak);
+        }
+
+        const KernelTable avx2Kernels {
+            InstructionSet::avx2,
+            "avx2",
+            applyGainAvx2,
+            addWithGainAvx2,
+            biquadCascadeStereoAvx2,
+            envelopeFollowerStereoAvx2,
+            findPeakAvx2,
+            sumOfSquaresAvx2,
+            oversampledPeakAvx2
+        };
+    }
+#endif
+
+    namespace detail
+    {
+        const KernelTable* getAvx2Kernels() noexcept
+        {
+           #if AURALIS_SIMD_AVX2
+            return &avx2Kernels;
+           #else
+            return nullptr;
+           #endif
+        }
+    }
+}
+}
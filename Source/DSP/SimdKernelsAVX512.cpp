@@ -0,0 +1,205 @@
+#include "SimdKernels.h"
+
+#if defined (__x86_64__) || defined (_M_X64)
+ #define AURALIS_SIMD_AVX512 1
+ #include <immintrin.h>
+
+ // As with AVX2, only these functions are built for AVX-512
+ #if defined (__GNUC__) || defined (__clang__)
+  #define AURALIS_AVX512_TARGET __attribute__ ((target ("avx512f,avx2,fma")))
+ #else
+  #define AURALIS_AVX512_TARGET
+ #endif
+#endif
+
+/*
+ * AVX-512F: sixteen samples per vector, with masked loads and stores for the
+ * end of a block instead of a scalar tail, and four output samples per
+ * vector for the true-peak filter. The recursive biquad and envelope kernels
+ * are only ever two channels wide, so this table keeps the AVX2 ones.
+ */
+
+namespace auralis
+{
+namespace simd
+{
+#if AURALIS_SIMD_AVX512
+    namespace
+    {
+        AURALIS_AVX512_TARGET inline __mmask16 tailMask (int numLeft)
+        {
+            return static_cast<__mmask16> ((1u << numLeft) - 1u);
+        }
+
+        // GCC 12's unmasked forms of these fill their unused source with
+        // _mm512_undefined_*(), which -Wall reports as uninitialised. These
+        // helpers use the zero-masked forms with every lane set instead.
+        constexpr __mmask16 allLanes = 0xffff;
+
+        AURALIS_AVX512_TARGET inline __m512 maximum (__m512 a, __m512 b)
+        {
+            return _mm512_maskz_max_ps (allLanes, a, b);
+        }
+
+        AURALIS_AVX512_TARGET inline __m512 absolute (__m512 v)
+        {
+            return _mm512_mask_abs_ps (v, allLanes, v);
+        }
+
+        AURALIS_AVX512_TARGET inline __m512d widen (__m256 v)
+        {
+            return _mm512_maskz_cvtps_pd (static_cast<__mmask8> (allLanes), v);
+        }
+
+        AURALIS_AVX512_TARGET inline float horizontalMax (__m512 v)
+        {
+            const __m512d d = _mm512_castps_pd (v);
+            const __m256 m8 = _mm256_max_ps (_mm256_castpd_ps (_mm512_maskz_extractf64x4_pd (0xf, d, 0)),
+                                             _mm256_castpd_ps (_mm512_maskz_extractf64x4_pd (0xf, d, 1)));
+            __m128 m = _mm_max_ps (_mm256_castps256_ps128 (m8), _mm256_extractf128_ps (m8, 1));
+            m = _mm_max_ps (m, _mm_movehl_ps (m, m));
+            m = _mm_max_ps (m, _mm_shuffle_ps (m, m, _MM_SHUFFLE (1, 1, 1, 1)));
+            return _mm_cvtss_f32 (m);
+        }
+
+        AURALIS_AVX512_TARGET inline double horizontalSum (__m512d v)
+        {
+            const __m256d s4 = _mm256_add_pd (_mm512_maskz_extractf64x4_pd (0xf, v, 0), _mm512_maskz_extractf64x4_pd (0xf, v, 1));
+            __m128d s = _mm_add_pd (_mm256_castpd256_pd128 (s4), _mm256_extractf128_pd (s4, 1));
+            s = _mm_add_sd (s, _mm_unpackhi_pd (s, s));
+            return _mm_cvtsd_f64 (s);
+        }
+
+        AURALIS_AVX512_TARGET void applyGainAvx512 (float* data, int numSamples, float gain)
+        {
+            const __m512 g = _mm512_set1_ps (gain);
+            int i = 0;
+
+            for (; i + 16 <= numSamples; i += 16)
+                _mm512_storeu_ps (data + i, _mm512_mul_ps (_mm512_loadu_ps (data + i), g));
+
+            if (i < numSamples)
+            {
+                const auto mask = tailMask (numSamples - i);
+                _mm512_mask_storeu_ps (data + i, mask, _mm512_mul_ps (_mm512_maskz_loadu_ps (mask, data + i), g));
+            }
+        }
+
+        AURALIS_AVX512_TARGET void addWithGainAvx512 (float* destination, const float* source, int numSamples, float gain)
+        {
+            const __m512 g = _mm512_set1_ps (gain);
+            int i = 0;
+
+            for (; i + 16 <= numSamples; i += 16)
+                _mm512_storeu_ps (destination + i, _mm512_fmadd_ps (_mm512_loadu_ps (source + i), g, _mm512_loadu_ps (destination + i)));
+
+            if (i < numSamples)
+            {
+                const auto mask = tailMask (numSamples - i);
+                const __m512 sum = _mm512_fmadd_ps (_mm512_maskz_loadu_ps (mask, source + i), g, _mm512_maskz_loadu_ps (mask, destination + i));
+                _mm512_mask_storeu_ps (destination + i, mask, sum);
+            }
+        }
+
+        AURALIS_AVX512_TARGET float findPeakAvx512 (const float* data, int numSamples)
+        {
+            __m512 peak = _mm512_setzero_ps();
+            int i = 0;
+
+            for (; i + 16 <= numSamples; i += 16)
+                peak = maximum (peak, absolute (_mm512_loadu_ps (data + i)));
+
+            // Masked-off lanes load as zero, which never wins
+            if (i < numSamples)
+                peak = maximum (peak, absolute (_mm512_maskz_loadu_ps (tailMask (numSamples - i), data + i)));
+
+            return horizontalMax (peak);
+        }
+
+        AURALIS_AVX512_TARGET double sumOfSquaresAvx512 (const float* data, int numSamples)
+        {
+            __m512d low = _mm512_setzero_pd(), high = _mm512_setzero_pd();
+            int i = 0;
+
+            for (; i + 16 <= numSamples; i += 16)
+            {
+                const __m512d x0 = widen (_mm256_loadu_ps (data + i));
+                const __m512d x1 = widen (_mm256_loadu_ps (data + i + 8));
+                low = _mm512_fmadd_pd (x0, x0, low);
+                high = _mm512_fmadd_pd (x1, x1, high);
+            }
+
+            double sum = horizontalSum (_mm512_add_pd (low, high));
+
+            for (; i < numSamples; ++i)
+                sum += static_cast<double> (data[i]) * static_cast<double> (data[i]);
+
+            return sum;
+        }
+
+        AURALIS_AVX512_TARGET float oversampledPeakAvx512 (const float* window, int numOutputs)
+        {
+            // Each tap's four phases four times over, one output sample per 128-bit lane
+            __m512 coefficients[truePeakTaps];
+            for (int tap = 0; tap < truePeakTaps; ++tap)
+                coefficients[tap] = _mm512_maskz_broadcast_f32x4 (allLanes, _mm_load_ps (truePeakCoefficients[tap]));
+
+            // Spreads four consecutive samples over the lanes: x0 x0 x0 x0 x1 x1 x1 x1 ...
+            const __m512i spread = _mm512_setr_epi32 (0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+
+            __m512 peak = _mm512_setzero_ps();
+            int n = 0;
+
+            for (; n + 4 <= numOutputs; n += 4)
+            {
+                __m512 phases = _mm512_setzero_ps();
+                for (int tap = 0; tap < truePeakTaps; ++tap)
+                {
+                    const __m128 x = _mm_loadu_ps (window + n + truePeakTaps - 1 - tap);
+                    phases = _mm512_fmadd_ps (coefficients[tap], _mm512_maskz_permutexvar_ps (allLanes, spread, _mm512_zextps128_ps512 (x)), phases);
+                }
+
+                peak = maximum (peak, absolute (phases));
+            }
+
+            float result = horizontalMax (peak);
+
+            // The last few outputs go through the AVX2 kernel
+            if (n < numOutputs)
+            {
+                const float rest = detail::getAvx2Kernels()->oversampledPeak (window + n, numOutputs - n);
+                result = result > rest ? result : rest;
+            }
+
+            return result;
+        }
+
+        KernelTable makeAvx512Kernels()
+        {
+            auto table = *detail::getAvx2Kernels();
+            table.instructionSet = InstructionSet::avx512;
+            table.name = "avx512";
+            table.applyGain = applyGainAvx512;
+            table.addWithGain = addWithGainAvx512;
+            table.findPeak = findPeakAvx512;
+            table.sumOfSquares = sumOfSquaresAvx512;
+            table.oversampledPeak = oversampledPeakAvx512;
+            return table;
+        }
+    }
+#endif
+
+    namespace detail
+    {
+        const KernelTable* getAvx512Kernels() noexcept
+        {
+           #if AURALIS_SIMD_AVX512
+            static const KernelTable avx512Kernels = makeAvx512Kernels();
+            return &avx512Kernels;
+           #else
+            return nullptr;
+           #endif
+        }
+    }
+}
+}
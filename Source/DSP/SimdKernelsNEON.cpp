@@ -0,0 +1,199 @@
+#include "SimdKernels.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined (__aarch64__) || defined (_M_ARM64)
+ #define AURALIS_SIMD_NEON 1
+ #include <arm_neon.h>
+#endif
+
+/*
+ * NEON on 64-bit ARM, where it is always present, so built with the default
+ * flags. A two-lane vector holds exactly one stereo sample for the biquad and
+ * envelope kernels.
+ */
+
+namespace auralis
+{
+namespace simd
+{
+#if AURALIS_SIMD_NEON
+    namespace
+    {
+        inline float32x2_t loadPair (const float* left, const float* right, int i)
+        {
+            return vset_lane_f32 (right[i], vdup_n_f32 (left[i]), 1);
+        }
+
+        inline void storePair (float32x2_t v, float* left, float* right, int i)
+        {
+            left[i] = vget_lane_f32 (v, 0);
+            right[i] = vget_lane_f32 (v, 1);
+        }
+
+        void applyGainNeon (float* data, int numSamples, float gain)
+        {
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+                vst1q_f32 (data + i, vmulq_n_f32 (vld1q_f32 (data + i), gain));
+
+            for (; i < numSamples; ++i)
+                data[i] *= gain;
+        }
+
+        void addWithGainNeon (float* destination, const float* source, int numSamples, float gain)
+        {
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+                vst1q_f32 (destination + i, vfmaq_n_f32 (vld1q_f32 (destination + i), vld1q_f32 (source + i), gain));
+
+            for (; i < numSamples; ++i)
+                destination[i] += source[i] * gain;
+        }
+
+        void biquadCascadeStereoNeon (float* left, float* right, int numSamples,
+                                      const BiquadCoefficients* stages, BiquadState* state, int numStages)
+        {
+            if (right == nullptr)
+            {
+                detail::biquadCascadeMono (left, numSamples, stages, state, numStages, 2);
+                return;
+            }
+
+            for (int stage = 0; stage < numStages; ++stage)
+            {
+                const auto& c = stages[stage];
+                const float32x2_t b0 = vdup_n_f32 (c.b0), b1 = vdup_n_f32 (c.b1), b2 = vdup_n_f32 (c.b2);
+                const float32x2_t a1 = vdup_n_f32 (c.a1), a2 = vdup_n_f32 (c.a2);
+
+                auto& leftState = state[stage * 2];
+                auto& rightState = state[stage * 2 + 1];
+                float32x2_t z1 = vset_lane_f32 (rightState.z1, vdup_n_f32 (leftState.z1), 1);
+                float32x2_t z2 = vset_lane_f32 (rightState.z2, vdup_n_f32 (leftState.z2), 1);
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const float32x2_t x = loadPair (left, right, i);
+                    const float32x2_t y = vfma_f32 (z1, b0, x);
+                    z1 = vfms_f32 (vfma_f32 (z2, b1, x), a1, y);
+                    z2 = vfms_f32 (vmul_f32 (b2, x), a2, y);
+                    storePair (y, left, right, i);
+                }
+
+                leftState = { detail::snapToZero (vget_lane_f32 (z1, 0)), detail::snapToZero (vget_lane_f32 (z2, 0)) };
+                rightState = { detail::snapToZero (vget_lane_f32 (z1, 1)), detail::snapToZero (vget_lane_f32 (z2, 1)) };
+            }
+        }
+
+        void envelopeFollowerStereoNeon (const float* left, const float* right,
+                                         float* leftEnvelope, float* rightEnvelope, int numSamples,
+                                         float attackCoefficient, float releaseCoefficient, float* state)
+        {
+            if (right == nullptr)
+            {
+                detail::envelopeFollowerMono (left, leftEnvelope, numSamples, attackCoefficient, releaseCoefficient, state[0]);
+                return;
+            }
+
+            const float32x2_t attack = vdup_n_f32 (attackCoefficient);
+            const float32x2_t release = vdup_n_f32 (releaseCoefficient);
+            float32x2_t level = vld1_f32 (state);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float32x2_t x = loadPair (left, right, i);
+                const float32x2_t squared = vmul_f32 (x, x);
+                const float32x2_t coefficient = vbsl_f32 (vcgt_f32 (squared, level), attack, release);
+                level = vfma_f32 (squared, coefficient, vsub_f32 (level, squared));
+                storePair (level, leftEnvelope, rightEnvelope, i);
+            }
+
+            vst1_f32 (state, level);
+        }
+
+        float findPeakNeon (const float* data, int numSamples)
+        {
+            float32x4_t peak = vdupq_n_f32 (0.0f);
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+                peak = vmaxq_f32 (peak, vabsq_f32 (vld1q_f32 (data + i)));
+
+            float result = vmaxvq_f32 (peak);
+            for (; i < numSamples; ++i)
+                result = std::max (result, std::abs (data[i]));
+
+            return result;
+        }
+
+        double sumOfSquaresNeon (const float* data, int numSamples)
+        {
+            float64x2_t low = vdupq_n_f64 (0.0), high = vdupq_n_f64 (0.0);
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+            {
+                const float32x4_t x = vld1q_f32 (data + i);
+                const float64x2_t x01 = vcvt_f64_f32 (vget_low_f32 (x));
+                const float64x2_t x23 = vcvt_high_f64_f32 (x);
+                low = vfmaq_f64 (low, x01, x01);
+                high = vfmaq_f64 (high, x23, x23);
+            }
+
+            double sum = vaddvq_f64 (vaddq_f64 (low, high));
+
+            for (; i < numSamples; ++i)
+                sum += static_cast<double> (data[i]) * static_cast<double> (data[i]);
+
+            return sum;
+        }
+
+        float oversampledPeakNeon (const float* window, int numOutputs)
+        {
+            float32x4_t coefficients[truePeakTaps];
+            for (int tap = 0; tap < truePeakTaps; ++tap)
+                coefficients[tap] = vld1q_f32 (truePeakCoefficients[tap]);
+
+            float32x4_t peak = vdupq_n_f32 (0.0f);
+
+            for (int n = 0; n < numOutputs; ++n)
+            {
+                float32x4_t phases = vdupq_n_f32 (0.0f);
+                for (int tap = 0; tap < truePeakTaps; ++tap)
+                    phases = vfmaq_n_f32 (phases, coefficients[tap], window[n + truePeakTaps - 1 - tap]);
+
+                peak = vmaxq_f32 (peak, vabsq_f32 (phases));
+            }
+
+            return vmaxvq_f32 (peak);
+        }
+
+        const KernelTable neonKernels {
+            InstructionSet::neon,
+            "neon",
+            applyGainNeon,
+            addWithGainNeon,
+            biquadCascadeStereoNeon,
+            envelopeFollowerStereoNeon,
+            findPeakNeon,
+            sumOfSquaresNeon,
+            oversampledPeakNeon
+        };
+    }
+#endif
+
+    namespace detail
+    {
+        const KernelTable* getNeonKernels() noexcept
+        {
+           #if AURALIS_SIMD_NEON
+            return &neonKernels;
+           #else
+            return nullptr;
+           #endif
+        }
+    }
+}
+}
@@ -0,0 +1,228 @@
+#include "SimdKernels.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define AURALIS_SIMD_SSE2 1
+ #include <emmintrin.h>
+#endif
+
+/*
+ * SSE2: the baseline of every x86-64 CPU, so built with the default flags.
+ * The biquad and envelope kernels do exactly the scalar operations, two
+ * channels to a vector, so a default build matches the scalar table bit for
+ * bit.
+ */
+
+namespace auralis
+{
+namespace simd
+{
+#if AURALIS_SIMD_SSE2
+    namespace
+    {
+        inline float horizontalMax (__m128 v)
+        {
+            v = _mm_max_ps (v, _mm_movehl_ps (v, v));
+            v = _mm_max_ps (v, _mm_shuffle_ps (v, v, _MM_SHUFFLE (1, 1, 1, 1)));
+            return _mm_cvtss_f32 (v);
+        }
+
+        inline __m128 absolute (__m128 v)
+        {
+            return _mm_andnot_ps (_mm_set1_ps (-0.0f), v);
+        }
+
+        /** [left, right, 0, 0] */
+        inline __m128 loadPair (const float* left, const float* right, int i)
+        {
+            return _mm_unpacklo_ps (_mm_load_ss (left + i), _mm_load_ss (right + i));
+        }
+
+        inline void storePair (__m128 v, float* left, float* right, int i)
+        {
+            _mm_store_ss (left + i, v);
+            _mm_store_ss (right + i, _mm_shuffle_ps (v, v, _MM_SHUFFLE (1, 1, 1, 1)));
+        }
+
+        void applyGainSse2 (float* data, int numSamples, float gain)
+        {
+            const __m128 g = _mm_set1_ps (gain);
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+                _mm_storeu_ps (data + i, _mm_mul_ps (_mm_loadu_ps (data + i), g));
+
+            for (; i < numSamples; ++i)
+                data[i] *= gain;
+        }
+
+        void addWithGainSse2 (float* destination, const float* source, int numSamples, float gain)
+        {
+            const __m128 g = _mm_set1_ps (gain);
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+            {
+                const __m128 sum = _mm_add_ps (_mm_loadu_ps (destination + i), _mm_mul_ps (_mm_loadu_ps (source + i), g));
+                _mm_storeu_ps (destination + i, sum);
+            }
+
+            for (; i < numSamples; ++i)
+                destination[i] += source[i] * gain;
+        }
+
+        void biquadCascadeStereoSse2 (float* left, float* right, int numSamples,
+                                      const BiquadCoefficients* stages, BiquadState* state, int numStages)
+        {
+            if (right == nullptr)
+            {
+                detail::biquadCascadeMono (left, numSamples, stages, state, numStages, 2);
+                return;
+            }
+
+            for (int stage = 0; stage < numStages; ++stage)
+            {
+                const auto& c = stages[stage];
+                const __m128 b0 = _mm_set1_ps (c.b0), b1 = _mm_set1_ps (c.b1), b2 = _mm_set1_ps (c.b2);
+                const __m128 a1 = _mm_set1_ps (c.a1), a2 = _mm_set1_ps (c.a2);
+
+                auto& leftState = state[stage * 2];
+                auto& rightState = state[stage * 2 + 1];
+                __m128 z1 = _mm_setr_ps (leftState.z1, rightState.z1, 0.0f, 0.0f);
+                __m128 z2 = _mm_setr_ps (leftState.z2, rightState.z2, 0.0f, 0.0f);
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const __m128 x = loadPair (left, right, i);
+                    const __m128 y = _mm_add_ps (_mm_mul_ps (b0, x), z1);
+                    z1 = _mm_add_ps (_mm_sub_ps (_mm_mul_ps (b1, x), _mm_mul_ps (a1, y)), z2);
+                    z2 = _mm_sub_ps (_mm_mul_ps (b2, x), _mm_mul_ps (a2, y));
+                    storePair (y, left, right, i);
+                }
+
+                alignas (16) float z1Lanes[4], z2Lanes[4];
+                _mm_store_ps (z1Lanes, z1);
+                _mm_store_ps (z2Lanes, z2);
+                leftState = { detail::snapToZero (z1Lanes[0]), detail::snapToZero (z2Lanes[0]) };
+                rightState = { detail::snapToZero (z1Lanes[1]), detail::snapToZero (z2Lanes[1]) };
+            }
+        }
+
+        void envelopeFollowerStereoSse2 (const float* left, const float* right,
+                                         float* leftEnvelope, float* rightEnvelope, int numSamples,
+                                         float attackCoefficient, float releaseCoefficient, float* state)
+        {
+            if (right == nullptr)
+            {
+                detail::envelopeFollowerMono (left, leftEnvelope, numSamples, attackCoefficient, releaseCoefficient, state[0]);
+                return;
+            }
+
+            const __m128 attack = _mm_set1_ps (attackCoefficient);
+            const __m128 release = _mm_set1_ps (releaseCoefficient);
+            __m128 level = _mm_setr_ps (state[0], state[1], 0.0f, 0.0f);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const __m128 x = loadPair (left, right, i);
+                const __m128 squared = _mm_mul_ps (x, x);
+                const __m128 rising = _mm_cmpgt_ps (squared, level);
+                const __m128 coefficient = _mm_or_ps (_mm_and_ps (rising, attack), _mm_andnot_ps (rising, release));
+                level = _mm_add_ps (_mm_mul_ps (coefficient, _mm_sub_ps (level, squared)), squared);
+                storePair (level, leftEnvelope, rightEnvelope, i);
+            }
+
+            alignas (16) float lanes[4];
+            _mm_store_ps (lanes, level);
+            state[0] = lanes[0];
+            state[1] = lanes[1];
+        }
+
+        float findPeakSse2 (const float* data, int numSamples)
+        {
+            __m128 peak = _mm_setzero_ps();
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+                peak = _mm_max_ps (peak, absolute (_mm_loadu_ps (data + i)));
+
+            float result = horizontalMax (peak);
+            for (; i < numSamples; ++i)
+                result = std::max (result, std::abs (data[i]));
+
+            return result;
+        }
+
+        double sumOfSquaresSse2 (const float* data, int numSamples)
+        {
+            __m128d low = _mm_setzero_pd(), high = _mm_setzero_pd();
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+            {
+                const __m128 x = _mm_loadu_ps (data + i);
+                const __m128d x01 = _mm_cvtps_pd (x);
+                const __m128d x23 = _mm_cvtps_pd (_mm_movehl_ps (x, x));
+                low = _mm_add_pd (low, _mm_mul_pd (x01, x01));
+                high = _mm_add_pd (high, _mm_mul_pd (x23, x23));
+            }
+
+            alignas (16) double lanes[2];
+            _mm_store_pd (lanes, _mm_add_pd (low, high));
+            double sum = lanes[0] + lanes[1];
+
+            for (; i < numSamples; ++i)
+                sum += static_cast<double> (data[i]) * static_cast<double> (data[i]);
+
+            return sum;
+        }
+
+        float oversampledPeakSse2 (const float* window, int numOutputs)
+        {
+            __m128 coefficients[truePeakTaps];
+            for (int tap = 0; tap < truePeakTaps; ++tap)
+                coefficients[tap] = _mm_load_ps (truePeakCoefficients[tap]);
+
+            __m128 peak = _mm_setzero_ps();
+
+            // All four phases of one output sample per vector
+            for (int n = 0; n < numOutputs; ++n)
+            {
+                __m128 phases = _mm_setzero_ps();
+                for (int tap = 0; tap < truePeakTaps; ++tap)
+                    phases = _mm_add_ps (phases, _mm_mul_ps (coefficients[tap], _mm_set1_ps (window[n + truePeakTaps - 1 - tap])));
+
+                peak = _mm_max_ps (peak, absolute (phases));
+            }
+
+            return horizontalMax (peak);
+        }
+
+        const KernelTable sse2Kernels {
+            InstructionSet::sse2,
+            "sse2",
+            applyGainSse2,
+            addWithGainSse2,
+            biquadCascadeStereoSse2,
+            envelopeFollowerStereoSse2,
+            findPeakSse2,
+            sumOfSquaresSse2,
+            oversampledPeakSse2
+        };
+    }
+#endif
+
+    namespace detail
+    {
+        const KernelTable* getSse2Kernels() noexcept
+        {
+           #if AURALIS_SIMD_SSE2
+            return &sse2Kernels;
+           #else
+            return nullptr;
+           #endif
+        }
+    }
+}
+}
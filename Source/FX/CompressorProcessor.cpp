@@ -48,6 +48,7 @@ void CompressorProcessor::releaseResources()
 
 void CompressorProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    DSPLoadProfiler::ScopedTimer loadTimer(loadSlot, buffer.getNumSamples());
     juce::ScopedNoDenormals noDenormals;
     
     // Process audio through the compressor
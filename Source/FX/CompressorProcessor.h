@@ -1,6 +1,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "../Audio/DSPLoadProfiler.h"
 
 class CompressorProcessor : public juce::AudioProcessor
 {
@@ -49,6 +50,9 @@ public:
     bool isMakeupGainAuto() const { return autoMakeupGain; }
     float getMakeupGain() const { return makeupGainDb; }
 
+    // Per-block cost, while the engine's load profiler is on
+    void setLoadSlot(DSPLoadProfiler::Slot* slot) { loadSlot = slot; }
+
 private:
     // Compressor parameters
     float thresholdInDb = -18.0f;  // Default threshold (dBFS)
@@ -69,4 +73,6 @@ private:
     float calculateAutoMakeupGain(float thresholdInDb, float ratio);
     
     double sampleRate = 44100.0;
+    
+    DSPLoadProfiler::Slot* loadSlot = nullptr;
 }; 
\ No newline at end of file
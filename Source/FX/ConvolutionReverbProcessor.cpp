@@ -0,0 +1,473 @@
+#include "ConvolutionReverbProcessor.h"
+
+namespace
+{
+    constexpr int numTailChannels = 2;
+
+    // Copy into a ring from an absolute position onwards; no source writes silence
+    void writeRing(float* ring, int mask, juce::int64 position, const float* source, int count)
+    {
+        const int start = static_cast<int>(position & mask);
+        const int first = juce::jmin(count, mask + 1 - start);
+
+        if (source != nullptr)
+        {
+            std::copy_n(source, first, ring + start);
+            std::copy_n(source + first, count - first, ring);
+        }
+        else
+        {
+            std::fill_n(ring + start, first, 0.0f);
+            std::fill_n(ring, count - first, 0.0f);
+        }
+    }
+
+    void readRing(const float* ring, int mask, juce::int64 position, float* destination, int count)
+    {
+        const int start = static_cast<int>(position & mask);
+        const int first = juce::jmin(count, mask + 1 - start);
+
+        std::copy_n(ring + start, first, destination);
+        std::copy_n(ring, count - first, destination + first);
+    }
+
+    void addFromRing(const float* ring, int mask, juce::int64 position, float* destination, int count)
+    {
+        const int start = static_cast<int>(position & mask);
+        const int first = juce::jmin(count, mask + 1 - start);
+
+        juce::FloatVectorOperations::add(destination, ring + start, first);
+        juce::FloatVectorOperations::add(destination + first, ring, count - first);
+    }
+}
+
+ConvolutionReverbProcessor::ConvolutionReverbProcessor()
+    : AudioProcessor (juce::AudioProcessor::BusesProperties()
+                     .withInput ("Input", juce::AudioChannelSet::stereo(), true)
+                     .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
+      juce::Thread("Convolution tail")
+{
+    wetGain.setCurrentAndTargetValue(getWetLevel());
+}
+
+ConvolutionReverbProcessor::~ConvolutionReverbProcessor()
+{
+    stopThread(2000);
+}
+
+void ConvolutionReverbProcessor::prepareToPlay(double newSampleRate, int maximumExpectedSamplesPerBlock)
+{
+    // The worker starts again from the first sample with the new sizes
+    stopThread(2000);
+
+    const juce::ScopedLock lock(impulseLock);
+    sampleRate = newSampleRate;
+
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = sampleRate;
+    spec.maximumBlockSize = maximumExpectedSamplesPerBlock;
+    spec.numChannels = getTotalNumOutputChannels();
+
+    headConvolution.prepare(spec);
+
+    // Long enough for the worker to fill a tail partition and then have as long again to
+    // convolve it, whatever the block size
+    headLength = 2 * tailPartitionSize + 2 * maximumExpectedSamplesPerBlock;
+
+    const int ringSize = juce::nextPowerOfTwo(2 * (headLength + tailPartitionSize + maximumExpectedSamplesPerBlock));
+    ringMask = ringSize - 1;
+    tailInput.setSize(numTailChannels, ringSize);
+    tailInput.clear();
+    tailOutput.setSize(numTailChannels, ringSize);
+    tailOutput.clear();
+
+    inputPosition = 0;
+    inputWritten.store(0);
+    inputGapEnd.store(0);
+    tailDone.store(0);
+
+    // The worker is stopped, so its state can be reset from here
+    currentTail.reset();
+    inputSpectra.clear();
+    spectrumIndex = 0;
+    tailPosition = 0;
+    fftBuffer.assign(static_cast<size_t>(4 * tailPartitionSize), 0.0f);
+    accumulator.assign(static_cast<size_t>(tailPartitionSize + 1), {});
+    previousInput.setSize(numTailChannels, tailPartitionSize);
+    previousInput.clear();
+    tailBlock.setSize(numTailChannels, tailPartitionSize);
+
+    // Allocate the wet buffer up front so processBlock never allocates
+    wetBuffer.setSize(static_cast<int>(spec.numChannels), maximumExpectedSamplesPerBlock);
+    wetBuffer.clear();
+
+    // Short ramp so wet level changes don't zipper
+    wetGain.reset(sampleRate, 0.05);
+    wetGain.setCurrentAndTargetValue(getWetLevel());
+
+    // An IR loaded before now, or at another rate, is split for this device
+    splitImpulseResponse();
+
+    startThread();
+}
+
+void ConvolutionReverbProcessor::releaseResources()
+{
+    stopThread(2000);
+    headConvolution.reset();
+}
+
+void ConvolutionReverbProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    const int numChannels = juce::jmin(buffer.getNumChannels(), wetBuffer.getNumChannels(), tailInput.getNumChannels());
+    const int numSamples = juce::jmin(buffer.getNumSamples(), wetBuffer.getNumSamples());
+
+    // The ramp itself belongs to the audio thread; only the target crosses over
+    wetGain.setTargetValue(getWetLevel());
+
+    // Nothing loaded yet - the dry signal passes through untouched
+    if (! hasImpulseResponse() || numSamples == 0)
+        return;
+
+    // Hand the dry input to the worker. If it has fallen a whole ring behind there's no
+    // room: the block is dropped and the worker told to skip past it.
+    const auto blockStart = inputPosition;
+    const auto done = tailDone.load(std::memory_order_acquire);
+
+    if (blockStart + numSamples - done > ringMask + 1)
+    {
+        inputGapEnd.store(blockStart + numSamples, std::memory_order_relaxed);
+    }
+    else
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            writeRing(tailInput.getWritePointer(channel), ringMask, blockStart, buffer.getReadPointer(channel), numSamples);
+    }
+
+    inputPosition += numSamples;
+    inputWritten.store(inputPosition, std::memory_order_release);
+
+    // Convolve the head into the preallocated wet buffer
+    for (int channel = 0; channel < numChannels; ++channel)
+        wetBuffer.copyFrom(channel, 0, buffer, channel, 0, numSamples);
+
+    juce::dsp::AudioBlock<float> block(wetBuffer);
+    auto wetBlock = block.getSubsetChannelBlock(0, static_cast<size_t>(numChannels))
+                         .getSubBlock(0, static_cast<size_t>(numSamples));
+    juce::dsp::ProcessContextReplacing<float> context(wetBlock);
+    headConvolution.process(context);
+
+    // Add the tail the worker convolved from the input headLength samples ago
+    const auto from = blockStart - headLength;
+    const auto begin = juce::jmax<juce::int64>(from, 0);
+    const auto end = juce::jmin<juce::int64>(from + numSamples, done);
+
+    if (end > begin)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            addFromRing(tailOutput.getReadPointer(channel), ringMask, begin,
+                        wetBuffer.getWritePointer(channel, static_cast<int>(begin - from)), static_cast<int>(end - begin));
+    }
+
+    if (end < from + numSamples && from + numSamples > 0)
+        tailUnderruns.fetch_add(1, std::memory_order_relaxed);
+
+    // Mix wet on top of the dry signal
+    if (wetGain.isSmoothing())
+    {
+        const float startGain = wetGain.getCurrentValue();
+        const float endGain = wetGain.skip(numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            buffer.addFromWithRamp(channel, 0, wetBuffer.getReadPointer(channel), numSamples, startGain, endGain);
+    }
+    else
+    {
+        const float gain = wetGain.getTargetValue();
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            buffer.addFrom(channel, 0, wetBuffer, channel, 0, numSamples, gain);
+    }
+}
+
+double ConvolutionReverbProcessor::getTailLengthSeconds() const
+{
+    if (sampleRate <= 0.0)
+        return 0.0;
+
+    return static_cast<double>(impulseResponseLength.load()) / sampleRate;
+}
+
+bool ConvolutionReverbProcessor::loadImpulseResponse(const juce::File& file)
+{
+    if (! file.existsAsFile())
+    {
+        juce::Logger::writeToLog("ConvolutionReverbProcessor: IR file not found: " + file.getFullPathName());
+        return false;
+    }
+
+    // Read and check the file here, so a bad one is refused before anything switches to it
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+    if (reader == nullptr || reader->numChannels == 0 || reader->sampleRate <= 0.0 || reader->lengthInSamples <= 0)
+    {
+        juce::Logger::writeToLog("ConvolutionReverbProcessor: can't read an IR from " + file.getFullPathName());
+        return false;
+    }
+
+    const auto maxLength = static_cast<juce::int64>(maxImpulseLengthSeconds * reader->sampleRate);
+    const int length = static_cast<int>(juce::jmin(reader->lengthInSamples, maxLength));
+    const int numChannels = static_cast<int>(juce::jmin(reader->numChannels, 2u));
+
+    juce::AudioBuffer<float> impulse(numChannels, length);
+    if (! reader->read(&impulse, 0, length, 0, true, numChannels > 1) || impulse.getMagnitude(0, length) <= 0.0f)
+    {
+        juce::Logger::writeToLog("ConvolutionReverbProcessor: " + file.getFileName() + " is empty or unreadable");
+        return false;
+    }
+
+    // Split here if the device is already running, otherwise in prepareToPlay()
+    {
+        const juce::ScopedLock lock(impulseLock);
+        impulseResponse = std::move(impulse);
+        impulseResponseRate = reader->sampleRate;
+        splitImpulseResponse();
+    }
+
+    impulseResponseFile = file;
+    impulseResponseLoaded = true;
+
+    juce::Logger::writeToLog("ConvolutionReverbProcessor: loading IR " + file.getFileName());
+    return true;
+}
+
+void ConvolutionReverbProcessor::setWetLevel(float level)
+{
+    wetLevel.store(juce::jlimit(0.0f, 1.0f, level), std::memory_order_relaxed);
+}
+
+void ConvolutionReverbProcessor::splitImpulseResponse()
+{
+    if (headLength == 0 || impulseResponse.getNumSamples() == 0)
+        return;
+
+    const int numChannels = impulseResponse.getNumChannels();
+    const int fileLength = impulseResponse.getNumSamples();
+
+    // At the device rate, so the split lands exactly headLength samples in
+    const double ratio = impulseResponseRate / sampleRate;
+    const int length = juce::jmin(static_cast<int>(std::ceil(fileLength / ratio)),
+                                  static_cast<int>(maxImpulseLengthSeconds * sampleRate));
+    juce::AudioBuffer<float> impulse(numChannels, length);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        if (ratio == 1.0)
+        {
+            impulse.copyFrom(channel, 0, impulseResponse, channel, 0, length);
+            continue;
+        }
+
+        // The interpolator reads a few samples ahead of where it is: give it silence past the end
+        std::vector<float> padded(static_cast<size_t>(fileLength + 64), 0.0f);
+        std::copy_n(impulseResponse.getReadPointer(channel), fileLength, padded.begin());
+
+        juce::LagrangeInterpolator interpolator;
+        interpolator.process(ratio, padded.data(), impulse.getWritePointer(channel), length);
+    }
+
+    // Drop the silence at either end
+    const float threshold = impulse.getMagnitude(0, length) * juce::Decibels::decibelsToGain(-80.0f);
+    int first = length, last = 0;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const auto* samples = impulse.getReadPointer(channel);
+        for (int i = 0; i < length; ++i)
+        {
+            if (std::abs(samples[i]) > threshold)
+            {
+                first = juce::jmin(first, i);
+                last = juce::jmax(last, i + 1);
+            }
+        }
+    }
+
+    if (first >= last)
+        return;
+
+    // Unit energy in the loudest channel, so short and long rooms come out at a similar level
+    double energy = 0.0;
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        double channelEnergy = 0.0;
+        for (int i = first; i < last; ++i)
+            channelEnergy += static_cast<double>(impulse.getSample(channel, i)) * impulse.getSample(channel, i);
+
+        energy = juce::jmax(energy, channelEnergy);
+    }
+
+    const auto gain = static_cast<float>(1.0 / std::sqrt(energy));
+    const int trimmedLength = last - first;
+    const int headSamples = juce::jmin(trimmedLength, headLength);
+
+    // The head engine is built on the convolution's background queue
+    juce::AudioBuffer<float> head(numChannels, headSamples);
+    for (int channel = 0; channel < numChannels; ++channel)
+        head.copyFrom(channel, 0, impulse, channel, first, headSamples);
+    head.applyGain(gain);
+
+    headConvolution.loadImpulseResponse(std::move(head), sampleRate,
+                                        numChannels > 1 ? juce::dsp::Convolution::Stereo::yes : juce::dsp::Convolution::Stereo::no,
+                                        juce::dsp::Convolution::Trim::no,
+                                        juce::dsp::Convolution::Normalise::no);
+
+    // The tail's partitions are transformed here; an IR that fits in the head leaves none
+    constexpr int numBins = tailPartitionSize + 1;
+    auto tail = std::make_unique<TailPartitions>();
+    tail->numChannels = numChannels;
+    tail->numPartitions = (trimmedLength - headSamples + tailPartitionSize - 1) / tailPartitionSize;
+    tail->spectra.resize(static_cast<size_t>(numChannels * tail->numPartitions * numBins));
+
+    juce::dsp::FFT fft(tailFFTOrder);
+    std::vector<float> partition(static_cast<size_t>(4 * tailPartitionSize));
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        for (int index = 0; index < tail->numPartitions; ++index)
+        {
+            const int start = first + headSamples + index * tailPartitionSize;
+            const int count = juce::jmin(tailPartitionSize, last - start);
+
+            std::fill(partition.begin(), partition.end(), 0.0f);
+            juce::FloatVectorOperations::multiply(partition.data(), impulse.getReadPointer(channel, start), gain, count);
+            fft.performRealOnlyForwardTransform(partition.data(), true);
+
+            const auto* spectrum = reinterpret_cast<const std::complex<float>*>(partition.data());
+            std::copy_n(spectrum, numBins, tail->spectra.begin() + (channel * tail->numPartitions + index) * numBins);
+        }
+    }
+
+    {
+        const juce::ScopedLock lock(pendingTailLock);
+        std::swap(pendingTail, tail);
+    }
+
+    impulseResponseLength.store(trimmedLength);
+}
+
+//==============================================================================
+void ConvolutionReverbProcessor::run()
+{
+    while (! threadShouldExit())
+    {
+        processTail();
+        wait(2);
+    }
+}
+
+void ConvolutionReverbProcessor::processTail()
+{
+    constexpr int numBins = tailPartitionSize + 1;
+
+    // Pick up a newly loaded tail; its input history starts empty
+    std::unique_ptr<TailPartitions> newTail;
+    {
+        const juce::ScopedLock lock(pendingTailLock);
+        std::swap(newTail, pendingTail);
+    }
+
+    if (newTail != nullptr)
+    {
+        currentTail = std::move(newTail);
+        inputSpectra.assign(static_cast<size_t>(numTailChannels * currentTail->numPartitions * numBins), {});
+        spectrumIndex = 0;
+    }
+
+    const auto written = inputWritten.load(std::memory_order_acquire);
+
+    // The audio thread dropped input it had no room for: silence the tail over the gap
+    // and carry on after it. Nothing reads that output until tailDone passes it.
+    if (const auto gapEnd = inputGapEnd.load(std::memory_order_relaxed); tailPosition < gapEnd)
+    {
+        const auto from = juce::jmax(tailPosition, gapEnd - (ringMask + 1) / 2);
+        for (int channel = 0; channel < numTailChannels; ++channel)
+            writeRing(tailOutput.getWritePointer(channel), ringMask, from, nullptr, static_cast<int>(gapEnd - from));
+
+        std::fill(inputSpectra.begin(), inputSpectra.end(), std::complex<float>());
+        previousInput.clear();
+        tailPosition = gapEnd;
+        tailDone.store(tailPosition, std::memory_order_release);
+    }
+
+    while (tailPosition + tailPartitionSize <= written && ! threadShouldExit())
+    {
+        for (int channel = 0; channel < numTailChannels; ++channel)
+        {
+            auto* samples = tailBlock.getWritePointer(channel);
+            readRing(tailInput.getReadPointer(channel), ringMask, tailPosition, samples, tailPartitionSize);
+            convolveTailPartition(channel, samples);
+            writeRing(tailOutput.getWritePointer(channel), ringMask, tailPosition, samples, tailPartitionSize);
+        }
+
+        if (currentTail != nullptr && currentTail->numPartitions > 0)
+            spectrumIndex = (spectrumIndex + 1) % currentTail->numPartitions;
+
+        tailPosition += tailPartitionSize;
+        tailDone.store(tailPosition, std::memory_order_release);
+    }
+}
+
+void ConvolutionReverbProcessor::convolveTailPartition(int channel, float* samples)
+{
+    constexpr int numBins = tailPartitionSize + 1;
+    constexpr int fftSize = 2 * tailPartitionSize;
+
+    // Overlap-save: transform the previous partition of input and this one together
+    auto* previous = previousInput.getWritePointer(channel);
+    std::copy_n(previous, tailPartitionSize, fftBuffer.begin());
+    std::copy_n(samples, tailPartitionSize, fftBuffer.begin() + tailPartitionSize);
+    std::copy_n(samples, tailPartitionSize, previous);
+
+    const int numPartitions = currentTail != nullptr ? currentTail->numPartitions : 0;
+    if (numPartitions == 0)
+    {
+        std::fill_n(samples, tailPartitionSize, 0.0f);
+        return;
+    }
+
+    std::fill(fftBuffer.begin() + fftSize, fftBuffer.end(), 0.0f);
+    tailFFT.performRealOnlyForwardTransform(fftBuffer.data(), true);
+
+    auto* spectrum = reinterpret_cast<std::complex<float>*>(fftBuffer.data());
+    auto* history = inputSpectra.data() + channel * numPartitions * numBins;
+    std::copy_n(spectrum, numBins, history + spectrumIndex * numBins);
+
+    // Partition p of the IR meets the input from p partitions ago
+    const int irChannel = juce::jmin(channel, currentTail->numChannels - 1);
+    const auto* partitions = currentTail->spectra.data() + irChannel * numPartitions * numBins;
+
+    std::fill(accumulator.begin(), accumulator.end(), std::complex<float>());
+    for (int index = 0; index < numPartitions; ++index)
+    {
+        const auto* input = history + ((spectrumIndex - index + numPartitions) % numPartitions) * numBins;
+        const auto* response = partitions + index * numBins;
+
+        for (int bin = 0; bin < numBins; ++bin)
+            accumulator[static_cast<size_t>(bin)] += input[bin] * response[bin];
+    }
+
+    // The inverse transform wants the whole spectrum: mirror the negative frequencies
+    std::copy(accumulator.begin(), accumulator.end(), spectrum);
+    for (int bin = 1; bin < tailPartitionSize; ++bin)
+        spectrum[fftSize - bin] = std::conj(accumulator[static_cast<size_t>(bin)]);
+
+    tailFFT.performRealOnlyInverseTransform(fftBuffer.data());
+
+    // Only the second half is free of wraparound
+    std::copy_n(fftBuffer.begin() + tailPartitionSize, tailPartitionSize, samples);
+}
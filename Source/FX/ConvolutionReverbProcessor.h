@@ -0,0 +1,138 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <complex>
+
+/**
+ * ConvolutionReverbProcessor - Impulse-response reverb for the FX buses
+ *
+ * Zero-latency partitioned convolution split across two threads. The IR's
+ * head, its first headLength samples, runs in processBlock() on a
+ * juce::dsp::Convolution with block-sized partitions. The tail runs on a
+ * worker thread in tailPartitionSize FFT partitions: the audio thread copies
+ * its input into a ring, and the worker's output comes back through a second
+ * ring that processBlock() reads headLength samples later. The head is long
+ * enough that the worker has a couple of partitions' time to deliver; a tail
+ * block that still isn't ready plays without its tail and is counted.
+ *
+ * The IR file is read and checked on the calling thread, resampled to the
+ * device rate and split there; building the head engine happens on the
+ * convolution's background thread, and both halves are swapped in without
+ * locking the audio thread.
+ */
+class ConvolutionReverbProcessor : public juce::AudioProcessor,
+                                   private juce::Thread
+{
+public:
+    ConvolutionReverbProcessor();
+    ~ConvolutionReverbProcessor() override;
+
+    // AudioProcessor interface implementations
+    void prepareToPlay(double sampleRate, int maximumExpectedSamplesPerBlock) override;
+    void releaseResources() override;
+    void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages) override;
+
+    // Editor
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+    bool hasEditor() const override { return false; }
+
+    // State management
+    const juce::String getName() const override { return "ConvolutionReverbProcessor"; }
+    bool acceptsMidi() const override { return false; }
+    bool producesMidi() const override { return false; }
+    double getTailLengthSeconds() const override;
+
+    // Programs
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int index) override {}
+    const juce::String getProgramName(int index) override { return {}; }
+    void changeProgramName(int index, const juce::String& newName) override {}
+
+    // State handling
+    void getStateInformation(juce::MemoryBlock& destData) override {}
+    void setStateInformation(const void* data, int sizeInBytes) override {}
+
+    // Impulse response loading - safe to call from the message thread while audio runs.
+    // Returns false, and keeps the current IR, if the file can't be read.
+    bool loadImpulseResponse(const juce::File& impulseResponseFile);
+    juce::File getImpulseResponseFile() const { return impulseResponseFile; }
+    bool hasImpulseResponse() const { return impulseResponseLoaded.load(); }
+
+    // Parameter control methods
+    void setWetLevel(float level);
+    float getWetLevel() const { return wetLevel.load(std::memory_order_relaxed); }
+
+    // Blocks that played without their tail because the worker fell behind
+    juce::int64 getNumTailUnderruns() const { return tailUnderruns.load(std::memory_order_relaxed); }
+
+private:
+    // The worker convolves the tail this many samples at a time, with FFTs of twice that
+    static constexpr int tailPartitionSize = 2048;
+    static constexpr int tailFFTOrder = 12;
+    static_assert((1 << tailFFTOrder) == 2 * tailPartitionSize, "Overlap-save needs two partitions per FFT");
+
+    // Longest IR we accept; anything after this is cut off
+    static constexpr double maxImpulseLengthSeconds = 8.0;
+
+    // Spectra of the tail's partitions, built on the loading thread
+    struct TailPartitions
+    {
+        int numChannels = 0;
+        int numPartitions = 0;
+        std::vector<std::complex<float>> spectra;   // [channel][partition][bin]
+    };
+
+    void run() override;
+    void processTail();
+    void convolveTailPartition(int channel, float* samples);
+
+    // Resample, trim and normalise the file's IR, then hand the head and tail to their engines.
+    // The caller holds impulseLock.
+    void splitImpulseResponse();
+
+    juce::dsp::Convolution headConvolution;
+
+    // Wet signal is rendered here so the dry path stays at unity, like ReverbProcessor
+    juce::AudioBuffer<float> wetBuffer;
+    juce::SmoothedValue<float> wetGain;      // Audio thread only
+
+    // The IR as read from the file, kept so a new device rate or block size can re-split it
+    juce::CriticalSection impulseLock;
+    juce::AudioBuffer<float> impulseResponse;
+    double impulseResponseRate = 0.0;
+    int headLength = 0;                      // 0 until prepared
+
+    // Both rings are indexed by absolute input sample, masked by ringMask
+    juce::AudioBuffer<float> tailInput;      // Written by the audio thread below inputWritten
+    juce::AudioBuffer<float> tailOutput;     // Written by the worker below tailDone
+    int ringMask = 0;
+    juce::int64 inputPosition = 0;           // Audio thread only
+    std::atomic<juce::int64> inputWritten { 0 };
+    std::atomic<juce::int64> inputGapEnd { 0 };     // Input before this was dropped: the worker skips it
+    std::atomic<juce::int64> tailDone { 0 };
+    std::atomic<juce::int64> tailUnderruns { 0 };
+
+    // A newly split tail on its way to the worker
+    juce::CriticalSection pendingTailLock;
+    std::unique_ptr<TailPartitions> pendingTail;
+
+    // Worker thread only: the running tail and its overlap-save state
+    std::unique_ptr<TailPartitions> currentTail;
+    juce::dsp::FFT tailFFT { tailFFTOrder };
+    std::vector<float> fftBuffer;
+    std::vector<std::complex<float>> inputSpectra;  // [channel][partition][bin], a ring of past input
+    std::vector<std::complex<float>> accumulator;
+    juce::AudioBuffer<float> previousInput;
+    juce::AudioBuffer<float> tailBlock;
+    int spectrumIndex = 0;
+    juce::int64 tailPosition = 0;
+
+    juce::File impulseResponseFile;           // Message thread only
+    std::atomic<bool> impulseResponseLoaded { false };
+    std::atomic<int> impulseResponseLength { 0 };   // At the device rate, after trimming
+    std::atomic<float> wetLevel { 0.25f };   // Set from the message thread
+    double sampleRate = 44100.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConvolutionReverbProcessor)
+};
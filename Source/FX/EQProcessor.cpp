@@ -5,7 +5,6 @@ EQProcessor::EQProcessor()
                       .withInput ("Input", juce::AudioChannelSet::stereo(), true)
                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true))
 {
-    // Initialize with default parameters
 }
 
 EQProcessor::~EQProcessor()
@@ -16,16 +15,11 @@ void EQProcessor::prepareToPlay(double sampleRate, int maximumExpectedSamplesPer
 {
     this->sampleRate = sampleRate;
     
-    // Prepare the processor chain
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = maximumExpectedSamplesPerBlock;
-    spec.numChannels = getTotalNumOutputChannels();
+    filterState.fill({});
     
-    processorChain.prepare(spec);
-    
-    // Initialize filter coefficients
+    // Initialize filter coefficients; nothing is filtering yet, so every set starts with them
     updateFilters();
+    coefficientSets.fill(coefficientSets[static_cast<size_t>(waitingSet.load() & ~newSetFlag)]);
 }
 
 void EQProcessor::releaseResources()
@@ -35,18 +29,26 @@ void EQProcessor::releaseResources()
 
 void EQProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    DSPLoadProfiler::ScopedTimer loadTimer(loadSlot, buffer.getNumSamples());
     juce::ScopedNoDenormals noDenormals;
     
-    // Process using the EQ processor chain
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
-    processorChain.process(context);
+    if (buffer.getNumChannels() == 0)
+        return;
+    
+    // Take the newest coefficients once per block, if updateFilters() has finished any
+    if ((waitingSet.load(std::memory_order_acquire) & newSetFlag) != 0)
+        filterSet = waitingSet.exchange(filterSet, std::memory_order_acq_rel) & ~newSetFlag;
+    
+    // Band by band over the block, both channels in one vector
+    float* right = buffer.getNumChannels() > 1 ? buffer.getWritePointer(1) : nullptr;
+    kernels.biquadCascadeStereo(buffer.getWritePointer(0), right, buffer.getNumSamples(),
+                                coefficientSets[static_cast<size_t>(filterSet)].data(), filterState.data(), numBands);
 }
 
 void EQProcessor::setGain(Band band, float gainInDecibels)
 {
     // Clamp gain between -12 and +12 dB
-    float clampedGain = juce::jlimit(-12.0f, 12.0f, gainInDecibels);
+    float clampedGain = juce::jlimit(-maxGainDb, maxGainDb, gainInDecibels);
     
     // Update the appropriate gain parameter
     switch (band)
@@ -69,6 +71,16 @@ void EQProcessor::setGain(Band band, float gainInDecibels)
     updateFilters();
 }
 
+void EQProcessor::setGains(const std::array<float, 4>& gainsInDecibels)
+{
+    lowShelfGain = juce::jlimit(-maxGainDb, maxGainDb, gainsInDecibels[0]);
+    lowMidGain = juce::jlimit(-maxGainDb, maxGainDb, gainsInDecibels[1]);
+    highMidGain = juce::jlimit(-maxGainDb, maxGainDb, gainsInDecibels[2]);
+    highShelfGain = juce::jlimit(-maxGainDb, maxGainDb, gainsInDecibels[3]);
+    
+    updateFilters();
+}
+
 float EQProcessor::getGain(Band band) const
 {
     switch (band)
@@ -92,35 +104,24 @@ void EQProcessor::updateFilters()
     if (sampleRate <= 0)
         return;
         
-    // Get references to each filter in the chain
-    auto& lowShelfBand = processorChain.get<0>();
-    auto& lowMidBand = processorChain.get<1>();
-    auto& highMidBand = processorChain.get<2>();
-    auto& highShelfBand = processorChain.get<3>();
+    using ArrayCoefs = juce::dsp::IIR::ArrayCoefficients<float>;
+    using auralis::simd::makeBiquad;
     
-    // Create coefficient objects
-    auto lowShelfCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowShelf(
-        sampleRate, lowShelfFrequency, midQ, juce::Decibels::decibelsToGain(lowShelfGain));
+    // Designed as plain arrays, so this never allocates; both channels share each band
+    auto& bandCoefficients = coefficientSets[static_cast<size_t>(designSet)];
     
-    auto lowMidCoeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-        sampleRate, lowMidFrequency, midQ, juce::Decibels::decibelsToGain(lowMidGain));
+    bandCoefficients[0] = makeBiquad(ArrayCoefs::makeLowShelf(
+        sampleRate, lowShelfFrequency, midQ, juce::Decibels::decibelsToGain(lowShelfGain)));
     
-    auto highMidCoeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter(
-        sampleRate, highMidFrequency, midQ, juce::Decibels::decibelsToGain(highMidGain));
+    bandCoefficients[1] = makeBiquad(ArrayCoefs::makePeakFilter(
+        sampleRate, lowMidFrequency, midQ, juce::Decibels::decibelsToGain(lowMidGain)));
     
-    auto highShelfCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighShelf(
-        sampleRate, highShelfFrequency, midQ, juce::Decibels::decibelsToGain(highShelfGain));
-        
-    // Update the filters with new coefficients
-    // Left channel (0)
-    lowShelfBand.get<0>().coefficients = lowShelfCoeffs;
-    lowMidBand.get<0>().coefficients = lowMidCoeffs;
-    highMidBand.get<0>().coefficients = highMidCoeffs;
-    highShelfBand.get<0>().coefficients = highShelfCoeffs;
+    bandCoefficients[2] = makeBiquad(ArrayCoefs::makePeakFilter(
+        sampleRate, highMidFrequency, midQ, juce::Decibels::decibelsToGain(highMidGain)));
+    
+    bandCoefficients[3] = makeBiquad(ArrayCoefs::makeHighShelf(
+        sampleRate, highShelfFrequency, midQ, juce::Decibels::decibelsToGain(highShelfGain)));
     
-    // Right channel (1)
-    lowShelfBand.get<1>().coefficients = lowShelfCoeffs;
-    lowMidBand.get<1>().coefficients = lowMidCoeffs;
-    highMidBand.get<1>().coefficients = highMidCoeffs;
-    highShelfBand.get<1>().coefficients = highShelfCoeffs;
-} 
\ No newline at end of file
+    // Publish the finished set and design into whichever one was waiting next time
+    designSet = waitingSet.exchange(designSet | newSetFlag, std::memory_order_acq_rel) & ~newSetFlag;
+}
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "../DSP/SimdKernels.h"
+#include "../Audio/DSPLoadProfiler.h"
 
 class EQProcessor : public juce::AudioProcessor
 {
@@ -44,37 +46,60 @@ public:
     };
     
     void setGain(Band band, float gainInDecibels);
+    void setGains(const std::array<float, 4>& gainsInDecibels);    // All bands, one coefficient update
     float getGain(Band band) const;
     
-    // Update filter coefficients based on parameters
+    // Update filter coefficients based on parameters. Designs into a spare
+    // coefficient set and hands it to the audio thread, so it never allocates
+    // and never rewrites the set a block is filtering with. One thread at a
+    // time may call this (and the setters above).
     void updateFilters();
 
-private:
-    // Filter parameters
+    // Per-block cost, while the engine's load profiler is on
+    void setLoadSlot(DSPLoadProfiler::Slot* slot) { loadSlot = slot; }
+
+    // Filter parameters - public so the soundcheck can model the exact response
     static constexpr float lowShelfFrequency = 80.0f;    // Hz
     static constexpr float lowMidFrequency = 300.0f;     // Hz
     static constexpr float highMidFrequency = 3000.0f;   // Hz
     static constexpr float highShelfFrequency = 8000.0f; // Hz
     
+    // The Q factor for the mid bands (also used for the shelves)
+    static constexpr float midQ = 0.7f;
+    
+    // Gain range of every band
+    static constexpr float maxGainDb = 12.0f;
+
+private:
     // Gain parameters for each band (in dB, range: -12 to +12)
     float lowShelfGain = 0.0f;
     float lowMidGain = 0.0f;
     float highMidGain = 0.0f;
     float highShelfGain = 0.0f;
     
-    // The Q factor for the mid bands
-    static constexpr float midQ = 0.7f;
+    static constexpr int numBands = 4;
     
-    // IIR Filters for stereo processing
-    using IIRFilter = juce::dsp::IIR::Filter<float>;
-    using IIRCoefs = juce::dsp::IIR::Coefficients<float>;
+    // One section per band, shared by both channels: low shelf, low mid, high mid, high shelf
+    using BandCoefficients = std::array<auralis::simd::BiquadCoefficients, numBands>;
     
-    // Create a stereo filter using two mono filters
-    using StereoFilter = juce::dsp::ProcessorChain<IIRFilter, IIRFilter>;
+    // The audio thread filters with one set while updateFilters() designs into
+    // another; the newest finished set waits in the third until the next block
+    // takes it. Each side swaps its set with the waiting one in one exchange.
+    static constexpr int numCoefficientSets = 3;
+    static constexpr int newSetFlag = 4;
+    std::array<BandCoefficients, numCoefficientSets> coefficientSets;
+    int designSet = 0;                  // updateFilters() only
+    int filterSet = 1;                  // Audio thread only
+    std::atomic<int> waitingSet { 2 };  // Plus newSetFlag until the audio thread takes it
     
-    // Four bands of stereo filters: low shelf, low mid, high mid, high shelf
-    juce::dsp::ProcessorChain<StereoFilter, StereoFilter, StereoFilter, StereoFilter> processorChain;
+    // Each band's filter state, left and right side by side
+    std::array<auralis::simd::BiquadState, numBands * 2> filterState;
+    
+    // The band cascade runs both channels at once in this CPU's vector kernel
+    const auralis::simd::KernelTable& kernels { auralis::simd::getKernels() };
     
     // Sample rate for coefficient calculations
     double sampleRate = 44100.0;
+    
+    DSPLoadProfiler::Slot* loadSlot = nullptr;
 }; 
\ No newline at end of file
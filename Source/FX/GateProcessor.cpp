@@ -25,6 +25,8 @@ void GateProcessor::prepareToPlay(double sampleRate, int maximumExpectedSamplesP
     // Reset envelopes
     levelEnvelopePerChannel[0] = 0.0f;
     levelEnvelopePerChannel[1] = 0.0f;
+    
+    envelopeBuffer.setSize(2, juce::jmax(1, maximumExpectedSamplesPerBlock));
 }
 
 void GateProcessor::releaseResources()
@@ -34,52 +36,39 @@ void GateProcessor::releaseResources()
 
 void GateProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    DSPLoadProfiler::ScopedTimer loadTimer(loadSlot, buffer.getNumSamples());
     juce::ScopedNoDenormals noDenormals;
     
-    const int numChannels = buffer.getNumChannels();
+    const int numChannels = juce::jmin(buffer.getNumChannels(), 2);
     const int numSamples = buffer.getNumSamples();
+    const int chunkSize = envelopeBuffer.getNumSamples();
+    
+    if (numChannels == 0 || chunkSize == 0)
+        return;
     
-    // Process each channel independently
-    for (int channel = 0; channel < numChannels; ++channel)
+    // A block longer than promised in prepareToPlay goes through in chunks
+    for (int start = 0; start < numSamples; start += chunkSize)
     {
-        float* channelData = buffer.getWritePointer(channel);
+        const int numThisTime = juce::jmin(chunkSize, numSamples - start);
         
-        // Process each sample
-        for (int i = 0; i < numSamples; ++i)
+        // Track the mean-square level of both channels at once
+        const float* right = numChannels > 1 ? buffer.getReadPointer(1, start) : nullptr;
+        kernels.envelopeFollowerStereo(buffer.getReadPointer(0, start), right,
+                                       envelopeBuffer.getWritePointer(0), envelopeBuffer.getWritePointer(1),
+                                       numThisTime, attackCoeff, releaseCoeff, levelEnvelopePerChannel);
+        
+        for (int channel = 0; channel < numChannels; ++channel)
         {
-            // Apply envelope follower to get the RMS level
-            float rmsLevel = applyEnvelope(channelData[i] * channelData[i], channel);
-            
-            // Calculate the gain based on the RMS level and gate settings
-            float gain = calculateGain(rmsLevel);
+            float* channelData = buffer.getWritePointer(channel, start);
+            const float* envelope = envelopeBuffer.getReadPointer(channel);
             
-            // Apply the gain to the sample
-            channelData[i] *= gain;
+            // Calculate the gain from the RMS level and gate settings, and apply it
+            for (int i = 0; i < numThisTime; ++i)
+                channelData[i] *= calculateGain(std::sqrt(envelope[i]));
         }
     }
 }
 
-float GateProcessor::applyEnvelope(float inputSquared, int channel)
-{
-    // Apply envelope follower to track the input signal level
-    float& envelope = levelEnvelopePerChannel[channel];
-    
-    // Choose attack or release coefficient based on whether input is above current envelope
-    if (inputSquared > envelope)
-    {
-        // Signal is rising, use attack time
-        envelope = attackCoeff * (envelope - inputSquared) + inputSquared;
-    }
-    else
-    {
-        // Signal is falling, use release time
-        envelope = releaseCoeff * (envelope - inputSquared) + inputSquared;
-    }
-    
-    // Return RMS value
-    return std::sqrt(envelope);
-}
-
 float GateProcessor::calculateGain(float rmsLevel)
 {
     // Convert threshold from dB to linear
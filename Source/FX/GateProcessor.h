@@ -1,6 +1,8 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "../DSP/SimdKernels.h"
+#include "../Audio/DSPLoadProfiler.h"
 
 class GateProcessor : public juce::AudioProcessor
 {
@@ -45,6 +47,9 @@ public:
     float getAttack() const { return attackMs; }
     float getRelease() const { return releaseMs; }
 
+    // Per-block cost, while the engine's load profiler is on
+    void setLoadSlot(DSPLoadProfiler::Slot* slot) { loadSlot = slot; }
+
 private:
     // Gate parameters
     float thresholdInDb = -50.0f;  // Default threshold in dBFS
@@ -55,6 +60,10 @@ private:
     float levelEnvelopePerChannel[2] = { 0.0f, 0.0f };  // Envelope followers for each channel
     double sampleRate = 44100.0;
     
+    // Per-sample envelopes of the block, from the vector kernel; sized in prepareToPlay
+    juce::AudioBuffer<float> envelopeBuffer;
+    const auralis::simd::KernelTable& kernels { auralis::simd::getKernels() };
+    
     // Coefficient calculations
     float calculateAttackCoefficient(float attackTimeMs, double sampleRate);
     float calculateReleaseCoefficient(float releaseTimeMs, double sampleRate);
@@ -63,6 +72,7 @@ private:
     float releaseCoeff = 0.0f;
     
     // Process helpers
-    float applyEnvelope(float input, int channel);
     float calculateGain(float rmsLevel);
+    
+    DSPLoadProfiler::Slot* loadSlot = nullptr;
 }; 
\ No newline at end of file
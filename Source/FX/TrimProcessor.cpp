@@ -5,8 +5,6 @@ TrimProcessor::TrimProcessor()
                       .withInput ("Input", juce::AudioChannelSet::stereo(), true)
                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true))
 {
-    // Initialize gainLinear to 1.0 (0 dB)
-    gain.setGainLinear(gainLinear);
 }
 
 TrimProcessor::~TrimProcessor()
@@ -15,14 +13,7 @@ TrimProcessor::~TrimProcessor()
 
 void TrimProcessor::prepareToPlay(double sampleRate, int maximumExpectedSamplesPerBlock)
 {
-    // Prepare the DSP gain object
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = maximumExpectedSamplesPerBlock;
-    spec.numChannels = getTotalNumOutputChannels();
-    
-    gain.prepare(spec);
-    gain.setGainLinear(gainLinear);
+    // Nothing to prepare: the gain is applied as it stands
 }
 
 void TrimProcessor::releaseResources()
@@ -32,16 +23,15 @@ void TrimProcessor::releaseResources()
 
 void TrimProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    DSPLoadProfiler::ScopedTimer loadTimer(loadSlot, buffer.getNumSamples());
     juce::ScopedNoDenormals noDenormals;
     
-    // Process using the gain module
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
-    gain.process(context);
+    const float currentGain = gainLinear;
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        kernels.applyGain(buffer.getWritePointer(channel), buffer.getNumSamples(), currentGain);
 }
 
 void TrimProcessor::setGainLinear(float newGain)
 {
     gainLinear = newGain;
-    gain.setGainLinear(gainLinear);
 } 
\ No newline at end of file
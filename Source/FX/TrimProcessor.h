@@ -1,6 +1,8 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "../DSP/SimdKernels.h"
+#include "../Audio/DSPLoadProfiler.h"
 
 class TrimProcessor : public juce::AudioProcessor
 {
@@ -38,7 +40,12 @@ public:
     void setGainLinear(float newGain);
     float getGainLinear() const { return gainLinear; }
 
+    // Per-block cost, while the engine's load profiler is on
+    void setLoadSlot(DSPLoadProfiler::Slot* slot) { loadSlot = slot; }
+
 private:
     float gainLinear = 1.0f;
-    juce::dsp::Gain<float> gain;
+    const auralis::simd::KernelTable& kernels { auralis::simd::getKernels() };
+    
+    DSPLoadProfiler::Slot* loadSlot = nullptr;
 }; 
\ No newline at end of file
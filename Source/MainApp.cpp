@@ -1,6 +1,11 @@
 #include "MainApp.h"
 #include "UI/MainComponent.h"
+#include "UI/ChannelsComponent.h"
 #include "MainWindow.h"
+#include "Audio/OfflineRenderer.h"
+#include "State/AutosaveService.h"
+#include "State/ParameterHistory.h"
+#include "State/ParameterRegistry.h"
 #include "Tests/SessionRoundTripTest.h"
 #include "Utils/StyleManager.h"
 
@@ -46,6 +51,44 @@ namespace {
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TestRunnerWindow)
     };
 
+    class RenderThread : public juce::ThreadWithProgressWindow
+    {
+    public:
+        explicit RenderThread(OfflineRenderer::Settings s)
+            : ThreadWithProgressWindow("Rendering stems...", true, true), settings(std::move(s))
+        {
+        }
+        
+        void run() override
+        {
+            result = OfflineRenderer::render(settings, [this](double progress)
+            {
+                setProgress(progress);
+                return !threadShouldExit();
+            });
+        }
+        
+        void threadComplete(bool) override
+        {
+            if (result.success)
+                juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::InfoIcon, "Render Complete",
+                    settings.output.getFileName() + "\n"
+                    + juce::String(result.loudness.integratedLufs, 1) + " LUFS integrated, peak "
+                    + juce::String(result.loudness.samplePeakDb, 1) + " dBFS, true peak "
+                    + juce::String(result.loudness.truePeakDb, 1) + " dBTP\n"
+                    + "Rendered in " + juce::String(result.loudness.renderSeconds, 1) + " s");
+            else
+                juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "Render Failed",
+                                                       result.errorMessage);
+            
+            delete this;
+        }
+        
+    private:
+        OfflineRenderer::Settings settings;
+        OfflineRenderer::Result result;
+    };
+
     class TestLogger : public juce::Logger
     {
     public:
@@ -74,10 +117,50 @@ void MainApp::initialise(const juce::String& commandLine)
     mainWindow = std::make_unique<MainWindow>();
     createMenuBarModel();
     logToStderr("Main window created");
+    
+    auralis::ParameterRegistry::getInstance().attach(audioEngine);
+    auralis::SessionManager::getInstance().attach(audioEngine, [this] { refreshMixerViews(); });
+    
+    // Pick up where a crash or power cut left off, then keep autosaving
+    auto& autosave = auralis::AutosaveService::getInstance();
+    if (!autosave.wasShutDownCleanly())
+    {
+        auralis::SessionSnapshot recovered;
+        if (autosave.recoverLatest(recovered))
+        {
+            auralis::SessionManager::getInstance().applySnapshot(recovered);
+            logToStderr("Session recovered from autosave");
+        }
+    }
+    
+    autosave.start(audioEngine);
+}
+
+void MainApp::refreshMixerViews()
+{
+    if (mainWindow == nullptr)
+        return;
+
+    if (auto* mainComponent = dynamic_cast<MainComponent*>(mainWindow->getContentComponent()))
+    {
+        // Find the channels component and refresh it
+        if (auto* channelsComponent = dynamic_cast<ChannelsComponent*>(mainComponent->findChildWithID("channelsTab")))
+            channelsComponent->refreshAllChannelStrips();
+
+        // Propagate a custom loudness target to the SettingsComponent slider
+        if (auto* master = audioEngine.getMasterBusProcessor())
+        {
+            if (master->getStreamTarget() == StreamTarget::Custom)
+                if (auto* settings = mainComponent->getSettingsComponent())
+                    settings->setCustomLufs(master->getTargetLufs());
+        }
+    }
 }
 
 void MainApp::shutdown()
 {
+    auralis::AutosaveService::getInstance().stop();
+    
     logToStderr("Shutting down main window");
     juce::MenuBarModel::setMacMainMenu(nullptr);
     mainWindow = nullptr;
@@ -108,6 +191,8 @@ juce::PopupMenu MainApp::getMenuForIndex(int topLevelMenuIndex, const juce::Stri
         menu.addCommandItem(&commandManager, CommandIDs::openSession);
         menu.addCommandItem(&commandManager, CommandIDs::saveSession);
         menu.addCommandItem(&commandManager, CommandIDs::saveSessionAs);
+        menu.addCommandItem(&commandManager, CommandIDs::exportSessionJson);
+        menu.addCommandItem(&commandManager, CommandIDs::renderStems);
         menu.addSeparator();
         menu.addCommandItem(&commandManager, CommandIDs::audioSettings);
         menu.addSeparator();
@@ -144,6 +229,8 @@ void MainApp::getAllCommands(juce::Array<juce::CommandID>& commands)
         CommandIDs::openSession,
         CommandIDs::saveSession,
         CommandIDs::saveSessionAs,
+        CommandIDs::exportSessionJson,
+        CommandIDs::renderStems,
         CommandIDs::quit,
         CommandIDs::undo,
         CommandIDs::redo,
@@ -171,15 +258,33 @@ void MainApp::getCommandInfo(juce::CommandID commandID, juce::ApplicationCommand
         case CommandIDs::saveSessionAs:
             result.setInfo("Save Session As", "Save the current session with a new name", "File", 0);
             break;
+        case CommandIDs::exportSessionJson:
+            result.setInfo("Export Session as JSON...", "Write the current session as human-readable JSON", "File", 0);
+            break;
+        case CommandIDs::renderStems:
+            result.setInfo("Render Stems Offline...", "Mix multitrack stems through the current settings to a file", "File", 0);
+            break;
         case CommandIDs::quit:
             result.setInfo("Quit", "Quit the application", "File", 0);
             break;
         case CommandIDs::undo:
-            result.setInfo("Undo", "Undo the last action", "Edit", 0);
+        {
+            auto& history = auralis::ParameterHistory::getInstance();
+            result.setInfo(history.canUndo() ? "Undo " + history.getUndoDescription() : juce::String("Undo"),
+                           "Undo the last action", "Edit", 0);
+            result.setActive(history.canUndo());
+            result.addDefaultKeypress('z', juce::ModifierKeys::commandModifier);
             break;
+        }
         case CommandIDs::redo:
-            result.setInfo("Redo", "Redo the last undone action", "Edit", 0);
+        {
+            auto& history = auralis::ParameterHistory::getInstance();
+            result.setInfo(history.canRedo() ? "Redo " + history.getRedoDescription() : juce::String("Redo"),
+                           "Redo the last undone action", "Edit", 0);
+            result.setActive(history.canRedo());
+            result.addDefaultKeypress('z', juce::ModifierKeys::commandModifier | juce::ModifierKeys::shiftModifier);
             break;
+        }
         case CommandIDs::showSettings:
             result.setInfo("Show Settings", "Show the settings panel", "View", 0);
             break;
@@ -266,6 +371,76 @@ bool MainApp::perform(const juce::ApplicationCommandTarget::InvocationInfo& info
             });
             return true;
         }
+        case CommandIDs::exportSessionJson:
+        {
+            auto chooser = std::make_shared<juce::FileChooser>("Export Session as JSON", juce::File{}, "*.json");
+            auto flags = juce::FileBrowserComponent::saveMode | 
+                        juce::FileBrowserComponent::canSelectFiles;
+            
+            chooser->launchAsync(flags, [chooser](const juce::FileChooser& fc)
+            {
+                auto file = fc.getResult();
+                if (file != juce::File{})
+                {
+                    if (auralis::SessionManager::getInstance().exportSessionJson(file))
+                        logToStderr("Session exported to: " + file.getFullPathName());
+                    else
+                        logToStderr("Error exporting session to: " + file.getFullPathName());
+                }
+            });
+            return true;
+        }
+        case CommandIDs::renderStems:
+        {
+            auto stemChooser = std::make_shared<juce::FileChooser>("Choose Stems (one per channel, in order)",
+                                                                   juce::File{}, "*.wav;*.flac");
+            auto flags = juce::FileBrowserComponent::openMode |
+                        juce::FileBrowserComponent::canSelectFiles |
+                        juce::FileBrowserComponent::canSelectMultipleItems;
+            
+            stemChooser->launchAsync(flags, [this, stemChooser](const juce::FileChooser& fc)
+            {
+                auto stems = fc.getResults();
+                if (stems.isEmpty())
+                    return;
+                
+                std::sort(stems.begin(), stems.end());
+                
+                // Render with the mixer as it is now
+                OfflineRenderer::Settings settings;
+                settings.stems = stems;
+                settings.mixerState.emplace();
+                settings.mixerState->capture(audioEngine);
+                settings.routing = audioEngine.getRoutingManager().getAssignments();
+                
+                auto outputChooser = std::make_shared<juce::FileChooser>("Save Mix", juce::File{}, "*.wav;*.flac");
+                outputChooser->launchAsync(juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::canSelectFiles,
+                                           [outputChooser, settings](const juce::FileChooser& chooser) mutable
+                {
+                    settings.output = chooser.getResult();
+                    if (settings.output == juce::File{})
+                        return;
+                    
+                    if (!settings.output.hasFileExtension("wav;flac"))
+                        settings.output = settings.output.withFileExtension("wav");
+                    
+                    (new RenderThread(std::move(settings)))->launchThread();
+                });
+            });
+            return true;
+        }
+        case CommandIDs::undo:
+        case CommandIDs::redo:
+        {
+            auto& history = auralis::ParameterHistory::getInstance();
+            const bool changed = info.commandID == CommandIDs::undo ? history.undo() : history.redo();
+            if (changed)
+            {
+                auralis::SessionManager::getInstance().refreshUserInterface();
+                commandManager.commandStatusChanged();
+            }
+            return changed;
+        }
         case CommandIDs::quit:
             logToStderr("Quit requested");
             juce::JUCEApplication::getInstance()->systemRequestedQuit();
@@ -40,6 +40,8 @@ public:
         redo,
         showSettings,
         runTests,
+        exportSessionJson,
+        renderStems,
         audioSettings = 11001
     };
 
@@ -61,6 +63,7 @@ private:
 
     void createMenuBarModel();
     void runUnitTests();
+    void refreshMixerViews();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainApp)
 };
@@ -0,0 +1,325 @@
+#include "MultitrackPlayer.h"
+#include "MultitrackRecorder.h"
+
+MultitrackPlayer::MultitrackPlayer(int numChannelsToPlay)
+    : juce::Thread("Multitrack prefetch"),
+      numChannels(numChannelsToPlay)
+{
+}
+
+MultitrackPlayer::~MultitrackPlayer()
+{
+    close();
+}
+
+bool MultitrackPlayer::open(const juce::File& takeFolder, double prefetchSeconds)
+{
+    close();
+
+    juce::WavAudioFormat wav;
+
+    for (int i = 0; i < numChannels; ++i)
+    {
+        const auto file = MultitrackRecorder::getChannelFile(takeFolder, i);
+        if (!file.existsAsFile())
+            continue;
+
+        // Mapped where possible, so reading is just page faults on the prefetch thread
+        std::unique_ptr<juce::AudioFormatReader> reader;
+        if (std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped { wav.createMemoryMappedReader(file) };
+            mapped != nullptr && mapped->mapEntireFile())
+            reader = std::move(mapped);
+        else
+            reader.reset(wav.createReaderFor(file.createInputStream().release(), true));
+
+        if (reader == nullptr)
+        {
+            juce::Logger::writeToLog("MultitrackPlayer: can't read " + file.getFullPathName());
+            continue;
+        }
+
+        if (fileSampleRate > 0.0 && reader->sampleRate != fileSampleRate)
+        {
+            juce::Logger::writeToLog("MultitrackPlayer: " + file.getFileName() + " doesn't match the take's sample rate, skipped");
+            continue;
+        }
+
+        fileSampleRate = reader->sampleRate;
+        lengthInSamples = juce::jmax(lengthInSamples, reader->lengthInSamples);
+
+        auto track = std::make_unique<Track>();
+        track->channelIndex = i;
+        track->reader = std::move(reader);
+        tracks.push_back(std::move(track));
+    }
+
+    if (tracks.empty() || lengthInSamples == 0)
+    {
+        juce::Logger::writeToLog("MultitrackPlayer: no tracks to play in " + takeFolder.getFullPathName());
+        close();
+        return false;
+    }
+
+    prefetchSize = juce::jmax(8192, juce::roundToInt(prefetchSeconds * fileSampleRate));
+    for (auto& track : tracks)
+    {
+        track->samples.setSize(1, prefetchSize);
+        track->fifo.setTotalSize(prefetchSize);
+    }
+
+    folder = takeFolder;
+    underruns.store(0, std::memory_order_relaxed);
+    restartFrom(0);
+
+    juce::Logger::writeToLog("MultitrackPlayer: opened " + juce::String(static_cast<int>(tracks.size())) + " tracks, "
+                             + juce::String(getLengthSeconds(), 1) + " s, from " + folder.getFullPathName());
+    return true;
+}
+
+void MultitrackPlayer::close()
+{
+    pausePlayback();
+    stopThread(2000);
+
+    tracks.clear();
+    folder = juce::File();
+    lengthInSamples = 0;
+    fileSampleRate = 0.0;
+    readPosition = 0;
+    playPosition.store(0, std::memory_order_relaxed);
+}
+
+bool MultitrackPlayer::play()
+{
+    if (!isOpen() || isPlaying())
+        return isPlaying();
+
+    const double deviceSampleRate = sampleRate.load(std::memory_order_relaxed);
+    if (fileSampleRate != deviceSampleRate)
+    {
+        juce::Logger::writeToLog("MultitrackPlayer: the take is " + juce::String(fileSampleRate) + " Hz but the device runs at "
+                                 + juce::String(deviceSampleRate) + " Hz");
+        return false;
+    }
+
+    // Played to the end: start again from the top
+    if (playPosition.load(std::memory_order_relaxed) >= lengthInSamples)
+        restartFrom(0);
+
+    playing.store(true, std::memory_order_release);
+    return true;
+}
+
+void MultitrackPlayer::stop()
+{
+    pausePlayback();
+}
+
+void MultitrackPlayer::setPosition(double seconds)
+{
+    if (!isOpen())
+        return;
+
+    const bool wasPlaying = isPlaying();
+    pausePlayback();
+    restartFrom(juce::jlimit<juce::int64>(0, lengthInSamples, static_cast<juce::int64>(std::round(seconds * fileSampleRate))));
+
+    if (wasPlaying)
+        playing.store(true, std::memory_order_release);
+}
+
+void MultitrackPlayer::setChannelLive(int channelIndex, bool shouldBeLive)
+{
+    if (auto* track = findTrack(channelIndex))
+        track->live.store(shouldBeLive, std::memory_order_relaxed);
+}
+
+bool MultitrackPlayer::isChannelLive(int channelIndex) const
+{
+    auto* track = findTrack(channelIndex);
+    return track == nullptr || track->live.load(std::memory_order_relaxed);
+}
+
+bool MultitrackPlayer::hasTrack(int channelIndex) const
+{
+    return findTrack(channelIndex) != nullptr;
+}
+
+double MultitrackPlayer::getPosition() const
+{
+    return fileSampleRate > 0.0 ? static_cast<double>(playPosition.load(std::memory_order_relaxed)) / fileSampleRate : 0.0;
+}
+
+double MultitrackPlayer::getLengthSeconds() const
+{
+    return fileSampleRate > 0.0 ? static_cast<double>(lengthInSamples) / fileSampleRate : 0.0;
+}
+
+void MultitrackPlayer::prepare(double newSampleRate, int maximumBlockSize)
+{
+    // The take only plays at the rate it was recorded at
+    if (isPlaying() && newSampleRate != sampleRate.load(std::memory_order_relaxed))
+    {
+        juce::Logger::writeToLog("MultitrackPlayer: sample rate changed, playback stopped");
+        stop();
+    }
+
+    sampleRate.store(newSampleRate, std::memory_order_relaxed);
+    blockSamples.setSize(numChannels, maximumBlockSize);
+}
+
+bool MultitrackPlayer::beginBlock() noexcept
+{
+    // Announce ourselves before checking, so stop() can wait us out
+    blocksInFlight.fetch_add(1, std::memory_order_seq_cst);
+
+    if (!playing.load(std::memory_order_seq_cst))
+    {
+        blocksInFlight.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+
+    return true;
+}
+
+const float* const* MultitrackPlayer::substituteInputs(const auralis::RoutingTable& routing, const float* const* inputChannelData,
+                                                       int& numInputChannels, int numSamples) noexcept
+{
+    // A block bigger than prepare() promised plays live rather than allocate here
+    if (numSamples > blockSamples.getNumSamples())
+        return inputChannelData;
+
+    // Every track moves by the same amount, live or not, so they never drift apart
+    int available = numSamples;
+    for (const auto& track : tracks)
+        available = juce::jmin(available, track->fifo.getNumReady());
+
+    for (const auto& track : tracks)
+    {
+        auto* destination = blockSamples.getWritePointer(track->channelIndex);
+        const auto scope = track->fifo.read(available);
+
+        if (scope.blockSize1 > 0)
+            std::copy_n(track->samples.getReadPointer(0, scope.startIndex1), scope.blockSize1, destination);
+        if (scope.blockSize2 > 0)
+            std::copy_n(track->samples.getReadPointer(0, scope.startIndex2), scope.blockSize2, destination + scope.blockSize1);
+
+        std::fill(destination + available, destination + numSamples, 0.0f);
+    }
+
+    auto position = playPosition.load(std::memory_order_relaxed) + available;
+    if (looping.load(std::memory_order_relaxed) && position >= lengthInSamples)
+        position -= lengthInSamples;
+    playPosition.store(position, std::memory_order_relaxed);
+
+    // Short of a full block: either the end of the take, or the disk fell behind
+    if (position >= lengthInSamples)
+        playing.store(false, std::memory_order_relaxed);
+    else if (available < numSamples)
+        underruns.store(underruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    // The live inputs, with each played channel's track over the input it's patched to
+    int count = juce::jmin(numInputChannels, maxInputs);
+    std::copy_n(inputChannelData, count, inputs.begin());
+
+    for (const auto& track : tracks)
+    {
+        if (track->live.load(std::memory_order_relaxed) || track->channelIndex >= routing.numChannels)
+            continue;
+
+        const int input = routing.inputForChannel[(size_t) track->channelIndex];
+        if (input < 0 || input >= maxInputs)
+            continue;
+
+        // Patched to an input this device doesn't have: add it
+        while (count <= input)
+            inputs[(size_t) count++] = nullptr;
+
+        inputs[(size_t) input] = blockSamples.getReadPointer(track->channelIndex);
+    }
+
+    numInputChannels = count;
+    return inputs.data();
+}
+
+void MultitrackPlayer::run()
+{
+    while (!threadShouldExit())
+    {
+        prefetch();
+        wait(20);
+    }
+}
+
+void MultitrackPlayer::prefetch()
+{
+    // Reads of at least a quarter of the window, so the disk sees few, big requests
+    const int minimumRead = prefetchSize / 4;
+
+    for (;;)
+    {
+        if (readPosition >= lengthInSamples)
+        {
+            if (!looping.load(std::memory_order_relaxed))
+                return;
+
+            readPosition = 0;
+        }
+
+        int space = prefetchSize;
+        for (const auto& track : tracks)
+            space = juce::jmin(space, track->fifo.getFreeSpace());
+
+        const int numToRead = static_cast<int>(juce::jmin<juce::int64>(space, lengthInSamples - readPosition));
+        if (numToRead == 0 || (numToRead < minimumRead && numToRead < lengthInSamples - readPosition))
+            return;
+
+        // Reading past the end of a shorter file gives silence
+        for (auto& track : tracks)
+        {
+            const auto scope = track->fifo.write(numToRead);
+
+            if (scope.blockSize1 > 0)
+                track->reader->read(&track->samples, scope.startIndex1, scope.blockSize1, readPosition, true, false);
+            if (scope.blockSize2 > 0)
+                track->reader->read(&track->samples, scope.startIndex2, scope.blockSize2, readPosition + scope.blockSize1, true, false);
+        }
+
+        readPosition += numToRead;
+    }
+}
+
+void MultitrackPlayer::pausePlayback()
+{
+    // The same handshake as MultitrackRecorder::stop(), so seq_cst for the same reason
+    playing.store(false, std::memory_order_seq_cst);
+
+    // A callback already past beginBlock() finishes within one block
+    while (blocksInFlight.load(std::memory_order_seq_cst) > 0)
+        juce::Thread::yield();
+}
+
+void MultitrackPlayer::restartFrom(juce::int64 position)
+{
+    // Playback is paused: nothing reads the FIFOs, and the prefetch thread is stopped here
+    stopThread(2000);
+
+    for (auto& track : tracks)
+        track->fifo.reset();
+
+    readPosition = position;
+    playPosition.store(position, std::memory_order_relaxed);
+
+    // The first window is read here, so playback never starts on an empty FIFO
+    prefetch();
+    startThread();
+}
+
+MultitrackPlayer::Track* MultitrackPlayer::findTrack(int channelIndex) const
+{
+    for (const auto& track : tracks)
+        if (track->channelIndex == channelIndex)
+            return track.get();
+
+    return nullptr;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "../Routing/RoutingManager.h"
+
+/**
+ * MultitrackPlayer - A recorded take played back in place of the live inputs
+ *
+ * Opens a folder written by MultitrackRecorder and, while playing, hands the
+ * engine a set of device inputs in which each channel's patched input
+ * carries that channel's recorded track. Everything after the input stage -
+ * the channel strips, the buses and the soundcheck capture - sees the take
+ * exactly as it saw the band, so a mix can be rehearsed or a soundcheck run
+ * with nobody on stage. Channels with no track, switched back to live, or
+ * unpatched keep their live input.
+ *
+ * Files are memory-mapped where the format allows and read through a normal
+ * reader otherwise. Either way only the prefetch thread touches them: it
+ * keeps every track's lock-free FIFO topped up to the prefetch window, in
+ * lockstep so the tracks can't drift apart, and the audio thread only copies
+ * out of the FIFOs. If the disk ever falls behind, every track plays the
+ * samples all of them have ready and silence for the rest of the block, so
+ * they stay in step, and the block is counted as an underrun.
+ *
+ * open(), play(), stop() and setPosition() are message-thread calls.
+ */
+class MultitrackPlayer : private juce::Thread
+{
+public:
+    explicit MultitrackPlayer(int numChannels);
+    ~MultitrackPlayer() override;
+
+    // Message thread
+    bool open(const juce::File& folder, double prefetchSeconds = 2.0);
+    void close();
+    bool isOpen() const { return !tracks.empty(); }
+    juce::File getFolder() const { return folder; }
+
+    bool play();
+    void stop();
+    bool isPlaying() const { return playing.load(std::memory_order_relaxed); }
+
+    /** Move the play head; playback carries on from there if it was running. */
+    void setPosition(double seconds);
+    void setLooping(bool shouldLoop) { looping.store(shouldLoop, std::memory_order_relaxed); }
+    bool isLooping() const { return looping.load(std::memory_order_relaxed); }
+
+    /** Put one channel back on its live input, or back on its track. */
+    void setChannelLive(int channelIndex, bool shouldBeLive);
+    bool isChannelLive(int channelIndex) const;
+    bool hasTrack(int channelIndex) const;
+
+    // Any thread
+    double getPosition() const;
+    double getLengthSeconds() const;
+    juce::int64 getNumUnderruns() const { return underruns.load(std::memory_order_relaxed); }
+
+    // Audio thread
+    void prepare(double sampleRate, int maximumBlockSize);
+
+    /** Returns false when not playing; otherwise call endBlock() after using the inputs. */
+    bool beginBlock() noexcept;
+    void endBlock() noexcept { blocksInFlight.fetch_sub(1, std::memory_order_release); }
+
+    /** The next block of the take laid over the live inputs. numInputChannels
+        grows if the take's patch reaches past the inputs this device has. */
+    const float* const* substituteInputs(const auralis::RoutingTable& routing, const float* const* inputChannelData,
+                                         int& numInputChannels, int numSamples) noexcept;
+
+private:
+    static constexpr int maxInputs = 256;
+
+    struct Track
+    {
+        int channelIndex = -1;
+        std::unique_ptr<juce::AudioFormatReader> reader;
+        juce::AudioBuffer<float> samples;
+        juce::AbstractFifo fifo { 1 };
+        std::atomic<bool> live { false };
+    };
+
+    void run() override;
+    void prefetch();
+    void pausePlayback();
+    void restartFrom(juce::int64 position);
+    Track* findTrack(int channelIndex) const;
+
+    const int numChannels;
+    juce::File folder;
+    std::vector<std::unique_ptr<Track>> tracks;
+    juce::int64 lengthInSamples = 0;
+    double fileSampleRate = 0.0;
+    int prefetchSize = 0;
+
+    // Prefetch thread only, or the message thread while that is stopped
+    juce::int64 readPosition = 0;
+
+    // Audio thread: one block per track, and the input pointers handed on
+    juce::AudioBuffer<float> blockSamples;
+    std::array<const float*, maxInputs> inputs {};
+
+    std::atomic<double> sampleRate { 44100.0 };     // Written by prepare(), read by play()
+    std::atomic<bool> playing { false }, looping { false };
+    std::atomic<int> blocksInFlight { 0 };
+    std::atomic<juce::int64> playPosition { 0 };
+    std::atomic<juce::int64> underruns { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultitrackPlayer)
+};
@@ -0,0 +1,347 @@
+#include "MultitrackRecorder.h"
+
+MultitrackRecorder::MultitrackRecorder(int numChannelsToRecord)
+    : juce::Thread("Multitrack recorder"),
+      numChannels(numChannelsToRecord)
+{
+}
+
+MultitrackRecorder::~MultitrackRecorder()
+{
+    stop();
+}
+
+juce::File MultitrackRecorder::getChannelFile(const juce::File& folder, int channelIndex)
+{
+    return folder.getChildFile("Ch " + juce::String(channelIndex + 1).paddedLeft('0', 2) + ".wav");
+}
+
+juce::File MultitrackRecorder::getMasterFile(const juce::File& folder)
+{
+    return folder.getChildFile("Master.wav");
+}
+
+void MultitrackRecorder::prepare(double newSampleRate)
+{
+    // A take can't change rate halfway through. The device is starting, so
+    // no block is in flight: stop taking blocks now, and leave finalising the
+    // files, which waits on the writer, to the message thread
+    if (recording.load(std::memory_order_acquire) && newSampleRate != takeSampleRate)
+    {
+        recording.store(false, std::memory_order_seq_cst);
+        juce::Logger::writeToLog("MultitrackRecorder: sample rate changed, recording stopped");
+        triggerAsyncUpdate();
+    }
+
+    sampleRate.store(newSampleRate, std::memory_order_relaxed);
+}
+
+void MultitrackRecorder::handleAsyncUpdate()
+{
+    stop();
+}
+
+bool MultitrackRecorder::start(const Settings& settings)
+{
+    if (isRecording())
+        return false;
+
+    // Finish a take the device stopped before starting over
+    handleUpdateNowIfNeeded();
+
+    if (!settings.folder.createDirectory())
+    {
+        juce::Logger::writeToLog("MultitrackRecorder: can't create " + settings.folder.getFullPathName());
+        return false;
+    }
+
+    takeSampleRate = sampleRate.load(std::memory_order_relaxed);
+    const int capacity = juce::jmax(4096, juce::roundToInt(settings.bufferSeconds * takeSampleRate));
+    juce::WavAudioFormat wav;
+
+    auto addTrack = [&](const juce::File& file, int numTrackChannels)
+    {
+        auto track = std::make_unique<Track>();
+        track->samples.setSize(numTrackChannels, capacity);
+        track->fifo.setTotalSize(capacity);
+        track->gaps.allocate(gapCapacity, true);
+
+        // Large buffered writes: the disk sees megabytes at a time, not blocks
+        file.deleteFile();
+        std::unique_ptr<juce::OutputStream> stream(file.createOutputStream(1 << 20));
+        if (stream == nullptr)
+        {
+            juce::Logger::writeToLog("MultitrackRecorder: can't write " + file.getFullPathName());
+            return false;
+        }
+
+        track->writer.reset(wav.createWriterFor(stream.get(), takeSampleRate, static_cast<unsigned int>(numTrackChannels),
+                                                settings.bitDepth, {}, 0));
+        if (track->writer == nullptr)
+        {
+            juce::Logger::writeToLog("MultitrackRecorder: can't create a " + juce::String(settings.bitDepth) + "-bit WAV writer");
+            return false;
+        }
+
+        stream.release();   // Now owned by the writer
+        tracks.push_back(std::move(track));
+        return true;
+    };
+
+    tracks.clear();
+    recordingMaster = settings.recordMaster;
+
+    bool opened = true;
+    for (int i = 0; i < numChannels && opened; ++i)
+        opened = addTrack(getChannelFile(settings.folder, i), 1);
+
+    if (opened && recordingMaster)
+        opened = addTrack(getMasterFile(settings.folder), 2);
+
+    if (!opened)
+    {
+        tracks.clear();
+        return false;
+    }
+
+    silence.setSize(2, 8192);
+    silence.clear();
+    recordedSamples.store(0, std::memory_order_relaxed);
+    writeError.store(false, std::memory_order_relaxed);
+
+    startThread();
+    recording.store(true, std::memory_order_release);
+
+    juce::Logger::writeToLog("MultitrackRecorder: recording " + juce::String(static_cast<int>(tracks.size()))
+                             + " tracks to " + settings.folder.getFullPathName());
+    return true;
+}
+
+void MultitrackRecorder::stop()
+{
+    if (!isRecording() && !isThreadRunning())
+        return;
+
+    // Store then load here, fetch_add then load in beginBlock(): only seq_cst
+    // on all four keeps both sides from missing the other's write
+    recording.store(false, std::memory_order_seq_cst);
+
+    // A callback already past beginBlock() finishes within one block
+    while (blocksInFlight.load(std::memory_order_seq_cst) > 0)
+        juce::Thread::yield();
+
+    // The writer drains everything left before it exits
+    stopThread(10000);
+
+    for (auto& track : tracks)
+    {
+        // Blocks dropped at the very end never got a gap entry; pad them here so all files end together
+        for (int done = 0; done < track->pendingGap;)
+        {
+            const int chunk = juce::jmin(track->pendingGap - done, silence.getNumSamples());
+            writeSamples(*track, silence.getArrayOfReadPointers(), chunk);
+            done += chunk;
+        }
+
+        track->pendingGap = 0;
+        track->writer.reset();
+    }
+
+    juce::Logger::writeToLog("MultitrackRecorder: stopped after " + juce::String(getRecordedSeconds(), 1) + " s, "
+                             + juce::String(getNumDroppedBlocks()) + " blocks dropped");
+}
+
+double MultitrackRecorder::getRecordedSeconds() const
+{
+    return static_cast<double>(recordedSamples.load(std::memory_order_relaxed)) / takeSampleRate;
+}
+
+juce::int64 MultitrackRecorder::getNumDroppedBlocks() const
+{
+    juce::int64 total = 0;
+    for (const auto& track : tracks)
+        total += track->droppedBlocks.load(std::memory_order_relaxed);
+    return total;
+}
+
+juce::int64 MultitrackRecorder::getNumDroppedSamples() const
+{
+    juce::int64 total = 0;
+    for (const auto& track : tracks)
+        total += track->droppedSamples.load(std::memory_order_relaxed);
+    return total;
+}
+
+bool MultitrackRecorder::beginBlock() noexcept
+{
+    // Announce ourselves before checking, so stop() can wait us out
+    blocksInFlight.fetch_add(1, std::memory_order_seq_cst);
+
+    if (!recording.load(std::memory_order_seq_cst))
+    {
+        blocksInFlight.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+
+    return true;
+}
+
+void MultitrackRecorder::pushInputs(const auralis::RoutingTable& routing, const float* const* inputChannelData,
+                                    int numInputChannels, int numSamples) noexcept
+{
+    for (int i = 0; i < numChannels; ++i)
+    {
+        // Unpatched channels record silence, so every file lines up
+        const int input = i < routing.numChannels ? routing.inputForChannel[(size_t) i] : -1;
+        const float* source = input >= 0 && input < numInputChannels ? inputChannelData[input] : nullptr;
+        tracks[(size_t) i]->push(&source, numSamples);
+    }
+
+    recordedSamples.store(recordedSamples.load(std::memory_order_relaxed) + numSamples, std::memory_order_relaxed);
+}
+
+void MultitrackRecorder::pushMaster(const juce::AudioBuffer<float>& mix, int numSamples) noexcept
+{
+    if (!recordingMaster)
+        return;
+
+    const float* channels[] = { mix.getReadPointer(0), mix.getReadPointer(juce::jmin(1, mix.getNumChannels() - 1)) };
+    tracks.back()->push(channels, numSamples);
+}
+
+void MultitrackRecorder::Track::push(const float* const* channelData, int numSamples) noexcept
+{
+    // Note the last gap before anything after it, or the writer couldn't place it
+    if (pendingGap > 0 && gapFifo.getFreeSpace() > 0 && fifo.getFreeSpace() >= numSamples)
+    {
+        int start1, size1, start2, size2;
+        gapFifo.prepareToWrite(1, start1, size1, start2, size2);
+        gaps[start1] = { samplesPushed, pendingGap };
+        gapFifo.finishedWrite(1);
+
+        samplesPushed += pendingGap;
+        pendingGap = 0;
+    }
+
+    if (pendingGap > 0 || fifo.getFreeSpace() < numSamples)
+    {
+        pendingGap += numSamples;
+        droppedBlocks.store(droppedBlocks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        droppedSamples.store(droppedSamples.load(std::memory_order_relaxed) + numSamples, std::memory_order_relaxed);
+        return;
+    }
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    for (int channel = 0; channel < samples.getNumChannels(); ++channel)
+    {
+        if (channelData[channel] == nullptr)
+        {
+            samples.clear(channel, start1, size1);
+            if (size2 > 0)
+                samples.clear(channel, start2, size2);
+            continue;
+        }
+
+        samples.copyFrom(channel, start1, channelData[channel], size1);
+        if (size2 > 0)
+            samples.copyFrom(channel, start2, channelData[channel] + size1, size2);
+    }
+
+    fifo.finishedWrite(size1 + size2);
+    samplesPushed += numSamples;
+}
+
+void MultitrackRecorder::run()
+{
+    while (!threadShouldExit())
+    {
+        writePending(false);
+        wait(100);
+    }
+
+    writePending(true);
+}
+
+void MultitrackRecorder::writePending(bool flushEverything)
+{
+    for (auto& track : tracks)
+        writeTrack(*track, flushEverything);
+}
+
+void MultitrackRecorder::writeTrack(Track& track, bool flushEverything)
+{
+    // Big batches, but never so big the FIFO fills waiting for one
+    const int minimumBatch = juce::jmin(juce::roundToInt(takeSampleRate / 4.0), track.fifo.getTotalSize() / 2);
+
+    for (;;)
+    {
+        // Samples first: a gap is always published before the samples after it
+        int numSamples = track.fifo.getNumReady();
+        bool upToGap = false;
+
+        if (track.gapFifo.getNumReady() > 0)
+        {
+            int start1, size1, start2, size2;
+            track.gapFifo.prepareToRead(1, start1, size1, start2, size2);
+            const auto gap = track.gaps[start1];
+
+            if (gap.position <= track.samplesRead)
+            {
+                for (int done = 0; done < gap.numSamples;)
+                {
+                    const int chunk = juce::jmin(gap.numSamples - done, silence.getNumSamples());
+                    writeSamples(track, silence.getArrayOfReadPointers(), chunk);
+                    done += chunk;
+                }
+
+                track.samplesRead += gap.numSamples;
+                track.gapFifo.finishedRead(1);
+                continue;
+            }
+
+            numSamples = static_cast<int>(juce::jmin<juce::int64>(numSamples, gap.position - track.samplesRead));
+            upToGap = true;
+        }
+
+        if (numSamples == 0 || (!flushEverything && !upToGap && numSamples < minimumBatch))
+            return;
+
+        int start1, size1, start2, size2;
+        track.fifo.prepareToRead(numSamples, start1, size1, start2, size2);
+
+        const float* channels[2];
+        for (int channel = 0; channel < track.samples.getNumChannels(); ++channel)
+            channels[channel] = track.samples.getReadPointer(channel, start1);
+        writeSamples(track, channels, size1);
+
+        if (size2 > 0)
+        {
+            for (int channel = 0; channel < track.samples.getNumChannels(); ++channel)
+                channels[channel] = track.samples.getReadPointer(channel, start2);
+            writeSamples(track, channels, size2);
+        }
+
+        track.fifo.finishedRead(size1 + size2);
+        track.samplesRead += size1 + size2;
+    }
+}
+
+bool MultitrackRecorder::writeSamples(Track& track, const float* const* channelData, int numSamples)
+{
+    // After a failed write the track is closed and the rest of its audio discarded
+    if (track.writer == nullptr)
+        return false;
+
+    if (!track.writer->writeFromFloatArrays(channelData, track.samples.getNumChannels(), numSamples))
+    {
+        if (!writeError.exchange(true))
+            juce::Logger::writeToLog("MultitrackRecorder: write failed, is the disk full?");
+
+        track.writer.reset();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "../Routing/RoutingManager.h"
+
+/**
+ * MultitrackRecorder - Every channel's raw input and the master mix to disk
+ *
+ * One mono track per mixer channel, taken from its patched device input
+ * before any processing (silence while unpatched), and a stereo master
+ * track, all sample-aligned, written as WAV files into one folder. The WAV
+ * writer switches a file to RF64 on its own if it grows past 4 GB.
+ *
+ * The audio thread copies each block into its track's lock-free FIFO and
+ * never waits: if a FIFO is full because the disk has fallen behind, the
+ * block is dropped and counted, and the gap is noted in a small side FIFO so
+ * the writer fills it with silence and every track stays aligned with the
+ * others. A single writer thread drains the FIFOs in batches of at least a
+ * quarter of a second into files with large write buffers, so the disk sees
+ * few, big writes.
+ *
+ * start() and stop() are message-thread calls; stop() waits for the audio
+ * thread to leave the current block and for the writer to flush everything
+ * it has been given. A sample rate change mid-take ends the take at once,
+ * and the files are finalised on the message thread shortly after.
+ */
+class MultitrackRecorder : private juce::Thread,
+                           private juce::AsyncUpdater
+{
+public:
+    struct Settings
+    {
+        juce::File folder;                  // Created if missing; existing takes are overwritten
+        int bitDepth = 24;
+        double bufferSeconds = 4.0;         // Per track, how long the disk may stall before blocks drop
+        bool recordMaster = true;
+    };
+
+    explicit MultitrackRecorder(int numChannels);
+    ~MultitrackRecorder() override;
+
+    // Message thread
+    bool start(const Settings& settings);
+    void stop();
+    bool isRecording() const { return recording.load(std::memory_order_relaxed); }
+
+    /** Where a take keeps each channel's and the master's file. */
+    static juce::File getChannelFile(const juce::File& folder, int channelIndex);
+    static juce::File getMasterFile(const juce::File& folder);
+
+    // Any thread, for the current or last take
+    double getRecordedSeconds() const;
+    juce::int64 getNumDroppedBlocks() const;
+    juce::int64 getNumDroppedSamples() const;
+    bool hasWriteError() const { return writeError.load(std::memory_order_relaxed); }
+
+    // Device thread, with no callback running
+    void prepare(double sampleRate);
+
+    // Audio thread
+    /** Returns false when not recording; otherwise call endBlock() after the pushes. */
+    bool beginBlock() noexcept;
+    void endBlock() noexcept { blocksInFlight.fetch_sub(1, std::memory_order_release); }
+
+    void pushInputs(const auralis::RoutingTable& routing, const float* const* inputChannelData,
+                    int numInputChannels, int numSamples) noexcept;
+    void pushMaster(const juce::AudioBuffer<float>& mix, int numSamples) noexcept;
+
+private:
+    static constexpr int gapCapacity = 64;
+
+    struct Gap
+    {
+        juce::int64 position;       // Where the silence starts, in samples from the start of the take
+        int numSamples;
+    };
+
+    struct Track
+    {
+        juce::AudioBuffer<float> samples;
+        juce::AbstractFifo fifo { 1 };
+        juce::HeapBlock<Gap> gaps;
+        juce::AbstractFifo gapFifo { gapCapacity };
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+
+        // Audio thread only
+        juce::int64 samplesPushed = 0;
+        int pendingGap = 0;
+
+        // Writer thread only
+        juce::int64 samplesRead = 0;
+
+        std::atomic<juce::int64> droppedBlocks { 0 }, droppedSamples { 0 };
+
+        void push(const float* const* channelData, int numSamples) noexcept;
+    };
+
+    void run() override;
+    void handleAsyncUpdate() override;
+    void writePending(bool flushEverything);
+    void writeTrack(Track& track, bool flushEverything);
+    bool writeSamples(Track& track, const float* const* channelData, int numSamples);
+
+    const int numChannels;
+    std::vector<std::unique_ptr<Track>> tracks;     // Channels, then the master if recorded
+    bool recordingMaster = false;
+    juce::AudioBuffer<float> silence;               // Source for the writer's gap fills
+
+    std::atomic<double> sampleRate { 44100.0 };     // The device's, from prepare()
+    double takeSampleRate = 44100.0;                // Fixed by start() for the take
+    std::atomic<bool> recording { false };
+    std::atomic<int> blocksInFlight { 0 };
+    std::atomic<juce::int64> recordedSamples { 0 };
+    std::atomic<bool> writeError { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultitrackRecorder)
+};
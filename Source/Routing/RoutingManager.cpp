@@ -1,113 +1,172 @@
 #include "RoutingManager.h"
-#include "../MainApp.h"
+#include "../Audio/AudioEngine.h"
 
 namespace auralis {
 
+// Group and FX assignments start from the channel type
+static void getDefaultBuses(ChannelProcessor::ChannelType type, int& group, int& fxBus)
+{
+    switch (type)
+    {
+        case ChannelProcessor::ChannelType::Vocal:      group = 0; fxBus = 0; break;   // Vocal FX bus
+        case ChannelProcessor::ChannelType::Instrument: group = 1; fxBus = 1; break;   // Instrument FX bus
+        case ChannelProcessor::ChannelType::Drums:      group = 2; fxBus = 2; break;   // Drum FX bus
+        case ChannelProcessor::ChannelType::Other:      group = 3; fxBus = -1; break;  // Speech, no FX
+    }
+}
+
 RoutingManager& RoutingManager::getInstance()
 {
     static RoutingManager instance;
     return instance;
 }
 
+RoutingManager::RoutingManager()
+{
+    editing.inputForChannel.fill(-1);
+    editing.groupForChannel.fill(-1);
+    editing.fxBusForChannel.fill(-1);
+    editing.groupToMaster.fill(true);
+
+    // The audio thread always has a table to read, even before initialize()
+    publish();
+}
+
 void RoutingManager::initialize(const std::vector<std::unique_ptr<ChannelProcessor>>& channels,
-                              const std::vector<std::unique_ptr<FXBusProcessor>>& fxBuses)
+                              const std::vector<std::unique_ptr<FXBusProcessor>>& fxBuses,
+                              int numGroupBuses)
 {
-    // Initialize FX bus assignments based on channel types
-    fxBusAssignments.resize(channels.size());
-    
-    for (size_t i = 0; i < channels.size(); ++i)
+    editing.numChannels = juce::jmin(static_cast<int>(channels.size()), RoutingTable::maxChannels);
+    editing.numFXBuses = juce::jmin(static_cast<int>(fxBuses.size()), RoutingTable::maxFXBuses);
+    editing.numGroupBuses = juce::jmin(numGroupBuses, RoutingTable::maxGroupBuses);
+
+    channelProcessors.clear();
+    for (const auto& channel : channels)
+        channelProcessors.push_back(channel.get());
+
+    fxBusProcessors.clear();
+    for (const auto& bus : fxBuses)
+        fxBusProcessors.push_back(bus.get());
+
+    for (int i = 0; i < editing.numChannels; ++i)
     {
-        const auto& channel = channels[i];
-        switch (channel->getChannelType())
-        {
-            case ChannelProcessor::ChannelType::Vocal:
-                fxBusAssignments.set(i, 0); // Vocal FX bus
-                break;
-            case ChannelProcessor::ChannelType::Instrument:
-                fxBusAssignments.set(i, 1); // Instrument FX bus
-                break;
-            case ChannelProcessor::ChannelType::Drums:
-                fxBusAssignments.set(i, 2); // Drum FX bus
-                break;
-            default:
-                fxBusAssignments.set(i, -1); // No FX bus
-                break;
-        }
+        int group = -1, fxBus = -1;
+        getDefaultBuses(channels[i]->getChannelType(), group, fxBus);
+
+        editing.groupForChannel[i] = group < editing.numGroupBuses ? group : -1;
+        editing.fxBusForChannel[i] = fxBus < editing.numFXBuses ? fxBus : -1;
+        editing.inputForChannel[i] = -1;
+
+        channels[i]->setFxBusProcessor(editing.fxBusForChannel[i] >= 0 ? fxBusProcessors[editing.fxBusForChannel[i]] : nullptr);
     }
-    
-    // Initialize input map to unassigned (-1)
-    inputMap.resize(channels.size());
-    for (int i = 0; i < inputMap.size(); ++i)
-        inputMap.set(i, -1);
+
+    publish();
 }
 
 void RoutingManager::assignFXBus(int channelIndex, int busIndex)
 {
-    if (channelIndex < 0 || channelIndex >= numChannels)
+    if (channelIndex < 0 || channelIndex >= editing.numChannels || busIndex >= editing.numFXBuses)
         return;
-        
-    // Resize the assignments array if needed
-    if (fxBusAssignments.size() <= channelIndex)
-    {
-        const int oldSize = fxBusAssignments.size();
-        fxBusAssignments.resize(channelIndex + 1);
-        // Initialize new elements to -1
-        for (int i = oldSize; i < fxBusAssignments.size(); ++i)
-            fxBusAssignments.set(i, -1);
-    }
-        
-    fxBusAssignments.set(channelIndex, busIndex);
+
+    editing.fxBusForChannel[channelIndex] = juce::jmax(-1, busIndex);
+
+    // The channel keeps the bus pointer for its send-level bookkeeping
+    if (channelIndex < static_cast<int>(channelProcessors.size()))
+        channelProcessors[channelIndex]->setFxBusProcessor(busIndex >= 0 ? fxBusProcessors[busIndex] : nullptr);
+
+    publish();
 }
 
 int RoutingManager::getFXBusAssignment(int channelIndex) const
 {
-    if (channelIndex < 0 || channelIndex >= numChannels || channelIndex >= fxBusAssignments.size())
+    if (channelIndex < 0 || channelIndex >= editing.numChannels)
         return -1;
-        
-    return fxBusAssignments[channelIndex];
+
+    return editing.fxBusForChannel[channelIndex];
+}
+
+void RoutingManager::assignGroupBus(int channelIndex, int busIndex)
+{
+    if (channelIndex < 0 || channelIndex >= editing.numChannels || busIndex >= editing.numGroupBuses)
+        return;
+
+    editing.groupForChannel[channelIndex] = juce::jmax(-1, busIndex);
+    publish();
+}
+
+int RoutingManager::getGroupBusAssignment(int channelIndex) const
+{
+    if (channelIndex < 0 || channelIndex >= editing.numChannels)
+        return -1;
+
+    return editing.groupForChannel[channelIndex];
+}
+
+void RoutingManager::setGroupToMaster(int busIndex, bool shouldFeedMaster)
+{
+    if (busIndex < 0 || busIndex >= editing.numGroupBuses)
+        return;
+
+    editing.groupToMaster[busIndex] = shouldFeedMaster;
+    publish();
+}
+
+bool RoutingManager::isGroupToMaster(int busIndex) const
+{
+    return busIndex >= 0 && busIndex < editing.numGroupBuses && editing.groupToMaster[busIndex];
 }
 
 void RoutingManager::assignPhysicalInput(int channelIdx, int deviceChanIdx)
 {
-    if (channelIdx < 0 || channelIdx >= numChannels)
+    if (channelIdx < 0 || channelIdx >= editing.numChannels)
         return;
-        
-    // Resize the map if needed
-    if (inputMap.size() <= channelIdx)
-    {
-        const int oldSize = inputMap.size();
-        inputMap.resize(channelIdx + 1);
-        // Initialize new elements to -1
-        for (int i = oldSize; i < inputMap.size(); ++i)
-            inputMap.set(i, -1);
-    }
-        
-    inputMap.set(channelIdx, deviceChanIdx);
+
+    editing.inputForChannel[channelIdx] = juce::jmax(-1, deviceChanIdx);
+    publish();
 }
 
 int RoutingManager::getPhysicalInput(int channelIdx) const
 {
-    if (channelIdx < 0 || channelIdx >= numChannels || channelIdx >= inputMap.size())
+    if (channelIdx < 0 || channelIdx >= editing.numChannels)
         return -1;
-        
-    return inputMap[channelIdx];
+
+    return editing.inputForChannel[channelIdx];
 }
 
 int RoutingManager::getNumPhysicalInputs() const
 {
-    if (auto* app = dynamic_cast<MainApp*>(juce::JUCEApplication::getInstance()))
-    {
-        auto* device = app->getAudioEngine().getAudioDeviceManager().getCurrentAudioDevice();
+    auto* device = deviceManager != nullptr ? deviceManager->getCurrentAudioDevice() : nullptr;
+
+    // Ensure the audio device exists and is currently active before querying it.
+    if (device != nullptr && device->isOpen())
+        return device->getInputChannelNames().size();
+
+    // No device, or it is changing
+    return 0;
+}
+
+RoutingTable RoutingManager::createDefaultTable(AudioEngine& engine)
+{
+    RoutingTable table;
+    table.numChannels = juce::jmin(engine.getNumChannels(), RoutingTable::maxChannels);
+    table.numGroupBuses = juce::jmin(engine.getNumGroupBuses(), RoutingTable::maxGroupBuses);
+    table.numFXBuses = juce::jmin(engine.getNumFXBuses(), RoutingTable::maxFXBuses);
+    table.inputForChannel.fill(-1);
+    table.groupForChannel.fill(-1);
+    table.fxBusForChannel.fill(-1);
+    table.groupToMaster.fill(true);
 
-        // Ensure the audio device exists and is currently active before querying it.
-        if (device != nullptr && device->isOpen())
-            return device->getInputChannelNames().size();
+    for (int i = 0; i < table.numChannels; ++i)
+    {
+        int group = -1, fxBus = -1;
+        if (auto* channel = engine.getChannelProcessor(i))
+            getDefaultBuses(channel->getChannelType(), group, fxBus);
 
-        // Device is unavailable or changing
-        return 0;
+        table.groupForChannel[i] = group < table.numGroupBuses ? group : -1;
+        table.fxBusForChannel[i] = fxBus < table.numFXBuses ? fxBus : -1;
     }
 
-    return 0;
+    return table;
 }
 
 int RoutingManager::getMaxChannelsForPlan(auralis::Plan plan)
@@ -121,4 +180,44 @@ int RoutingManager::getMaxChannelsForPlan(auralis::Plan plan)
     return 32;
 }
 
+//==============================================================================
+void RoutingManager::publish()
+{
+    auto table = std::make_unique<RoutingTable>(editing);
+    table->generation = ++lastGeneration;
+
+    currentTable.store(table.get(), std::memory_order_release);
+    ownedTables.push_back(std::move(table));
+
+    collectGarbage();
+}
+
+void RoutingManager::collectGarbage()
+{
+    const auto* current = currentTable.load(std::memory_order_relaxed);
+
+    // With no audio thread running nothing but the current table can be in use
+    const auto acknowledged = running.load() ? acknowledgedGeneration.load(std::memory_order_acquire)
+                                             : current->generation;
+
+    // Once the audio thread has picked up a generation it never looks at older ones again
+    ownedTables.erase(std::remove_if(ownedTables.begin(), ownedTables.end(),
+                                     [acknowledged, current](const auto& t)
+                                     { return t.get() != current && t->generation < acknowledged; }),
+                      ownedTables.end());
+}
+
+const RoutingTable& RoutingManager::acquireTable() noexcept
+{
+    const auto* table = currentTable.load(std::memory_order_acquire);
+    acknowledgedGeneration.store(table->generation, std::memory_order_release);
+    return *table;
+}
+
+void RoutingManager::released()
+{
+    running.store(false);
+    acknowledgedGeneration.store(currentTable.load(std::memory_order_acquire)->generation, std::memory_order_release);
+}
+
 } // namespace auralis
@@ -1,33 +1,87 @@
 #pragma once
 #include <JuceHeader.h>
+#include <array>
 #include "../Audio/ChannelProcessor.h"
 #include "../Audio/FXBusProcessor.h"
 #include "Subscription/SubscriptionManager.h"
 
+class AudioEngine;
+
 namespace auralis {
 
+/**
+ * RoutingTable - One immutable, flat snapshot of every assignment
+ *
+ * The audio callback reads it without locks. It is never modified once
+ * published; a repatch publishes a new table instead.
+ */
+struct RoutingTable
+{
+    static constexpr int maxChannels = 64;      // Largest subscription plan
+    static constexpr int maxGroupBuses = 8;
+    static constexpr int maxFXBuses = 8;
+
+    int numChannels = 0;
+    int numGroupBuses = 0;
+    int numFXBuses = 0;
+
+    std::array<int, maxChannels> inputForChannel;   // Device input, -1 = none
+    std::array<int, maxChannels> groupForChannel;   // Group bus, -1 = none
+    std::array<int, maxChannels> fxBusForChannel;   // FX send bus, -1 = none
+    std::array<bool, maxGroupBuses> groupToMaster;
+
+    juce::uint32 generation = 0;
+};
+
+/**
+ * RoutingManager - Input, group, FX send and master assignments
+ *
+ * The message thread edits the assignments; every edit compiles a new
+ * RoutingTable and publishes it with one atomic pointer exchange, so a
+ * repatch takes effect at the next audio block. Replaced tables are freed
+ * once the audio thread has acknowledged a newer generation.
+ */
 class RoutingManager
 {
 public:
     static RoutingManager& getInstance();
-    
+
     // Initialize with processors
     void initialize(const std::vector<std::unique_ptr<ChannelProcessor>>& channels,
-                   const std::vector<std::unique_ptr<FXBusProcessor>>& fxBuses);
-    
+                   const std::vector<std::unique_ptr<FXBusProcessor>>& fxBuses,
+                   int numGroupBuses);
+
     // Get the number of channels
-    int getNumChannels() const { return numChannels; }
-    
+    int getNumChannels() const { return editing.numChannels; }
+
     // Get/Set FX bus assignments
     void assignFXBus(int channelIndex, int busIndex);
     int getFXBusAssignment(int channelIndex) const;
-    
+
+    // Get/Set group bus assignments
+    void assignGroupBus(int channelIndex, int busIndex);
+    int getGroupBusAssignment(int channelIndex) const;
+
+    // Get/Set whether a group bus feeds the master bus
+    void setGroupToMaster(int busIndex, bool shouldFeedMaster);
+    bool isGroupToMaster(int busIndex) const;
+
     // Get/Set physical input assignments
     void assignPhysicalInput(int channelIdx, int deviceChanIdx);
     int getPhysicalInput(int channelIdx) const;
-    
-    // Get the number of physical inputs
+
+    // Get the number of physical inputs on the device in use
     int getNumPhysicalInputs() const;
+    void setAudioDeviceManager(juce::AudioDeviceManager* manager) { deviceManager = manager; }
+
+    // A copy of the current assignments, e.g. to route an offline render the same way
+    RoutingTable getAssignments() const { return editing; }
+
+    // Published tables not yet freed: the current one and any the audio thread may still be reading
+    int getNumRetainedTables() const { return static_cast<int>(ownedTables.size()); }
+
+    // The assignments initialize() starts from, for any engine
+    static RoutingTable createDefaultTable(AudioEngine& engine);
 
     /**
      * Return the maximum number of channels allowed for the given
@@ -35,16 +89,36 @@ public:
      * how many channels can be shown or routed.
      */
     static int getMaxChannelsForPlan(auralis::Plan plan);
-    
+
+    //==============================================================================
+    // Audio thread
+
+    /** The table to use for this block. Call once at the start of each block. */
+    const RoutingTable& acquireTable() noexcept;
+
+    void prepare() { running.store(true); }
+    void released();
+
 private:
-    RoutingManager() = default;
+    RoutingManager();
     ~RoutingManager() = default;
-    
-    static constexpr int numChannels = 32;
-    juce::Array<int> fxBusAssignments;
-    juce::Array<int> inputMap;
-    
+
+    void publish();
+    void collectGarbage();
+
+    // Message thread: the assignments the next table is compiled from
+    RoutingTable editing;
+    std::vector<FXBusProcessor*> fxBusProcessors;
+    std::vector<ChannelProcessor*> channelProcessors;
+    juce::AudioDeviceManager* deviceManager = nullptr;
+    std::vector<std::unique_ptr<RoutingTable>> ownedTables;
+    juce::uint32 lastGeneration = 0;
+
+    std::atomic<const RoutingTable*> currentTable { nullptr };
+    std::atomic<juce::uint32> acknowledgedGeneration { 0 };
+    std::atomic<bool> running { false };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RoutingManager)
-}; 
+};
 
-} // namespace auralis 
\ No newline at end of file
+} // namespace auralis
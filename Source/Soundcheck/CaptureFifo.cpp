@@ -0,0 +1,112 @@
+#include "CaptureFifo.h"
+
+void CaptureFifo::prepare(int numChannels, int numSamples)
+{
+    samples.setSize(numChannels, numSamples);
+    sampleFifo.setTotalSize(numSamples);
+
+    if (blocks == nullptr)
+        blocks.allocate(blockCapacity, true);
+
+    reset();
+}
+
+void CaptureFifo::reset()
+{
+    sampleFifo.reset();
+    blockFifo.reset();
+    samples.clear();
+}
+
+CaptureFifo::Region CaptureFifo::prepareToWrite(int numSamples) const
+{
+    Region region;
+
+    // Every write needs a block record as well as room for the samples
+    if (numSamples <= 0 || blockFifo.getFreeSpace() == 0)
+        return region;
+
+    sampleFifo.prepareToWrite(numSamples, region.start1, region.size1, region.start2, region.size2);
+    return region;
+}
+
+void CaptureFifo::writeChannel(int channel, const Region& region, const float* source)
+{
+    if (source == nullptr)
+    {
+        samples.clear(channel, region.start1, region.size1);
+        if (region.size2 > 0)
+            samples.clear(channel, region.start2, region.size2);
+        return;
+    }
+
+    samples.copyFrom(channel, region.start1, source, region.size1);
+    if (region.size2 > 0)
+        samples.copyFrom(channel, region.start2, source + region.size1, region.size2);
+}
+
+void CaptureFifo::finishedWrite(const Region& region, juce::uint32 epoch, int mixerChannel)
+{
+    if (region.getTotal() == 0)
+        return;
+
+    // Publish the samples before the record that describes them, so a reader
+    // that sees the record always finds the samples
+    sampleFifo.finishedWrite(region.getTotal());
+
+    int start1, size1, start2, size2;
+    blockFifo.prepareToWrite(1, start1, size1, start2, size2);
+    jassert(size1 == 1); // prepareToWrite() checked for a free record
+
+    blocks[start1] = { epoch, mixerChannel, region.getTotal() };
+    blockFifo.finishedWrite(1);
+}
+
+CaptureFifo::Region CaptureFifo::prepareToRead(juce::uint32 epoch, int& mixerChannel)
+{
+    Region region;
+
+    const int numRecords = blockFifo.getNumReady();
+    if (numRecords == 0)
+        return region;
+
+    int start1, size1, start2, size2;
+    blockFifo.prepareToRead(numRecords, start1, size1, start2, size2);
+
+    int recordsConsumed = 0;
+    int samplesForEpoch = 0;
+
+    for (int i = 0; i < size1 + size2; ++i)
+    {
+        const auto& record = blocks[i < size1 ? start1 + i : start2 + (i - size1)];
+
+        if (record.epoch != epoch)
+        {
+            // Left over from an earlier measurement. Records are in capture order,
+            // so stale ones can only come before the samples we want.
+            if (samplesForEpoch > 0)
+                break;
+
+            sampleFifo.finishedRead(record.numSamples);
+            ++recordsConsumed;
+            continue;
+        }
+
+        mixerChannel = record.mixerChannel;
+        samplesForEpoch += record.numSamples;
+        ++recordsConsumed;
+    }
+
+    // The samples stay reserved until finishedRead(), so the records can go now
+    blockFifo.finishedRead(recordsConsumed);
+
+    if (samplesForEpoch > 0)
+        sampleFifo.prepareToRead(samplesForEpoch, region.start1, region.size1, region.start2, region.size2);
+
+    return region;
+}
+
+void CaptureFifo::finishedRead(const Region& region)
+{
+    sampleFifo.finishedRead(region.getTotal());
+}
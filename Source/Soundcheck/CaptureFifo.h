@@ -0,0 +1,64 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * CaptureFifo - Single-producer, single-consumer FIFO for soundcheck capture
+ *
+ * The audio thread writes multichannel blocks, the analysis thread reads them.
+ * Every block is tagged with the measurement epoch it was captured for and
+ * the mixer channel it belongs to, in a side FIFO of block records. The reader
+ * asks for one epoch and silently discards anything older, so switching to a
+ * new measurement never requires either side to reset shared indices.
+ *
+ * Neither side ever blocks or allocates. prepare() and reset() are the only
+ * non-thread-safe calls and must run while nothing is reading or writing.
+ */
+class CaptureFifo
+{
+public:
+    // A contiguous-or-wrapped span of the sample ring
+    struct Region
+    {
+        int start1 = 0, size1 = 0, start2 = 0, size2 = 0;
+        int getTotal() const { return size1 + size2; }
+    };
+
+    CaptureFifo() = default;
+
+    // Allocation - call only while neither side is running
+    void prepare(int numChannels, int numSamples);
+    void reset();
+    int getNumChannels() const { return samples.getNumChannels(); }
+
+    // Producer side (audio thread). The region may be shorter than asked
+    // for, or empty, when the reader has fallen behind.
+    Region prepareToWrite(int numSamples) const;
+    void writeChannel(int channel, const Region& region, const float* source);  // nullptr writes silence
+    void finishedWrite(const Region& region, juce::uint32 epoch, int mixerChannel);
+
+    // Consumer side (analysis thread). Returns every sample captured for the
+    // given epoch so far and the mixer channel it was captured for.
+    Region prepareToRead(juce::uint32 epoch, int& mixerChannel);
+    const float* getReadPointer(int channel, int start) const { return samples.getReadPointer(channel, start); }
+    void finishedRead(const Region& region);
+
+private:
+    struct BlockRecord
+    {
+        juce::uint32 epoch;
+        int mixerChannel;
+        int numSamples;
+    };
+
+    // Enough records for a second of 32-sample device blocks at 32 kHz
+    static constexpr int blockCapacity = 1024;
+
+    juce::AudioBuffer<float> samples;
+    juce::AbstractFifo sampleFifo { 1 };
+
+    juce::HeapBlock<BlockRecord> blocks;
+    juce::AbstractFifo blockFifo { blockCapacity };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CaptureFifo)
+};
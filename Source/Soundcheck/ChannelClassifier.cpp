@@ -0,0 +1,229 @@
+#include "ChannelClassifier.h"
+#include <limits>
+
+namespace
+{
+    using SIMDFloat = juce::dsp::SIMDRegister<float>;
+
+    static_assert(ChannelFeatures::paddedSize % SIMDFloat::SIMDNumElements == 0,
+                  "Feature rows must be a whole number of SIMD registers");
+
+    // Feature scaling: one unit is about one "clearly different" step
+    constexpr float bandUnitDb = 6.0f;          // Band shape
+    constexpr float centroidUnitOctaves = 0.5f;
+    constexpr float fluxUnit = 0.05f;
+    constexpr float crestUnitDb = 4.0f;
+    constexpr float onsetUnitPerSecond = 1.5f;
+
+    // Each descriptor counts as much as a few bands, so they aren't drowned out by 32 band terms
+    constexpr float descriptorWeight = 2.0f;
+
+    // Squared Euclidean distance between two aligned, padded feature rows
+    float squaredDistance(const float* a, const float* b) noexcept
+    {
+        auto sum = SIMDFloat::expand(0.0f);
+
+        for (int i = 0; i < ChannelFeatures::paddedSize; i += static_cast<int>(SIMDFloat::SIMDNumElements))
+        {
+            const auto difference = SIMDFloat::fromRawArray(a + i) - SIMDFloat::fromRawArray(b + i);
+            sum += difference * difference;
+        }
+
+        return sum.sum();
+    }
+}
+
+//==============================================================================
+ChannelFeatures ChannelFeatures::fromMeasurements(const juce::Array<float>& bandMagnitudesDb,
+                                                  float spectralFlux,
+                                                  float crestFactorDb,
+                                                  float onsetsPerSecond)
+{
+    ChannelFeatures features;
+    const int numMeasured = juce::jmin(numBands, bandMagnitudesDb.size());
+
+    // Remove the overall level so only the spectral shape is compared
+    float meanDb = 0.0f;
+    for (int band = 0; band < numMeasured; ++band)
+        meanDb += bandMagnitudesDb[band];
+
+    if (numMeasured > 0)
+        meanDb /= numMeasured;
+
+    for (int band = 0; band < numMeasured; ++band)
+        features.values[static_cast<size_t>(band)] = (bandMagnitudesDb[band] - meanDb) / bandUnitDb;
+
+    // Descriptors
+    const float centroid = juce::jmax(20.0f, getSpectralCentroid(bandMagnitudesDb));
+    features.values[numBands + 0] = descriptorWeight * std::log2(centroid / 1000.0f) / centroidUnitOctaves;
+    features.values[numBands + 1] = descriptorWeight * spectralFlux / fluxUnit;
+    features.values[numBands + 2] = descriptorWeight * crestFactorDb / crestUnitDb;
+    features.values[numBands + 3] = descriptorWeight * onsetsPerSecond / onsetUnitPerSecond;
+
+    return features;
+}
+
+ChannelFeatures ChannelFeatures::fromProfile(const ToneProfile& profile)
+{
+    return fromMeasurements(profile.refMagnitudes, profile.spectralFlux, profile.crestFactorDb, profile.onsetRate);
+}
+
+float ChannelFeatures::getSpectralCentroid(const juce::Array<float>& bandMagnitudesDb)
+{
+    const auto bandFrequencies = getThirdOctaveBandFrequencies();
+    const int n = juce::jmin(bandFrequencies.size(), bandMagnitudesDb.size());
+
+    // Band levels are per-bin averages; a 1/3-octave band's width grows with
+    // its centre frequency, so weight each band by f to get its energy share
+    double weightedSum = 0.0;
+    double totalWeight = 0.0;
+
+    for (int band = 0; band < n; ++band)
+    {
+        const double frequency = bandFrequencies[band];
+        const double weight = juce::Decibels::decibelsToGain(bandMagnitudesDb[band], -60.0f) * frequency;
+        weightedSum += weight * frequency;
+        totalWeight += weight;
+    }
+
+    return totalWeight > 0.0 ? static_cast<float>(weightedSum / totalWeight) : 0.0f;
+}
+
+//==============================================================================
+ChannelClassifier::ChannelClassifier()
+{
+    addBuiltInProfiles();
+}
+
+void ChannelClassifier::clear()
+{
+    numProfiles = 0;
+    profileTypes.clear();
+    profileNames.clear();
+    referenceProfiles.clear();
+}
+
+void ChannelClassifier::addBuiltInProfiles()
+{
+    using ProfileType = ToneProfileType;
+
+    struct BuiltIn { ProfileType profile; ChannelProcessor::ChannelType type; const char* name; };
+    const BuiltIn builtIns[] = {
+        { ProfileType::SingingVocal, ChannelProcessor::ChannelType::Vocal,      "Singing Vocal" },
+        { ProfileType::Speech,       ChannelProcessor::ChannelType::Vocal,      "Speech" },
+        { ProfileType::Instrument,   ChannelProcessor::ChannelType::Instrument, "Instrument" },
+        { ProfileType::Drums,        ChannelProcessor::ChannelType::Drums,      "Drums" },
+        { ProfileType::Other,        ChannelProcessor::ChannelType::Other,      "Other" }
+    };
+
+    for (const auto& builtIn : builtIns)
+        addProfile(getProfileFor(builtIn.profile), builtIn.type, builtIn.name);
+}
+
+int ChannelClassifier::addProfile(const ToneProfile& profile, ChannelProcessor::ChannelType type, const juce::String& name)
+{
+    const int index = addProfile(ChannelFeatures::fromProfile(profile), type, name);
+    referenceProfiles[static_cast<size_t>(index)] = profile;
+    return index;
+}
+
+const ToneProfile* ChannelClassifier::getReferenceProfile(int index) const
+{
+    if (index < 0 || index >= numProfiles || referenceProfiles[static_cast<size_t>(index)].refMagnitudes.isEmpty())
+        return nullptr;
+
+    return &referenceProfiles[static_cast<size_t>(index)];
+}
+
+int ChannelClassifier::addProfile(const ChannelFeatures& features, ChannelProcessor::ChannelType type, const juce::String& name)
+{
+    if (numProfiles == capacity)
+        reserve(juce::jmax(16, capacity * 2));
+
+    std::copy(features.values.begin(), features.values.end(),
+              rows + static_cast<size_t>(numProfiles) * ChannelFeatures::paddedSize);
+
+    profileTypes.push_back(type);
+    profileNames.add(name);
+    referenceProfiles.emplace_back();
+    return numProfiles++;
+}
+
+void ChannelClassifier::reserve(int newCapacity)
+{
+    if (newCapacity <= capacity)
+        return;
+
+    // Over-allocate by one register so the rows can start on an aligned address
+    const size_t numFloats = static_cast<size_t>(newCapacity) * ChannelFeatures::paddedSize + SIMDFloat::SIMDNumElements;
+    juce::HeapBlock<float> newStorage(numFloats, true);
+    float* newRows = SIMDFloat::getNextSIMDAlignedPtr(newStorage.get());
+
+    if (numProfiles > 0)
+        std::copy(rows, rows + static_cast<size_t>(numProfiles) * ChannelFeatures::paddedSize, newRows);
+
+    storage.swapWith(newStorage);
+    rows = newRows;
+    capacity = newCapacity;
+}
+
+int ChannelClassifier::findNearest(const ChannelFeatures& query, Match* results, int maxResults) const
+{
+    if (maxResults <= 0 || numProfiles == 0)
+        return 0;
+
+    // Aligned copy of the query for the SIMD loads
+    alignas(64) float queryRow[ChannelFeatures::paddedSize];
+    std::copy(query.values.begin(), query.values.end(), queryRow);
+
+    int numResults = 0;
+
+    for (int index = 0; index < numProfiles; ++index)
+    {
+        const float distance = squaredDistance(queryRow, getRow(index));
+
+        // Insertion into the small sorted result list
+        if (numResults == maxResults && distance >= results[numResults - 1].distance)
+            continue;
+
+        int position = juce::jmin(numResults, maxResults - 1);
+        while (position > 0 && results[position - 1].distance > distance)
+        {
+            results[position] = results[position - 1];
+            --position;
+        }
+
+        results[position] = { index, distance };
+        numResults = juce::jmin(numResults + 1, maxResults);
+    }
+
+    // Report real distances rather than squared ones
+    for (int i = 0; i < numResults; ++i)
+        results[i].distance = std::sqrt(results[i].distance);
+
+    return numResults;
+}
+
+ChannelProcessor::ChannelType ChannelClassifier::classify(const ChannelFeatures& query, Match* bestMatch) const
+{
+    Match neighbours[numNeighbours];
+    const int numFound = findNearest(query, neighbours, numNeighbours);
+
+    if (numFound == 0)
+        return ChannelProcessor::ChannelType::Other;
+
+    if (bestMatch != nullptr)
+        *bestMatch = neighbours[0];
+
+    // Distance-weighted vote among the nearest references
+    std::array<float, 4> votes {};
+
+    for (int i = 0; i < numFound; ++i)
+    {
+        const auto type = profileTypes[static_cast<size_t>(neighbours[i].profileIndex)];
+        votes[static_cast<size_t>(type)] += 1.0f / (neighbours[i].distance + 1.0e-3f);
+    }
+
+    const auto best = std::max_element(votes.begin(), votes.end());
+    return static_cast<ChannelProcessor::ChannelType>(std::distance(votes.begin(), best));
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include "../Audio/ChannelProcessor.h"
+#include "ToneProfiles.h"
+
+/**
+ * ChannelFeatures - Fixed-size feature vector describing one input
+ *
+ * Level-normalised 1/3-octave band energies plus a handful of temporal and
+ * spectral descriptors, scaled so that one unit means roughly the same
+ * perceptual difference in every dimension. Padded to a multiple of the
+ * widest SIMD register so the index can compare vectors without tails.
+ */
+struct ChannelFeatures
+{
+    static constexpr int numBands = 32;
+    static constexpr int numDescriptors = 4;    // Centroid, flux, crest factor, onset rate
+    static constexpr int size = numBands + numDescriptors;
+    static constexpr int paddedSize = 40;       // Multiple of 8 floats (AVX)
+
+    std::array<float, paddedSize> values {};
+
+    // Build the vector from measured or reference data
+    static ChannelFeatures fromMeasurements(const juce::Array<float>& bandMagnitudesDb,
+                                            float spectralFlux,
+                                            float crestFactorDb,
+                                            float onsetsPerSecond);
+
+    // Reference vector for a built-in tone profile
+    static ChannelFeatures fromProfile(const ToneProfile& profile);
+
+    // Unscaled spectral centroid (Hz) of a 32-band magnitude curve
+    static float getSpectralCentroid(const juce::Array<float>& bandMagnitudesDb);
+};
+
+/**
+ * ChannelClassifier - Nearest-neighbour channel type classifier
+ *
+ * Holds reference feature vectors in one flat, SIMD-aligned array (row per
+ * profile) and labels an input by a distance-weighted vote of its k nearest
+ * references. The built-in tone profiles are always present; profiles from
+ * the ToneProfileLibrary are added on top, and hundreds of rows still scan
+ * in microseconds. Rows added from a ToneProfile keep it, so the match can
+ * also serve as the correction target.
+ *
+ * Not thread-safe: build the index before analysis starts, then only query it.
+ */
+class ChannelClassifier
+{
+public:
+    struct Match
+    {
+        int profileIndex = -1;
+        float distance = 0.0f;
+    };
+
+    ChannelClassifier();
+
+    // Index management
+    void clear();
+    void addBuiltInProfiles();
+    int addProfile(const ChannelFeatures& features, ChannelProcessor::ChannelType type, const juce::String& name);
+    int addProfile(const ToneProfile& profile, ChannelProcessor::ChannelType type, const juce::String& name);
+    int getNumProfiles() const { return numProfiles; }
+    const ToneProfile* getReferenceProfile(int index) const;
+    ChannelProcessor::ChannelType getProfileType(int index) const { return profileTypes[static_cast<size_t>(index)]; }
+    const juce::String& getProfileName(int index) const { return profileNames.getReference(index); }
+
+    // Queries
+    int findNearest(const ChannelFeatures& query, Match* results, int maxResults) const;
+    ChannelProcessor::ChannelType classify(const ChannelFeatures& query, Match* bestMatch = nullptr) const;
+
+private:
+    static constexpr int numNeighbours = 3;
+
+    void reserve(int newCapacity);
+    const float* getRow(int index) const { return rows + static_cast<size_t>(index) * ChannelFeatures::paddedSize; }
+
+    // Flat feature storage; rows points at the first SIMD-aligned float in storage
+    juce::HeapBlock<float> storage;
+    float* rows = nullptr;
+    int numProfiles = 0;
+    int capacity = 0;
+
+    std::vector<ChannelProcessor::ChannelType> profileTypes;
+    juce::StringArray profileNames;
+    std::vector<ToneProfile> referenceProfiles;     // Empty curve for rows added from raw features
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChannelClassifier)
+};
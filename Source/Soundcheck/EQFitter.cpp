@@ -0,0 +1,275 @@
+#include "EQFitter.h"
+#include "ToneProfiles.h"
+
+namespace
+{
+    using Matrix = std::array<std::array<double, EQFitter::numEQBands>, EQFitter::numEQBands>;
+    using Vector = std::array<double, EQFitter::numEQBands>;
+
+    // Solve a small symmetric system in place with partial pivoting
+    bool solve(Matrix a, Vector b, Vector& x)
+    {
+        constexpr int n = EQFitter::numEQBands;
+
+        for (int col = 0; col < n; ++col)
+        {
+            int pivot = col;
+            for (int row = col + 1; row < n; ++row)
+                if (std::abs(a[row][col]) > std::abs(a[pivot][col]))
+                    pivot = row;
+
+            if (std::abs(a[pivot][col]) < 1.0e-12)
+                return false;
+
+            std::swap(a[col], a[pivot]);
+            std::swap(b[col], b[pivot]);
+
+            for (int row = col + 1; row < n; ++row)
+            {
+                const double factor = a[row][col] / a[col][col];
+                for (int k = col; k < n; ++k)
+                    a[row][k] -= factor * a[col][k];
+                b[row] -= factor * b[col];
+            }
+        }
+
+        for (int row = n - 1; row >= 0; --row)
+        {
+            double sum = b[row];
+            for (int k = row + 1; k < n; ++k)
+                sum -= a[row][k] * x[k];
+            x[row] = sum / a[row][row];
+        }
+
+        return true;
+    }
+}
+
+void EQFitter::prepare(double sampleRate)
+{
+    const auto bandFrequencies = getThirdOctaveBandFrequencies();
+
+    for (int i = 0; i < numBands; ++i)
+    {
+        const double w = juce::MathConstants<double>::twoPi * bandFrequencies[i] / sampleRate;
+        cosW[i] = std::cos(w);
+        sinW[i] = std::sin(w);
+        cos2W[i] = std::cos(2.0 * w);
+        sin2W[i] = std::sin(2.0 * w);
+        belowNyquist[i] = bandFrequencies[i] < 0.45 * sampleRate;
+    }
+
+    preparedSampleRate = sampleRate;
+}
+
+void EQFitter::getBandResponseDb(int eqBand, float gainDb, float* responseDb) const
+{
+    using Coefficients = juce::dsp::IIR::ArrayCoefficients<double>;
+
+    // Same designs EQProcessor::updateFilters() uses
+    const double gain = juce::Decibels::decibelsToGain(static_cast<double>(gainDb));
+    std::array<double, 6> c;
+
+    switch (static_cast<EQProcessor::Band>(eqBand))
+    {
+        case EQProcessor::Band::LowShelf:
+            c = Coefficients::makeLowShelf(preparedSampleRate, EQProcessor::lowShelfFrequency, EQProcessor::midQ, gain);
+            break;
+        case EQProcessor::Band::LowMid:
+            c = Coefficients::makePeakFilter(preparedSampleRate, EQProcessor::lowMidFrequency, EQProcessor::midQ, gain);
+            break;
+        case EQProcessor::Band::HighMid:
+            c = Coefficients::makePeakFilter(preparedSampleRate, EQProcessor::highMidFrequency, EQProcessor::midQ, gain);
+            break;
+        case EQProcessor::Band::HighShelf:
+        default:
+            c = Coefficients::makeHighShelf(preparedSampleRate, EQProcessor::highShelfFrequency, EQProcessor::midQ, gain);
+            break;
+    }
+
+    // |H(e^jw)|^2 = |b0 + b1 e^-jw + b2 e^-2jw|^2 / |a0 + a1 e^-jw + a2 e^-2jw|^2
+    for (int i = 0; i < numBands; ++i)
+    {
+        if (!belowNyquist[i])
+        {
+            responseDb[i] = 0.0f;
+            continue;
+        }
+
+        const double numRe = c[0] + c[1] * cosW[i] + c[2] * cos2W[i];
+        const double numIm = -(c[1] * sinW[i] + c[2] * sin2W[i]);
+        const double denRe = c[3] + c[4] * cosW[i] + c[5] * cos2W[i];
+        const double denIm = -(c[4] * sinW[i] + c[5] * sin2W[i]);
+
+        const double powerRatio = (numRe * numRe + numIm * numIm) / (denRe * denRe + denIm * denIm);
+        responseDb[i] = static_cast<float>(10.0 * std::log10(juce::jmax(1.0e-12, powerRatio)));
+    }
+}
+
+void EQFitter::getResponseDb(const std::array<float, numEQBands>& gainsDb, float* responseDb) const
+{
+    std::fill(responseDb, responseDb + numBands, 0.0f);
+
+    float bandResponse[numBands];
+    for (int eqBand = 0; eqBand < numEQBands; ++eqBand)
+    {
+        getBandResponseDb(eqBand, gainsDb[static_cast<size_t>(eqBand)], bandResponse);
+        for (int i = 0; i < numBands; ++i)
+            responseDb[i] += bandResponse[i];
+    }
+}
+
+EQFitter::Result EQFitter::fit(const float* targetDb, const float* weights) const
+{
+    jassert(preparedSampleRate > 0.0);
+
+    Result result;
+
+    float w[numBands];
+    double totalWeight = 0.0;
+    for (int i = 0; i < numBands; ++i)
+    {
+        w[i] = belowNyquist[i] ? juce::jmax(0.0f, weights[i]) : 0.0f;
+        totalWeight += w[i];
+    }
+
+    if (totalWeight <= 0.0)
+        return result;
+
+    // Weighted sum of squared errors for a set of gains
+    float response[numBands];
+    auto cost = [&](const std::array<float, numEQBands>& gains)
+    {
+        getResponseDb(gains, response);
+
+        double sum = 0.0;
+        for (int i = 0; i < numBands; ++i)
+        {
+            const double error = response[i] - targetDb[i];
+            sum += w[i] * error * error;
+        }
+        return sum;
+    };
+
+    auto gains = result.gainsDb;
+    double currentCost = cost(gains);
+    result.initialResidualDb = static_cast<float>(std::sqrt(currentCost / totalWeight));
+
+    double lambda = 1.0e-2;
+    float bandResponse[numEQBands][numBands];
+    float steppedResponse[numBands];
+
+    for (int iteration = 0; iteration < maxIterations; ++iteration)
+    {
+        result.iterations = iteration + 1;
+
+        // Residual and forward-difference Jacobian. Each band only depends on
+        // its own gain, so a column is one extra band evaluation.
+        float residual[numBands];
+        std::fill(residual, residual + numBands, 0.0f);
+
+        float jacobian[numEQBands][numBands];
+
+        for (int eqBand = 0; eqBand < numEQBands; ++eqBand)
+        {
+            const float g = gains[static_cast<size_t>(eqBand)];
+            const float h = g + derivativeStepDb <= EQProcessor::maxGainDb ? derivativeStepDb : -derivativeStepDb;
+
+            getBandResponseDb(eqBand, g, bandResponse[eqBand]);
+            getBandResponseDb(eqBand, g + h, steppedResponse);
+
+            for (int i = 0; i < numBands; ++i)
+            {
+                residual[i] += bandResponse[eqBand][i];
+                jacobian[eqBand][i] = (steppedResponse[i] - bandResponse[eqBand][i]) / h;
+            }
+        }
+
+        for (int i = 0; i < numBands; ++i)
+            residual[i] -= targetDb[i];
+
+        // Normal equations J'WJ and gradient J'Wr
+        Matrix normal {};
+        Vector gradient {};
+
+        for (int a = 0; a < numEQBands; ++a)
+        {
+            for (int i = 0; i < numBands; ++i)
+                gradient[a] += static_cast<double>(w[i]) * jacobian[a][i] * residual[i];
+
+            for (int b = a; b < numEQBands; ++b)
+            {
+                double sum = 0.0;
+                for (int i = 0; i < numBands; ++i)
+                    sum += static_cast<double>(w[i]) * jacobian[a][i] * jacobian[b][i];
+                normal[a][b] = normal[b][a] = sum;
+            }
+        }
+
+        // Gains pinned at a limit that the gradient pushes further out stay put
+        std::array<bool, numEQBands> active {};
+        for (int a = 0; a < numEQBands; ++a)
+        {
+            const float g = gains[static_cast<size_t>(a)];
+            active[static_cast<size_t>(a)] = (g >= EQProcessor::maxGainDb && gradient[a] < 0.0)
+                                          || (g <= -EQProcessor::maxGainDb && gradient[a] > 0.0);
+        }
+
+        // Try damped steps until one lowers the cost
+        bool improved = false;
+        float largestStep = 0.0f;
+
+        while (!improved && lambda < 1.0e6)
+        {
+            Matrix damped = normal;
+            Vector rhs;
+
+            for (int a = 0; a < numEQBands; ++a)
+            {
+                rhs[a] = -gradient[a];
+                damped[a][a] += lambda * juce::jmax(normal[a][a], 1.0e-6);
+
+                if (active[static_cast<size_t>(a)])
+                {
+                    for (int b = 0; b < numEQBands; ++b)
+                        damped[a][b] = damped[b][a] = 0.0;
+                    damped[a][a] = 1.0;
+                    rhs[a] = 0.0;
+                }
+            }
+
+            Vector step {};
+            if (!solve(damped, rhs, step))
+                break;
+
+            auto candidate = gains;
+            for (int a = 0; a < numEQBands; ++a)
+                candidate[static_cast<size_t>(a)] = juce::jlimit(-EQProcessor::maxGainDb, EQProcessor::maxGainDb,
+                                                                 gains[static_cast<size_t>(a)] + static_cast<float>(step[a]));
+
+            const double candidateCost = cost(candidate);
+            if (candidateCost < currentCost)
+            {
+                largestStep = 0.0f;
+                for (int a = 0; a < numEQBands; ++a)
+                    largestStep = juce::jmax(largestStep, std::abs(candidate[static_cast<size_t>(a)] - gains[static_cast<size_t>(a)]));
+
+                gains = candidate;
+                currentCost = candidateCost;
+                lambda = juce::jmax(1.0e-6, lambda * 0.3);
+                improved = true;
+            }
+            else
+            {
+                lambda *= 10.0;
+            }
+        }
+
+        if (!improved || largestStep < stepToleranceDb)
+            break;
+    }
+
+    result.gainsDb = gains;
+    result.residualDb = static_cast<float>(std::sqrt(currentCost / totalWeight));
+    return result;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include "../FX/EQProcessor.h"
+
+/**
+ * EQFitter - Fits the channel EQ's band gains to a target correction curve
+ *
+ * Models the exact EQProcessor filters (RBJ low shelf, two peaks and a high
+ * shelf at their fixed frequencies and Q) and solves for the four gains that
+ * minimise the weighted squared error against a 32-band dB target, within the
+ * EQ's +/-12 dB range. Neighbouring bands overlap, so fitting them jointly
+ * avoids the overshoot of averaging the target into independent buckets.
+ *
+ * The solver is a projected Levenberg-Marquardt iteration on the 4 gains; a
+ * fit takes a few dozen biquad evaluations per band and finishes well under
+ * a millisecond. fit() is const and allocation-free, so one prepared fitter
+ * can serve several threads.
+ */
+class EQFitter
+{
+public:
+    static constexpr int numEQBands = 4;
+    static constexpr int numBands = 32;     // 1/3-octave target points
+
+    struct Result
+    {
+        std::array<float, numEQBands> gainsDb {};
+        float residualDb = 0.0f;        // Weighted RMS error of the fitted curve
+        float initialResidualDb = 0.0f; // Same, with the EQ flat
+        int iterations = 0;
+    };
+
+    // Evaluation points for a sample rate; call again when the rate changes
+    void prepare(double sampleRate);
+    double getSampleRate() const { return preparedSampleRate; }
+
+    // Fit the EQ to targetDb (correction wanted per 1/3-octave band).
+    // Bands with zero weight, or above Nyquist, are ignored.
+    Result fit(const float* targetDb, const float* weights) const;
+
+    // Response of the EQ in dB at each band centre for the given gains
+    void getResponseDb(const std::array<float, numEQBands>& gainsDb, float* responseDb) const;
+
+private:
+    static constexpr int maxIterations = 30;
+    static constexpr float stepToleranceDb = 0.01f;
+    static constexpr float derivativeStepDb = 0.1f;
+
+    // Response of one EQ band in dB at every band centre
+    void getBandResponseDb(int eqBand, float gainDb, float* responseDb) const;
+
+    double preparedSampleRate = 0.0;
+    std::array<double, numBands> cosW {}, sinW {}, cos2W {}, sin2W {};
+    std::array<bool, numBands> belowNyquist {};
+};
@@ -1,5 +1,6 @@
 #include "SoundcheckEngine.h"
-#include <limits>
+#include "ToneProfileLibrary.h"
+#include "../Routing/RoutingManager.h"
 
 // Singleton instance implementation
 SoundcheckEngine& SoundcheckEngine::getInstance()
@@ -14,27 +15,20 @@ SoundcheckEngine::SoundcheckEngine()
     // Initialize with 32 channels
     channelAnalyses.resize(32);
     
-    // Initialize FFT processor
-    fft = std::make_unique<juce::dsp::FFT>(fftOrder);
+    // Build the band lookup for the default rate; the capture FIFO is
+    // sized in startCheck() once the duration and device rate are known
+    updateBandLookup(sampleRate.load());
+    eqFitter.prepare(sampleRate.load());
     
-    // Initialize FFT buffers
-    fftTimeDomain.allocate(fftSize, true);
-    fftFrequencyDomain.allocate(fftSize * 2, true);
-    windowBuffer.allocate(fftSize, true);
-    
-    // Create Hann window for FFT
-    for (int i = 0; i < fftSize; ++i)
-        windowBuffer[i] = 0.5f - 0.5f * std::cos(2.0f * juce::MathConstants<float>::pi * i / (fftSize - 1));
-    
-    // Initialize audio ring buffer (5 sec at 48kHz stereo)
-    audioRingBuffer.setSize(2, maxBufferSize);
-    audioRingBuffer.clear();
+    // Scratch for publishing the live spectrum
+    liveSpectrum.allocate(fftSize / 2, true);
+    liveBands.resize(numBands);
     
     // Initialize analyzed bands array for each channel
     for (auto& analysis : channelAnalyses)
     {
-        analysis.measuredMagnitudes.resize(32);
-        for (int i = 0; i < 32; ++i)
+        analysis.measuredMagnitudes.resize(numBands);
+        for (int i = 0; i < numBands; ++i)
             analysis.measuredMagnitudes.set(i, -60.0f); // Default to very quiet
     }
 }
@@ -46,35 +40,108 @@ SoundcheckEngine::~SoundcheckEngine()
     
     // Wait for thread to finish
     stopThread(2000);
+    analysisPool.removeAllJobs(true, 2000);
 }
 
-void SoundcheckEngine::startCheck(int secondsPerChannel)
+void SoundcheckEngine::startCheck(int secondsPerChannel, Mode mode)
 {
     // Don't start if already running
     if (isRunning())
         return;
     
+    // A cancelled check may still be winding down
+    stopThread(2000);
+    waitForCaptureToStop();
+    
+    // Results of the previous check no longer apply
+    correctionDelta.entries.clear();
+    originalDelta.entries.clear();
+    
     // Set analysis parameters
+    checkMode = mode;
     analysisLengthSeconds = secondsPerChannel;
     currentChannelIndex = 0;
     
+    // Snapshot the input routing so the audio thread never touches the RoutingManager
+    const int numChannels = static_cast<int>(channelAnalyses.size());
+    captureInputs.resize(static_cast<size_t>(numChannels));
+    
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const int input = auralis::RoutingManager::getInstance().getPhysicalInput(channel);
+        captureInputs[static_cast<size_t>(channel)] = input >= 0 ? input : channel;
+    }
+    
+    // One analyser per channel, created up front so the analysis thread never allocates
+    while (static_cast<int>(analysers.size()) < numChannels)
+        analysers.push_back(std::make_unique<StreamingChannelAnalyser>(fftOrder));
+    
+    if (numLiveChannels != numChannels)
+    {
+        liveMagnitudes = std::make_unique<std::atomic<float>[]>(static_cast<size_t>(numChannels * numBands));
+        numLiveChannels = numChannels;
+    }
+    
+    // Size everything for the device rate
+    const double rate = sampleRate.load();
+    checkSampleRate = rate;
+    samplesPerChannel = juce::roundToInt(analysisLengthSeconds * rate);
+    
+    // Neither side of the FIFO is running here, so it can be reallocated
+    captureFifo.prepare(checkMode == Mode::AllChannels ? numChannels : 1,
+                        juce::roundToInt(captureRingSeconds * rate));
+    
+    if (rate != bandLookupSampleRate)
+        updateBandLookup(rate);
+    
+    if (rate != eqFitter.getSampleRate())
+        eqFitter.prepare(rate);
+    
+    // Pick up profiles saved since the last check
+    if (ToneProfileLibrary::getInstance().getRevision() != classifierLibraryRevision)
+        rebuildClassifier();
+    
     // Start tracking execution time
     startTime = std::chrono::high_resolution_clock::now();
     
     // Initialize analysis data
     initializeAnalysis();
     
-    // Set state and start thread
+    // First measurement: every channel, or channel 0 in sequential mode
+    beginMeasurement(checkMode == Mode::AllChannels ? -1 : 0);
+    
+    // Set state and start thread. The state store publishes everything above to the audio thread.
     currentState = State::analysing;
     startThread(juce::Thread::Priority::high); // High priority thread
 }
 
+void SoundcheckEngine::rebuildClassifier()
+{
+    auto& library = ToneProfileLibrary::getInstance();
+    
+    classifier.clear();
+    classifier.addBuiltInProfiles();
+    
+    for (int i = 0; i < library.getNumProfiles(); ++i)
+    {
+        const auto entry = library.getProfile(i);
+        classifier.addProfile(entry.profile, entry.type, entry.name);
+    }
+    
+    classifierLibraryRevision = library.getRevision();
+}
+
 void SoundcheckEngine::initializeAnalysis()
 {
-    // Reset audio buffer
-    bufferWritePosition = 0;
+    // Reset audio capture
     samplesCollected = 0;
-    audioRingBuffer.clear();
+    droppedSamples = 0;
+    
+    for (auto& analyser : analysers)
+        analyser->reset();
+    
+    for (int i = 0; i < numLiveChannels * numBands; ++i)
+        liveMagnitudes[static_cast<size_t>(i)].store(-60.0f, std::memory_order_relaxed);
     
     // Reset analysis data
     for (auto& analysis : channelAnalyses)
@@ -92,16 +159,18 @@ void SoundcheckEngine::initializeAnalysis()
         analysis.gateThresholdSuggestion = -50.0f;
         for (int i = 0; i < 4; ++i)
             analysis.eqGainSuggestions[i] = 0.0f;
+        analysis.eqFitResidualDb = 0.0f;
         analysis.compressorRatioSuggestion = 1.0f;
     }
 }
 
 void SoundcheckEngine::stopCheck()
 {
-    // Only stop if we're analyzing
+    // Only stop if we're analyzing. A cancelled check has no complete
+    // results, so it goes back to idle rather than finished.
     if (currentState == State::analysing)
     {
-        currentState = State::finished;
+        currentState = State::idle;
         signalThreadShouldExit();
     }
 }
@@ -111,6 +180,29 @@ bool SoundcheckEngine::isRunning() const
     return currentState == State::analysing;
 }
 
+bool SoundcheckEngine::isFinished() const
+{
+    return currentState == State::finished;
+}
+
+double SoundcheckEngine::getProgress() const
+{
+    if (currentState == State::finished)
+        return 1.0;
+    
+    if (currentState != State::analysing || samplesPerChannel <= 0)
+        return 0.0;
+    
+    const double captured = juce::jlimit(0.0, 1.0, samplesCollected / static_cast<double>(samplesPerChannel));
+    
+    // All channels share one capture window
+    if (checkMode == Mode::AllChannels)
+        return captured;
+    
+    const int numChannels = juce::jmax(1, static_cast<int>(channelAnalyses.size()));
+    return juce::jlimit(0.0, 1.0, (currentChannelIndex + captured) / numChannels);
+}
+
 const SoundcheckEngine::ChannelAnalysis& SoundcheckEngine::getAnalysis(int channelIndex) const
 {
     // Make sure index is valid
@@ -120,6 +212,21 @@ const SoundcheckEngine::ChannelAnalysis& SoundcheckEngine::getAnalysis(int chann
     return channelAnalyses[channelIndex];
 }
 
+void SoundcheckEngine::getLiveMagnitudes(int channelIndex, juce::Array<float>& magnitudes) const
+{
+    magnitudes.resize(numBands);
+    
+    if (channelIndex < 0 || channelIndex >= numLiveChannels)
+    {
+        magnitudes.fill(-60.0f);
+        return;
+    }
+    
+    // Bands are published individually; a frame may mix two updates, which is fine for display
+    for (int band = 0; band < numBands; ++band)
+        magnitudes.set(band, liveMagnitudes[static_cast<size_t>(channelIndex * numBands + band)].load(std::memory_order_relaxed));
+}
+
 void SoundcheckEngine::setChannelProcessors(const std::vector<ChannelProcessor*>& processors)
 {
     channelProcessors = processors;
@@ -130,191 +237,287 @@ void SoundcheckEngine::setChannelProcessors(const std::vector<ChannelProcessor*>
         channelAnalyses.resize(processors.size());
         for (auto& analysis : channelAnalyses)
         {
-            analysis.measuredMagnitudes.resize(32);
-            for (int i = 0; i < 32; ++i)
+            analysis.measuredMagnitudes.resize(numBands);
+            for (int i = 0; i < numBands; ++i)
                 analysis.measuredMagnitudes.set(i, -60.0f); // Default to very quiet
         }
     }
 }
 
-void SoundcheckEngine::captureAudio(const float* const* inputChannelData, int numChannels, int numSamples)
+void SoundcheckEngine::setSampleRate(double newSampleRate)
 {
-    // Check if we're still collecting samples
-    if (samplesCollected >= analysisLengthSeconds * 48000) // Assuming 48kHz
-        return;
-        
-    // Get how many channels to process (limited to stereo)
-    const int channelsToProcess = juce::jmin(numChannels, 2);
+    if (newSampleRate > 0.0)
+        sampleRate = newSampleRate;
+}
+
+void SoundcheckEngine::beginMeasurement(int channelIndex)
+{
+    // Anything still in flight for the previous measurement is discarded by epoch
+    samplesAnalysed = 0;
+    samplesCollected.store(0, std::memory_order_relaxed);
+    ++measurementEpoch;
     
-    // Copy the samples into the ring buffer
-    for (int channel = 0; channel < channelsToProcess; ++channel)
-    {
-        int bufferIndex = bufferWritePosition;
-        for (int i = 0; i < numSamples; ++i)
-        {
-            audioRingBuffer.setSample(channel, bufferIndex, inputChannelData[channel][i]);
-            if (++bufferIndex >= audioRingBuffer.getNumSamples())
-                bufferIndex = 0;
-        }
-    }
+    if (channelIndex >= 0)
+        currentChannelIndex = channelIndex;
     
-    // Move write position
-    bufferWritePosition = (bufferWritePosition + numSamples) % audioRingBuffer.getNumSamples();
-    samplesCollected += numSamples;
+    captureRequest.store({ measurementEpoch, channelIndex }, std::memory_order_release);
 }
 
-void SoundcheckEngine::analyzeCurrentChannelBuffer()
+void SoundcheckEngine::waitForCaptureToStop()
 {
-    // Get the current channel analysis
-    auto& analysis = channelAnalyses[currentChannelIndex];
+    // Only called once the state has left 'analysing', so no new capture can
+    // start; an audio callback that is already inside captureAudio finishes
+    // within one block
+    jassert(currentState != State::analysing);
     
-    // Calculate RMS and peak levels
-    float sumSquared = 0.0f;
-    float peak = 0.0f;
-    
-    // Analyze the samples we've collected
-    const int numSamplesToAnalyze = juce::jmin(samplesCollected, audioRingBuffer.getNumSamples());
+    while (capturesInFlight.load() > 0)
+        juce::Thread::yield();
+}
+
+void SoundcheckEngine::captureAudio(const float* const* inputChannelData, int numChannels, int numSamples)
+{
+    // Announce ourselves before checking the state, so startCheck() can wait us out
+    ++capturesInFlight;
     
-    // RMS analysis
-    for (int channel = 0; channel < audioRingBuffer.getNumChannels(); ++channel)
+    if (currentState != State::analysing)
     {
-        for (int i = 0; i < numSamplesToAnalyze; ++i)
-        {
-            const float sample = audioRingBuffer.getSample(channel, i);
-            sumSquared += sample * sample;
-            peak = juce::jmax(peak, std::abs(sample));
-        }
+        --capturesInFlight;
+        return;
     }
     
-    // Store the results
-    analysis.avgRMS = std::sqrt(sumSquared / (numSamplesToAnalyze * audioRingBuffer.getNumChannels()));
-    analysis.peakLevel = peak;
-    
-    // Determine noise floor (use bottom 20% of samples)
-    juce::Array<float> magnitudes;
-    for (int channel = 0; channel < audioRingBuffer.getNumChannels(); ++channel)
+    // A new request starts a new measurement on this side
+    const auto request = captureRequest.load(std::memory_order_acquire);
+    if (request.epoch != activeEpoch)
     {
-        for (int i = 0; i < numSamplesToAnalyze; i += 64) // Sample every 64 samples for efficiency
-        {
-            magnitudes.add(std::abs(audioRingBuffer.getSample(channel, i)));
-        }
+        activeEpoch = request.epoch;
+        activeChannel = request.channel;
+        samplesCapturedThisEpoch = 0;
     }
     
-    // Sort and take the bottom 20%
-    magnitudes.sort();
-    const int noiseFloorIndex = static_cast<int>(magnitudes.size() * 0.2f);
-    analysis.noiseFloor = noiseFloorIndex < magnitudes.size() ? magnitudes[noiseFloorIndex] : 0.0f;
-    
-    // Perform FFT analysis - divide signal into overlapping windows
-    const int hopSize = fftSize / 4; // 75% overlap
-    const int numWindows = (numSamplesToAnalyze - fftSize) / hopSize + 1;
+    // Never capture past the end of the measurement, and never wait for the
+    // analysis thread - if the FIFO is full the rest of the block is dropped
+    const int samplesWanted = juce::jmin(numSamples, samplesPerChannel - samplesCapturedThisEpoch);
     
-    // Reset frequency domain averages
-    for (int i = 0; i < fftSize; ++i)
-        fftFrequencyDomain[i] = 0.0f;
-    
-    // Process each window
-    for (int window = 0; window < numWindows; ++window)
+    if (samplesWanted > 0)
     {
-        // Fill time domain buffer with windowed data (average of L+R channels)
-        for (int i = 0; i < fftSize; ++i)
+        const auto region = captureFifo.prepareToWrite(samplesWanted);
+        
+        if (region.getTotal() < samplesWanted)
+            droppedSamples += samplesWanted - region.getTotal();
+        
+        if (region.getTotal() > 0)
         {
-            const int sampleIndex = window * hopSize + i;
-            if (sampleIndex < numSamplesToAnalyze)
+            // Routed device input for a mixer channel, or nullptr for silence
+            auto sourceFor = [&](int mixerChannel) -> const float*
             {
-                float sample = 0.0f;
-                for (int channel = 0; channel < audioRingBuffer.getNumChannels(); ++channel)
-                    sample += audioRingBuffer.getSample(channel, sampleIndex);
+                if (mixerChannel < 0 || mixerChannel >= static_cast<int>(captureInputs.size()))
+                    return nullptr;
                 
-                sample /= audioRingBuffer.getNumChannels(); // Average the channels
-                fftTimeDomain[i] = sample * windowBuffer[i]; // Apply window function
+                const int input = captureInputs[static_cast<size_t>(mixerChannel)];
+                return input >= 0 && input < numChannels ? inputChannelData[input] : nullptr;
+            };
+            
+            if (activeChannel < 0)
+            {
+                for (int channel = 0; channel < captureFifo.getNumChannels(); ++channel)
+                    captureFifo.writeChannel(channel, region, sourceFor(channel));
             }
             else
             {
-                fftTimeDomain[i] = 0.0f;
+                captureFifo.writeChannel(0, region, sourceFor(activeChannel));
             }
+            
+            captureFifo.finishedWrite(region, activeEpoch, activeChannel);
+            samplesCapturedThisEpoch += region.getTotal();
+            samplesCollected.store(samplesCapturedThisEpoch, std::memory_order_relaxed);
         }
+    }
+    
+    --capturesInFlight;
+}
+
+void SoundcheckEngine::processCapturedAudio()
+{
+    int mixerChannel = -1;
+    const auto region = captureFifo.prepareToRead(measurementEpoch, mixerChannel);
+    if (region.getTotal() == 0)
+        return;
+    
+    // Feed both halves of the FIFO region to a channel's analyser
+    auto feedAnalyser = [this, region](int captureChannel, int channelIndex)
+    {
+        auto& analyser = *analysers[static_cast<size_t>(channelIndex)];
+        analyser.process(captureFifo.getReadPointer(captureChannel, region.start1), region.size1);
+        if (region.size2 > 0)
+            analyser.process(captureFifo.getReadPointer(captureChannel, region.start2), region.size2);
+    };
+    
+    if (mixerChannel < 0)
+    {
+        const int numChannels = juce::jmin(captureFifo.getNumChannels(), static_cast<int>(analysers.size()));
         
-        // Perform FFT
-        fft->performRealOnlyForwardTransform(fftTimeDomain);
+        // Each job owns one channel's analyser, so the jobs share nothing writable
+        analysisJobsDone.reset();
+        pendingAnalysisJobs = numChannels;
         
-        // Convert to power spectrum and accumulate
-        for (int i = 0; i < fftSize / 2; ++i)
+        for (int channel = 0; channel < numChannels; ++channel)
         {
-            const float real = fftTimeDomain[i * 2];
-            const float imag = fftTimeDomain[i * 2 + 1];
-            const float magnitude = std::sqrt(real * real + imag * imag);
-            fftFrequencyDomain[i] += magnitude;
+            analysisPool.addJob([this, feedAnalyser, channel]
+            {
+                feedAnalyser(channel, channel);
+                
+                if (--pendingAnalysisJobs == 0)
+                    analysisJobsDone.signal();
+            });
         }
+        
+        if (numChannels > 0)
+            analysisJobsDone.wait();
+    }
+    else if (mixerChannel < static_cast<int>(analysers.size()))
+    {
+        feedAnalyser(0, mixerChannel);
     }
     
-    // Average the spectrum across all windows
-    if (numWindows > 0)
+    samplesAnalysed += region.getTotal();
+    captureFifo.finishedRead(region);
+}
+
+void SoundcheckEngine::publishLiveMagnitudes()
+{
+    auto publishChannel = [this](int channelIndex)
     {
-        for (int i = 0; i < fftSize / 2; ++i)
-            fftFrequencyDomain[i] /= numWindows;
+        if (channelIndex < 0 || channelIndex >= numLiveChannels || channelIndex >= static_cast<int>(analysers.size()))
+            return;
+        
+        analysers[static_cast<size_t>(channelIndex)]->getAverageSpectrum(liveSpectrum);
+        mapFFTToThirdOctaveBands(liveSpectrum, liveBands);
+        
+        for (int band = 0; band < numBands; ++band)
+            liveMagnitudes[static_cast<size_t>(channelIndex * numBands + band)].store(liveBands[band], std::memory_order_relaxed);
+    };
+    
+    if (checkMode == Mode::AllChannels)
+    {
+        for (int channel = 0; channel < captureFifo.getNumChannels(); ++channel)
+            publishChannel(channel);
     }
+    else
+    {
+        publishChannel(currentChannelIndex);
+    }
+}
+
+void SoundcheckEngine::finaliseChannel(int channelIndex)
+{
+    if (channelIndex < 0 || channelIndex >= static_cast<int>(analysers.size()))
+        return;
+    
+    // Everything was accumulated while the audio arrived; just read it out
+    auto& analysis = channelAnalyses[static_cast<size_t>(channelIndex)];
+    const auto& analyser = *analysers[static_cast<size_t>(channelIndex)];
+    
+    analysis.avgRMS = analyser.getRMS();
+    analysis.peakLevel = analyser.getPeak();
+    analysis.noiseFloor = analyser.getNoiseFloor(0.2f); // Bottom 20% of sampled levels
     
     // Map FFT data to 1/3 octave bands
-    mapFFTToThirdOctaveBands(fftFrequencyDomain, analysis.measuredMagnitudes);
+    analyser.getAverageSpectrum(liveSpectrum);
+    mapFFTToThirdOctaveBands(liveSpectrum, analysis.measuredMagnitudes);
 
-    // Classify channel type based on spectral profile
-    analysis.suggestedType = classifyChannel(analysis.measuredMagnitudes);
+    // Classify channel type from its spectral shape and behaviour over time
+    const double secondsAnalysed = analyser.getNumSamples() / checkSampleRate;
+    const float onsetsPerSecond = secondsAnalysed > 0.0 ? static_cast<float>(analyser.getNumOnsets() / secondsAnalysed) : 0.0f;
+    
+    analysis.spectralFlux = analyser.getMeanFlux();
+    analysis.crestFactorDb = analyser.getCrestFactorDb();
+    analysis.onsetRate = onsetsPerSecond;
+    analysis.features = ChannelFeatures::fromMeasurements(analysis.measuredMagnitudes,
+                                                          analysis.spectralFlux,
+                                                          analysis.crestFactorDb,
+                                                          analysis.onsetRate);
+    
+    ChannelClassifier::Match match;
+    analysis.suggestedType = classifier.classify(analysis.features, &match);
+    analysis.matchIndex = match.profileIndex;
+    analysis.matchedProfile = match.profileIndex >= 0 ? classifier.getProfileName(match.profileIndex) : juce::String();
+    analysis.matchDistance = match.distance;
 
     // Calculate suggested corrections based on reference profiles
-    calculateCorrections(currentChannelIndex);
+    calculateCorrections(channelIndex);
     
-    juce::Logger::writeToLog("Analyzing channel " + juce::String(currentChannelIndex) + 
+    juce::Logger::writeToLog("Analyzing channel " + juce::String(channelIndex) + 
                            " - RMS: " + juce::String(analysis.avgRMS) + 
                            ", Noise floor: " + juce::String(analysis.noiseFloor) + 
-                           ", Peak: " + juce::String(analysis.peakLevel));
+                           ", Peak: " + juce::String(analysis.peakLevel) +
+                           ", Closest profile: " + analysis.matchedProfile +
+                           ", EQ fit residual: " + juce::String(analysis.eqFitResidualDb, 1) + " dB");
 }
 
-void SoundcheckEngine::mapFFTToThirdOctaveBands(const float* fftData, juce::Array<float>& bandMagnitudes)
+void SoundcheckEngine::updateBandLookup(double rate)
 {
     // Get the standard 1/3 octave frequencies
     const auto bandFrequencies = getThirdOctaveBandFrequencies();
+    const int numBands = bandFrequencies.size();
     
-    // Calculate bin frequencies
-    const double binWidth = 48000.0 / fftSize; // Assuming 48kHz sample rate
+    // Calculate bin frequencies for this rate
+    const double binWidth = rate / fftSize;
     
-    // Reset band magnitudes
-    for (int band = 0; band < bandMagnitudes.size(); ++band)
-        bandMagnitudes.set(band, 0.0f);
+    binToBand.assign(fftSize / 2, -1);
+    bandBinCounts.assign(static_cast<size_t>(numBands), 0);
     
-    // Count how many FFT bins map to each 1/3 octave band
-    juce::Array<int> binCounts;
-    binCounts.resize(bandMagnitudes.size());
-    binCounts.fill(0);
-    
-    // Map each FFT bin to its corresponding 1/3 octave band
+    // Bands are contiguous, so a single forward walk assigns every bin
+    int band = 0;
     for (int bin = 1; bin < fftSize / 2; ++bin) // Skip DC (bin 0)
     {
         const double binFreq = bin * binWidth;
         
-        // Find which 1/3 octave band this frequency belongs to
-        for (int band = 0; band < bandFrequencies.size(); ++band)
+        // Advance to the band whose upper edge lies above this bin
+        while (band < numBands)
         {
-            const double lowerFreq = band > 0 ? std::sqrt(bandFrequencies[band] * bandFrequencies[band - 1]) : 0;
-            const double upperFreq = band < bandFrequencies.size() - 1 ? 
+            const double upperFreq = band < numBands - 1 ?
                 std::sqrt(bandFrequencies[band] * bandFrequencies[band + 1]) : 30000.0;
             
-            if (binFreq >= lowerFreq && binFreq < upperFreq)
-            {
-                // Add bin magnitude to band
-                bandMagnitudes.set(band, bandMagnitudes[band] + fftData[bin]);
-                binCounts.set(band, binCounts[band] + 1);
+            if (binFreq < upperFreq)
                 break;
-            }
+            
+            ++band;
         }
+        
+        if (band >= numBands)
+            break;
+        
+        binToBand[static_cast<size_t>(bin)] = band;
+        ++bandBinCounts[static_cast<size_t>(band)];
+    }
+    
+    bandLookupSampleRate = rate;
+}
+
+void SoundcheckEngine::mapFFTToThirdOctaveBands(const float* fftData, juce::Array<float>& bandMagnitudes)
+{
+    // Reset band magnitudes
+    for (int band = 0; band < bandMagnitudes.size(); ++band)
+        bandMagnitudes.set(band, 0.0f);
+    
+    // Accumulate each FFT bin into its precomputed band
+    float* bands = bandMagnitudes.getRawDataPointer();
+    const int numBands = bandMagnitudes.size();
+    
+    for (int bin = 1; bin < fftSize / 2; ++bin) // Skip DC (bin 0)
+    {
+        const int band = binToBand[static_cast<size_t>(bin)];
+        if (band >= 0 && band < numBands)
+            bands[band] += fftData[bin];
     }
     
     // Average the magnitudes in each band and convert to dB
     for (int band = 0; band < bandMagnitudes.size(); ++band)
     {
-        if (binCounts[band] > 0)
+        const int binCount = band < static_cast<int>(bandBinCounts.size()) ? bandBinCounts[static_cast<size_t>(band)] : 0;
+        if (binCount > 0)
         {
-            float avg = bandMagnitudes[band] / binCounts[band];
+            float avg = bandMagnitudes[band] / binCount;
             // Convert to dB, with a minimum of -60dB
             bandMagnitudes.set(band, juce::jmax(-60.0f, juce::Decibels::gainToDecibels(avg)));
         }
@@ -336,26 +539,30 @@ void SoundcheckEngine::calculateCorrections(int channelIndex)
     auto& analysis = channelAnalyses[channelIndex];
     auto* processor = channelProcessors[channelIndex];
     
-    // Convert suggested type to ChannelStripComponent type
-    ChannelStripComponent::ChannelType channelType;
+    // Convert suggested type to the tone profile type
+    ToneProfileType channelType;
     switch (analysis.suggestedType)
     {
         case ChannelProcessor::ChannelType::Vocal:
-            channelType = ChannelStripComponent::ChannelType::SingingVocal;
+            channelType = ToneProfileType::SingingVocal;
             break;
         case ChannelProcessor::ChannelType::Instrument:
-            channelType = ChannelStripComponent::ChannelType::Instrument;
+            channelType = ToneProfileType::Instrument;
             break;
         case ChannelProcessor::ChannelType::Drums:
-            channelType = ChannelStripComponent::ChannelType::Drums;
+            channelType = ToneProfileType::Drums;
             break;
         default:
-            channelType = ChannelStripComponent::ChannelType::Other;
+            channelType = ToneProfileType::Other;
             break;
     }
     
-    // Get reference profile for this channel type
-    const auto& refProfile = getProfileFor(channelType);
+    // Correct towards the closest reference when it agrees with the vote
+    // (a saved "our lead vocal" curve), otherwise the generic type profile
+    const auto* matchedProfile = classifier.getReferenceProfile(analysis.matchIndex);
+    const bool useMatch = matchedProfile != nullptr
+                          && classifier.getProfileType(analysis.matchIndex) == analysis.suggestedType;
+    const auto& refProfile = useMatch ? *matchedProfile : getProfileFor(channelType);
     
     // Backup original settings before calculating corrections
     backupOriginalSettings(channelIndex);
@@ -371,46 +578,50 @@ void SoundcheckEngine::calculateCorrections(int channelIndex)
     analysis.gateThresholdSuggestion = noiseFloorDb + 6.0f; // Set threshold 6dB above noise floor
     analysis.gateThresholdSuggestion = juce::jlimit(-60.0f, -20.0f, analysis.gateThresholdSuggestion);
     
-    // 3. Calculate EQ corrections - compare reference and measured magnitudes
-    // First, initialize to zeros
-    for (int band = 0; band < 4; ++band)
-        analysis.eqGainSuggestions[band] = 0.0f;
-    
-    // Map each band to its closest EQ band and calculate average difference
-    juce::Array<float> bandDifferences;
-    bandDifferences.resize(4);
-    bandDifferences.fill(0.0f);
-    
-    juce::Array<int> bandCounts;
-    bandCounts.resize(4);
-    bandCounts.fill(0);
-    
+    // 3. Fit the EQ to the tonal difference. Reference curves are relative and
+    // the measurement is absolute, and overall level is the trim's job, so only
+    // the shape of the difference is fitted: its weighted mean is removed.
     const auto bandFrequencies = getThirdOctaveBandFrequencies();
-    for (int i = 0; i < bandFrequencies.size(); ++i)
+    float targetDb[EQFitter::numBands];
+    float weights[EQFitter::numBands];
+    double weightedSum = 0.0;
+    double totalWeight = 0.0;
+    
+    for (int i = 0; i < EQFitter::numBands; ++i)
     {
-        if (i < analysis.measuredMagnitudes.size() && i < refProfile.refMagnitudes.size())
-        {
-            // Calculate difference (positive means we need to boost, negative means cut)
-            float diff = refProfile.refMagnitudes[i] - analysis.measuredMagnitudes[i];
-            
-            // Map to the appropriate EQ band
-            int eqBand = getEQBandForFrequency(bandFrequencies[i]);
-            
-            bandDifferences.set(eqBand, bandDifferences[eqBand] + diff);
-            bandCounts.set(eqBand, bandCounts[eqBand] + 1);
-        }
+        targetDb[i] = 0.0f;
+        weights[i] = 0.0f;
+        
+        if (i >= analysis.measuredMagnitudes.size() || i >= refProfile.refMagnitudes.size())
+            continue;
+        
+        // Bands at the measurement floor carry no information
+        if (analysis.measuredMagnitudes[i] <= -59.9f)
+            continue;
+        
+        // The extreme bands matter less and are hard to reach with shelves
+        const float frequency = bandFrequencies[i];
+        weights[i] = (frequency < 31.0f || frequency > 17000.0f) ? 0.25f : 1.0f;
+        
+        // Positive means we need to boost, negative means cut
+        targetDb[i] = refProfile.refMagnitudes[i] - analysis.measuredMagnitudes[i];
+        weightedSum += weights[i] * targetDb[i];
+        totalWeight += weights[i];
     }
     
-    // Average the differences for each EQ band
-    for (int band = 0; band < 4; ++band)
+    if (totalWeight > 0.0)
     {
-        if (bandCounts[band] > 0)
-        {
-            analysis.eqGainSuggestions[band] = bandDifferences[band] / bandCounts[band];
-            analysis.eqGainSuggestions[band] = juce::jlimit(-12.0f, 12.0f, analysis.eqGainSuggestions[band]);
-        }
+        const float meanDifference = static_cast<float>(weightedSum / totalWeight);
+        for (int i = 0; i < EQFitter::numBands; ++i)
+            targetDb[i] -= meanDifference;
     }
     
+    const auto fit = eqFitter.fit(targetDb, weights);
+    for (int band = 0; band < 4; ++band)
+        analysis.eqGainSuggestions[band] = fit.gainsDb[static_cast<size_t>(band)];
+    
+    analysis.eqFitResidualDb = fit.residualDb;
+    
     // 4. Calculate Compressor settings based on dynamic range
     float dynamicRange = juce::Decibels::gainToDecibels(analysis.peakLevel) - 
                          juce::Decibels::gainToDecibels(analysis.avgRMS);
@@ -424,6 +635,44 @@ void SoundcheckEngine::calculateCorrections(int channelIndex)
         analysis.compressorRatioSuggestion = 1.0f;  // No compression for narrow range
 }
 
+bool SoundcheckEngine::saveChannelAsProfile(int channelIndex, const juce::String& name, const juce::StringArray& tags)
+{
+    // Only complete measurements make useful references
+    if (currentState != State::finished || name.trim().isEmpty()
+        || channelIndex < 0 || channelIndex >= static_cast<int>(channelAnalyses.size()))
+        return false;
+    
+    const auto& analysis = channelAnalyses[static_cast<size_t>(channelIndex)];
+    if (analysis.avgRMS <= 0.0f)
+        return false;
+    
+    ToneProfileLibrary::Entry entry;
+    entry.name = name.trim();
+    entry.tags = tags;
+    entry.type = analysis.suggestedType;
+    
+    // Store the curve's shape; its level is kept as the target RMS
+    float meanDb = 0.0f;
+    for (auto magnitude : analysis.measuredMagnitudes)
+        meanDb += magnitude;
+    meanDb /= juce::jmax(1, analysis.measuredMagnitudes.size());
+    
+    for (auto magnitude : analysis.measuredMagnitudes)
+        entry.profile.refMagnitudes.add(magnitude - meanDb);
+    
+    entry.profile.targetRms = juce::Decibels::gainToDecibels(analysis.avgRMS);
+    entry.profile.gateThreshold = analysis.gateThresholdSuggestion;
+    entry.profile.spectralFlux = analysis.spectralFlux;
+    entry.profile.crestFactorDb = analysis.crestFactorDb;
+    entry.profile.onsetRate = analysis.onsetRate;
+    
+    if (!ToneProfileLibrary::getInstance().addProfile(entry))
+        return false;
+    
+    juce::Logger::writeToLog("SoundcheckEngine: saved channel " + juce::String(channelIndex) + " as profile " + entry.name);
+    return true;
+}
+
 void SoundcheckEngine::backupOriginalSettings(int channelIndex)
 {
     // Make sure channel index is valid
@@ -448,102 +697,87 @@ void SoundcheckEngine::backupOriginalSettings(int channelIndex)
     analysis.originalCompressorRatio = processor->getCompressorRatio();
 }
 
-void SoundcheckEngine::applyCorrections()
+void SoundcheckEngine::buildSceneDeltas()
 {
-    // Only apply if we have channel processors and soundcheck is finished
-    if (channelProcessors.empty() || currentState != State::finished)
-        return;
-    
-    juce::Logger::writeToLog("SoundcheckEngine: Applying corrections to " + 
-                            juce::String(channelProcessors.size()) + " channels");
+    correctionDelta.entries.clear();
+    originalDelta.entries.clear();
     
-    // Apply correction to each channel
     for (size_t i = 0; i < channelProcessors.size() && i < channelAnalyses.size(); ++i)
     {
-        // Get channel processor
         auto* processor = channelProcessors[i];
         if (processor == nullptr)
             continue;
         
-        // Get analysis data
         const auto& analysis = channelAnalyses[i];
-
-        // Update processor channel type based on analysis
-        processor->setChannelType(analysis.suggestedType);
-
-        juce::String typeStr;
-        switch (analysis.suggestedType)
-        {
-            case ChannelProcessor::ChannelType::Vocal:      typeStr = "Vocal"; break;
-            case ChannelProcessor::ChannelType::Instrument: typeStr = "Instrument"; break;
-            case ChannelProcessor::ChannelType::Drums:      typeStr = "Drums"; break;
-            default:                                       typeStr = "Other"; break;
-        }
-        juce::Logger::writeToLog("Channel " + juce::String(i) + " classified as " + typeStr);
-
-        // Apply trim gain
-        processor->setTrimGain(analysis.trimGainSuggestion);
         
-        // Apply gate threshold
-        processor->setGateThreshold(analysis.gateThresholdSuggestion);
-        processor->setGateEnabled(true);
+        // Start from the channel's current settings so untouched parameters stay put
+        const auto current = ChannelSettings::capture(*processor);
         
-        // Apply EQ band gains
-        processor->setEqEnabled(true);
+        auto corrected = current;
+        corrected.type = analysis.suggestedType;
+        corrected.trimGainDb = analysis.trimGainSuggestion;
+        corrected.gateEnabled = true;
+        corrected.gateThresholdDb = analysis.gateThresholdSuggestion;
+        corrected.eqEnabled = true;
         for (int band = 0; band < 4; ++band)
-        {
-            processor->setEQBandGain(static_cast<EQProcessor::Band>(band), 
-                                     analysis.eqGainSuggestions[band]);
-        }
+            corrected.eqGainsDb[static_cast<size_t>(band)] = analysis.eqGainSuggestions[band];
+        corrected.compressorEnabled = analysis.compressorRatioSuggestion > 1.0f;
+        corrected.compressorRatio = analysis.compressorRatioSuggestion;
         
-        // Apply compressor settings
-        processor->setCompressorRatio(analysis.compressorRatioSuggestion);
-        processor->setCompressorEnabled(analysis.compressorRatioSuggestion > 1.0f);
+        auto original = current;
+        original.type = analysis.originalType;
+        original.trimGainDb = analysis.originalTrimGain;
+        original.gateThresholdDb = analysis.originalGateThreshold;
+        for (int band = 0; band < 4; ++band)
+            original.eqGainsDb[static_cast<size_t>(band)] = analysis.originalEqGains[band];
+        original.compressorRatio = analysis.originalCompressorRatio;
         
-        // Log the settings for debugging
-        juce::Logger::writeToLog("Channel " + juce::String(i) + 
-                               " - Trim: " + juce::String(analysis.trimGainSuggestion) + " dB" +
-                               ", Gate: " + juce::String(analysis.gateThresholdSuggestion) + " dB" +
-                               ", Comp Ratio: " + juce::String(analysis.compressorRatioSuggestion) + ":1");
+        correctionDelta.entries.push_back({ processor, corrected });
+        originalDelta.entries.push_back({ processor, original });
     }
+}
+
+void SoundcheckEngine::publishDelta(const SceneDelta& delta, double crossfadeSeconds)
+{
+    SceneDelta copy = delta;
+    copy.crossfadeSeconds = crossfadeSeconds;
+    
+    if (sceneDeltaQueue != nullptr)
+    {
+        sceneDeltaQueue->publish(std::move(copy));
+    }
+    else
+    {
+        for (const auto& entry : copy.entries)
+            entry.target.applyTo(*entry.processor);
+    }
+}
+
+void SoundcheckEngine::applyCorrections(double crossfadeSeconds)
+{
+    // Needs the results of a completed check
+    if (isRunning() || !hasCorrections())
+        return;
+    
+    publishDelta(correctionDelta, crossfadeSeconds);
+    
+    juce::Logger::writeToLog("SoundcheckEngine: Applying corrections to " + 
+                            juce::String(static_cast<int>(correctionDelta.entries.size())) + " channels" +
+                            (crossfadeSeconds > 0.0 ? " over " + juce::String(crossfadeSeconds, 1) + " s" : juce::String()));
     
     // Switch to idle state
     currentState = State::idle;
 }
 
-void SoundcheckEngine::revertCorrections()
+void SoundcheckEngine::revertCorrections(double crossfadeSeconds)
 {
-    // Only revert if we have channel processors
-    if (channelProcessors.empty())
+    if (isRunning() || originalDelta.entries.empty())
         return;
     
-    juce::Logger::writeToLog("SoundcheckEngine: Reverting corrections for " + 
-                            juce::String(channelProcessors.size()) + " channels");
+    publishDelta(originalDelta, crossfadeSeconds);
     
-    // Apply original settings to each channel
-    for (size_t i = 0; i < channelProcessors.size() && i < channelAnalyses.size(); ++i)
-    {
-        // Get channel processor
-        auto* processor = channelProcessors[i];
-        if (processor == nullptr)
-            continue;
-        
-        // Get analysis data
-        const auto& analysis = channelAnalyses[i];
-        
-        // Restore original settings
-        processor->setChannelType(analysis.originalType);
-        processor->setTrimGain(analysis.originalTrimGain);
-        processor->setGateThreshold(analysis.originalGateThreshold);
-        
-        for (int band = 0; band < 4; ++band)
-        {
-            processor->setEQBandGain(static_cast<EQProcessor::Band>(band), 
-                                    analysis.originalEqGains[band]);
-        }
-        
-        processor->setCompressorRatio(analysis.originalCompressorRatio);
-    }
+    juce::Logger::writeToLog("SoundcheckEngine: Reverting corrections for " + 
+                            juce::String(static_cast<int>(originalDelta.entries.size())) + " channels");
     
     // Switch to idle state
     currentState = State::idle;
@@ -551,36 +785,55 @@ void SoundcheckEngine::revertCorrections()
 
 void SoundcheckEngine::run()
 {
-    // Process each channel in sequence
-    while (!threadShouldExit() && currentChannelIndex < static_cast<int>(channelAnalyses.size()))
+    // Drain the capture FIFO into the analysers until the measurement is complete
+    auto analyseUntilCaptured = [this]
     {
-        // Get current channel to analyze
-        auto& analysis = channelAnalyses[currentChannelIndex];
-        
-        // Reset audio capture buffer
-        bufferWritePosition = 0;
-        samplesCollected = 0;
-        audioRingBuffer.clear();
+        while (!threadShouldExit())
+        {
+            processCapturedAudio();
+            publishLiveMagnitudes();
+            
+            // Complete once this measurement's samples have all been analysed
+            if (samplesAnalysed >= samplesPerChannel)
+                return true;
+            
+            wait(20);
+        }
         
-        // Wait for audio to be collected
-        while (!threadShouldExit() && samplesCollected < analysisLengthSeconds * 48000)
+        return false;
+    };
+    
+    if (checkMode == Mode::AllChannels)
+    {
+        // One capture window covers every routed input
+        if (analyseUntilCaptured())
         {
-            wait(100); // Check every 100ms
+            for (int channel = 0; channel < captureFifo.getNumChannels() && !threadShouldExit(); ++channel)
+                finaliseChannel(channel);
         }
+    }
+    else
+    {
+        // Process each channel in sequence. startCheck() already requested channel 0.
+        const int numChannels = static_cast<int>(channelAnalyses.size());
         
-        if (threadShouldExit())
-            break;
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            if (channel > 0)
+                beginMeasurement(channel);
             
-        // Analyze the collected audio
-        analyzeCurrentChannelBuffer();
-        
-        // Move to next channel
-        ++currentChannelIndex;
+            if (!analyseUntilCaptured())
+                break;
+            
+            finaliseChannel(channel);
+        }
     }
     
     // Set state to finished if we completed all channels
     if (!threadShouldExit())
     {
+        // Assemble the complete before/after scenes here, off the message thread
+        buildSceneDeltas();
         currentState = State::finished;
         
         // Check elapsed time
@@ -590,44 +843,8 @@ void SoundcheckEngine::run()
         juce::Logger::writeToLog("SoundcheckEngine: Analysis complete for all channels in " + 
                                 juce::String(elapsedMs / 1000.0) + " seconds");
         
-        // Assert if it took too long
-        jassert(elapsedMs < 60000); // Must complete in under 60 seconds
+        if (droppedSamples > 0)
+            juce::Logger::writeToLog("SoundcheckEngine: " + juce::String(droppedSamples.load()) +
+                                     " samples dropped while the analysis thread caught up");
     }
 }
-
-ChannelProcessor::ChannelType SoundcheckEngine::classifyChannel(const juce::Array<float>& magnitudes) const
-{
-    using StripType = ChannelStripComponent::ChannelType;
-
-    struct TypeMap { StripType strip; ChannelProcessor::ChannelType proc; };
-    const TypeMap types[] = {
-        {StripType::SingingVocal,   ChannelProcessor::ChannelType::Vocal},
-        {StripType::Speech,         ChannelProcessor::ChannelType::Vocal},
-        {StripType::Instrument,     ChannelProcessor::ChannelType::Instrument},
-        {StripType::Drums,          ChannelProcessor::ChannelType::Drums},
-        {StripType::Other,          ChannelProcessor::ChannelType::Other}
-    };
-
-    ChannelProcessor::ChannelType best = ChannelProcessor::ChannelType::Other;
-    float bestScore = std::numeric_limits<float>::max();
-
-    for (const auto& t : types)
-    {
-        const auto& profile = getProfileFor(t.strip);
-        float score = 0.0f;
-        const int n = juce::jmin(magnitudes.size(), profile.refMagnitudes.size());
-        for (int i = 0; i < n; ++i)
-        {
-            const float diff = profile.refMagnitudes[i] - magnitudes[i];
-            score += diff * diff;
-        }
-
-        if (score < bestScore)
-        {
-            bestScore = score;
-            best = t.proc;
-        }
-    }
-
-    return best;
-}
@@ -2,7 +2,12 @@
 
 #include <JuceHeader.h>
 #include "../Audio/ChannelProcessor.h"
+#include "../Audio/SceneDelta.h"
 #include "ToneProfiles.h"
+#include "StreamingChannelAnalyser.h"
+#include "CaptureFifo.h"
+#include "ChannelClassifier.h"
+#include "EQFitter.h"
 #include <chrono>
 
 // Forward declare the callback class
@@ -40,6 +45,7 @@ public:
         float trimGainSuggestion = 0.0f;
         float gateThresholdSuggestion = -50.0f;
         float eqGainSuggestions[4] = { 0.0f, 0.0f, 0.0f, 0.0f }; // For the 4 EQ bands
+        float eqFitResidualDb = 0.0f;   // RMS error left after applying the EQ suggestion
         float compressorRatioSuggestion = 1.0f;
         
         // Original values (for revert)
@@ -51,21 +57,60 @@ public:
 
         // Suggested channel type based on analysis
         ChannelProcessor::ChannelType suggestedType = ChannelProcessor::ChannelType::Other;
+        
+        // Classifier input and its closest reference profile
+        ChannelFeatures features;
+        float spectralFlux = 0.0f;
+        float crestFactorDb = 0.0f;
+        float onsetRate = 0.0f;
+        int matchIndex = -1;
+        juce::String matchedProfile;
+        float matchDistance = 0.0f;
+    };
+    
+    // How the inputs are captured
+    enum class Mode
+    {
+        Sequential,     // One channel at a time, secondsPerChannel each
+        AllChannels     // Every routed input at once, analysed in parallel afterwards
     };
     
     // Public API
-    void startCheck(int secondsPerChannel = 5);
+    void startCheck(int secondsPerChannel = 5, Mode mode = Mode::Sequential);
     void stopCheck();
     bool isRunning() const;
+    bool isFinished() const;
+    Mode getMode() const { return checkMode; }
+    int getCurrentChannel() const { return currentChannelIndex.load(); }
+    double getProgress() const;     // 0..1 across the whole check
     const ChannelAnalysis& getAnalysis(int channelIndex) const;
     
-    // Apply/revert correction settings based on analysis
-    void applyCorrections();
-    void revertCorrections();
+    // Running 32-band spectrum of a channel while the check is in progress.
+    // Safe to call from the message thread at any time.
+    void getLiveMagnitudes(int channelIndex, juce::Array<float>& magnitudes) const;
+    
+    // Apply/revert correction settings based on analysis. Every channel
+    // changes in the same audio block, optionally crossfading over the
+    // given time.
+    void applyCorrections(double crossfadeSeconds = 0.0);
+    void revertCorrections(double crossfadeSeconds = 0.0);
+    bool hasCorrections() const { return !correctionDelta.entries.empty(); }
+    
+    // Store a finished channel's measurement in the ToneProfileLibrary, so
+    // later checks can match it and correct towards it
+    bool saveChannelAsProfile(int channelIndex, const juce::String& name, const juce::StringArray& tags);
     
     // Set channel processors to control
     void setChannelProcessors(const std::vector<ChannelProcessor*>& processors);
     
+    // Where corrections are published; without one they are applied directly
+    void setSceneDeltaQueue(SceneDeltaQueue* queue) { sceneDeltaQueue = queue; }
+    
+    // Device sample rate - set by the audio engine when the device starts.
+    // Takes effect at the next startCheck().
+    void setSampleRate(double newSampleRate);
+    double getSampleRate() const { return sampleRate.load(); }
+    
     // Make the audio callback class a friend so it can call captureAudio
     friend class SoundcheckAudioCallback;
     
@@ -79,45 +124,106 @@ private:
     // Thread implementation
     void run() override;
     
-    // Analysis states
+    // Analysis states - read by the audio, analysis and message threads
     enum class State { idle, analysing, finished };
-    State currentState = State::idle;
+    std::atomic<State> currentState { State::idle };
     
     // Analysis data
     std::vector<ChannelAnalysis> channelAnalyses;
     std::vector<ChannelProcessor*> channelProcessors;
     
+    // Complete before/after scenes, built by the analysis thread when the
+    // check finishes and only read by the message thread after that
+    SceneDelta correctionDelta;
+    SceneDelta originalDelta;
+    SceneDeltaQueue* sceneDeltaQueue = nullptr;
+    
     // Analysis parameters
+    Mode checkMode = Mode::Sequential;
     int analysisLengthSeconds = 5;
-    int currentChannelIndex = 0;
+    std::atomic<int> currentChannelIndex { 0 };
+    std::atomic<double> sampleRate { 48000.0 };
+    int samplesPerChannel = 0;  // analysisLengthSeconds at the current rate
+    double checkSampleRate = 48000.0;   // Rate the current check was started at
     
     // FFT processing
     static constexpr int fftOrder = 11;          // 2^11 = 2048 points
     static constexpr int fftSize = 1 << fftOrder;
-    std::unique_ptr<juce::dsp::FFT> fft;
+    static constexpr int numBands = 32;
     
-    // Audio capture buffer (5 seconds at 48 kHz)
-    static constexpr int maxBufferSize = 48000 * 5 * 2; // 5 seconds stereo at 48kHz
-    juce::AudioBuffer<float> audioRingBuffer;
-    int bufferWritePosition = 0;
-    int samplesCollected = 0;
+    // Audio capture: a lock-free FIFO with one mono channel per captured
+    // mixer channel. The audio thread writes, the analysis thread drains it
+    // a few times per second. Sequential mode uses a single channel.
+    static constexpr double captureRingSeconds = 1.0;
+    CaptureFifo captureFifo;
+    std::vector<int> captureInputs;     // Device input feeding each mixer channel
     
-    // FFT analysis buffers
-    juce::HeapBlock<float> fftTimeDomain;
-    juce::HeapBlock<float> fftFrequencyDomain;
-    juce::HeapBlock<float> windowBuffer;
-    juce::Array<float> analyzedBands;
+    // Each measurement has an epoch. The analysis thread publishes the epoch
+    // and mixer channel it wants next; the audio thread tags everything it
+    // captures with the request it saw, and the reader ignores older epochs.
+    struct CaptureRequest
+    {
+        juce::uint32 epoch = 0;
+        int channel = -1;           // -1 captures every channel
+    };
+    std::atomic<CaptureRequest> captureRequest { CaptureRequest {} };
+    std::atomic<int> capturesInFlight { 0 };
+    std::atomic<int> samplesCollected { 0 };        // Current measurement, for progress only
+    std::atomic<int> droppedSamples { 0 };
+    
+    // Audio thread only
+    juce::uint32 activeEpoch = 0;
+    int activeChannel = -1;
+    int samplesCapturedThisEpoch = 0;
+    
+    // Analysis thread only (and startCheck() while the thread is stopped)
+    juce::uint32 measurementEpoch = 0;
+    int samplesAnalysed = 0;
+    
+    // One incremental analyser per mixer channel, owned by the analysis thread
+    std::vector<std::unique_ptr<StreamingChannelAnalyser>> analysers;
+    
+    // Workers that share the per-hop analysis across channels
+    juce::ThreadPool analysisPool { juce::jmax(1, juce::SystemStats::getNumCpus() - 1) };
+    juce::WaitableEvent analysisJobsDone;
+    std::atomic<int> pendingAnalysisJobs { 0 };
+    
+    // Live band magnitudes published for the UI, numBands per channel
+    std::unique_ptr<std::atomic<float>[]> liveMagnitudes;
+    int numLiveChannels = 0;
+    juce::HeapBlock<float> liveSpectrum;            // Analysis thread scratch
+    juce::Array<float> liveBands;                   // Analysis thread scratch
+    
+    // FFT bin -> 1/3-octave band lookup, rebuilt whenever the sample rate changes
+    std::vector<int> binToBand;         // -1 for bins outside every band
+    std::vector<int> bandBinCounts;
+    double bandLookupSampleRate = 0.0;
+    
+    // Least-squares fit of the channel EQ, prepared for the check's rate
+    EQFitter eqFitter;
     
     // Performance monitoring
     std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
     
     // Helper methods
     void initializeAnalysis();
-    void analyzeCurrentChannelBuffer();
+    void beginMeasurement(int channelIndex);
+    void waitForCaptureToStop();
+    void processCapturedAudio();
+    void publishLiveMagnitudes();
+    void finaliseChannel(int channelIndex);
     void calculateCorrections(int channelIndex);
     void backupOriginalSettings(int channelIndex);
+    void buildSceneDeltas();
+    void publishDelta(const SceneDelta& delta, double crossfadeSeconds);
+    void updateBandLookup(double rate);
     void mapFFTToThirdOctaveBands(const float* fftData, juce::Array<float>& bandMagnitudes);
-    ChannelProcessor::ChannelType classifyChannel(const juce::Array<float>& magnitudes) const;
+    
+    // Reference index for channel type classification: the built-in
+    // profiles plus the user library, rebuilt when the library changes
+    void rebuildClassifier();
+    ChannelClassifier classifier;
+    int classifierLibraryRevision = -1;
 };
 
 // Callback class to capture audio for analysis
@@ -146,7 +252,11 @@ public:
         }
     }
     
-    void audioDeviceAboutToStart(juce::AudioIODevice* device) override {}
+    void audioDeviceAboutToStart(juce::AudioIODevice* device) override
+    {
+        if (device != nullptr)
+            soundcheckEngine.setSampleRate(device->getCurrentSampleRate());
+    }
     void audioDeviceStopped() override {}
     
 private:
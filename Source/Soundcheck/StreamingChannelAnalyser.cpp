@@ -0,0 +1,189 @@
+#include "StreamingChannelAnalyser.h"
+
+StreamingChannelAnalyser::StreamingChannelAnalyser(int fftOrder)
+    : fftSize(1 << fftOrder),
+      hopSize(fftSize / 4), // 75% overlap
+      fft(fftOrder)
+{
+    // Initialize analysis buffers
+    window.allocate(fftSize, true);
+    frame.allocate(fftSize, true);
+    fftBuffer.allocate(fftSize * 2, true);
+    spectrumSum.allocate(fftSize / 2, true);
+    previousMagnitudes.allocate(fftSize / 2, true);
+
+    // Create Hann window for FFT
+    for (int i = 0; i < fftSize; ++i)
+        window[i] = 0.5f - 0.5f * std::cos(2.0f * juce::MathConstants<float>::pi * i / (fftSize - 1));
+
+    reset();
+}
+
+void StreamingChannelAnalyser::reset()
+{
+    frame.clear(fftSize);
+    spectrumSum.clear(fftSize / 2);
+    framePosition = 0;
+    samplesUntilNextFrame = fftSize; // First frame needs a full window of audio
+    numFrames = 0;
+
+    numSamples = 0;
+    sumSquared = 0.0;
+    peak = 0.0f;
+
+    noiseHistogram.fill(0);
+    noiseSampleCount = 0;
+    decimationCounter = 0;
+
+    previousMagnitudes.clear(fftSize / 2);
+    fluxSum = 0.0;
+    numFluxFrames = 0;
+    fluxMean = 0.0f;
+    aboveOnsetThreshold = false;
+    numOnsets = 0;
+}
+
+void StreamingChannelAnalyser::process(const float* samples, int numSamplesToProcess)
+{
+    for (int i = 0; i < numSamplesToProcess; ++i)
+    {
+        const float sample = samples[i];
+        const float magnitude = std::abs(sample);
+
+        // Level statistics
+        sumSquared += static_cast<double>(sample) * sample;
+        peak = juce::jmax(peak, magnitude);
+
+        // Noise floor histogram
+        if (decimationCounter == 0)
+        {
+            const float levelDb = juce::Decibels::gainToDecibels(magnitude, histogramFloorDb);
+            const int bin = juce::jlimit(0, numHistogramBins - 1,
+                                         static_cast<int>((levelDb - histogramFloorDb) / histogramStepDb));
+            ++noiseHistogram[static_cast<size_t>(bin)];
+            ++noiseSampleCount;
+        }
+
+        if (++decimationCounter >= noiseFloorDecimation)
+            decimationCounter = 0;
+
+        // Spectrum frames
+        frame[framePosition] = sample;
+        if (++framePosition >= fftSize)
+            framePosition = 0;
+
+        if (--samplesUntilNextFrame == 0)
+        {
+            processFrame();
+            samplesUntilNextFrame = hopSize;
+        }
+    }
+
+    numSamples += numSamplesToProcess;
+}
+
+void StreamingChannelAnalyser::processFrame()
+{
+    // Unroll the circular frame (oldest sample first) and apply the window
+    for (int i = 0; i < fftSize; ++i)
+    {
+        int index = framePosition + i;
+        if (index >= fftSize)
+            index -= fftSize;
+
+        fftBuffer[i] = frame[index] * window[i];
+    }
+
+    // Perform FFT
+    fft.performRealOnlyForwardTransform(fftBuffer);
+
+    // Accumulate the magnitude spectrum, and the rise since the last frame
+    float frameMagnitude = 0.0f;
+    float frameRise = 0.0f;
+
+    for (int i = 0; i < fftSize / 2; ++i)
+    {
+        const float real = fftBuffer[i * 2];
+        const float imag = fftBuffer[i * 2 + 1];
+        const float magnitude = std::sqrt(real * real + imag * imag);
+
+        spectrumSum[i] += magnitude;
+        frameMagnitude += magnitude;
+        frameRise += juce::jmax(0.0f, magnitude - previousMagnitudes[i]);
+        previousMagnitudes[i] = magnitude;
+    }
+
+    // Flux relative to the frame's own level, so it doesn't depend on gain.
+    // Silent frames and the first frame have nothing to compare against.
+    if (numFrames > 0 && frameMagnitude > silentFrameMagnitude)
+    {
+        const float flux = frameRise / frameMagnitude;
+        fluxSum += flux;
+        ++numFluxFrames;
+
+        // Onset on a rising edge well above the running flux level
+        const bool above = flux > fluxMean * 1.5f + 0.05f;
+        if (above && !aboveOnsetThreshold)
+            ++numOnsets;
+
+        aboveOnsetThreshold = above;
+        fluxMean = fluxMean * 0.9f + flux * 0.1f;
+    }
+
+    ++numFrames;
+}
+
+float StreamingChannelAnalyser::getRMS() const
+{
+    if (numSamples == 0)
+        return 0.0f;
+
+    return static_cast<float>(std::sqrt(sumSquared / static_cast<double>(numSamples)));
+}
+
+float StreamingChannelAnalyser::getCrestFactorDb() const
+{
+    const float rms = getRMS();
+    if (rms <= 0.0f || peak <= 0.0f)
+        return 0.0f;
+
+    return juce::Decibels::gainToDecibels(peak / rms);
+}
+
+float StreamingChannelAnalyser::getMeanFlux() const
+{
+    return numFluxFrames > 0 ? static_cast<float>(fluxSum / numFluxFrames) : 0.0f;
+}
+
+float StreamingChannelAnalyser::getNoiseFloor(float quantile) const
+{
+    if (noiseSampleCount == 0)
+        return 0.0f;
+
+    // Same rank the old sort-based estimate used
+    const int targetRank = static_cast<int>(noiseSampleCount * juce::jlimit(0.0f, 1.0f, quantile));
+
+    int cumulative = 0;
+    for (int bin = 0; bin < numHistogramBins; ++bin)
+    {
+        cumulative += noiseHistogram[static_cast<size_t>(bin)];
+        if (cumulative > targetRank)
+        {
+            // The bottom bucket collects digital silence
+            if (bin == 0)
+                return 0.0f;
+
+            return juce::Decibels::decibelsToGain(histogramFloorDb + (bin + 0.5f) * histogramStepDb);
+        }
+    }
+
+    return 1.0f;
+}
+
+void StreamingChannelAnalyser::getAverageSpectrum(float* destination) const
+{
+    const double scale = numFrames > 0 ? 1.0 / numFrames : 0.0;
+
+    for (int i = 0; i < fftSize / 2; ++i)
+        destination[i] = static_cast<float>(spectrumSum[i] * scale);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+/**
+ * StreamingChannelAnalyser - Incremental level and spectrum analysis for one channel
+ *
+ * Consumes audio in arbitrary-sized chunks as it is captured and keeps running
+ * statistics, so the soundcheck results are ready as soon as capture stops:
+ *  - RMS and peak level
+ *  - Welch-averaged magnitude spectrum (Hann window, 75% overlap)
+ *  - Noise floor as a quantile of a level histogram (0.5 dB buckets)
+ *  - Spectral flux and onset count, for the channel classifier
+ *
+ * Not thread-safe: one analysis thread owns each instance.
+ */
+class StreamingChannelAnalyser
+{
+public:
+    explicit StreamingChannelAnalyser(int fftOrder);
+
+    // Clear all running statistics before a new measurement
+    void reset();
+
+    // Feed captured samples
+    void process(const float* samples, int numSamples);
+
+    // Running results
+    juce::int64 getNumSamples() const { return numSamples; }
+    int getNumFrames() const { return numFrames; }
+    float getRMS() const;
+    float getPeak() const { return peak; }
+    float getNoiseFloor(float quantile = 0.2f) const;   // Linear gain
+    float getCrestFactorDb() const;
+
+    // Level-independent spectral flux averaged over frames (0..1), and the
+    // number of onsets detected as sharp rises in flux
+    float getMeanFlux() const;
+    int getNumOnsets() const { return numOnsets; }
+
+    // Average magnitude spectrum so far, fftSize / 2 bins
+    void getAverageSpectrum(float* destination) const;
+    int getFFTSize() const { return fftSize; }
+
+private:
+    void processFrame();
+
+    // Noise floor histogram: every 64th sample, 0.5 dB buckets from -120 dBFS up
+    static constexpr int noiseFloorDecimation = 64;
+    static constexpr int numHistogramBins = 240;
+    static constexpr float histogramFloorDb = -120.0f;
+    static constexpr float histogramStepDb = 0.5f;
+
+    // Summed frame magnitude below which a frame counts as silence for flux
+    static constexpr float silentFrameMagnitude = 1.0e-3f;
+
+    const int fftSize;
+    const int hopSize;
+    juce::dsp::FFT fft;
+
+    // Analysis buffers
+    juce::HeapBlock<float> window;
+    juce::HeapBlock<float> frame;           // Circular, the last fftSize samples
+    juce::HeapBlock<float> fftBuffer;       // 2 * fftSize for the real-only transform
+    juce::HeapBlock<double> spectrumSum;    // fftSize / 2 bins
+    juce::HeapBlock<float> previousMagnitudes;
+    int framePosition = 0;
+    int samplesUntilNextFrame = 0;
+    int numFrames = 0;
+
+    // Level statistics
+    juce::int64 numSamples = 0;
+    double sumSquared = 0.0;
+    float peak = 0.0f;
+
+    std::array<int, numHistogramBins> noiseHistogram {};
+    int noiseSampleCount = 0;
+    int decimationCounter = 0;
+
+    // Flux and onsets
+    double fluxSum = 0.0;
+    int numFluxFrames = 0;
+    float fluxMean = 0.0f;          // Smoothed flux, the onset detector's adaptive baseline
+    bool aboveOnsetThreshold = false;
+    int numOnsets = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StreamingChannelAnalyser)
+};
@@ -0,0 +1,288 @@
+#include "ToneProfileLibrary.h"
+#include <cstring>
+
+// Singleton instance implementation
+ToneProfileLibrary& ToneProfileLibrary::getInstance()
+{
+    static ToneProfileLibrary instance;
+    return instance;
+}
+
+ToneProfileLibrary::ToneProfileLibrary()
+{
+    // Mapping is constant-time, so the library is always open
+    open();
+}
+
+juce::File ToneProfileLibrary::getDefaultFile()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+               .getChildFile("Auralis/tone_profiles.bin");
+}
+
+bool ToneProfileLibrary::open(const juce::File& file)
+{
+    libraryFile = file;
+    return remap();
+}
+
+bool ToneProfileLibrary::remap()
+{
+    mappedFile.reset();
+    numRecords = 0;
+    ++revision;
+    
+    // No file yet just means no saved profiles
+    if (!libraryFile.existsAsFile())
+        return true;
+    
+    // An empty file is what a first save truncates to anyway
+    const auto fileSize = libraryFile.getSize();
+    if (fileSize == 0)
+        return true;
+    
+    if (fileSize < static_cast<juce::int64>(sizeof(FileHeader)))
+    {
+        juce::Logger::writeToLog("ToneProfileLibrary: " + libraryFile.getFullPathName() + " is too short to be a library");
+        return setAsideUnreadableFile();
+    }
+    
+    auto mapped = std::make_unique<juce::MemoryMappedFile>(libraryFile, juce::MemoryMappedFile::readOnly);
+    if (mapped->getData() == nullptr || mapped->getSize() < sizeof(FileHeader))
+    {
+        juce::Logger::writeToLog("ToneProfileLibrary: could not map " + libraryFile.getFullPathName());
+        return false;
+    }
+    
+    FileHeader header;
+    std::memcpy(&header, mapped->getData(), sizeof(FileHeader));
+    
+    if (header.magic != fileMagic || header.byteOrder != byteOrderMark
+        || header.version != fileVersion || header.recordSize != sizeof(Record))
+    {
+        juce::Logger::writeToLog("ToneProfileLibrary: unrecognised file format in " + libraryFile.getFullPathName());
+        mapped.reset();
+        return setAsideUnreadableFile();
+    }
+    
+    // Ignore a partly written trailing record
+    const auto recordsInFile = (mapped->getSize() - sizeof(FileHeader)) / sizeof(Record);
+    numRecords = static_cast<int>(juce::jmin<size_t>(header.numRecords, recordsInFile));
+    mappedFile = std::move(mapped);
+    
+    juce::Logger::writeToLog("ToneProfileLibrary: " + juce::String(numRecords) + " profiles mapped");
+    return true;
+}
+
+bool ToneProfileLibrary::setAsideUnreadableFile()
+{
+    // Keep the bytes for whoever wants them back, and start a fresh library in their place
+    const auto aside = libraryFile.getSiblingFile(libraryFile.getFileName() + ".corrupt").getNonexistentSibling(false);
+    
+    if (!libraryFile.moveFileTo(aside))
+    {
+        juce::Logger::writeToLog("ToneProfileLibrary: could not move " + libraryFile.getFullPathName() + " aside");
+        return false;
+    }
+    
+    juce::Logger::writeToLog("ToneProfileLibrary: moved the unreadable library to " + aside.getFullPathName()
+                             + ", starting a new one");
+    return true;
+}
+
+int ToneProfileLibrary::getNumProfiles() const
+{
+    return mappedFile != nullptr ? numRecords : 0;
+}
+
+const ToneProfileLibrary::Record* ToneProfileLibrary::getRecord(int index) const
+{
+    if (mappedFile == nullptr || index < 0 || index >= numRecords)
+        return nullptr;
+    
+    // Records are 4-byte multiples after a 32-byte header in page-aligned memory
+    const auto* base = static_cast<const char*>(mappedFile->getData()) + sizeof(FileHeader);
+    return reinterpret_cast<const Record*>(base + static_cast<size_t>(index) * sizeof(Record));
+}
+
+ToneProfileLibrary::Entry ToneProfileLibrary::getProfile(int index) const
+{
+    Entry entry;
+    
+    const auto* record = getRecord(index);
+    if (record == nullptr)
+        return entry;
+    
+    entry.name = juce::String::fromUTF8(record->name, static_cast<int>(strnlen(record->name, sizeof(record->name))));
+    entry.tags.addTokens(juce::String::fromUTF8(record->tags, static_cast<int>(strnlen(record->tags, sizeof(record->tags)))), ",", {});
+    entry.tags.removeEmptyStrings();
+    entry.type = static_cast<ChannelProcessor::ChannelType>(juce::jlimit<juce::uint32>(0, 3, record->type));
+    
+    entry.profile.refMagnitudes = juce::Array<float>(record->refMagnitudes, 32);
+    entry.profile.targetRms = record->targetRms;
+    entry.profile.gateThreshold = record->gateThreshold;
+    entry.profile.spectralFlux = record->spectralFlux;
+    entry.profile.crestFactorDb = record->crestFactorDb;
+    entry.profile.onsetRate = record->onsetRate;
+    
+    return entry;
+}
+
+bool ToneProfileLibrary::writeHeader(juce::FileOutputStream& stream, juce::uint32 recordCount) const
+{
+    FileHeader header {};
+    header.magic = fileMagic;
+    header.byteOrder = byteOrderMark;
+    header.version = fileVersion;
+    header.recordSize = sizeof(Record);
+    header.numRecords = recordCount;
+    
+    return stream.setPosition(0) && stream.write(&header, sizeof(header));
+}
+
+bool ToneProfileLibrary::addProfile(const Entry& entry)
+{
+    // Encode the fixed-size record
+    Record record {};
+    entry.name.copyToUTF8(record.name, sizeof(record.name));
+    
+    // Whole tags only: one cut short would lose the ',' that searching relies on
+    juce::String tagField(",");
+    for (const auto& tag : entry.tags)
+    {
+        const auto cleaned = tag.trim().toLowerCase().removeCharacters(",");
+        if (cleaned.isEmpty())
+            continue;
+        
+        if (tagField.getNumBytesAsUTF8() + cleaned.getNumBytesAsUTF8() + 1 >= sizeof(record.tags))
+        {
+            juce::Logger::writeToLog("ToneProfileLibrary: no room for tag " + cleaned + " on " + entry.name);
+            continue;
+        }
+        
+        tagField << cleaned << ",";
+    }
+    tagField.copyToUTF8(record.tags, sizeof(record.tags));
+    
+    record.type = static_cast<juce::uint32>(entry.type);
+    for (int band = 0; band < 32; ++band)
+        record.refMagnitudes[band] = band < entry.profile.refMagnitudes.size() ? entry.profile.refMagnitudes[band] : -60.0f;
+    
+    record.targetRms = entry.profile.targetRms;
+    record.gateThreshold = entry.profile.gateThreshold;
+    record.spectralFlux = entry.profile.spectralFlux;
+    record.crestFactorDb = entry.profile.crestFactorDb;
+    record.onsetRate = entry.profile.onsetRate;
+    
+    // remap() moves unreadable files aside, so one still here couldn't be mapped or moved: don't write over it
+    if (mappedFile == nullptr && libraryFile.getSize() > 0 && !remap())
+    {
+        juce::Logger::writeToLog("ToneProfileLibrary: not saving " + entry.name + ", "
+                                 + libraryFile.getFullPathName() + " can't be read");
+        return false;
+    }
+    
+    // Release the mapping while the file is written
+    const int existingRecords = getNumProfiles();
+    mappedFile.reset();
+    libraryFile.getParentDirectory().createDirectory();
+    
+    bool ok = false;
+    {
+        juce::FileOutputStream stream(libraryFile);
+        if (stream.openedOk())
+        {
+            // A missing or empty file is started afresh
+            if (existingRecords == 0)
+            {
+                stream.setPosition(0);
+                stream.truncate();
+            }
+            
+            // Append the record, then publish it by bumping the count
+            ok = stream.setPosition(static_cast<juce::int64>(sizeof(FileHeader) + existingRecords * sizeof(Record)))
+                 && stream.write(&record, sizeof(record))
+                 && writeHeader(stream, static_cast<juce::uint32>(existingRecords + 1));
+            
+            stream.flush();
+            ok = ok && !stream.getStatus().failed();
+        }
+    }
+    
+    if (!ok)
+        juce::Logger::writeToLog("ToneProfileLibrary: failed to save profile " + entry.name);
+    
+    return remap() && ok;
+}
+
+bool ToneProfileLibrary::removeProfile(int index)
+{
+    const int existingRecords = getNumProfiles();
+    if (index < 0 || index >= existingRecords)
+        return false;
+    
+    // Move the last record into the gap, then shorten the file
+    const Record lastRecord = *getRecord(existingRecords - 1);
+    mappedFile.reset();
+    
+    bool ok = false;
+    {
+        juce::FileOutputStream stream(libraryFile);
+        if (stream.openedOk())
+        {
+            ok = stream.setPosition(static_cast<juce::int64>(sizeof(FileHeader) + index * sizeof(Record)))
+                 && stream.write(&lastRecord, sizeof(lastRecord))
+                 && writeHeader(stream, static_cast<juce::uint32>(existingRecords - 1))
+                 && stream.setPosition(static_cast<juce::int64>(sizeof(FileHeader) + (existingRecords - 1) * sizeof(Record)));
+            
+            if (ok)
+                ok = stream.truncate().wasOk();
+            
+            stream.flush();
+        }
+    }
+    
+    return remap() && ok;
+}
+
+juce::Array<int> ToneProfileLibrary::findProfiles(const juce::String& tag) const
+{
+    return search(-1, tag);
+}
+
+juce::Array<int> ToneProfileLibrary::findProfiles(ChannelProcessor::ChannelType type, const juce::String& tag) const
+{
+    return search(static_cast<int>(type), tag);
+}
+
+juce::Array<int> ToneProfileLibrary::search(int typeFilter, const juce::String& tag) const
+{
+    juce::Array<int> results;
+    
+    // Tags are stored as ",a,b,", so a whole-word match is a substring match on ",tag,"
+    const auto cleanedTag = tag.trim().toLowerCase();
+    const juce::String needle = cleanedTag.isNotEmpty() ? "," + cleanedTag + "," : juce::String();
+    const char* needleUTF8 = needle.toRawUTF8();
+    
+    for (int i = 0; i < getNumProfiles(); ++i)
+    {
+        const auto* record = getRecord(i);
+        
+        if (typeFilter >= 0 && record->type != static_cast<juce::uint32>(typeFilter))
+            continue;
+        
+        if (needle.isNotEmpty())
+        {
+            char tags[sizeof(Record::tags) + 1];
+            std::memcpy(tags, record->tags, sizeof(Record::tags));
+            tags[sizeof(Record::tags)] = 0;
+            
+            if (std::strstr(tags, needleUTF8) == nullptr)
+                continue;
+        }
+        
+        results.add(i);
+    }
+    
+    return results;
+}
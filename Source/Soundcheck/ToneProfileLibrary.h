@@ -0,0 +1,99 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Audio/ChannelProcessor.h"
+#include "ToneProfiles.h"
+
+/**
+ * ToneProfileLibrary - Persistent store of user-captured tone profiles
+ *
+ * Engineers save reference curves ("our lead vocal mic") from soundcheck
+ * results. The library is one binary file of fixed-size records that is
+ * memory-mapped read-only, so opening it costs the same with five profiles or
+ * five thousand: nothing is parsed until a record is asked for, and searching
+ * by type or tag scans the mapped records in place.
+ *
+ * File layout (native little-endian, byte-order tagged):
+ *   FileHeader, then numRecords * Record
+ *
+ * Message thread only.
+ */
+class ToneProfileLibrary
+{
+public:
+    static ToneProfileLibrary& getInstance();
+
+    struct Entry
+    {
+        juce::String name;
+        juce::StringArray tags;
+        ChannelProcessor::ChannelType type = ChannelProcessor::ChannelType::Other;
+        ToneProfile profile;
+    };
+
+    // Map the library file. A missing file is an empty library, not an error;
+    // one too short or in a format this version can't read is renamed to
+    // "<name>.corrupt" and a fresh library is started in its place.
+    bool open(const juce::File& file = getDefaultFile());
+    const juce::File& getFile() const { return libraryFile; }
+    static juce::File getDefaultFile();
+
+    // Profiles
+    int getNumProfiles() const;
+    Entry getProfile(int index) const;
+    bool addProfile(const Entry& entry);
+    bool removeProfile(int index);
+
+    // Search; tags match whole words, case-insensitively
+    juce::Array<int> findProfiles(const juce::String& tag = {}) const;
+    juce::Array<int> findProfiles(ChannelProcessor::ChannelType type, const juce::String& tag = {}) const;
+
+    // Bumped whenever the contents change, so users can cache derived data
+    int getRevision() const { return revision; }
+
+private:
+    ToneProfileLibrary();
+
+    static constexpr juce::uint32 fileMagic = 0x50545541;     // "AUTP"
+    static constexpr juce::uint32 byteOrderMark = 0x01020304;
+    static constexpr juce::uint32 fileVersion = 1;
+
+    struct FileHeader
+    {
+        juce::uint32 magic;
+        juce::uint32 byteOrder;
+        juce::uint32 version;
+        juce::uint32 recordSize;
+        juce::uint32 numRecords;
+        juce::uint32 reserved[3];
+    };
+
+    struct Record
+    {
+        char name[48];              // UTF-8, NUL-terminated
+        char tags[64];              // ",tag,tag," lower-case, NUL-terminated
+        juce::uint32 type;
+        float refMagnitudes[32];
+        float targetRms;
+        float gateThreshold;
+        float spectralFlux;
+        float crestFactorDb;
+        float onsetRate;
+    };
+
+    static_assert(sizeof(FileHeader) == 32, "Library header layout changed");
+    static_assert(sizeof(Record) == 264, "Library record layout changed");
+
+    const Record* getRecord(int index) const;
+    juce::Array<int> search(int typeFilter, const juce::String& tag) const;
+    bool writeHeader(juce::FileOutputStream& stream, juce::uint32 numRecords) const;
+    bool remap();
+    bool setAsideUnreadableFile();
+
+    juce::File libraryFile;
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+    int numRecords = 0;
+    int revision = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ToneProfileLibrary)
+};
@@ -1,19 +1,39 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "../UI/ChannelStripComponent.h"
+#include "../FX/EQProcessor.h"
+
+/**
+ * ToneProfileType - The kinds of source a reference profile exists for
+ *
+ * The channel strip's type selector offers the same choices.
+ */
+enum class ToneProfileType
+{
+    SingingVocal,
+    Instrument,
+    Drums,
+    Speech,
+    Other
+};
 
 /**
  * ToneProfile - A reference frequency profile for different channel types
  * 
  * Contains a reference magnitude curve (32-band 1/3-octave), target RMS level,
- * and noise gate threshold for specific channel types.
+ * and noise gate threshold for specific channel types, plus typical temporal
+ * descriptors used by the channel classifier.
  */
 struct ToneProfile
 {
     juce::Array<float> refMagnitudes;   // 32-band ⅓-octave
     float targetRms = -18.0f;           // dBFS
     float gateThreshold = -50.0f;       // dBFS
+    
+    // Typical behaviour over time
+    float spectralFlux = 0.10f;         // Mean level-normalised flux (0..1)
+    float crestFactorDb = 12.0f;        // Peak to RMS
+    float onsetRate = 2.0f;             // Onsets per second
 };
 
 /**
@@ -22,9 +42,9 @@ struct ToneProfile
  * @param type The channel type (SingingVocal, Instrument, etc.)
  * @return The reference ToneProfile for the specified channel type
  */
-inline const ToneProfile& getProfileFor(ChannelStripComponent::ChannelType type)
+inline const ToneProfile& getProfileFor(ToneProfileType type)
 {
-    using ChType = ChannelStripComponent::ChannelType;
+    using ChType = ToneProfileType;
     
     // Static profiles for each channel type
     static const std::map<ChType, ToneProfile> profiles = {
@@ -39,6 +59,9 @@ inline const ToneProfile& getProfileFor(ChannelStripComponent::ChannelType type)
             };
             profile.targetRms = -18.0f;
             profile.gateThreshold = -45.0f;
+            profile.spectralFlux = 0.08f;
+            profile.crestFactorDb = 12.0f;
+            profile.onsetRate = 1.5f;
             return profile;
         }()},
         
@@ -53,6 +76,9 @@ inline const ToneProfile& getProfileFor(ChannelStripComponent::ChannelType type)
             };
             profile.targetRms = -16.0f;
             profile.gateThreshold = -50.0f;
+            profile.spectralFlux = 0.06f;
+            profile.crestFactorDb = 10.0f;
+            profile.onsetRate = 2.0f;
             return profile;
         }()},
         
@@ -67,6 +93,9 @@ inline const ToneProfile& getProfileFor(ChannelStripComponent::ChannelType type)
             };
             profile.targetRms = -14.0f;
             profile.gateThreshold = -40.0f;
+            profile.spectralFlux = 0.25f;
+            profile.crestFactorDb = 20.0f;
+            profile.onsetRate = 6.0f;
             return profile;
         }()},
         
@@ -81,6 +110,9 @@ inline const ToneProfile& getProfileFor(ChannelStripComponent::ChannelType type)
             };
             profile.targetRms = -16.0f;
             profile.gateThreshold = -40.0f;
+            profile.spectralFlux = 0.12f;
+            profile.crestFactorDb = 15.0f;
+            profile.onsetRate = 4.0f;
             return profile;
         }()},
         
@@ -95,6 +127,9 @@ inline const ToneProfile& getProfileFor(ChannelStripComponent::ChannelType type)
             };
             profile.targetRms = -18.0f;
             profile.gateThreshold = -50.0f;
+            profile.spectralFlux = 0.10f;
+            profile.crestFactorDb = 12.0f;
+            profile.onsetRate = 2.0f;
             return profile;
         }()}
     };
@@ -0,0 +1,326 @@
+#include "AutosaveService.h"
+#include "DurableFile.h"
+#include "../Audio/AudioEngine.h"
+#include <cstring>
+
+namespace auralis
+{
+    namespace
+    {
+        template <typename Block>
+        bool blockDiffers (const std::vector<Block>& before, const std::vector<Block>& after, size_t index)
+        {
+            return index >= before.size() || std::memcmp (&before[index], &after[index], sizeof (Block)) != 0;
+        }
+
+        template <typename Block>
+        bool replaceBlock (std::vector<Block>& blocks, juce::uint32 index, const void* data, juce::uint32 size)
+        {
+            if (index >= blocks.size() || size != sizeof (Block))
+                return false;
+
+            std::memcpy (&blocks[index], data, sizeof (Block));
+            return true;
+        }
+    }
+
+    AutosaveService& AutosaveService::getInstance()
+    {
+        static AutosaveService instance;
+        return instance;
+    }
+
+    AutosaveService::AutosaveService()
+        : juce::Thread ("Autosave"),
+          directory (juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+                         .getChildFile ("Auralis")
+                         .getChildFile ("Autosave"))
+    {
+    }
+
+    AutosaveService::~AutosaveService()
+    {
+        stopTimer();
+        stopThread (2000);
+    }
+
+    juce::File AutosaveService::getSnapshotFile (juce::uint32 gen) const
+    {
+        return getDirectory().getChildFile ("autosave-" + juce::String (gen).paddedLeft ('0', 8) + ".aur");
+    }
+
+    juce::File AutosaveService::getJournalFile (juce::uint32 gen) const
+    {
+        return getDirectory().getChildFile ("autosave-" + juce::String (gen).paddedLeft ('0', 8) + ".journal");
+    }
+
+    juce::File AutosaveService::getMarkerFile() const
+    {
+        return getDirectory().getChildFile ("running.marker");
+    }
+
+    juce::Array<juce::uint32> AutosaveService::findGenerations() const
+    {
+        juce::Array<juce::uint32> generations;
+
+        for (const auto& file : getDirectory().findChildFiles (juce::File::findFiles, false, "autosave-*.aur"))
+        {
+            const auto number = file.getFileNameWithoutExtension().fromFirstOccurrenceOf ("-", false, false);
+            if (number.containsOnly ("0123456789"))
+                generations.add (static_cast<juce::uint32> (number.getLargeIntValue()));
+        }
+
+        generations.sort();
+        return generations;
+    }
+
+    //==============================================================================
+    bool AutosaveService::wasShutDownCleanly() const
+    {
+        return !getMarkerFile().existsAsFile();
+    }
+
+    bool AutosaveService::recoverLatest (SessionSnapshot& snapshot) const
+    {
+        const auto generations = findGenerations();
+
+        // Newest first; a snapshot torn by the power cut fails its checksum
+        for (int i = generations.size(); --i >= 0;)
+        {
+            const auto gen = generations.getUnchecked (i);
+
+            if (snapshot.readFromFile (getSnapshotFile (gen)))
+            {
+                replayJournal (getJournalFile (gen), gen, snapshot);
+                juce::Logger::writeToLog ("Autosave: recovered generation " + juce::String (gen));
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void AutosaveService::replayJournal (const juce::File& journal, juce::uint32 gen, SessionSnapshot& snapshot)
+    {
+        juce::MemoryBlock data;
+        if (!journal.loadFileAsData (data))
+            return;
+
+        auto* position = static_cast<const char*> (data.getData());
+        auto* end = position + data.getSize();
+        int replayed = 0;
+
+        while (end - position >= static_cast<std::ptrdiff_t> (sizeof (RecordHeader)))
+        {
+            RecordHeader header;
+            std::memcpy (&header, position, sizeof (header));
+            const auto* block = position + sizeof (RecordHeader);
+
+            // Stop at the first record the power cut tore
+            if (header.magic != recordMagic || header.generation != gen
+                || end - block < static_cast<std::ptrdiff_t> (header.size)
+                || SessionSnapshot::calculateChecksum (block, header.size) != header.checksum)
+                break;
+
+            switch (static_cast<BlockKind> (header.kind))
+            {
+                case BlockKind::channel:  replaceBlock (snapshot.channels, header.index, block, header.size); break;
+                case BlockKind::groupBus: replaceBlock (snapshot.groupBuses, header.index, block, header.size); break;
+                case BlockKind::fxBus:
+                    if (replaceBlock (snapshot.fxBuses, header.index, block, header.size))
+                        snapshot.fxBuses[header.index].validateReverbMode();
+                    break;
+                case BlockKind::master:
+                    if (header.size == sizeof (snapshot.master))
+                        std::memcpy (&snapshot.master, block, sizeof (snapshot.master));
+                    break;
+                default:
+                    break;
+            }
+
+            position = block + header.size;
+            ++replayed;
+        }
+
+        if (replayed > 0)
+            juce::Logger::writeToLog ("Autosave: replayed " + juce::String (replayed) + " journal records");
+    }
+
+    //==============================================================================
+    void AutosaveService::start (AudioEngine& engineToWatch)
+    {
+        engine = &engineToWatch;
+
+        getDirectory().createDirectory();
+        getMarkerFile().create();
+
+        // Carry on numbering after whatever is on disk so older runs stay recoverable
+        const auto generations = findGenerations();
+        generation = generations.isEmpty() ? 0 : generations.getLast();
+        hasBaseline = false;
+        journalRecords = 0;
+
+        startThread (juce::Thread::Priority::low);
+        startTimer (tickIntervalMs);
+    }
+
+    void AutosaveService::stop()
+    {
+        if (engine == nullptr)
+            return;
+
+        stopTimer();
+
+        // Finish with a full snapshot so the next start has no journal to replay
+        hasBaseline = false;
+        tick();
+
+        signalThreadShouldExit();
+        notify();
+        stopThread (10000);
+
+        // Anything the thread didn't get to
+        writePendingJobs();
+
+        getMarkerFile().deleteFile();
+        engine = nullptr;
+    }
+
+    void AutosaveService::tick()
+    {
+        if (engine == nullptr)
+            return;
+
+        SessionSnapshot current;
+        current.capture (*engine);
+
+        const auto now = juce::Time::getMillisecondCounter();
+        const bool fullSaveDue = journalRecords > 0
+                                 && (now - lastFullSaveTime >= fullSaveIntervalMs || journalRecords >= maxJournalRecords);
+
+        if (!hasBaseline || fullSaveDue)
+        {
+            Job job;
+            job.generation = ++generation;
+            job.fullSnapshot = true;
+            job.data = current.toMemoryBlock();
+            queueJob (std::move (job));
+
+            journalRecords = 0;
+            lastFullSaveTime = now;
+        }
+        else
+        {
+            juce::MemoryOutputStream records;
+            const int numChanged = appendChangedBlocks (lastSnapshot, current, records);
+
+            if (numChanged > 0)
+            {
+                Job job;
+                job.generation = generation;
+                job.data = records.getMemoryBlock();
+                queueJob (std::move (job));
+
+                journalRecords += numChanged;
+            }
+        }
+
+        lastSnapshot = std::move (current);
+        hasBaseline = true;
+    }
+
+    int AutosaveService::appendChangedBlocks (const SessionSnapshot& before, const SessionSnapshot& after,
+                                              juce::MemoryOutputStream& records) const
+    {
+        int count = 0;
+
+        auto writeRecord = [&] (BlockKind kind, size_t index, const void* block, size_t size)
+        {
+            RecordHeader header;
+            header.magic = recordMagic;
+            header.generation = generation;
+            header.kind = static_cast<juce::uint32> (kind);
+            header.index = static_cast<juce::uint32> (index);
+            header.size = static_cast<juce::uint32> (size);
+            header.checksum = SessionSnapshot::calculateChecksum (block, size);
+
+            records.write (&header, sizeof (header));
+            records.write (block, size);
+            ++count;
+        };
+
+        for (size_t i = 0; i < after.channels.size(); ++i)
+            if (blockDiffers (before.channels, after.channels, i))
+                writeRecord (BlockKind::channel, i, &after.channels[i], sizeof (after.channels[i]));
+
+        for (size_t i = 0; i < after.groupBuses.size(); ++i)
+            if (blockDiffers (before.groupBuses, after.groupBuses, i))
+                writeRecord (BlockKind::groupBus, i, &after.groupBuses[i], sizeof (after.groupBuses[i]));
+
+        for (size_t i = 0; i < after.fxBuses.size(); ++i)
+            if (blockDiffers (before.fxBuses, after.fxBuses, i))
+                writeRecord (BlockKind::fxBus, i, &after.fxBuses[i], sizeof (after.fxBuses[i]));
+
+        if (std::memcmp (&before.master, &after.master, sizeof (after.master)) != 0)
+            writeRecord (BlockKind::master, 0, &after.master, sizeof (after.master));
+
+        return count;
+    }
+
+    //==============================================================================
+    void AutosaveService::queueJob (Job job)
+    {
+        {
+            const juce::ScopedLock sl (queueLock);
+            pendingJobs.push_back (std::move (job));
+        }
+
+        notify();
+    }
+
+    void AutosaveService::run()
+    {
+        while (!threadShouldExit())
+        {
+            wait (-1);
+            writePendingJobs();
+        }
+    }
+
+    void AutosaveService::writePendingJobs()
+    {
+        std::vector<Job> jobs;
+
+        {
+            const juce::ScopedLock sl (queueLock);
+            jobs.swap (pendingJobs);
+        }
+
+        for (const auto& job : jobs)
+        {
+            if (job.fullSnapshot)
+            {
+                if (DurableFile::replaceWithData (getSnapshotFile (job.generation), job.data.getData(), job.data.getSize()))
+                    removeOldGenerations (job.generation);
+                else
+                    juce::Logger::writeToLog ("Autosave: failed to write generation " + juce::String (job.generation));
+            }
+            else if (!DurableFile::append (getJournalFile (job.generation), job.data.getData(), job.data.getSize()))
+            {
+                juce::Logger::writeToLog ("Autosave: failed to append to journal " + juce::String (job.generation));
+            }
+        }
+    }
+
+    void AutosaveService::removeOldGenerations (juce::uint32 latest)
+    {
+        for (auto gen : findGenerations())
+        {
+            if (gen + generationsToKeep <= latest)
+            {
+                getSnapshotFile (gen).deleteFile();
+                getJournalFile (gen).deleteFile();
+            }
+        }
+    }
+}
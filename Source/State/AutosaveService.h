@@ -0,0 +1,112 @@
+#pragma once
+#include <JuceHeader.h>
+#include "SessionSnapshot.h"
+
+class AudioEngine;
+
+namespace auralis
+{
+    /**  Background session autosave.
+
+         Every tick the message thread captures a SessionSnapshot, which costs
+         a few getter calls per processor, and compares it block by block with
+         the previous one. Changed blocks are appended to a journal. A full
+         snapshot starts a new generation every fullSaveIntervalMs while the
+         mix keeps changing, or sooner if the journal grows long.
+
+         All disk work runs on a low-priority thread. Snapshots go to a temp
+         file that is synced and renamed into place, and journal appends are
+         synced as they are written, so a power cut loses at most one tick.
+         The last few generations are kept.
+
+         recoverLatest() loads the newest readable generation and replays its
+         journal up to the first torn or corrupt record. */
+    class AutosaveService : private juce::Timer,
+                            private juce::Thread
+    {
+    public:
+        static AutosaveService& getInstance();
+        ~AutosaveService() override;
+
+        /** False if the last run didn't reach stop(), e.g. a crash or power cut. */
+        bool wasShutDownCleanly() const;
+
+        /** Newest autosaved state, journal included. */
+        bool recoverLatest (SessionSnapshot& snapshot) const;
+
+        void start (AudioEngine& engine);
+
+        /** Writes a final snapshot and waits for the writer thread. */
+        void stop();
+
+        /** Captures the engine and queues whatever changed, as the timer does
+            every tickIntervalMs. The files are written on the writer thread. */
+        void tick();
+
+        /** Where the generations are kept: the user's application data folder
+            unless another is set. Change it only while stopped. */
+        void setDirectory (const juce::File& newDirectory) { directory = newDirectory; }
+        juce::File getDirectory() const { return directory; }
+
+    private:
+        AutosaveService();
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AutosaveService)
+
+        static constexpr int tickIntervalMs = 250;
+        static constexpr juce::uint32 fullSaveIntervalMs = 30000;
+        static constexpr int maxJournalRecords = 512;
+        static constexpr juce::uint32 generationsToKeep = 5;
+
+        static constexpr juce::uint32 recordMagic = 0x4a525541;     // "AURJ"
+
+        enum class BlockKind : juce::uint32 { channel, groupBus, fxBus, master };
+
+        // Journal record header, followed by one snapshot parameter block
+        struct RecordHeader
+        {
+            juce::uint32 magic;
+            juce::uint32 generation;
+            juce::uint32 kind;
+            juce::uint32 index;
+            juce::uint32 size;
+            juce::uint32 checksum;     // CRC-32 of the block
+        };
+
+        struct Job
+        {
+            juce::uint32 generation = 0;
+            bool fullSnapshot = false;
+            juce::MemoryBlock data;
+        };
+
+        void timerCallback() override { tick(); }
+        void run() override;
+
+        void queueJob (Job job);
+        void writePendingJobs();
+        void removeOldGenerations (juce::uint32 latest);
+
+        int appendChangedBlocks (const SessionSnapshot& before, const SessionSnapshot& after,
+                                 juce::MemoryOutputStream& records) const;
+        static void replayJournal (const juce::File& journal, juce::uint32 generation, SessionSnapshot& snapshot);
+
+        juce::Array<juce::uint32> findGenerations() const;
+        juce::File getSnapshotFile (juce::uint32 generation) const;
+        juce::File getJournalFile (juce::uint32 generation) const;
+        juce::File getMarkerFile() const;
+
+        juce::File directory;
+
+        // Message thread
+        AudioEngine* engine = nullptr;
+        SessionSnapshot lastSnapshot;
+        bool hasBaseline = false;
+        juce::uint32 generation = 0;
+        int journalRecords = 0;
+        juce::uint32 lastFullSaveTime = 0;
+
+        // Handed to the writer thread
+        juce::CriticalSection queueLock;
+        std::vector<Job> pendingJobs;
+    };
+}
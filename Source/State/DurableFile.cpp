@@ -0,0 +1,144 @@
+#include "DurableFile.h"
+#include <cstdio>
+#include <fcntl.h>
+
+#if JUCE_WINDOWS
+ #include <io.h>
+ #include <sys/stat.h>
+#else
+ #include <unistd.h>
+#endif
+
+namespace auralis
+{
+    namespace
+    {
+       #if JUCE_WINDOWS
+        int openForWriting (const juce::File& file, bool append)
+        {
+            return _wopen (file.getFullPathName().toWideCharPointer(),
+                           _O_WRONLY | _O_CREAT | _O_BINARY | (append ? _O_APPEND : _O_TRUNC),
+                           _S_IREAD | _S_IWRITE);
+        }
+
+        int writeSome (int fd, const char* data, size_t numBytes)
+        {
+            return _write (fd, data, static_cast<unsigned int> (juce::jmin<size_t> (numBytes, 1 << 30)));
+        }
+
+        bool syncAndClose (int fd)
+        {
+            const bool synced = _commit (fd) == 0;
+            return _close (fd) == 0 && synced;
+        }
+
+        // NTFS journals the rename itself
+        void syncDirectory (const juce::File&) {}
+
+        bool renameOver (const juce::File& source, const juce::File& target)
+        {
+            return source.moveFileTo (target);
+        }
+       #else
+        int openForWriting (const juce::File& file, bool append)
+        {
+            return ::open (file.getFullPathName().toRawUTF8(),
+                           O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC), 0644);
+        }
+
+        ssize_t writeSome (int fd, const char* data, size_t numBytes)
+        {
+            return ::write (fd, data, numBytes);
+        }
+
+        bool syncAndClose (int fd)
+        {
+           #if JUCE_MAC
+            // fsync() on macOS stops at the drive's cache
+            const bool synced = ::fcntl (fd, F_FULLFSYNC) == 0 || ::fsync (fd) == 0;
+           #else
+            const bool synced = ::fsync (fd) == 0;
+           #endif
+            return ::close (fd) == 0 && synced;
+        }
+
+        // Makes the rename itself durable
+        void syncDirectory (const juce::File& directory)
+        {
+            const int fd = ::open (directory.getFullPathName().toRawUTF8(), O_RDONLY);
+            if (fd >= 0)
+            {
+                ::fsync (fd);
+                ::close (fd);
+            }
+        }
+
+        // rename() replaces the target atomically; File::moveFileTo() deletes it first
+        bool renameOver (const juce::File& source, const juce::File& target)
+        {
+            return std::rename (source.getFullPathName().toRawUTF8(), target.getFullPathName().toRawUTF8()) == 0;
+        }
+       #endif
+
+        bool writeAndSync (const juce::File& file, bool append, const void* data, size_t numBytes)
+        {
+            const int fd = openForWriting (file, append);
+            if (fd < 0)
+                return false;
+
+            auto* bytes = static_cast<const char*> (data);
+            bool ok = true;
+
+            while (numBytes > 0)
+            {
+                const auto written = writeSome (fd, bytes, numBytes);
+                if (written <= 0)
+                {
+                    ok = false;
+                    break;
+                }
+
+                bytes += written;
+                numBytes -= static_cast<size_t> (written);
+            }
+
+            return syncAndClose (fd) && ok;
+        }
+    }
+
+    bool DurableFile::replaceWithData (const juce::File& file, const void* data, size_t numBytes)
+    {
+        if (!file.getParentDirectory().createDirectory())
+            return false;
+
+        const auto temp = file.getSiblingFile (file.getFileName() + ".tmp");
+
+        if (!writeAndSync (temp, false, data, numBytes))
+        {
+            temp.deleteFile();
+            return false;
+        }
+
+        if (!renameOver (temp, file))
+        {
+            temp.deleteFile();
+            return false;
+        }
+
+        syncDirectory (file.getParentDirectory());
+        return true;
+    }
+
+    bool DurableFile::append (const juce::File& file, const void* data, size_t numBytes)
+    {
+        const bool created = !file.existsAsFile();
+
+        if (!writeAndSync (file, true, data, numBytes))
+            return false;
+
+        if (created)
+            syncDirectory (file.getParentDirectory());
+
+        return true;
+    }
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <JuceHeader.h>
+
+namespace auralis
+{
+    /**  File writes that survive a power cut.
+
+         replaceWithData() writes a sibling temp file, flushes it to the disk
+         and renames it over the target, so the target always holds either
+         the old or the new contents in full. append() flushes before it
+         returns. Both block on the disk, so keep them off the message thread
+         when the data is written often. */
+    class DurableFile
+    {
+    public:
+        static bool replaceWithData (const juce::File& file, const void* data, size_t numBytes);
+        static bool append (const juce::File& file, const void* data, size_t numBytes);
+
+    private:
+        DurableFile() = delete;
+    };
+}
@@ -0,0 +1,154 @@
+#include "ParameterHistory.h"
+#include "ParameterRegistry.h"
+#include <unordered_map>
+
+namespace auralis
+{
+    ParameterHistory& ParameterHistory::getInstance()
+    {
+        static ParameterHistory instance;
+        return instance;
+    }
+
+    ParameterHistory::ParameterHistory()
+        : records (capacity)
+    {
+    }
+
+    bool ParameterHistory::setParameter (juce::uint32 parameterId, float value)
+    {
+        auto& registry = ParameterRegistry::getInstance();
+
+        // Scene recalls and soundcheck write processors directly, so re-read first
+        if (!registry.refresh (parameterId))
+            return false;
+
+        const float oldValue = registry.getValue (parameterId);
+        if (!registry.setValue (parameterId, value))
+            return false;
+
+        // Record what the processor actually took, after any clamping
+        const float newValue = registry.getValue (parameterId);
+
+        if (newValue == oldValue)
+            return true;
+
+        // A new change discards whatever could have been redone
+        if (savedPosition > cursor)
+            savedReachable = false;
+
+        end = cursor;
+
+        const auto now = juce::Time::getMillisecondCounter();
+
+        if (canCoalesce && end > begin && end > savedPosition)
+        {
+            auto& last = at (end - 1);
+            if (last.parameterId == parameterId && now - last.timeMs <= coalesceMs)
+            {
+                last.newValue = newValue;
+                last.timeMs = now;
+                return true;
+            }
+        }
+
+        if (end - begin == capacity)
+        {
+            ++begin;
+            if (savedPosition < begin)
+                savedReachable = false;
+        }
+
+        at (end) = { parameterId, oldValue, newValue, now };
+        cursor = ++end;
+        canCoalesce = true;
+        return true;
+    }
+
+    bool ParameterHistory::undo()
+    {
+        if (!canUndo())
+            return false;
+
+        --cursor;
+        ParameterRegistry::getInstance().setValue (at (cursor).parameterId, at (cursor).oldValue);
+        canCoalesce = false;
+        return true;
+    }
+
+    bool ParameterHistory::redo()
+    {
+        if (!canRedo())
+            return false;
+
+        ParameterRegistry::getInstance().setValue (at (cursor).parameterId, at (cursor).newValue);
+        ++cursor;
+        canCoalesce = false;
+        return true;
+    }
+
+    juce::String ParameterHistory::getUndoDescription() const
+    {
+        return canUndo() ? ParameterId::getName (at (cursor - 1).parameterId) : juce::String();
+    }
+
+    juce::String ParameterHistory::getRedoDescription() const
+    {
+        return canRedo() ? ParameterId::getName (at (cursor).parameterId) : juce::String();
+    }
+
+    void ParameterHistory::markSaved()
+    {
+        savedPosition = cursor;
+        savedReachable = true;
+        canCoalesce = false;
+    }
+
+    bool ParameterHistory::diffSinceSave (std::vector<Change>& changes) const
+    {
+        changes.clear();
+
+        if (!savedReachable)
+            return false;
+
+        const bool forward = cursor >= savedPosition;
+        const auto first = juce::jmin (cursor, savedPosition);
+        const auto last = juce::jmax (cursor, savedPosition);
+
+        // First old value and last new value of each parameter in the range
+        std::unordered_map<juce::uint32, size_t> slots;
+
+        for (auto position = first; position < last; ++position)
+        {
+            const auto& record = at (position);
+            const auto found = slots.find (record.parameterId);
+
+            if (found == slots.end())
+            {
+                slots.emplace (record.parameterId, changes.size());
+                changes.push_back ({ record.parameterId, record.oldValue, record.newValue });
+            }
+            else
+            {
+                changes[found->second].currentValue = record.newValue;
+            }
+        }
+
+        // Walking back from the save point: the save holds the last new value
+        if (!forward)
+            for (auto& change : changes)
+                std::swap (change.savedValue, change.currentValue);
+
+        changes.erase (std::remove_if (changes.begin(), changes.end(),
+                                       [] (const Change& c) { return c.savedValue == c.currentValue; }),
+                       changes.end());
+        return true;
+    }
+
+    void ParameterHistory::clear()
+    {
+        begin = end = cursor = savedPosition = 0;
+        savedReachable = true;
+        canCoalesce = false;
+    }
+}
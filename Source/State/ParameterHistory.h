@@ -0,0 +1,82 @@
+#pragma once
+#include <JuceHeader.h>
+#include "ParameterId.h"
+
+namespace auralis
+{
+    /**  Undo/redo history of parameter changes.
+
+         UI controls change parameters through setParameter(). It applies the
+         value through the ParameterRegistry and appends a 16-byte record (id, old value, new value, time)
+         to a fixed ring, so memory stays at 1 MB however long the show runs.
+         When the ring is full the oldest records drop off. A change to the
+         same parameter within coalesceMs of the last one, such as a knob
+         drag, updates the last record instead of adding another.
+
+         diffSinceSave() walks only the records between the save point and
+         the undo position. Message thread only. */
+    class ParameterHistory
+    {
+    public:
+        static ParameterHistory& getInstance();
+
+        static constexpr size_t capacity = 65536;
+        static constexpr juce::uint32 coalesceMs = 500;
+
+        struct Change
+        {
+            juce::uint32 parameterId;
+            float savedValue;
+            float currentValue;
+        };
+
+        /** Apply a value and record it. Returns false if the id doesn't resolve. */
+        bool setParameter (juce::uint32 parameterId, float value);
+
+        bool canUndo() const { return cursor > begin; }
+        bool canRedo() const { return cursor < end; }
+        bool undo();
+        bool redo();
+
+        /** Name of the change undo() / redo() would revert or reapply. */
+        juce::String getUndoDescription() const;
+        juce::String getRedoDescription() const;
+
+        /** Call after the session has been saved or loaded. */
+        void markSaved();
+
+        /** Parameters whose value differs from the last save. Returns false if
+            the history no longer reaches back to it. */
+        bool diffSinceSave (std::vector<Change>& changes) const;
+
+        void clear();
+        int getNumRecords() const { return static_cast<int> (end - begin); }
+
+    private:
+        ParameterHistory();
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterHistory)
+
+        struct Record
+        {
+            juce::uint32 parameterId;
+            float oldValue;
+            float newValue;
+            juce::uint32 timeMs;
+        };
+
+        static_assert (sizeof (Record) == 16, "History records should stay compact");
+
+        Record& at (juce::uint64 position)              { return records[static_cast<size_t> (position % capacity)]; }
+        const Record& at (juce::uint64 position) const  { return records[static_cast<size_t> (position % capacity)]; }
+
+        std::vector<Record> records;    // capacity entries, allocated once
+
+        // Positions count every record ever written; [begin, end) is still in the ring
+        juce::uint64 begin = 0;
+        juce::uint64 end = 0;
+        juce::uint64 cursor = 0;        // Records before this are applied
+        juce::uint64 savedPosition = 0;
+        bool savedReachable = true;
+        bool canCoalesce = false;
+    };
+}
@@ -0,0 +1,228 @@
+#include "ParameterId.h"
+#include "../Audio/AudioEngine.h"
+
+namespace auralis
+{
+    namespace
+    {
+        float fromBool (bool b)     { return b ? 1.0f : 0.0f; }
+        bool toBool (float value)   { return value >= 0.5f; }
+    }
+
+    bool ParameterId::getValue (AudioEngine& engine, juce::uint32 id, float& value)
+    {
+        const int index = getIndex (id);
+        const auto parameter = getParameter (id);
+
+        switch (getTarget (id))
+        {
+            case Target::channel:
+            {
+                auto* ch = engine.getChannelProcessor (index);
+                if (ch == nullptr)
+                    return false;
+
+                switch (static_cast<Channel> (parameter))
+                {
+                    case Channel::trimGain:             value = ch->getTrimGain(); return true;
+                    case Channel::gateEnabled:          value = fromBool (ch->isGateEnabled()); return true;
+                    case Channel::gateThreshold:        value = ch->getGateThreshold(); return true;
+                    case Channel::eqEnabled:            value = fromBool (ch->isEqEnabled()); return true;
+                    case Channel::eqLowShelf:           value = ch->getEQBandGain (EQProcessor::Band::LowShelf); return true;
+                    case Channel::eqLowMid:             value = ch->getEQBandGain (EQProcessor::Band::LowMid); return true;
+                    case Channel::eqHighMid:            value = ch->getEQBandGain (EQProcessor::Band::HighMid); return true;
+                    case Channel::eqHighShelf:          value = ch->getEQBandGain (EQProcessor::Band::HighShelf); return true;
+                    case Channel::compressorEnabled:    value = fromBool (ch->isCompressorEnabled()); return true;
+                    case Channel::compressorRatio:      value = ch->getCompressorRatio(); return true;
+                    case Channel::compressorThreshold:  value = ch->getCompressorThreshold(); return true;
+                    case Channel::fxSendLevel:          value = ch->getFxSendLevel(); return true;
+                    case Channel::tunerEnabled:         value = fromBool (ch->isTunerEnabled()); return true;
+                    case Channel::tunerStrength:        value = ch->getTunerStrength(); return true;
+                    case Channel::muted:                value = fromBool (ch->isMuted()); return true;
+                    case Channel::solo:                 value = fromBool (ch->isSolo()); return true;
+                    default:                            return false;
+                }
+            }
+
+            case Target::groupBus:
+            {
+                auto* bus = engine.getGroupBusProcessor (index);
+                if (bus == nullptr)
+                    return false;
+
+                switch (static_cast<GroupBus> (parameter))
+                {
+                    case GroupBus::eqLowGain:   value = bus->getEQLowGain(); return true;
+                    case GroupBus::eqMidGain:   value = bus->getEQMidGain(); return true;
+                    case GroupBus::eqHighGain:  value = bus->getEQHighGain(); return true;
+                    case GroupBus::eqEnabled:   value = fromBool (bus->isEQEnabled()); return true;
+                    case GroupBus::compEnabled: value = fromBool (bus->isCompEnabled()); return true;
+                    case GroupBus::outputGain:  value = bus->getOutputGain(); return true;
+                    default:                    return false;
+                }
+            }
+
+            case Target::fxBus:
+            {
+                auto* bus = engine.getFXBusProcessor (index);
+                if (bus == nullptr)
+                    return false;
+
+                switch (static_cast<FXBus> (parameter))
+                {
+                    case FXBus::reverbWetLevel: value = bus->getReverbWetLevel(); return true;
+                    case FXBus::delayWetLevel:  value = bus->getDelayWetLevel(); return true;
+                    case FXBus::reverbEnabled:  value = fromBool (bus->isReverbEnabled()); return true;
+                    case FXBus::delayEnabled:   value = fromBool (bus->isDelayEnabled()); return true;
+                    case FXBus::bypassed:       value = fromBool (bus->isBypassed()); return true;
+                    case FXBus::reverbMode:     value = static_cast<float> (bus->getReverbMode()); return true;
+                    default:                    return false;
+                }
+            }
+
+            case Target::master:
+            {
+                auto* masterBus = engine.getMasterBusProcessor();
+                if (masterBus == nullptr)
+                    return false;
+
+                switch (static_cast<Master> (parameter))
+                {
+                    case Master::streamTarget:      value = static_cast<float> (masterBus->getStreamTarget()); return true;
+                    case Master::targetLufs:        value = masterBus->getTargetLufs(); return true;
+                    case Master::compressorEnabled: value = fromBool (masterBus->isCompressorEnabled()); return true;
+                    case Master::limiterEnabled:    value = fromBool (masterBus->isLimiterEnabled()); return true;
+                    default:                        return false;
+                }
+            }
+
+            default:
+                return false;
+        }
+    }
+
+    bool ParameterId::setValue (AudioEngine& engine, juce::uint32 id, float value)
+    {
+        const int index = getIndex (id);
+        const auto parameter = getParameter (id);
+
+        switch (getTarget (id))
+        {
+            case Target::channel:
+            {
+                auto* ch = engine.getChannelProcessor (index);
+                if (ch == nullptr)
+                    return false;
+
+                switch (static_cast<Channel> (parameter))
+                {
+                    case Channel::trimGain:             ch->setTrimGain (value); return true;
+                    case Channel::gateEnabled:          ch->setGateEnabled (toBool (value)); return true;
+                    case Channel::gateThreshold:        ch->setGateThreshold (value); return true;
+                    case Channel::eqEnabled:            ch->setEqEnabled (toBool (value)); return true;
+                    case Channel::eqLowShelf:           ch->setEQBandGain (EQProcessor::Band::LowShelf, value); return true;
+                    case Channel::eqLowMid:             ch->setEQBandGain (EQProcessor::Band::LowMid, value); return true;
+                    case Channel::eqHighMid:            ch->setEQBandGain (EQProcessor::Band::HighMid, value); return true;
+                    case Channel::eqHighShelf:          ch->setEQBandGain (EQProcessor::Band::HighShelf, value); return true;
+                    case Channel::compressorEnabled:    ch->setCompressorEnabled (toBool (value)); return true;
+                    case Channel::compressorRatio:      ch->setCompressorRatio (value); return true;
+                    case Channel::compressorThreshold:  ch->setCompressorThreshold (value); return true;
+                    case Channel::fxSendLevel:          ch->setFxSendLevel (value); return true;
+                    case Channel::tunerEnabled:         ch->setTunerEnabled (toBool (value)); return true;
+                    case Channel::tunerStrength:        ch->setTunerStrength (value); return true;
+                    case Channel::muted:                ch->setMuted (toBool (value)); return true;
+                    case Channel::solo:                 ch->setSolo (toBool (value)); return true;
+                    default:                            return false;
+                }
+            }
+
+            case Target::groupBus:
+            {
+                auto* bus = engine.getGroupBusProcessor (index);
+                if (bus == nullptr)
+                    return false;
+
+                switch (static_cast<GroupBus> (parameter))
+                {
+                    case GroupBus::eqLowGain:   bus->setEQLowGain (value); return true;
+                    case GroupBus::eqMidGain:   bus->setEQMidGain (value); return true;
+                    case GroupBus::eqHighGain:  bus->setEQHighGain (value); return true;
+                    case GroupBus::eqEnabled:   bus->setEQEnabled (toBool (value)); return true;
+                    case GroupBus::compEnabled: bus->setCompEnabled (toBool (value)); return true;
+                    case GroupBus::outputGain:  bus->setOutputGain (value); return true;
+                    default:                    return false;
+                }
+            }
+
+            case Target::fxBus:
+            {
+                auto* bus = engine.getFXBusProcessor (index);
+                if (bus == nullptr)
+                    return false;
+
+                switch (static_cast<FXBus> (parameter))
+                {
+                    case FXBus::reverbWetLevel: bus->setReverbWetLevel (value); return true;
+                    case FXBus::delayWetLevel:  bus->setDelayWetLevel (value); return true;
+                    case FXBus::reverbEnabled:  bus->setReverbEnabled (toBool (value)); return true;
+                    case FXBus::delayEnabled:   bus->setDelayEnabled (toBool (value)); return true;
+                    case FXBus::bypassed:       bus->setBypass (toBool (value)); return true;
+                    case FXBus::reverbMode:
+                        bus->setReverbMode (toBool (value) ? FXBusProcessor::ReverbMode::Convolution
+                                                           : FXBusProcessor::ReverbMode::Algorithmic);
+                        return true;
+                    default:                    return false;
+                }
+            }
+
+            case Target::master:
+            {
+                auto* masterBus = engine.getMasterBusProcessor();
+                if (masterBus == nullptr)
+                    return false;
+
+                switch (static_cast<Master> (parameter))
+                {
+                    case Master::streamTarget:
+                        masterBus->setStreamTarget (static_cast<StreamTarget> (juce::jlimit (0, 2, juce::roundToInt (value))));
+                        return true;
+                    case Master::targetLufs:        masterBus->setTargetLufs (value); return true;
+                    case Master::compressorEnabled: masterBus->setCompressorEnabled (toBool (value)); return true;
+                    case Master::limiterEnabled:    masterBus->setLimiterEnabled (toBool (value)); return true;
+                    default:                        return false;
+                }
+            }
+
+            default:
+                return false;
+        }
+    }
+
+    juce::String ParameterId::getName (juce::uint32 id)
+    {
+        static const char* const channelNames[] = { "Trim", "Gate", "Gate Threshold", "EQ",
+                                                    "EQ Low", "EQ Low Mid", "EQ High Mid", "EQ High",
+                                                    "Compressor", "Comp Ratio", "Comp Threshold",
+                                                    "FX Send", "Tuner", "Tuner Strength", "Mute", "Solo" };
+        static const char* const groupBusNames[] = { "EQ Low", "EQ Mid", "EQ High", "EQ", "Compressor", "Output" };
+        static const char* const fxBusNames[] = { "Reverb Wet", "Delay Wet", "Reverb", "Delay", "Bypass", "Reverb Mode" };
+        static const char* const masterNames[] = { "Stream Target", "Target LUFS", "Compressor", "Limiter" };
+
+        const auto parameter = getParameter (id);
+        const auto number = juce::String (getIndex (id) + 1);
+
+        auto lookup = [parameter] (const auto& names) -> juce::String
+        {
+            return parameter < std::size (names) ? juce::String (names[parameter]) : juce::String ("?");
+        };
+
+        switch (getTarget (id))
+        {
+            case Target::channel:  return "Ch " + number + " " + lookup (channelNames);
+            case Target::groupBus: return "Group " + number + " " + lookup (groupBusNames);
+            case Target::fxBus:    return "FX " + number + " " + lookup (fxBusNames);
+            case Target::master:   return "Master " + lookup (masterNames);
+            default:               return "Unknown";
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <JuceHeader.h>
+
+class AudioEngine;
+
+namespace auralis
+{
+    /**  Stable 32-bit identifiers for every user-facing mixer parameter.
+
+         Layout: target (8 bits) | processor index (16 bits) | parameter (8 bits).
+         Every value travels as a float: switches are 0 or 1 and choices hold
+         their enum value. */
+    class ParameterId
+    {
+    public:
+        enum class Target : juce::uint32 { channel = 1, groupBus, fxBus, master };
+
+        enum class Channel : juce::uint32
+        {
+            trimGain, gateEnabled, gateThreshold, eqEnabled,
+            eqLowShelf, eqLowMid, eqHighMid, eqHighShelf,
+            compressorEnabled, compressorRatio, compressorThreshold,
+            fxSendLevel, tunerEnabled, tunerStrength, muted, solo
+        };
+
+        enum class GroupBus : juce::uint32 { eqLowGain, eqMidGain, eqHighGain, eqEnabled, compEnabled, outputGain };
+        enum class FXBus : juce::uint32    { reverbWetLevel, delayWetLevel, reverbEnabled, delayEnabled, bypassed, reverbMode };
+        enum class Master : juce::uint32   { streamTarget, targetLufs, compressorEnabled, limiterEnabled };
+
+        static constexpr juce::uint32 channel (int index, Channel p)    { return make (Target::channel, index, static_cast<juce::uint32> (p)); }
+        static constexpr juce::uint32 groupBus (int index, GroupBus p)  { return make (Target::groupBus, index, static_cast<juce::uint32> (p)); }
+        static constexpr juce::uint32 fxBus (int index, FXBus p)        { return make (Target::fxBus, index, static_cast<juce::uint32> (p)); }
+        static constexpr juce::uint32 master (Master p)                 { return make (Target::master, 0, static_cast<juce::uint32> (p)); }
+
+        static constexpr Target getTarget (juce::uint32 id)         { return static_cast<Target> (id >> 24); }
+        static constexpr int getIndex (juce::uint32 id)             { return static_cast<int> ((id >> 8) & 0xffff); }
+        static constexpr juce::uint32 getParameter (juce::uint32 id) { return id & 0xff; }
+
+        /** Read / write through the processors' own getters and setters.
+            Both return false if the id doesn't name an existing parameter. */
+        static bool getValue (AudioEngine& engine, juce::uint32 id, float& value);
+        static bool setValue (AudioEngine& engine, juce::uint32 id, float value);
+
+        /** Human-readable name, e.g. "Ch 3 Trim". */
+        static juce::String getName (juce::uint32 id);
+
+    private:
+        static constexpr juce::uint32 make (Target target, int index, juce::uint32 parameter)
+        {
+            return (static_cast<juce::uint32> (target) << 24)
+                 | ((static_cast<juce::uint32> (index) & 0xffff) << 8)
+                 | (parameter & 0xff);
+        }
+
+        ParameterId() = delete;
+    };
+}
@@ -0,0 +1,247 @@
+#include "ParameterRegistry.h"
+#include "../Audio/AudioEngine.h"
+
+namespace auralis
+{
+    namespace
+    {
+        using Info = ParameterRegistry::Info;
+
+        // In ParameterId enum order
+        const Info channelInfo[] =
+        {
+            { "trimGain",            -24.0f, 24.0f,  0.0f,   false },
+            { "gateEnabled",           0.0f,  1.0f,  1.0f,   true  },
+            { "gateThreshold",       -80.0f,  0.0f, -50.0f,  false },
+            { "eqEnabled",             0.0f,  1.0f,  1.0f,   true  },
+            { "eqLowShelf",          -12.0f, 12.0f,  0.0f,   false },
+            { "eqLowMid",            -12.0f, 12.0f,  0.0f,   false },
+            { "eqHighMid",           -12.0f, 12.0f,  0.0f,   false },
+            { "eqHighShelf",         -12.0f, 12.0f,  0.0f,   false },
+            { "compressorEnabled",     0.0f,  1.0f,  1.0f,   true  },
+            { "compressorRatio",       1.0f, 20.0f,  3.0f,   false },
+            { "compressorThreshold", -60.0f,  0.0f, -18.0f,  false },
+            { "fxSendLevel",           0.0f,  1.0f,  0.0f,   false },
+            { "tunerEnabled",          0.0f,  1.0f,  1.0f,   true  },
+            { "tunerStrength",         0.0f,  1.0f,  0.5f,   false },
+            { "muted",                 0.0f,  1.0f,  0.0f,   true  },
+            { "solo",                  0.0f,  1.0f,  0.0f,   true  }
+        };
+
+        const Info groupBusInfo[] =
+        {
+            { "eqLowGain",   -12.0f, 12.0f, 0.0f, false },
+            { "eqMidGain",   -12.0f, 12.0f, 0.0f, false },
+            { "eqHighGain",  -12.0f, 12.0f, 0.0f, false },
+            { "eqEnabled",     0.0f,  1.0f, 1.0f, true  },
+            { "compEnabled",   0.0f,  1.0f, 1.0f, true  },
+            { "outputGain",    0.0f,  1.5f, 1.0f, false }
+        };
+
+        const Info fxBusInfo[] =
+        {
+            { "reverbWetLevel", 0.0f, 1.0f, 0.5f, false },
+            { "delayWetLevel",  0.0f, 1.0f, 0.5f, false },
+            { "reverbEnabled",  0.0f, 1.0f, 1.0f, true  },
+            { "delayEnabled",   0.0f, 1.0f, 1.0f, true  },
+            { "bypassed",       0.0f, 1.0f, 0.0f, true  },
+            { "reverbMode",     0.0f, 1.0f, 0.0f, true  }    // Algorithmic / Convolution
+        };
+
+        const Info masterInfo[] =
+        {
+            { "streamTarget",        0.0f,   2.0f,   0.0f, false },    // StreamTarget enum
+            { "targetLufs",        -24.0f, -10.0f, -14.0f, false },
+            { "compressorEnabled",   0.0f,   1.0f,   1.0f, true  },
+            { "limiterEnabled",      0.0f,   1.0f,   1.0f, true  }
+        };
+
+        struct TargetTable
+        {
+            const char* prefix;
+            const Info* info;
+            juce::uint32 numParameters;
+        };
+
+        // Indexed by ParameterId::Target
+        const TargetTable targets[] =
+        {
+            { nullptr,  nullptr,      0 },
+            { "ch",     channelInfo,  (juce::uint32) std::size (channelInfo) },
+            { "group",  groupBusInfo, (juce::uint32) std::size (groupBusInfo) },
+            { "fx",     fxBusInfo,    (juce::uint32) std::size (fxBusInfo) },
+            { "master", masterInfo,   (juce::uint32) std::size (masterInfo) }
+        };
+
+        static_assert (std::size (channelInfo) <= ParameterRegistry::valuesPerLine, "Channel parameters overflow a line");
+
+        const TargetTable* findTable (juce::uint32 parameterId) noexcept
+        {
+            const auto target = static_cast<juce::uint32> (ParameterId::getTarget (parameterId));
+            if (target == 0 || target >= std::size (targets))
+                return nullptr;
+
+            const auto& table = targets[target];
+            return ParameterId::getParameter (parameterId) < table.numParameters ? &table : nullptr;
+        }
+    }
+
+    ParameterRegistry& ParameterRegistry::getInstance()
+    {
+        static ParameterRegistry instance;
+        return instance;
+    }
+
+    void ParameterRegistry::attach (AudioEngine& engineToUse)
+    {
+        engine = &engineToUse;
+
+        numProcessors[(int) ParameterId::Target::channel]  = engine->getNumChannels();
+        numProcessors[(int) ParameterId::Target::groupBus] = engine->getNumGroupBuses();
+        numProcessors[(int) ParameterId::Target::fxBus]    = engine->getNumFXBuses();
+        numProcessors[(int) ParameterId::Target::master]   = 1;
+
+        numLines = 0;
+        for (int target = 1; target < (int) std::size (targets); ++target)
+        {
+            firstLine[target] = numLines;
+            numLines += numProcessors[target];
+        }
+
+        lines.reset (new ValueLine[(size_t) numLines]);
+
+        // Unused slots read as 0
+        for (int i = 0; i < numLines; ++i)
+            for (auto& value : lines[i].values)
+                value.store (0.0f, std::memory_order_relaxed);
+
+        syncFromEngine();
+    }
+
+    int ParameterRegistry::getSlot (juce::uint32 parameterId) const noexcept
+    {
+        if (findTable (parameterId) == nullptr)
+            return -1;
+
+        const auto target = static_cast<int> (ParameterId::getTarget (parameterId));
+        const int index = ParameterId::getIndex (parameterId);
+
+        if (index >= numProcessors[target])
+            return -1;
+
+        return (firstLine[target] + index) * valuesPerLine + (int) ParameterId::getParameter (parameterId);
+    }
+
+    const ParameterRegistry::Info* ParameterRegistry::getInfo (juce::uint32 parameterId) noexcept
+    {
+        if (auto* table = findTable (parameterId))
+            return table->info + ParameterId::getParameter (parameterId);
+
+        return nullptr;
+    }
+
+    float ParameterRegistry::getValue (juce::uint32 parameterId) const noexcept
+    {
+        const int slot = getSlot (parameterId);
+        if (slot < 0)
+        {
+            auto* info = getInfo (parameterId);
+            return info != nullptr ? info->defaultValue : 0.0f;
+        }
+
+        return lines[slot / valuesPerLine].values[slot % valuesPerLine].load (std::memory_order_relaxed);
+    }
+
+    bool ParameterRegistry::setValue (juce::uint32 parameterId, float value)
+    {
+        auto* info = getInfo (parameterId);
+        if (engine == nullptr || info == nullptr || getSlot (parameterId) < 0)
+            return false;
+
+        value = juce::jlimit (info->minimum, info->maximum, value);
+        if (info->isSwitch)
+            value = value >= 0.5f ? 1.0f : 0.0f;
+
+        if (!ParameterId::setValue (*engine, parameterId, value))
+            return false;
+
+        // Publish what the processor actually took
+        ParameterId::getValue (*engine, parameterId, value);
+        publish (parameterId, value);
+        return true;
+    }
+
+    void ParameterRegistry::publish (juce::uint32 parameterId, float value) noexcept
+    {
+        const int slot = getSlot (parameterId);
+        if (slot >= 0)
+            lines[slot / valuesPerLine].values[slot % valuesPerLine].store (value, std::memory_order_relaxed);
+    }
+
+    bool ParameterRegistry::refresh (juce::uint32 parameterId)
+    {
+        float value = 0.0f;
+        if (engine == nullptr || getSlot (parameterId) < 0 || !ParameterId::getValue (*engine, parameterId, value))
+            return false;
+
+        publish (parameterId, value);
+        return true;
+    }
+
+    void ParameterRegistry::syncFromEngine()
+    {
+        if (engine == nullptr)
+            return;
+
+        for (juce::uint32 target = 1; target < (juce::uint32) std::size (targets); ++target)
+        {
+            for (int index = 0; index < numProcessors[target]; ++index)
+            {
+                for (juce::uint32 parameter = 0; parameter < targets[target].numParameters; ++parameter)
+                {
+                    refresh ((target << 24) | ((juce::uint32) index << 8) | parameter);
+                }
+            }
+        }
+    }
+
+    juce::String ParameterRegistry::getKey (juce::uint32 parameterId)
+    {
+        auto* table = findTable (parameterId);
+        if (table == nullptr)
+            return {};
+
+        juce::String key (table->prefix);
+        if (ParameterId::getTarget (parameterId) != ParameterId::Target::master)
+            key << (ParameterId::getIndex (parameterId) + 1);
+
+        return key << "." << table->info[ParameterId::getParameter (parameterId)].key;
+    }
+
+    juce::uint32 ParameterRegistry::findId (const juce::String& key)
+    {
+        const auto processor = key.upToFirstOccurrenceOf (".", false, false);
+        const auto name = key.fromFirstOccurrenceOf (".", false, false);
+
+        for (juce::uint32 target = 1; target < (juce::uint32) std::size (targets); ++target)
+        {
+            const auto& table = targets[target];
+            if (!processor.startsWith (table.prefix))
+                continue;
+
+            const auto number = processor.substring ((int) std::strlen (table.prefix));
+            const bool isMaster = target == (juce::uint32) ParameterId::Target::master;
+
+            if (isMaster ? number.isNotEmpty() : (number.isEmpty() || !number.containsOnly ("0123456789")))
+                continue;
+
+            const juce::uint32 index = isMaster ? 0 : (juce::uint32) (number.getIntValue() - 1);
+
+            for (juce::uint32 parameter = 0; parameter < table.numParameters; ++parameter)
+                if (name == table.info[parameter].key)
+                    return (target << 24) | ((index & 0xffff) << 8) | parameter;
+        }
+
+        return 0;
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <JuceHeader.h>
+#include "ParameterId.h"
+#include <atomic>
+
+class AudioEngine;
+
+namespace auralis
+{
+    /**  Range, default and current value of every mixer parameter, by ParameterId.
+
+         Each processor owns one 64-byte line of 16 atomic floats, so a
+         parameter's slot is worked out from its id with a few shifts and an
+         add: no string keys or hashing on the way in. Values can be read from
+         any thread. setValue() clamps, applies through the processor and
+         publishes; code that writes processors directly (session loads,
+         scene recalls and deltas) calls syncFromEngine() afterwards, on the
+         message thread once the audio thread has finished applying them.
+
+         attach() sizes the table for the engine and must run on the message
+         thread before anything else reads it. */
+    class ParameterRegistry
+    {
+    public:
+        static ParameterRegistry& getInstance();
+
+        static constexpr int valuesPerLine = 16;
+
+        struct Info
+        {
+            const char* key;        // Stable, used for JSON / OSC addresses
+            float minimum;
+            float maximum;
+            float defaultValue;
+            bool isSwitch;
+        };
+
+        /** Size the table for the engine's processors and read their current values. */
+        void attach (AudioEngine& engineToUse);
+
+        /** Dense slot for an id, or -1 if it doesn't name a registered parameter. */
+        int getSlot (juce::uint32 parameterId) const noexcept;
+        int getNumSlots() const noexcept { return numLines * valuesPerLine; }
+
+        /** Range and default shared by every processor of the id's kind. */
+        static const Info* getInfo (juce::uint32 parameterId) noexcept;
+
+        /** Any thread. Returns the default for ids that aren't registered. */
+        float getValue (juce::uint32 parameterId) const noexcept;
+
+        /** Message thread: clamp, apply to the processor and publish. */
+        bool setValue (juce::uint32 parameterId, float value);
+
+        /** Any thread: record a value something else already applied. */
+        void publish (juce::uint32 parameterId, float value) noexcept;
+
+        /** Re-read one parameter, or all of them, from the processors. Message thread. */
+        bool refresh (juce::uint32 parameterId);
+        void syncFromEngine();
+
+        /** "ch3.trimGain", "group1.outputGain", "master.targetLufs"... */
+        static juce::String getKey (juce::uint32 parameterId);
+        static juce::uint32 findId (const juce::String& key);
+
+    private:
+        ParameterRegistry() = default;
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterRegistry)
+
+        struct alignas (64) ValueLine
+        {
+            std::atomic<float> values[valuesPerLine];
+        };
+
+        static_assert (sizeof (ValueLine) == 64, "One processor per cache line");
+
+        AudioEngine* engine = nullptr;
+        std::unique_ptr<ValueLine[]> lines;
+        int numLines = 0;
+
+        // First line and processor count for each ParameterId::Target
+        int firstLine[5] {};
+        int numProcessors[5] {};
+    };
+}
@@ -1,30 +1,77 @@
 #include "SessionManager.h"
+#include "ParameterHistory.h"
+#include "ParameterRegistry.h"
 #include "../Audio/AudioEngine.h"
 #include "../Audio/ChannelProcessor.h"
 #include "../Audio/GroupBusProcessor.h"
 #include "../Audio/MasterBusProcessor.h"
 #include "../FX/EQProcessor.h"
-#include "../MainApp.h"
-#include "../MainWindow.h"
-#include "../UI/MainComponent.h"
-#include "../UI/ChannelsComponent.h"
 
 namespace auralis
 {
-    // Static instance of AudioEngine
-    static AudioEngine& getAudioEngine()
+    SessionManager& SessionManager::getInstance()
     {
-        static AudioEngine instance;
+        static SessionManager instance;
         return instance;
     }
 
-    SessionManager& SessionManager::getInstance()
+    void SessionManager::attach(AudioEngine& engineToUse, std::function<void()> refreshViews)
     {
-        static SessionManager instance;
+        engine = &engineToUse;
+        onRefreshViews = std::move(refreshViews);
+    }
+
+    // The attached engine; a standalone one only when nothing was attached
+    AudioEngine& SessionManager::getAudioEngine() const
+    {
+        if (engine != nullptr)
+            return *engine;
+
+        static AudioEngine instance;
         return instance;
     }
 
     bool SessionManager::saveSession(const juce::File& fileToWrite) const
+    {
+        SessionSnapshot snapshot;
+        snapshot.capture(getAudioEngine());
+        if (!snapshot.writeToFile(fileToWrite))
+            return false;
+
+        ParameterHistory::getInstance().markSaved();
+        return true;
+    }
+
+    bool SessionManager::loadSession(const juce::File& fileToRead)
+    {
+        // Sessions saved before the binary format are JSON
+        if (!SessionSnapshot::isSnapshotFile(fileToRead))
+            return loadSessionJson(fileToRead);
+
+        SessionSnapshot snapshot;
+        if (!snapshot.readFromFile(fileToRead))
+        {
+            juce::Logger::writeToLog("Failed to read session snapshot: " + fileToRead.getFullPathName());
+            return false;
+        }
+
+        applySnapshot(snapshot);
+
+        juce::Logger::writeToLog("Session restored successfully");
+        return true;
+    }
+
+    void SessionManager::applySnapshot(const SessionSnapshot& snapshot)
+    {
+        snapshot.apply(getAudioEngine());
+
+        // Undoing past a load would mix two sessions
+        ParameterRegistry::getInstance().syncFromEngine();
+        ParameterHistory::getInstance().clear();
+        refreshUserInterface();
+    }
+
+    bool SessionManager::exportSessionJson(const juce::File& fileToWrite) const
     {
         auto& engine = getAudioEngine();
         auto root = std::make_unique<juce::DynamicObject>();
@@ -35,9 +82,7 @@ namespace auralis
         {
             if (auto* channel = engine.getChannelProcessor(i))
             {
-                auto channelJson = createChannelJson(i);
-                juce::Logger::writeToLog("Channel " + juce::String(i) + " JSON: " + juce::JSON::toString(channelJson));
-                channelsArray.add(channelJson);
+                channelsArray.add(createChannelJson(i));
             }
         }
         root->setProperty("channels", channelsArray);
@@ -61,16 +106,12 @@ namespace auralis
         
         // Convert to JSON string and save
         juce::var rootVar(root.release());  // Transfer ownership to var
-        juce::String json = juce::JSON::toString(rootVar, true);
-        juce::Logger::writeToLog("Full session JSON: " + json);
-        return fileToWrite.replaceWithText(json);
+        return fileToWrite.replaceWithText(juce::JSON::toString(rootVar, true));
     }
 
-    bool SessionManager::loadSession(const juce::File& fileToRead)
+    bool SessionManager::loadSessionJson(const juce::File& fileToRead)
     {
-        auto json = fileToRead.loadFileAsString();
-        juce::Logger::writeToLog("Loading JSON: " + json);
-        auto parsed = juce::JSON::parse(json);
+        auto parsed = juce::JSON::parse(fileToRead.loadFileAsString());
         
         if (!parsed.isObject())
         {
@@ -121,26 +162,20 @@ namespace auralis
             }
         }
         
-        // Get the main window to refresh the UI
-        if (auto* app = dynamic_cast<MainApp*>(juce::JUCEApplication::getInstance()))
-        {
-            if (auto* mainWindow = app->getMainWindow())
-            {
-                if (auto* mainComponent = dynamic_cast<MainComponent*>(mainWindow->getContentComponent()))
-                {
-                    // Find the channels component and refresh it
-                    if (auto* channelsComponent = dynamic_cast<ChannelsComponent*>(mainComponent->findChildWithID("channelsTab")))
-                    {
-                        channelsComponent->refreshAllChannelStrips();
-                    }
-                }
-            }
-        }
+        ParameterRegistry::getInstance().syncFromEngine();
+        ParameterHistory::getInstance().clear();
+        refreshUserInterface();
         
         juce::Logger::writeToLog("Session restored successfully");
         return true;
     }
 
+    void SessionManager::refreshUserInterface() const
+    {
+        if (onRefreshViews != nullptr)
+            onRefreshViews();
+    }
+
     juce::var SessionManager::createChannelJson(int channelIdx) const
     {
         auto& engine = getAudioEngine();
@@ -155,9 +190,7 @@ namespace auralis
         channelObj->setProperty("type", static_cast<int>(channel->getChannelType()));
         
         // Trim processor
-        float trimGain = channel->getTrimGain();
-        juce::Logger::writeToLog("Saving channel " + juce::String(channelIdx) + " trim gain: " + juce::String(trimGain));
-        channelObj->setProperty("trimGain", trimGain);
+        channelObj->setProperty("trimGain", channel->getTrimGain());
         
         // Gate processor
         channelObj->setProperty("gateThreshold", channel->getGateThreshold());
@@ -183,6 +216,9 @@ namespace auralis
         channelObj->setProperty("tunerEnabled", channel->isTunerEnabled());
         channelObj->setProperty("tunerStrength", channel->getTunerStrength());
         
+        // First to shed work under overload
+        channelObj->setProperty("lowPriority", channel->isLowPriority());
+        
         return juce::var(channelObj.release());
     }
 
@@ -360,6 +396,10 @@ namespace auralis
             juce::Logger::writeToLog("Setting channel " + juce::String(channelIdx) + " tuner strength to: " + juce::String(strength));
             channel->setTunerStrength(strength);
         }
+        if (v.hasProperty("lowPriority"))
+        {
+            channel->setLowPriority(static_cast<bool>(v["lowPriority"]));
+        }
             
         return true;
     }
@@ -450,23 +490,7 @@ namespace auralis
             
             // If platform is Custom and we have a custom LUFS value, restore it
             if (platform == StreamTarget::Custom && v.hasProperty("customLufs"))
-            {
-                const float custom = static_cast<float>(v["customLufs"]);
-                master->setTargetLufs(custom);
-
-                // Propagate the value to the SettingsComponent slider if available
-                if (auto* app = dynamic_cast<MainApp*>(juce::JUCEApplication::getInstance()))
-                {
-                    if (auto* mainWin = app->getMainWindow())
-                    {
-                        if (auto* mainComp = mainWin->getMainComponent())
-                        {
-                            if (auto* settings = mainComp->getSettingsComponent())
-                                settings->setCustomLufs(custom);
-                        }
-                    }
-                }
-            }
+                master->setTargetLufs(static_cast<float>(v["customLufs"]));
         }
         
         // Restore processor states
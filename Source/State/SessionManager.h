@@ -1,26 +1,48 @@
 #pragma once
 #include <JuceHeader.h>
+#include "SessionSnapshot.h"
+
+class AudioEngine;
 
 namespace auralis
 {
-    /**  Serialises the entire mixer state (routing, channel params,
-         bus params, master settings) to a single JSON file and
-         restores it on load.  Only declaration in this step. */
+    /**  Serialises the entire mixer state (channel params, bus params,
+         master settings) to a binary SessionSnapshot file and restores
+         it on load.  JSON is kept for export and for older sessions. */
     class SessionManager
     {
     public:
         static SessionManager& getInstance();
 
+        /** Save and load this engine from now on. refreshViews runs after
+            every load and undo to bring the mixer views in line (message thread). */
+        void attach (AudioEngine& engineToUse, std::function<void()> refreshViews = nullptr);
+
         /** Save the current session to disk.  Returns false on I/O failure. */
         bool saveSession (const juce::File& fileToWrite) const;
 
-        /** Load a session from disk.  Returns false if file corrupt. */
+        /** Load a session from disk, binary or JSON.  Returns false if file corrupt. */
         bool loadSession (const juce::File& fileToRead);
 
+        /** Push a snapshot into the engine and refresh the UI. */
+        void applySnapshot (const SessionSnapshot& snapshot);
+
+        /** Write the current session as human-readable JSON. */
+        bool exportSessionJson (const juce::File& fileToWrite) const;
+
+        /** Bring the mixer views back in line with the engine. */
+        void refreshUserInterface() const;
+
     private:
         SessionManager() = default;
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SessionManager)
 
+        bool loadSessionJson (const juce::File& fileToRead);
+        AudioEngine& getAudioEngine() const;
+
+        AudioEngine* engine = nullptr;
+        std::function<void()> onRefreshViews;
+
         // Helpers (to be implemented in .cpp)
         juce::var  createChannelJson      (int channelIdx) const;
         juce::var  createGroupBusJson     (const juce::String& name) const;
@@ -0,0 +1,380 @@
+#include "SessionSnapshot.h"
+#include "DurableFile.h"
+#include "../Audio/AudioEngine.h"
+#include <cstring>
+
+namespace auralis
+{
+    namespace
+    {
+        // CRC-32 (IEEE 802.3, reflected)
+        juce::uint32 crc32 (const void* data, size_t numBytes)
+        {
+            static const auto table = []
+            {
+                std::array<juce::uint32, 256> t {};
+                for (juce::uint32 i = 0; i < 256; ++i)
+                {
+                    juce::uint32 c = i;
+                    for (int k = 0; k < 8; ++k)
+                        c = (c & 1) != 0 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+                    t[i] = c;
+                }
+                return t;
+            }();
+
+            juce::uint32 crc = 0xffffffffu;
+            auto* bytes = static_cast<const juce::uint8*> (data);
+
+            for (size_t i = 0; i < numBytes; ++i)
+                crc = table[(crc ^ bytes[i]) & 0xff] ^ (crc >> 8);
+
+            return crc ^ 0xffffffffu;
+        }
+
+        void swapWords (void* data, size_t numBytes)
+        {
+            auto* words = static_cast<juce::uint32*> (data);
+            for (size_t i = 0; i < numBytes / 4; ++i)
+                words[i] = juce::ByteOrder::swap (words[i]);
+        }
+
+        bool hasFlag (juce::uint32 flags, juce::uint32 flag)    { return (flags & flag) != 0; }
+        juce::uint32 flagIf (bool condition, juce::uint32 flag) { return condition ? flag : 0; }
+
+        // Copies as much of a stored block as this version knows about; the
+        // rest keeps its default
+        template <typename Block>
+        const char* readBlock (const char* source, juce::uint32 storedSize, Block& block)
+        {
+            std::memcpy (&block, source, juce::jmin<size_t> (storedSize, sizeof (Block)));
+            return source + storedSize;
+        }
+    }
+
+    //==============================================================================
+    void SessionSnapshot::capture (AudioEngine& engine)
+    {
+        channels.resize (static_cast<size_t> (engine.getNumChannels()));
+
+        for (int i = 0; i < engine.getNumChannels(); ++i)
+        {
+            auto* channel = engine.getChannelProcessor (i);
+            if (channel == nullptr)
+                continue;
+
+            auto& p = channels[static_cast<size_t> (i)];
+            p.type = static_cast<juce::uint32> (channel->getChannelType());
+            p.trimGainDb = channel->getTrimGain();
+            p.gateThresholdDb = channel->getGateThreshold();
+
+            for (int band = 0; band < 4; ++band)
+                p.eqGainsDb[band] = channel->getEQBandGain (static_cast<EQProcessor::Band> (band));
+
+            p.compressorRatio = channel->getCompressorRatio();
+            p.compressorThresholdDb = channel->getCompressorThreshold();
+            p.fxSendLevel = channel->getFxSendLevel();
+            p.tunerStrength = channel->getTunerStrength();
+            p.flags = flagIf (channel->isGateEnabled(), ChannelParameters::gateEnabled)
+                    | flagIf (channel->isEqEnabled(), ChannelParameters::eqEnabled)
+                    | flagIf (channel->isCompressorEnabled(), ChannelParameters::compressorEnabled)
+                    | flagIf (channel->isTunerEnabled(), ChannelParameters::tunerEnabled)
+                    | flagIf (channel->isMuted(), ChannelParameters::muted)
+                    | flagIf (channel->isSolo(), ChannelParameters::solo)
+                    | flagIf (channel->isLowPriority(), ChannelParameters::lowPriority);
+        }
+
+        groupBuses.resize (static_cast<size_t> (engine.getNumGroupBuses()));
+
+        for (int i = 0; i < engine.getNumGroupBuses(); ++i)
+        {
+            if (auto* bus = engine.getGroupBusProcessor (i))
+            {
+                auto& p = groupBuses[static_cast<size_t> (i)];
+                p.eqLowGain = bus->getEQLowGain();
+                p.eqMidGain = bus->getEQMidGain();
+                p.eqHighGain = bus->getEQHighGain();
+                p.outputGain = bus->getOutputGain();
+                p.flags = flagIf (bus->isEQEnabled(), GroupBusParameters::eqEnabled)
+                        | flagIf (bus->isCompEnabled(), GroupBusParameters::compEnabled);
+            }
+        }
+
+        fxBuses.resize (static_cast<size_t> (engine.getNumFXBuses()));
+
+        for (int i = 0; i < engine.getNumFXBuses(); ++i)
+        {
+            if (auto* bus = engine.getFXBusProcessor (i))
+            {
+                auto& p = fxBuses[static_cast<size_t> (i)];
+                p.reverbWetLevel = bus->getReverbWetLevel();
+                p.delayWetLevel = bus->getDelayWetLevel();
+                p.reverbMode = static_cast<juce::uint32> (bus->getReverbMode());
+                p.flags = flagIf (bus->isReverbEnabled(), FXBusParameters::reverbEnabled)
+                        | flagIf (bus->isDelayEnabled(), FXBusParameters::delayEnabled)
+                        | flagIf (bus->isBypassed(), FXBusParameters::bypassed);
+            }
+        }
+
+        if (auto* masterBus = engine.getMasterBusProcessor())
+        {
+            master.targetLufs = masterBus->getTargetLufs();
+            master.platform = static_cast<juce::uint32> (masterBus->getStreamTarget());
+            master.flags = flagIf (masterBus->isCompressorEnabled(), MasterBusParameters::compressorEnabled)
+                         | flagIf (masterBus->isLimiterEnabled(), MasterBusParameters::limiterEnabled);
+        }
+    }
+
+    void SessionSnapshot::apply (AudioEngine& engine) const
+    {
+        // Setters are only called for values that differ, so recalling a
+        // scene that changes a handful of parameters only touches those
+        for (int i = 0; i < static_cast<int> (channels.size()); ++i)
+        {
+            auto* channel = engine.getChannelProcessor (i);
+            if (channel == nullptr)
+                continue;
+
+            const auto& p = channels[static_cast<size_t> (i)];
+            const auto type = static_cast<ChannelProcessor::ChannelType> (juce::jlimit<juce::uint32> (0, 3, p.type));
+
+            if (channel->getChannelType() != type)                  channel->setChannelType (type);
+            if (channel->getTrimGain() != p.trimGainDb)             channel->setTrimGain (p.trimGainDb);
+            if (channel->getGateThreshold() != p.gateThresholdDb)   channel->setGateThreshold (p.gateThresholdDb);
+
+            const std::array<float, 4> eqGains { p.eqGainsDb[0], p.eqGainsDb[1], p.eqGainsDb[2], p.eqGainsDb[3] };
+            for (int band = 0; band < 4; ++band)
+            {
+                if (channel->getEQBandGain (static_cast<EQProcessor::Band> (band)) != eqGains[static_cast<size_t> (band)])
+                {
+                    channel->setEQGains (eqGains);
+                    break;
+                }
+            }
+
+            if (channel->getCompressorRatio() != p.compressorRatio)             channel->setCompressorRatio (p.compressorRatio);
+            if (channel->getCompressorThreshold() != p.compressorThresholdDb)   channel->setCompressorThreshold (p.compressorThresholdDb);
+            if (channel->getFxSendLevel() != p.fxSendLevel)                     channel->setFxSendLevel (p.fxSendLevel);
+            if (channel->getTunerStrength() != p.tunerStrength)                 channel->setTunerStrength (p.tunerStrength);
+
+            const bool gate = hasFlag (p.flags, ChannelParameters::gateEnabled);
+            const bool eq = hasFlag (p.flags, ChannelParameters::eqEnabled);
+            const bool comp = hasFlag (p.flags, ChannelParameters::compressorEnabled);
+            const bool tuner = hasFlag (p.flags, ChannelParameters::tunerEnabled);
+
+            if (channel->isGateEnabled() != gate)           channel->setGateEnabled (gate);
+            if (channel->isEqEnabled() != eq)               channel->setEqEnabled (eq);
+            if (channel->isCompressorEnabled() != comp)     channel->setCompressorEnabled (comp);
+            if (channel->isTunerEnabled() != tuner)         channel->setTunerEnabled (tuner);
+
+            channel->setMuted (hasFlag (p.flags, ChannelParameters::muted));
+            channel->setSolo (hasFlag (p.flags, ChannelParameters::solo));
+            channel->setLowPriority (hasFlag (p.flags, ChannelParameters::lowPriority));
+        }
+
+        for (int i = 0; i < static_cast<int> (groupBuses.size()); ++i)
+        {
+            auto* bus = engine.getGroupBusProcessor (i);
+            if (bus == nullptr)
+                continue;
+
+            const auto& p = groupBuses[static_cast<size_t> (i)];
+            const bool eq = hasFlag (p.flags, GroupBusParameters::eqEnabled);
+            const bool comp = hasFlag (p.flags, GroupBusParameters::compEnabled);
+
+            if (bus->getEQLowGain() != p.eqLowGain)     bus->setEQLowGain (p.eqLowGain);
+            if (bus->getEQMidGain() != p.eqMidGain)     bus->setEQMidGain (p.eqMidGain);
+            if (bus->getEQHighGain() != p.eqHighGain)   bus->setEQHighGain (p.eqHighGain);
+            if (bus->getOutputGain() != p.outputGain)   bus->setOutputGain (p.outputGain);
+            if (bus->isEQEnabled() != eq)               bus->setEQEnabled (eq);
+            if (bus->isCompEnabled() != comp)           bus->setCompEnabled (comp);
+        }
+
+        for (int i = 0; i < static_cast<int> (fxBuses.size()); ++i)
+        {
+            auto* bus = engine.getFXBusProcessor (i);
+            if (bus == nullptr)
+                continue;
+
+            const auto& p = fxBuses[static_cast<size_t> (i)];
+            const auto mode = static_cast<FXBusProcessor::ReverbMode> (p.reverbMode);
+            const bool reverb = hasFlag (p.flags, FXBusParameters::reverbEnabled);
+            const bool delay = hasFlag (p.flags, FXBusParameters::delayEnabled);
+            const bool bypassed = hasFlag (p.flags, FXBusParameters::bypassed);
+
+            if (bus->getReverbWetLevel() != p.reverbWetLevel)   bus->setReverbWetLevel (p.reverbWetLevel);
+            if (bus->getDelayWetLevel() != p.delayWetLevel)     bus->setDelayWetLevel (p.delayWetLevel);
+            if (bus->getReverbMode() != mode)                   bus->setReverbMode (mode);
+            if (bus->isReverbEnabled() != reverb)               bus->setReverbEnabled (reverb);
+            if (bus->isDelayEnabled() != delay)                 bus->setDelayEnabled (delay);
+            if (bus->isBypassed() != bypassed)                  bus->setBypass (bypassed);
+        }
+
+        if (auto* masterBus = engine.getMasterBusProcessor())
+        {
+            const auto platform = static_cast<StreamTarget> (juce::jlimit<juce::uint32> (0, 2, master.platform));
+            const bool comp = hasFlag (master.flags, MasterBusParameters::compressorEnabled);
+            const bool limiter = hasFlag (master.flags, MasterBusParameters::limiterEnabled);
+
+            if (masterBus->getStreamTarget() != platform)
+                masterBus->setStreamTarget (platform);
+
+            // Presets set their own target; only a custom target is stored
+            if (platform == StreamTarget::Custom && masterBus->getTargetLufs() != master.targetLufs)
+                masterBus->setTargetLufs (master.targetLufs);
+
+            if (masterBus->isCompressorEnabled() != comp)   masterBus->setCompressorEnabled (comp);
+            if (masterBus->isLimiterEnabled() != limiter)   masterBus->setLimiterEnabled (limiter);
+        }
+    }
+
+    //==============================================================================
+    juce::MemoryBlock SessionSnapshot::toMemoryBlock() const
+    {
+        Header header {};
+        header.magic = fileMagic;
+        header.byteOrder = byteOrderMark;
+        header.version = currentVersion;
+        header.headerSize = sizeof (Header);
+        header.numChannels = static_cast<juce::uint32> (channels.size());
+        header.channelBlockSize = sizeof (ChannelParameters);
+        header.numGroupBuses = static_cast<juce::uint32> (groupBuses.size());
+        header.groupBusBlockSize = sizeof (GroupBusParameters);
+        header.numFXBuses = static_cast<juce::uint32> (fxBuses.size());
+        header.fxBusBlockSize = sizeof (FXBusParameters);
+        header.masterBlockSize = sizeof (MasterBusParameters);
+        header.payloadSize = static_cast<juce::uint32> (channels.size() * sizeof (ChannelParameters)
+                                                        + groupBuses.size() * sizeof (GroupBusParameters)
+                                                        + fxBuses.size() * sizeof (FXBusParameters)
+                                                        + sizeof (MasterBusParameters));
+
+        juce::MemoryBlock block (sizeof (Header) + header.payloadSize, true);
+        auto* payload = static_cast<char*> (block.getData()) + sizeof (Header);
+        auto* out = payload;
+
+        auto append = [&out] (const void* source, size_t size)
+        {
+            std::memcpy (out, source, size);
+            out += size;
+        };
+
+        append (channels.data(), channels.size() * sizeof (ChannelParameters));
+        append (groupBuses.data(), groupBuses.size() * sizeof (GroupBusParameters));
+        append (fxBuses.data(), fxBuses.size() * sizeof (FXBusParameters));
+        append (&master, sizeof (MasterBusParameters));
+
+        header.checksum = crc32 (payload, header.payloadSize);
+        block.copyFrom (&header, 0, sizeof (Header));
+        return block;
+    }
+
+    bool SessionSnapshot::FXBusParameters::validateReverbMode()
+    {
+        // apply() casts the mode straight to the enum
+        if (reverbMode <= static_cast<juce::uint32> (FXBusProcessor::ReverbMode::Convolution))
+            return true;
+
+        juce::Logger::writeToLog ("SessionSnapshot: unknown reverb mode " + juce::String (reverbMode) + ", using the algorithmic reverb");
+        reverbMode = static_cast<juce::uint32> (FXBusProcessor::ReverbMode::Algorithmic);
+        return false;
+    }
+
+    bool SessionSnapshot::fromMemory (const void* data, size_t size)
+    {
+        if (data == nullptr || size < sizeof (Header))
+            return false;
+
+        Header header;
+        std::memcpy (&header, data, sizeof (Header));
+
+        // Written with the other byte order: every field is a 32-bit word
+        const bool swapped = header.byteOrder == juce::ByteOrder::swap (byteOrderMark);
+        if (swapped)
+            swapWords (&header, sizeof (Header));
+
+        if (header.magic != fileMagic || header.byteOrder != byteOrderMark)
+            return false;
+
+        if (header.version == 0 || header.version > currentVersion)
+        {
+            juce::Logger::writeToLog ("SessionSnapshot: unsupported version " + juce::String (header.version));
+            return false;
+        }
+
+        const auto expectedPayload = static_cast<juce::uint64> (header.numChannels) * header.channelBlockSize
+                                   + static_cast<juce::uint64> (header.numGroupBuses) * header.groupBusBlockSize
+                                   + static_cast<juce::uint64> (header.numFXBuses) * header.fxBusBlockSize
+                                   + header.masterBlockSize;
+
+        if (header.headerSize < sizeof (Header) || expectedPayload != header.payloadSize
+            || header.headerSize + static_cast<juce::uint64> (header.payloadSize) > size
+            || header.channelBlockSize % 4 != 0 || header.groupBusBlockSize % 4 != 0
+            || header.fxBusBlockSize % 4 != 0 || header.masterBlockSize % 4 != 0)
+            return false;
+
+        const auto* storedPayload = static_cast<const char*> (data) + header.headerSize;
+        if (crc32 (storedPayload, header.payloadSize) != header.checksum)
+        {
+            juce::Logger::writeToLog ("SessionSnapshot: checksum mismatch");
+            return false;
+        }
+
+        // Work on a copy so a foreign byte order can be fixed in place
+        juce::HeapBlock<char> payload (header.payloadSize);
+        std::memcpy (payload.get(), storedPayload, header.payloadSize);
+
+        if (swapped)
+            swapWords (payload.get(), header.payloadSize);
+
+        const char* in = payload.get();
+
+        channels.assign (header.numChannels, {});
+        for (auto& channel : channels)
+            in = readBlock (in, header.channelBlockSize, channel);
+
+        groupBuses.assign (header.numGroupBuses, {});
+        for (auto& bus : groupBuses)
+            in = readBlock (in, header.groupBusBlockSize, bus);
+
+        fxBuses.assign (header.numFXBuses, {});
+        for (auto& bus : fxBuses)
+        {
+            in = readBlock (in, header.fxBusBlockSize, bus);
+            bus.validateReverbMode();
+        }
+
+        master = {};
+        readBlock (in, header.masterBlockSize, master);
+        return true;
+    }
+
+    bool SessionSnapshot::writeToFile (const juce::File& file) const
+    {
+        const auto block = toMemoryBlock();
+        return DurableFile::replaceWithData (file, block.getData(), block.getSize());
+    }
+
+    bool SessionSnapshot::readFromFile (const juce::File& file)
+    {
+        juce::MemoryMappedFile mapped (file, juce::MemoryMappedFile::readOnly);
+        return fromMemory (mapped.getData(), mapped.getSize());
+    }
+
+    juce::uint32 SessionSnapshot::calculateChecksum (const void* data, size_t numBytes)
+    {
+        return crc32 (data, numBytes);
+    }
+
+    bool SessionSnapshot::isSnapshotFile (const juce::File& file)
+    {
+        juce::FileInputStream stream (file);
+        if (!stream.openedOk())
+            return false;
+
+        juce::uint32 magic = 0;
+        if (stream.read (&magic, sizeof (magic)) != sizeof (magic))
+            return false;
+
+        return magic == fileMagic || magic == juce::ByteOrder::swap (fileMagic);
+    }
+}
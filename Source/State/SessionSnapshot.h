@@ -0,0 +1,148 @@
+#pragma once
+#include <JuceHeader.h>
+
+class AudioEngine;
+
+namespace auralis
+{
+    /**  Flat, fixed-layout copy of every mixer parameter.
+
+         On disk this is a header followed by one block per channel and bus.
+         Every field is a 32-bit word, so a file written on a machine with the
+         other byte order is fixed up with one swap pass; the payload carries
+         a CRC-32. Block sizes are stored in the header, so newer versions can
+         append fields and older readers skip them.
+
+         Loading is one mapped read plus direct setter calls, with no parsing
+         or logging. The JSON session format remains for export. */
+    class SessionSnapshot
+    {
+    public:
+        //==============================================================================
+        struct ChannelParameters
+        {
+            enum Flags : juce::uint32
+            {
+                gateEnabled       = 1 << 0,
+                eqEnabled         = 1 << 1,
+                compressorEnabled = 1 << 2,
+                tunerEnabled      = 1 << 3,
+                muted             = 1 << 4,
+                solo              = 1 << 5,
+                lowPriority       = 1 << 6
+            };
+
+            juce::uint32 type = 3;          // ChannelProcessor::ChannelType
+            float trimGainDb = 0.0f;
+            float gateThresholdDb = -50.0f;
+            float eqGainsDb[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            float compressorRatio = 3.0f;
+            float compressorThresholdDb = -18.0f;
+            float fxSendLevel = 0.0f;
+            float tunerStrength = 0.0f;
+            juce::uint32 flags = gateEnabled | eqEnabled | compressorEnabled | tunerEnabled;
+        };
+
+        struct GroupBusParameters
+        {
+            enum Flags : juce::uint32
+            {
+                eqEnabled   = 1 << 0,
+                compEnabled = 1 << 1
+            };
+
+            float eqLowGain = 0.0f;
+            float eqMidGain = 0.0f;
+            float eqHighGain = 0.0f;
+            float outputGain = 1.0f;
+            juce::uint32 flags = eqEnabled | compEnabled;
+        };
+
+        struct FXBusParameters
+        {
+            enum Flags : juce::uint32
+            {
+                reverbEnabled = 1 << 0,
+                delayEnabled  = 1 << 1,
+                bypassed      = 1 << 2
+            };
+
+            float reverbWetLevel = 0.5f;
+            float delayWetLevel = 0.5f;
+            juce::uint32 reverbMode = 0;       // FXBusProcessor::ReverbMode
+            juce::uint32 flags = reverbEnabled | delayEnabled;
+
+            /** False, and back to the algorithmic reverb, if the stored mode isn't
+                one this build knows, e.g. from a newer build or a damaged file. */
+            bool validateReverbMode();
+        };
+
+        struct MasterBusParameters
+        {
+            enum Flags : juce::uint32
+            {
+                compressorEnabled = 1 << 0,
+                limiterEnabled    = 1 << 1
+            };
+
+            float targetLufs = -14.0f;
+            juce::uint32 platform = 0;      // StreamTarget
+            juce::uint32 flags = compressorEnabled | limiterEnabled;
+        };
+
+        //==============================================================================
+        std::vector<ChannelParameters> channels;
+        std::vector<GroupBusParameters> groupBuses;
+        std::vector<FXBusParameters> fxBuses;
+        MasterBusParameters master;
+
+        /** Read every parameter from the engine. */
+        void capture (AudioEngine& engine);
+
+        /** Push every parameter into the engine (message thread). */
+        void apply (AudioEngine& engine) const;
+
+        //==============================================================================
+        /** Serialise to / from the binary layout. fromMemory() rejects bad
+            magic, unknown versions and checksum mismatches. */
+        juce::MemoryBlock toMemoryBlock() const;
+        bool fromMemory (const void* data, size_t size);
+
+        bool writeToFile (const juce::File& file) const;
+        bool readFromFile (const juce::File& file);
+
+        /** True if the file starts with the snapshot magic, in either byte order. */
+        static bool isSnapshotFile (const juce::File& file);
+
+        /** CRC-32 used for the payload, for formats that embed snapshot blocks. */
+        static juce::uint32 calculateChecksum (const void* data, size_t numBytes);
+
+    private:
+        static constexpr juce::uint32 fileMagic = 0x53535541;     // "AUSS"
+        static constexpr juce::uint32 byteOrderMark = 0x01020304;
+        static constexpr juce::uint32 currentVersion = 1;
+
+        struct Header
+        {
+            juce::uint32 magic;
+            juce::uint32 byteOrder;
+            juce::uint32 version;
+            juce::uint32 headerSize;
+            juce::uint32 numChannels;
+            juce::uint32 channelBlockSize;
+            juce::uint32 numGroupBuses;
+            juce::uint32 groupBusBlockSize;
+            juce::uint32 numFXBuses;
+            juce::uint32 fxBusBlockSize;
+            juce::uint32 masterBlockSize;
+            juce::uint32 payloadSize;
+            juce::uint32 checksum;          // CRC-32 of the payload as stored
+            juce::uint32 reserved[3];
+        };
+
+        static_assert (sizeof (Header) == 64, "Snapshot header layout changed");
+        static_assert (sizeof (ChannelParameters) % 4 == 0 && sizeof (GroupBusParameters) % 4 == 0
+                        && sizeof (FXBusParameters) % 4 == 0 && sizeof (MasterBusParameters) % 4 == 0,
+                       "Snapshot blocks must be made of 32-bit words");
+    };
+}
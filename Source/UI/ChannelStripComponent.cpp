@@ -2,6 +2,7 @@
 #include "LevelMeter.h"
 #include "ChannelsComponent.h"
 #include "../Audio/AudioEngine.h"
+#include "../State/ParameterHistory.h"
 #include "../Utils/StyleManager.h"
 
 ChannelStripComponent::ChannelStripComponent(int index, ChannelsComponent* parent)
@@ -392,41 +393,41 @@ void ChannelStripComponent::buttonClicked(juce::Button* button)
 {
     if (channelProcessor == nullptr)
         return;
+    
+    // Changes go through the history so they can be undone
+    using Parameter = auralis::ParameterId::Channel;
+    auto setParameter = [this](Parameter parameter, bool state)
+    {
+        auralis::ParameterHistory::getInstance().setParameter(
+            auralis::ParameterId::channel(channelProcessor->getChannelIndex(), parameter), state ? 1.0f : 0.0f);
+    };
         
     if (button == &gateToggle)
     {
-        channelProcessor->setGateEnabled(gateToggle.getToggleState());
+        setParameter(Parameter::gateEnabled, gateToggle.getToggleState());
     }
     else if (button == &compToggle)
     {
-        channelProcessor->setCompressorEnabled(compToggle.getToggleState());
+        setParameter(Parameter::compressorEnabled, compToggle.getToggleState());
     }
     else if (button == &eqButton)
     {
         // In a real app, this would open an EQ editor window
-        channelProcessor->setEqEnabled(!channelProcessor->isEqEnabled());
+        setParameter(Parameter::eqEnabled, !channelProcessor->isEqEnabled());
     }
     else if (button == &tunerToggle)
     {
-        channelProcessor->setTunerEnabled(tunerToggle.getToggleState());
+        setParameter(Parameter::tunerEnabled, tunerToggle.getToggleState());
     }
     else if (button == &muteButton)
     {
-        if (channelProcessor != nullptr)
-        {
-            bool newState = !channelProcessor->isMuted();
-            channelProcessor->setMuted(newState);
-            updateIconColours();
-        }
+        setParameter(Parameter::muted, !channelProcessor->isMuted());
+        updateIconColours();
     }
     else if (button == &soloButton)
     {
-        if (channelProcessor != nullptr)
-        {
-            bool newState = !channelProcessor->isSolo();
-            channelProcessor->setSolo(newState);
-            updateIconColours();
-        }
+        setParameter(Parameter::solo, !channelProcessor->isSolo());
+        updateIconColours();
     }
 }
 
@@ -434,29 +435,49 @@ void ChannelStripComponent::sliderValueChanged(juce::Slider* slider)
 {
     if (channelProcessor == nullptr)
         return;
+    
+    // Knob drags coalesce into one history record
+    using Parameter = auralis::ParameterId::Channel;
+    auto setParameter = [this](Parameter parameter, float value)
+    {
+        auralis::ParameterHistory::getInstance().setParameter(
+            auralis::ParameterId::channel(channelProcessor->getChannelIndex(), parameter), value);
+    };
         
     if (slider == &trimDial)
     {
         float gainInDb = static_cast<float>(slider->getValue());
-        channelProcessor->setTrimGain(gainInDb);
+        setParameter(Parameter::trimGain, gainInDb);
         trimValueLabel.setText(juce::String(gainInDb, 1) + " dB", juce::dontSendNotification);
     }
     else if (slider == &fxSendDial)
     {
         float level = static_cast<float>(slider->getValue());
-        channelProcessor->setFxSendLevel(level / 100.0f);
+        setParameter(Parameter::fxSendLevel, level / 100.0f);
         fxSendValueLabel.setText(juce::String(level, 1) + " %", juce::dontSendNotification);
     }
     else if (slider == &tunerDial)
     {
         float strength = static_cast<float>(slider->getValue());
-        channelProcessor->setTunerStrength(strength / 100.0f);
+        setParameter(Parameter::tunerStrength, strength / 100.0f);
         tunerValueLabel.setText(juce::String(strength, 1) + " %", juce::dontSendNotification);
     }
 }
 
 void ChannelStripComponent::mouseDown(const juce::MouseEvent& event)
 {
+    // Right-click: which channels give up their tuner first when the engine is overloaded
+    if (event.mods.isPopupMenu() && channelProcessor != nullptr)
+    {
+        juce::PopupMenu menu;
+        auto* processor = channelProcessor;
+        menu.addItem("Low priority under overload", true, processor->isLowPriority(), [processor]()
+        {
+            processor->setLowPriority(!processor->isLowPriority());
+        });
+        menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(this));
+    }
+
     // Notify parent component of selection
     if (parentComponent != nullptr)
     {
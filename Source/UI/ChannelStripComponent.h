@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "../Audio/ChannelProcessor.h"
+#include "../Soundcheck/ToneProfiles.h"
 #include "../Utils/StyleManager.h"
 
 // Forward declaration for cross-referencing
@@ -13,14 +14,8 @@ class ChannelStripComponent : public juce::Component,
                               public juce::ComboBox::Listener
 {
 public:
-    enum class ChannelType
-    {
-        SingingVocal,
-        Instrument,
-        Drums,
-        Speech,
-        Other
-    };
+    // The source types the soundcheck has tone profiles for
+    using ChannelType = ToneProfileType;
     
     // Standard width for channel strips as per requirements
     static constexpr int kStandardWidth = 140;
@@ -0,0 +1,297 @@
+#include "DSPLoadPanel.h"
+
+DSPLoadPanel::DSPLoadPanel(AudioEngine& engine)
+    : profiler(engine.getLoadProfiler()),
+      overloadGuard(engine.getOverloadGuard())
+{
+    callbackLabel.setFont(juce::Font(16.0f, juce::Font::bold));
+    callbackLabel.setColour(juce::Label::textColourId, juce::Colours::white);
+    addAndMakeVisible(callbackLabel);
+
+    guardLabel.setFont(juce::Font(13.0f));
+    guardLabel.setColour(juce::Label::textColourId, juce::Colours::lightgrey);
+    addAndMakeVisible(guardLabel);
+
+    // Off restores full quality straight away
+    adaptiveQualityToggle.setToggleState(overloadGuard.isEnabled(), juce::dontSendNotification);
+    adaptiveQualityToggle.onClick = [this]()
+    {
+        overloadGuard.setEnabled(adaptiveQualityToggle.getToggleState());
+        updateGuardLabel();
+    };
+    addAndMakeVisible(adaptiveQualityToggle);
+
+    overloadLogButton.onClick = [this]() { saveOverloadLogClicked(); };
+    addAndMakeVisible(overloadLogButton);
+
+    // Stages cost several times the strips' timers, so they are only timed on request
+    showStagesToggle.onClick = [this]() { profiler.setStagesEnabled(showStagesToggle.getToggleState()); };
+    addAndMakeVisible(showStagesToggle);
+
+    resetButton.onClick = [this]() { profiler.reset(); };
+    addAndMakeVisible(resetButton);
+
+    saveReportButton.onClick = [this]() { saveReportClicked(); };
+    addAndMakeVisible(saveReportButton);
+
+    addAndMakeVisible(table);
+    table.setModel(this);
+    table.setHeaderHeight(28);
+    table.setRowHeight(22);
+    table.setColour(juce::ListBox::backgroundColourId, juce::Colours::black.withAlpha(0.6f));
+
+    auto& header = table.getHeader();
+    header.setStretchToFitActive(true);
+    header.addColumn("Processor", nameColumn, 200, 100, 400, juce::TableHeaderComponent::defaultFlags);
+    header.addColumn("Average", averageColumn, 140, 80, 300, juce::TableHeaderComponent::defaultFlags);
+    header.addColumn("Max", maxColumn, 140, 80, 300, juce::TableHeaderComponent::defaultFlags);
+    header.addColumn("Min", minColumn, 100, 60, 200, juce::TableHeaderComponent::defaultFlags);
+    header.addColumn("Worst since reset", worstColumn, 140, 80, 300, juce::TableHeaderComponent::defaultFlags);
+    header.setSortColumnId(averageColumn, false);
+
+    if (!DSPLoadProfiler::isCompiledIn)
+    {
+        callbackLabel.setText("DSP load profiling is not in this build (AURALIS_DSP_PROFILER=OFF)", juce::dontSendNotification);
+        resetButton.setEnabled(false);
+        saveReportButton.setEnabled(false);
+    }
+}
+
+DSPLoadPanel::~DSPLoadPanel()
+{
+    profiler.setEnabled(false);
+}
+
+void DSPLoadPanel::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black.withAlpha(0.4f));
+}
+
+void DSPLoadPanel::resized()
+{
+    auto bounds = getLocalBounds().reduced(10);
+
+    auto topRow = bounds.removeFromTop(30);
+    saveReportButton.setBounds(topRow.removeFromRight(120));
+    topRow.removeFromRight(10);
+    resetButton.setBounds(topRow.removeFromRight(80));
+    topRow.removeFromRight(10);
+    showStagesToggle.setBounds(topRow.removeFromRight(160));
+    callbackLabel.setBounds(topRow);
+
+    bounds.removeFromTop(4);
+    auto guardRow = bounds.removeFromTop(24);
+    overloadLogButton.setBounds(guardRow.removeFromRight(120));
+    guardRow.removeFromRight(10);
+    adaptiveQualityToggle.setBounds(guardRow.removeFromRight(160));
+    guardLabel.setBounds(guardRow);
+    bounds.removeFromTop(10);
+    table.setBounds(bounds);
+}
+
+void DSPLoadPanel::visibilityChanged()
+{
+    // Only pay for the timers while someone is looking
+    const bool showing = isShowing();
+    profiler.setEnabled(showing);
+
+    if (showing)
+    {
+        updateGuardLabel();
+        startTimerHz(4);
+    }
+    else
+        stopTimer();
+}
+
+void DSPLoadPanel::timerCallback()
+{
+    updateGuardLabel();
+
+    if (!DSPLoadProfiler::isCompiledIn)
+        return;
+
+    refreshRows();
+}
+
+void DSPLoadPanel::updateGuardLabel()
+{
+    juce::StringArray steps;
+    for (auto step : overloadGuard.getActiveSteps())
+        steps.add(OverloadGuard::getStepName(step));
+
+    const auto quality = !overloadGuard.isEnabled() ? juce::String("adaptive quality off")
+                         : steps.isEmpty()          ? juce::String("full quality")
+                                                    : "shedding: " + steps.joinIntoString(", ");
+
+    guardLabel.setText(juce::String(overloadGuard.getNumOverruns()) + " overruns, "
+                       + juce::String(overloadGuard.getRecentLoad() * 100.0f, 0) + "% recent peak, " + quality,
+                       juce::dontSendNotification);
+    guardLabel.setColour(juce::Label::textColourId, steps.isEmpty() ? juce::Colours::lightgrey : juce::Colours::orange);
+}
+
+void DSPLoadPanel::refreshRows()
+{
+    const int numSlots = profiler.getNumSlots();
+    lastBlockCounts.resize((size_t) numSlots, 0);
+    rows.clear();
+
+    for (int i = 0; i < numSlots; ++i)
+    {
+        const auto& slot = profiler.getSlot(i);
+        const auto statistics = slot.getStatistics();
+        const bool ranSinceLastLook = statistics.numBlocks > 0 && statistics.numBlocks != lastBlockCounts[(size_t) i];
+        lastBlockCounts[(size_t) i] = statistics.numBlocks;
+
+        if (slot.getType() == DSPLoadProfiler::SlotType::Callback)
+        {
+            callbackLabel.setText("Audio callback: " + juce::String(statistics.averageLoad * 100.0f, 1) + "% average, "
+                                  + juce::String(statistics.maxLoad * 100.0f, 1) + "% max, "
+                                  + juce::String(statistics.worstLoad * 100.0f, 1) + "% worst",
+                                  juce::dontSendNotification);
+            callbackLabel.setColour(juce::Label::textColourId, getLoadColour(statistics.maxLoad, 0.5f, 0.8f));
+            continue;
+        }
+
+        // Unpatched channels and bypassed stages don't run; leave them out
+        if (!ranSinceLastLook)
+            continue;
+
+        if (slot.getType() == DSPLoadProfiler::SlotType::ChannelStage && !showStagesToggle.getToggleState())
+            continue;
+
+        rows.push_back({ i, statistics });
+    }
+
+    sortRows();
+    table.updateContent();
+    table.repaint();
+}
+
+void DSPLoadPanel::sortRows()
+{
+    std::stable_sort(rows.begin(), rows.end(), [this](const Row& a, const Row& b)
+    {
+        if (sortColumn == nameColumn)
+        {
+            const auto& first = profiler.getSlot(a.slotIndex);
+            const auto& second = profiler.getSlot(b.slotIndex);
+            const int order = first.getType() != second.getType() ? static_cast<int>(first.getType()) - static_cast<int>(second.getType())
+                                                                   : a.slotIndex - b.slotIndex;
+            return sortForwards ? order < 0 : order > 0;
+        }
+
+        const float first = getColumnLoad(a.statistics, sortColumn);
+        const float second = getColumnLoad(b.statistics, sortColumn);
+        return sortForwards ? first < second : first > second;
+    });
+}
+
+void DSPLoadPanel::sortOrderChanged(int newSortColumnId, bool isForwards)
+{
+    sortColumn = newSortColumnId;
+    sortForwards = isForwards;
+    sortRows();
+    table.updateContent();
+}
+
+int DSPLoadPanel::getNumRows()
+{
+    return static_cast<int>(rows.size());
+}
+
+void DSPLoadPanel::paintRowBackground(juce::Graphics& g, int rowNumber, int width, int height, bool rowIsSelected)
+{
+    // Alternate row colors
+    if (rowNumber % 2 == 0)
+        g.fillAll(juce::Colours::darkgrey.darker(0.2f));
+    else
+        g.fillAll(juce::Colours::darkgrey.darker(0.4f));
+
+    if (rowIsSelected)
+        g.fillAll(juce::Colours::blue.withAlpha(0.2f));
+}
+
+void DSPLoadPanel::paintCell(juce::Graphics& g, int rowNumber, int columnId, int width, int height, bool rowIsSelected)
+{
+    if (rowNumber < 0 || rowNumber >= static_cast<int>(rows.size()))
+        return;
+
+    const auto& row = rows[(size_t) rowNumber];
+    const auto& slot = profiler.getSlot(row.slotIndex);
+    g.setFont(juce::Font(12.0f));
+
+    if (columnId == nameColumn)
+    {
+        // Stages sit indented under their strip
+        const int indent = slot.getType() == DSPLoadProfiler::SlotType::ChannelStage ? 20 : 4;
+        g.setColour(juce::Colours::white);
+        g.drawText(slot.getName(), indent, 0, width - indent, height, juce::Justification::centredLeft);
+        return;
+    }
+
+    const float load = getColumnLoad(row.statistics, columnId);
+
+    // A bar for the share of the budget, full width at a quarter of it
+    const auto barWidth = juce::jlimit(0.0f, 1.0f, load * 4.0f) * static_cast<float>(width - 8);
+    g.setColour(getLoadColour(load, 0.05f, 0.2f).withAlpha(0.5f));
+    g.fillRect(4.0f, 3.0f, barWidth, static_cast<float>(height - 6));
+
+    g.setColour(juce::Colours::white);
+    g.drawText(juce::String(load * 100.0f, 2) + "%", 4, 0, width - 8, height, juce::Justification::centredRight);
+}
+
+float DSPLoadPanel::getColumnLoad(const DSPLoadProfiler::Statistics& statistics, int columnId)
+{
+    switch (columnId)
+    {
+        case averageColumn: return statistics.averageLoad;
+        case maxColumn:     return statistics.maxLoad;
+        case minColumn:     return statistics.minLoad;
+        case worstColumn:   return statistics.worstLoad;
+        default:            return 0.0f;
+    }
+}
+
+juce::Colour DSPLoadPanel::getLoadColour(float load, float warning, float overload)
+{
+    if (load < warning)
+        return juce::Colours::green;
+    if (load < overload)
+        return juce::Colours::orange;
+    return juce::Colours::red;
+}
+
+void DSPLoadPanel::saveReportClicked()
+{
+    reportChooser = std::make_unique<juce::FileChooser>("Save DSP Load Report", juce::File{}, "*.json");
+    const auto flags = juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::warnAboutOverwriting;
+
+    reportChooser->launchAsync(flags, [this](const juce::FileChooser& fc)
+    {
+        auto file = fc.getResult();
+        if (file == juce::File{})
+            return;
+
+        if (!profiler.writeReport(file.withFileExtension("json")))
+            juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon, "Save Report",
+                                                   "Couldn't write " + file.getFullPathName());
+    });
+}
+
+void DSPLoadPanel::saveOverloadLogClicked()
+{
+    reportChooser = std::make_unique<juce::FileChooser>("Save Overload Log", juce::File{}, "*.json");
+    const auto flags = juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::warnAboutOverwriting;
+
+    reportChooser->launchAsync(flags, [this](const juce::FileChooser& fc)
+    {
+        auto file = fc.getResult();
+        if (file == juce::File{})
+            return;
+
+        if (!overloadGuard.writeReport(file.withFileExtension("json")))
+            juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon, "Save Overload Log",
+                                                   "Couldn't write " + file.getFullPathName());
+    });
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Audio/AudioEngine.h"
+
+/**
+ * DSPLoadPanel - Which strip or bus is eating the callback budget
+ *
+ * Lists every channel strip, group bus, FX bus and the master with the share
+ * of the device's real-time budget each took over the last half second, busiest
+ * first, plus the whole callback at the top. Channel strips can be broken down
+ * into their stages. The engine's profiler runs only while the panel is showing.
+ * Below the callback figures, the overload guard's overrun count and whatever
+ * quality steps it has taken, with a switch to turn it off and its event log.
+ */
+class DSPLoadPanel : public juce::Component,
+                     private juce::Timer,
+                     private juce::TableListBoxModel
+{
+public:
+    explicit DSPLoadPanel(AudioEngine& engine);
+    ~DSPLoadPanel() override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    enum ColumnIds
+    {
+        nameColumn = 1,
+        averageColumn,
+        maxColumn,
+        minColumn,
+        worstColumn
+    };
+
+    struct Row
+    {
+        int slotIndex = 0;
+        DSPLoadProfiler::Statistics statistics;
+    };
+
+    // TableListBoxModel
+    int getNumRows() override;
+    void paintRowBackground(juce::Graphics& g, int rowNumber, int width, int height, bool rowIsSelected) override;
+    void paintCell(juce::Graphics& g, int rowNumber, int columnId, int width, int height, bool rowIsSelected) override;
+    void sortOrderChanged(int newSortColumnId, bool isForwards) override;
+
+    void timerCallback() override;   // 4 Hz
+    void visibilityChanged() override;
+
+    void refreshRows();
+    void sortRows();
+    void saveReportClicked();
+    void saveOverloadLogClicked();
+    void updateGuardLabel();
+
+    static float getColumnLoad(const DSPLoadProfiler::Statistics& statistics, int columnId);
+    static juce::Colour getLoadColour(float load, float warning, float overload);
+
+    DSPLoadProfiler& profiler;
+    OverloadGuard& overloadGuard;
+
+    juce::Label callbackLabel;
+    juce::Label guardLabel;
+    juce::ToggleButton adaptiveQualityToggle { "Adaptive quality" };
+    juce::TextButton overloadLogButton { "Overload Log..." };
+    juce::ToggleButton showStagesToggle { "Show strip stages" };
+    juce::TextButton resetButton { "Reset" };
+    juce::TextButton saveReportButton { "Save Report..." };
+    juce::TableListBox table;
+    std::unique_ptr<juce::FileChooser> reportChooser;
+
+    std::vector<Row> rows;
+    std::vector<juce::int64> lastBlockCounts;   // Per slot, to leave out processors that stopped running
+    int sortColumn = averageColumn;
+    bool sortForwards = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DSPLoadPanel)
+};
@@ -1,4 +1,5 @@
 #include "FXBusesComponent.h"
+#include "../State/ParameterHistory.h"
 
 //==============================================================================
 // FXBusRowComponent Implementation
@@ -31,6 +32,23 @@ FXBusRowComponent::FXBusRowComponent(FXBusProcessor* processor)
     reverbLabel.setColour(juce::Label::textColourId, juce::Colours::white);
     addAndMakeVisible(reverbLabel);
     
+    // Convolution reverb controls
+    loadIRButton.setTooltip("Load a room impulse response (WAV) for this bus");
+    loadIRButton.onClick = [this]() { loadIRButtonClicked(); };
+    addAndMakeVisible(loadIRButton);
+    
+    convolutionToggle.setButtonText("");
+    convolutionToggle.setToggleState(fxProcessor->getReverbMode() == FXBusProcessor::ReverbMode::Convolution,
+                                     juce::dontSendNotification);
+    convolutionToggle.addListener(this);
+    addAndMakeVisible(convolutionToggle);
+    
+    convolutionLabel.setText("Room IR", juce::dontSendNotification);
+    convolutionLabel.setJustificationType(juce::Justification::centred);
+    convolutionLabel.setFont(blackwayLookAndFeel.getRobotoFont().withHeight(12.0f));
+    convolutionLabel.setColour(juce::Label::textColourId, juce::Colours::white);
+    addAndMakeVisible(convolutionLabel);
+    
     // Delay wet slider
     delayWetSlider.setSliderStyle(juce::Slider::RotaryHorizontalVerticalDrag);
     delayWetSlider.setTextBoxStyle(juce::Slider::TextBoxBelow, false, 50, 20);
@@ -87,8 +105,8 @@ void FXBusRowComponent::resized()
     float nameWidth = bounds.getWidth() * 0.2f;
     row.items.add(juce::FlexItem(busNameLabel).withWidth(nameWidth).withHeight(30.0f));
     
-    // Reverb controls take up about 30% of width
-    float reverbWidth = bounds.getWidth() * 0.3f;
+    // Reverb controls take up about 25% of width
+    float reverbWidth = bounds.getWidth() * 0.25f;
     juce::FlexBox reverbBox;
     reverbBox.flexDirection = juce::FlexBox::Direction::column;
     reverbBox.justifyContent = juce::FlexBox::JustifyContent::center;
@@ -99,8 +117,21 @@ void FXBusRowComponent::resized()
     
     row.items.add(juce::FlexItem(reverbBox).withWidth(reverbWidth).withHeight(120.0f));
     
-    // Delay controls take up about 30% of width
-    float delayWidth = bounds.getWidth() * 0.3f;
+    // Convolution controls take up about 15% of width
+    float irWidth = bounds.getWidth() * 0.15f;
+    juce::FlexBox irBox;
+    irBox.flexDirection = juce::FlexBox::Direction::column;
+    irBox.justifyContent = juce::FlexBox::JustifyContent::center;
+    irBox.alignItems = juce::FlexBox::AlignItems::center;
+    
+    irBox.items.add(juce::FlexItem(convolutionLabel).withWidth(80.0f).withHeight(20.0f));
+    irBox.items.add(juce::FlexItem(convolutionToggle).withWidth(40.0f).withHeight(40.0f));
+    irBox.items.add(juce::FlexItem(loadIRButton).withWidth(90.0f).withHeight(24.0f));
+    
+    row.items.add(juce::FlexItem(irBox).withWidth(irWidth).withHeight(100.0f));
+    
+    // Delay controls take up about 25% of width
+    float delayWidth = bounds.getWidth() * 0.25f;
     juce::FlexBox delayBox;
     delayBox.flexDirection = juce::FlexBox::Direction::column;
     delayBox.justifyContent = juce::FlexBox::JustifyContent::center;
@@ -111,8 +142,8 @@ void FXBusRowComponent::resized()
     
     row.items.add(juce::FlexItem(delayBox).withWidth(delayWidth).withHeight(120.0f));
     
-    // Bypass toggle takes up about 20% of width
-    float bypassWidth = bounds.getWidth() * 0.2f;
+    // Bypass toggle takes up about 15% of width
+    float bypassWidth = bounds.getWidth() * 0.15f;
     juce::FlexBox bypassBox;
     bypassBox.flexDirection = juce::FlexBox::Direction::column;
     bypassBox.justifyContent = juce::FlexBox::JustifyContent::center;
@@ -131,14 +162,20 @@ void FXBusRowComponent::sliderValueChanged(juce::Slider* slider)
 {
     if (fxProcessor == nullptr)
         return;
+    
+    using Parameter = auralis::ParameterId::FXBus;
+    const int busIndex = static_cast<int>(fxProcessor->getBusType());
+    auto& history = auralis::ParameterHistory::getInstance();
         
     if (slider == &reverbWetSlider)
     {
-        fxProcessor->setReverbWetLevel(static_cast<float>(reverbWetSlider.getValue() / 100.0));
+        history.setParameter(auralis::ParameterId::fxBus(busIndex, Parameter::reverbWetLevel),
+                             static_cast<float>(reverbWetSlider.getValue() / 100.0));
     }
     else if (slider == &delayWetSlider)
     {
-        fxProcessor->setDelayWetLevel(static_cast<float>(delayWetSlider.getValue() / 100.0));
+        history.setParameter(auralis::ParameterId::fxBus(busIndex, Parameter::delayWetLevel),
+                             static_cast<float>(delayWetSlider.getValue() / 100.0));
     }
 }
 
@@ -147,10 +184,49 @@ void FXBusRowComponent::buttonClicked(juce::Button* button)
     if (fxProcessor == nullptr)
         return;
         
+    using Parameter = auralis::ParameterId::FXBus;
+    const int busIndex = static_cast<int>(fxProcessor->getBusType());
+    auto& history = auralis::ParameterHistory::getInstance();
+        
     if (button == &bypassToggle)
     {
-        fxProcessor->setBypass(bypassToggle.getToggleState());
+        history.setParameter(auralis::ParameterId::fxBus(busIndex, Parameter::bypassed),
+                             bypassToggle.getToggleState() ? 1.0f : 0.0f);
     }
+    else if (button == &convolutionToggle)
+    {
+        // Switching to convolution without an IR would just pass the dry signal
+        if (convolutionToggle.getToggleState() && fxProcessor->getImpulseResponseFile() == juce::File{})
+        {
+            convolutionToggle.setToggleState(false, juce::dontSendNotification);
+            loadIRButtonClicked();
+            return;
+        }
+        
+        history.setParameter(auralis::ParameterId::fxBus(busIndex, Parameter::reverbMode),
+                             static_cast<float>(convolutionToggle.getToggleState() ? FXBusProcessor::ReverbMode::Convolution
+                                                                                   : FXBusProcessor::ReverbMode::Algorithmic));
+    }
+}
+
+void FXBusRowComponent::loadIRButtonClicked()
+{
+    irChooser = std::make_unique<juce::FileChooser>("Load Impulse Response", juce::File{}, "*.wav;*.aif;*.aiff");
+    auto flags = juce::FileBrowserComponent::openMode |
+                 juce::FileBrowserComponent::canSelectFiles;
+    
+    irChooser->launchAsync(flags, [this](const juce::FileChooser& fc)
+    {
+        auto file = fc.getResult();
+        if (file == juce::File{} || fxProcessor == nullptr)
+            return;
+        
+        if (fxProcessor->loadImpulseResponse(file))
+        {
+            convolutionToggle.setToggleState(true, juce::dontSendNotification);
+            loadIRButton.setTooltip(file.getFileName());
+        }
+    });
 }
 
 //==============================================================================
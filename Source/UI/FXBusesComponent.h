@@ -28,6 +28,9 @@ private:
     juce::Label busNameLabel;
     juce::Slider reverbWetSlider;
     juce::Label reverbLabel;
+    juce::TextButton loadIRButton { "Load IR..." };
+    juce::ToggleButton convolutionToggle;
+    juce::Label convolutionLabel;
     juce::Slider delayWetSlider;
     juce::Label delayLabel;
     juce::ToggleButton bypassToggle;
@@ -35,6 +38,10 @@ private:
     
     BlackwayLookAndFeel blackwayLookAndFeel;
     
+    // Impulse response picker
+    std::unique_ptr<juce::FileChooser> irChooser;
+    void loadIRButtonClicked();
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FXBusRowComponent)
 };
 
@@ -1,4 +1,5 @@
 #include "GroupBusComponent.h"
+#include "../State/ParameterHistory.h"
 
 //==============================================================================
 // GroupBusRowComponent Implementation
@@ -142,21 +143,29 @@ void GroupBusRowComponent::sliderValueChanged(juce::Slider* slider)
     if (!groupProcessor)
         return;
     
+    using Parameter = auralis::ParameterId::GroupBus;
+    auto setParameter = [this, slider](Parameter parameter)
+    {
+        auralis::ParameterHistory::getInstance().setParameter(
+            auralis::ParameterId::groupBus(static_cast<int>(groupProcessor->getBusType()), parameter),
+            static_cast<float>(slider->getValue()));
+    };
+    
     if (slider == &outputGainSlider)
     {
-        groupProcessor->setOutputGain(static_cast<float>(slider->getValue()));
+        setParameter(Parameter::outputGain);
     }
     else if (slider == &eqLowGainSlider)
     {
-        groupProcessor->setEQLowGain(static_cast<float>(slider->getValue()));
+        setParameter(Parameter::eqLowGain);
     }
     else if (slider == &eqMidGainSlider)
     {
-        groupProcessor->setEQMidGain(static_cast<float>(slider->getValue()));
+        setParameter(Parameter::eqMidGain);
     }
     else if (slider == &eqHighGainSlider)
     {
-        groupProcessor->setEQHighGain(static_cast<float>(slider->getValue()));
+        setParameter(Parameter::eqHighGain);
     }
 }
 
@@ -167,7 +176,9 @@ void GroupBusRowComponent::buttonClicked(juce::Button* button)
     
     if (button == &compToggle)
     {
-        groupProcessor->setCompEnabled(button->getToggleState());
+        auralis::ParameterHistory::getInstance().setParameter(
+            auralis::ParameterId::groupBus(static_cast<int>(groupProcessor->getBusType()), auralis::ParameterId::GroupBus::compEnabled),
+            button->getToggleState() ? 1.0f : 0.0f);
     }
 }
 
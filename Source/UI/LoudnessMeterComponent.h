@@ -1,10 +1,12 @@
 #pragma once
 #include <JuceHeader.h>
+#include "../Audio/MeterTarget.h"
 
 namespace auralis
 {
     /**  Displays short-term LUFS, true-peak in dBFS, and a bar meter. */
     class LoudnessMeterComponent : public juce::Component,
+                                   public MeterTarget,
                                    private juce::Timer
     {
     public:
@@ -12,7 +14,7 @@ namespace auralis
         ~LoudnessMeterComponent() override = default;
 
         /** Call once per audio block from the master bus. */
-        void pushSamples (const juce::AudioBuffer<float>& buffer);
+        void pushSamples (const juce::AudioBuffer<float>& buffer) override;
 
         void paint    (juce::Graphics&) override;
         void resized  () override {}
@@ -4,6 +4,8 @@
 #include "FXBusesComponent.h"
 #include "MasterBusComponent.h"
 #include "RoutingComponent.h"
+#include "DSPLoadPanel.h"
+#include "RecorderPanel.h"
 #include "../Utils/StyleManager.h"
 
 MainComponent::MainComponent()
@@ -64,9 +66,11 @@ MainComponent::MainComponent()
         routingTab = std::make_unique<RoutingComponent>();
         fxBusesTab = std::make_unique<FXBusesComponent>();
         masterTab = std::make_unique<MasterBusComponent>(masterBusProcessor);
+        dspLoadTab = std::make_unique<DSPLoadPanel>(*audioEngine);
+        recorderTab = std::make_unique<RecorderPanel>(*audioEngine);
         settingsTab = std::make_unique<auralis::SettingsComponent>();
         
-        if (!channelsTab || !routingTab || !fxBusesTab || !masterTab || !settingsTab)
+        if (!channelsTab || !routingTab || !fxBusesTab || !masterTab || !dspLoadTab || !recorderTab || !settingsTab)
         {
             juce::Logger::writeToLog("Failed to create one or more tab components!");
             return;
@@ -107,6 +111,8 @@ MainComponent::MainComponent()
         tabbedComponent.addTab("Channels", juce::Colours::black, channelsTab.get(), false);
         tabbedComponent.addTab("FX Buses", juce::Colours::black, fxBusesTab.get(), false);
         tabbedComponent.addTab("Master", juce::Colours::black, masterTab.get(), false);
+        tabbedComponent.addTab("DSP Load", juce::Colours::black, dspLoadTab.get(), false);
+        tabbedComponent.addTab("Recorder", juce::Colours::black, recorderTab.get(), false);
         tabbedComponent.addTab("Settings", juce::Colours::black, settingsTab.get(), false);
         
         // Select Channels tab by default
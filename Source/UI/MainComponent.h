@@ -31,6 +31,8 @@ private:
     std::unique_ptr<juce::Component> channelsTab;
     std::unique_ptr<juce::Component> fxBusesTab;
     std::unique_ptr<juce::Component> masterTab;
+    std::unique_ptr<juce::Component> dspLoadTab;
+    std::unique_ptr<juce::Component> recorderTab;
     std::unique_ptr<auralis::SettingsComponent> settingsTab;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainComponent)
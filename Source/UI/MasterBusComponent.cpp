@@ -1,5 +1,14 @@
 #include "MasterBusComponent.h"
 #include "../Utils/StyleManager.h"
+#include "../State/ParameterHistory.h"
+
+namespace
+{
+    void setMasterParameter(auralis::ParameterId::Master parameter, float value)
+    {
+        auralis::ParameterHistory::getInstance().setParameter(auralis::ParameterId::master(parameter), value);
+    }
+}
 
 MasterBusComponent::MasterBusComponent(MasterBusProcessor* processor)
     : masterProcessor(processor)
@@ -40,12 +49,16 @@ MasterBusComponent::MasterBusComponent(MasterBusProcessor* processor)
     // Set up effect toggles
     compressorToggle.setButtonText("COMPRESSOR");
     compressorToggle.setToggleState(true, juce::dontSendNotification);
-    compressorToggle.onClick = [this] { masterProcessor->setCompressorEnabled(compressorToggle.getToggleState()); };
+    compressorToggle.onClick = [this] {
+        setMasterParameter(auralis::ParameterId::Master::compressorEnabled, compressorToggle.getToggleState() ? 1.0f : 0.0f);
+    };
     addAndMakeVisible(compressorToggle);
     
     limiterToggle.setButtonText("LIMITER");
     limiterToggle.setToggleState(true, juce::dontSendNotification);
-    limiterToggle.onClick = [this] { masterProcessor->setLimiterEnabled(limiterToggle.getToggleState()); };
+    limiterToggle.onClick = [this] {
+        setMasterParameter(auralis::ParameterId::Master::limiterEnabled, limiterToggle.getToggleState() ? 1.0f : 0.0f);
+    };
     addAndMakeVisible(limiterToggle);
     
     // Set up target selection buttons
@@ -55,7 +68,7 @@ MasterBusComponent::MasterBusComponent(MasterBusProcessor* processor)
     youtubeButton.setToggleState(true, juce::dontSendNotification);
     youtubeButton.onClick = [this] {
         if (youtubeButton.getToggleState()) {
-            masterProcessor->setStreamTarget(StreamTarget::YouTube);
+            setMasterParameter(auralis::ParameterId::Master::streamTarget, static_cast<float>(StreamTarget::YouTube));
             customLufsSlider.setVisible(false);
             customLufsLabel.setVisible(false);
             updateLufsDisplay();
@@ -68,7 +81,7 @@ MasterBusComponent::MasterBusComponent(MasterBusProcessor* processor)
     facebookButton.setRadioGroupId(1);
     facebookButton.onClick = [this] {
         if (facebookButton.getToggleState()) {
-            masterProcessor->setStreamTarget(StreamTarget::Facebook);
+            setMasterParameter(auralis::ParameterId::Master::streamTarget, static_cast<float>(StreamTarget::Facebook));
             customLufsSlider.setVisible(false);
             customLufsLabel.setVisible(false);
             updateLufsDisplay();
@@ -81,10 +94,10 @@ MasterBusComponent::MasterBusComponent(MasterBusProcessor* processor)
     customButton.setRadioGroupId(1);
     customButton.onClick = [this] {
         if (customButton.getToggleState()) {
-            masterProcessor->setStreamTarget(StreamTarget::Custom);
+            setMasterParameter(auralis::ParameterId::Master::streamTarget, static_cast<float>(StreamTarget::Custom));
             customLufsSlider.setVisible(true);
             customLufsLabel.setVisible(true);
-            masterProcessor->setTargetLufs(static_cast<float>(customLufsSlider.getValue()));
+            setMasterParameter(auralis::ParameterId::Master::targetLufs, static_cast<float>(customLufsSlider.getValue()));
             updateLufsDisplay();
         }
     };
@@ -96,7 +109,7 @@ MasterBusComponent::MasterBusComponent(MasterBusProcessor* processor)
     customLufsSlider.setSliderStyle(juce::Slider::LinearHorizontal);
     customLufsSlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, 60, 20);
     customLufsSlider.onValueChange = [this] {
-        masterProcessor->setTargetLufs(static_cast<float>(customLufsSlider.getValue()));
+        setMasterParameter(auralis::ParameterId::Master::targetLufs, static_cast<float>(customLufsSlider.getValue()));
         updateLufsDisplay();
     };
     customLufsSlider.setVisible(false);
@@ -0,0 +1,218 @@
+#include "RecorderPanel.h"
+
+RecorderPanel::RecorderPanel(AudioEngine& engine)
+    : recorder(engine.getRecorder()),
+      player(engine.getPlayer()),
+      recordingsFolder(juce::File::getSpecialLocation(juce::File::userMusicDirectory).getChildFile("Auralis Recordings"))
+{
+    folderLabel.setFont(juce::Font(14.0f));
+    folderLabel.setColour(juce::Label::textColourId, juce::Colours::white);
+    folderLabel.setText(recordingsFolder.getFullPathName(), juce::dontSendNotification);
+    addAndMakeVisible(folderLabel);
+
+    chooseFolderButton.onClick = [this]() { chooseFolderClicked(); };
+    addAndMakeVisible(chooseFolderButton);
+
+    recordButton.setClickingTogglesState(false);
+    recordButton.setColour(juce::TextButton::buttonOnColourId, juce::Colours::red);
+    recordButton.onClick = [this]() { recordClicked(); };
+    addAndMakeVisible(recordButton);
+
+    statusLabel.setFont(juce::Font(16.0f, juce::Font::bold));
+    statusLabel.setColour(juce::Label::textColourId, juce::Colours::lightgrey);
+    addAndMakeVisible(statusLabel);
+
+    openTakeButton.onClick = [this]() { openTakeClicked(); };
+    addAndMakeVisible(openTakeButton);
+
+    playButton.onClick = [this]() { playClicked(); };
+    addAndMakeVisible(playButton);
+
+    rewindButton.onClick = [this]()
+    {
+        player.setPosition(0.0);
+        updatePlaybackStatus();
+    };
+    addAndMakeVisible(rewindButton);
+
+    loopToggle.onClick = [this]() { player.setLooping(loopToggle.getToggleState()); };
+    addAndMakeVisible(loopToggle);
+
+    playbackLabel.setFont(juce::Font(14.0f));
+    playbackLabel.setColour(juce::Label::textColourId, juce::Colours::lightgrey);
+    addAndMakeVisible(playbackLabel);
+
+    updateStatus();
+    updatePlaybackStatus();
+    startTimerHz(4);
+}
+
+RecorderPanel::~RecorderPanel()
+{
+    stopTimer();
+}
+
+void RecorderPanel::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black.withAlpha(0.4f));
+}
+
+void RecorderPanel::resized()
+{
+    auto bounds = getLocalBounds().reduced(10);
+
+    auto folderRow = bounds.removeFromTop(30);
+    chooseFolderButton.setBounds(folderRow.removeFromRight(140));
+    folderRow.removeFromRight(10);
+    folderLabel.setBounds(folderRow);
+
+    bounds.removeFromTop(10);
+    auto recordRow = bounds.removeFromTop(40);
+    recordButton.setBounds(recordRow.removeFromLeft(120));
+    recordRow.removeFromLeft(10);
+    statusLabel.setBounds(recordRow);
+
+    bounds.removeFromTop(20);
+    auto playRow = bounds.removeFromTop(30);
+    openTakeButton.setBounds(playRow.removeFromLeft(120));
+    playRow.removeFromLeft(10);
+    playButton.setBounds(playRow.removeFromLeft(80));
+    playRow.removeFromLeft(10);
+    rewindButton.setBounds(playRow.removeFromLeft(80));
+    playRow.removeFromLeft(10);
+    loopToggle.setBounds(playRow.removeFromLeft(70));
+
+    bounds.removeFromTop(5);
+    playbackLabel.setBounds(bounds.removeFromTop(30));
+}
+
+void RecorderPanel::timerCallback()
+{
+    updateStatus();
+    updatePlaybackStatus();
+}
+
+void RecorderPanel::recordClicked()
+{
+    if (recorder.isRecording())
+    {
+        recorder.stop();
+        updateStatus();
+        return;
+    }
+
+    MultitrackRecorder::Settings settings;
+    settings.folder = recordingsFolder.getChildFile("Take " + juce::Time::getCurrentTime().formatted("%Y-%m-%d %H-%M-%S"));
+
+    if (!recorder.start(settings))
+    {
+        juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon, "Record",
+                                               "Couldn't start recording in " + settings.folder.getFullPathName());
+        return;
+    }
+
+    lastTake = settings.folder;
+    updateStatus();
+}
+
+void RecorderPanel::chooseFolderClicked()
+{
+    folderChooser = std::make_unique<juce::FileChooser>("Recordings Folder", recordingsFolder);
+    const auto flags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectDirectories;
+
+    folderChooser->launchAsync(flags, [this](const juce::FileChooser& fc)
+    {
+        auto folder = fc.getResult();
+        if (folder == juce::File{})
+            return;
+
+        recordingsFolder = folder;
+        folderLabel.setText(recordingsFolder.getFullPathName(), juce::dontSendNotification);
+    });
+}
+
+void RecorderPanel::openTakeClicked()
+{
+    folderChooser = std::make_unique<juce::FileChooser>("Open Take", lastTake == juce::File{} ? recordingsFolder : lastTake);
+    const auto flags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectDirectories;
+
+    folderChooser->launchAsync(flags, [this](const juce::FileChooser& fc)
+    {
+        auto folder = fc.getResult();
+        if (folder == juce::File{})
+            return;
+
+        if (!player.open(folder))
+            juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon, "Open Take",
+                                                   "No recorded channels found in " + folder.getFullPathName());
+        updatePlaybackStatus();
+    });
+}
+
+void RecorderPanel::playClicked()
+{
+    if (player.isPlaying())
+        player.stop();
+    else if (!player.play())
+        juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon, "Play",
+                                               "The take can't play: open one first, and run the device at the rate it was recorded at.");
+
+    updatePlaybackStatus();
+}
+
+void RecorderPanel::updatePlaybackStatus()
+{
+    const bool playing = player.isPlaying();
+    playButton.setButtonText(playing ? "Stop" : "Play");
+    playButton.setEnabled(player.isOpen());
+    rewindButton.setEnabled(player.isOpen());
+
+    if (!player.isOpen())
+    {
+        playbackLabel.setText("No take open - channels play their live inputs", juce::dontSendNotification);
+        return;
+    }
+
+    const auto formatTime = [](double seconds)
+    {
+        const auto whole = static_cast<int>(seconds);
+        return juce::String(whole / 60) + ":" + juce::String(whole % 60).paddedLeft('0', 2);
+    };
+
+    auto status = juce::String(playing ? "Playing " : "Stopped in ") + player.getFolder().getFileName() + ": "
+                  + formatTime(player.getPosition()) + " / " + formatTime(player.getLengthSeconds());
+
+    if (const auto underruns = player.getNumUnderruns(); underruns > 0)
+        status << ", " << juce::String(underruns) << " disk underruns";
+
+    playbackLabel.setText(status, juce::dontSendNotification);
+}
+
+void RecorderPanel::updateStatus()
+{
+    const bool recording = recorder.isRecording();
+    recordButton.setButtonText(recording ? "Stop" : "Record");
+    recordButton.setToggleState(recording, juce::dontSendNotification);
+    chooseFolderButton.setEnabled(!recording);
+
+    if (lastTake == juce::File{})
+    {
+        statusLabel.setText("Not recording", juce::dontSendNotification);
+        return;
+    }
+
+    const auto seconds = juce::roundToInt(recorder.getRecordedSeconds());
+    auto status = juce::String(recording ? "Recording " : "Last take ") + lastTake.getFileName() + ": "
+                  + juce::String(seconds / 60) + ":" + juce::String(seconds % 60).paddedLeft('0', 2);
+
+    const auto droppedBlocks = recorder.getNumDroppedBlocks();
+    if (droppedBlocks > 0)
+        status << ", " << juce::String(droppedBlocks) << " blocks dropped (filled with silence)";
+    if (recorder.hasWriteError())
+        status << ", WRITE FAILED";
+
+    statusLabel.setText(status, juce::dontSendNotification);
+    statusLabel.setColour(juce::Label::textColourId, droppedBlocks > 0 || recorder.hasWriteError() ? juce::Colours::orange
+                                                     : recording                                  ? juce::Colours::red
+                                                                                                  : juce::Colours::lightgrey);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Audio/AudioEngine.h"
+
+/**
+ * RecorderPanel - Record multitrack takes and play them back
+ *
+ * Each take goes to its own timestamped folder under the chosen recordings
+ * folder: one file per channel's raw input plus the master. While a take is
+ * running the panel shows its length and any blocks the disk couldn't keep
+ * up with. Below that, a take can be opened and played into the channels in
+ * place of the live inputs, for a virtual soundcheck.
+ */
+class RecorderPanel : public juce::Component,
+                      private juce::Timer
+{
+public:
+    explicit RecorderPanel(AudioEngine& engine);
+    ~RecorderPanel() override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    void timerCallback() override;   // 4 Hz
+    void recordClicked();
+    void chooseFolderClicked();
+    void openTakeClicked();
+    void playClicked();
+    void updateStatus();
+    void updatePlaybackStatus();
+
+    MultitrackRecorder& recorder;
+    MultitrackPlayer& player;
+
+    juce::File recordingsFolder;
+    juce::File lastTake;
+
+    juce::Label folderLabel;
+    juce::TextButton chooseFolderButton { "Choose Folder..." };
+    juce::TextButton recordButton { "Record" };
+    juce::Label statusLabel;
+
+    juce::TextButton openTakeButton { "Open Take..." };
+    juce::TextButton playButton { "Play" };
+    juce::TextButton rewindButton { "Rewind" };
+    juce::ToggleButton loopToggle { "Loop" };
+    juce::Label playbackLabel;
+    std::unique_ptr<juce::FileChooser> folderChooser;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RecorderPanel)
+};
@@ -205,6 +205,7 @@ void RoutingComponent::connectToAudioEngine(AudioEngine* engine)
         }
 
         soundcheckPanel->setChannelProcessors(processors);
+        SoundcheckEngine::getInstance().setSceneDeltaQueue(&audioEngine->getSceneDeltaQueue());
 
         routingMatrix->setRoutingManager(&audioEngine->getRoutingManager());
         routingMatrix->refreshMatrix();
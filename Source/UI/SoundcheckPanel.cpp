@@ -26,6 +26,22 @@ SoundcheckPanel::SoundcheckPanel()
     revertButton.onClick = [this]() { revertButtonClicked(); };
     revertButton.setEnabled(false);
     
+    // Store the selected channel's measurement as a reference profile
+    addAndMakeVisible(saveProfileButton);
+    saveProfileButton.onClick = [this]() { saveProfileButtonClicked(); };
+    saveProfileButton.setEnabled(false);
+    
+    addAndMakeVisible(allChannelsToggle);
+    allChannelsToggle.setToggleState(true, juce::dontSendNotification);
+    allChannelsToggle.setColour(juce::ToggleButton::textColourId, juce::Colours::white);
+    
+    // Channel shown in the live spectrum when the whole band is captured
+    addAndMakeVisible(spectrumChannelBox);
+    for (int i = 0; i < totalChannels; ++i)
+        spectrumChannelBox.addItem("Channel " + juce::String(i + 1), i + 1);
+    spectrumChannelBox.setSelectedId(1, juce::dontSendNotification);
+    spectrumChannelBox.onChange = [this]() { repaint(spectrumArea); };
+    
     // Configure labels with better fonts and colors
     auto titleFont = blackwayLookAndFeel.getRobotoFont().withHeight(24.0f).boldened();
     auto labelFont = blackwayLookAndFeel.getRobotoFont().withHeight(16.0f);
@@ -59,8 +75,8 @@ SoundcheckPanel::SoundcheckPanel()
     resultsTable.setMultipleSelectionEnabled(false);
     
     // Set up columns with proportional widths
-    columnNames = {"Channel", "Trim (dB)", "Gate Thresh", "EQ Low", "EQ LowMid", "EQ HighMid", "EQ High", "Comp Ratio"};
-    columnWidths = {140, 80, 90, 80, 90, 90, 80, 90};
+    columnNames = {"Channel", "Trim (dB)", "Gate Thresh", "EQ Low", "EQ LowMid", "EQ HighMid", "EQ High", "EQ Fit", "Comp Ratio"};
+    columnWidths = {140, 80, 90, 80, 90, 90, 80, 80, 90};
     
     auto& header = resultsTable.getHeader();
     header.setStretchToFitActive(true);
@@ -105,6 +121,10 @@ void SoundcheckPanel::paint(juce::Graphics& g)
     g.setColour(juce::Colours::white.withAlpha(0.1f));
     g.drawRoundedRectangle(bounds.reduced(1.0f), 12.0f, 2.0f);
     
+    // Live spectrum while analysing
+    if (currentMode == DisplayMode::Analyzing)
+        drawLiveSpectrum(g);
+    
     // Draw subtle grid lines in results mode
     if (currentMode == DisplayMode::Results)
     {
@@ -149,10 +169,21 @@ void SoundcheckPanel::resized()
         
         // Status label with more space
         statusLabel.setBounds(bounds.removeFromTop(40));
-        bounds.removeFromTop(20);
+        bounds.removeFromTop(10);
+        
+        // Capture mode
+        allChannelsToggle.setBounds(bounds.removeFromTop(24).withSizeKeepingCentre(200, 24));
+        bounds.removeFromTop(10);
         
         // Buttons at the bottom with better sizing
         auto buttonArea = bounds.removeFromBottom(40);
+        bounds.removeFromBottom(20);
+        
+        // Live spectrum fills the space in between
+        spectrumChannelBox.setBounds(bounds.removeFromTop(24).removeFromRight(160));
+        bounds.removeFromTop(6);
+        spectrumArea = bounds;
+        
         auto buttonWidth = (buttonArea.getWidth() - 20) / 2;
         startButton.setBounds(buttonArea.removeFromLeft(buttonWidth));
         buttonArea.removeFromLeft(20); // Gap between buttons
@@ -170,10 +201,12 @@ void SoundcheckPanel::resized()
         
         // Buttons at the bottom
         auto buttonArea = bounds.removeFromBottom(40);
-        auto buttonWidth = (buttonArea.getWidth() - 20) / 2;
+        auto buttonWidth = (buttonArea.getWidth() - 40) / 3;
         applyButton.setBounds(buttonArea.removeFromLeft(buttonWidth));
         buttonArea.removeFromLeft(20); // Gap between buttons
-        revertButton.setBounds(buttonArea);
+        revertButton.setBounds(buttonArea.removeFromLeft(buttonWidth));
+        buttonArea.removeFromLeft(20);
+        saveProfileButton.setBounds(buttonArea);
     }
 }
 
@@ -184,10 +217,13 @@ void SoundcheckPanel::updateUIForMode()
     progressBar.setVisible(currentMode == DisplayMode::Analyzing);
     startButton.setVisible(currentMode == DisplayMode::Analyzing);
     stopButton.setVisible(currentMode == DisplayMode::Analyzing);
+    allChannelsToggle.setVisible(currentMode == DisplayMode::Analyzing);
+    spectrumChannelBox.setVisible(currentMode == DisplayMode::Analyzing);
     
     resultsTable.setVisible(currentMode == DisplayMode::Results);
     applyButton.setVisible(currentMode == DisplayMode::Results);
     revertButton.setVisible(currentMode == DisplayMode::Results);
+    saveProfileButton.setVisible(currentMode == DisplayMode::Results);
     
     // Trigger a resize to update layout
     resized();
@@ -313,7 +349,14 @@ void SoundcheckPanel::paintCell(juce::Graphics& g, int rowNumber, int columnId,
             cellColor = getCorrectionColor(std::abs(analysis.eqGainSuggestions[3]));
             break;
             
-        case 8: // Compressor ratio
+        case 8: // Error left after the EQ suggestion
+            text = juce::String(analysis.eqFitResidualDb, 1) + " dB";
+            cellColor = analysis.eqFitResidualDb < 1.5f ? juce::Colours::lightgreen
+                      : analysis.eqFitResidualDb < 3.0f ? juce::Colours::yellow
+                                                        : juce::Colours::orange;
+            break;
+            
+        case 9: // Compressor ratio
             text = juce::String(analysis.compressorRatioSuggestion, 1) + ":1";
             cellColor = analysis.compressorRatioSuggestion > 1.0f ? juce::Colours::orange : juce::Colours::lightgreen;
             break;
@@ -370,29 +413,24 @@ void SoundcheckPanel::timerCallback()
     }
     
     // If we're showing and not doing animation, update soundcheck progress
-    if (isShowing && currentAlpha == targetAlpha && soundcheckEngine.isRunning())
+    if (isShowing && currentAlpha == targetAlpha && checkInProgress)
     {
-        // Get the current channel being analyzed from the engine
-        int currentChannelIndex = 0;
-        for (int i = 0; i < totalChannels; ++i) {
-            if (soundcheckEngine.getAnalysis(i).avgRMS > 0.0f) {
-                currentChannelIndex = i;
-            }
-        }
-        
-        // Update progress based on current channel being analyzed
-        currentChannel = currentChannelIndex;
-        
-        // Update progress
-        progress = static_cast<double>(currentChannel) / static_cast<double>(totalChannels);
+        // Progress comes straight from the engine
+        currentChannel = soundcheckEngine.getCurrentChannel();
+        progress = soundcheckEngine.getProgress();
         
         // Update UI
-        channelLabel.setText("Analyzing Channel: " + juce::String(currentChannel + 1), 
-                            juce::dontSendNotification);
+        if (soundcheckEngine.getMode() == SoundcheckEngine::Mode::AllChannels)
+            channelLabel.setText("Analyzing All Channels", juce::dontSendNotification);
+        else
+            channelLabel.setText("Analyzing Channel: " + juce::String(currentChannel + 1), 
+                                juce::dontSendNotification);
         
         // Check if soundcheck has finished
-        if (!soundcheckEngine.isRunning() && currentChannel >= totalChannels - 1)
+        if (!soundcheckEngine.isRunning() && soundcheckEngine.isFinished())
         {
+            checkInProgress = false;
+            
             // Update UI
             statusLabel.setText("Soundcheck complete! Review the suggested settings below:", 
                                juce::dontSendNotification);
@@ -405,23 +443,71 @@ void SoundcheckPanel::timerCallback()
             // Enable results buttons
             applyButton.setEnabled(true);
             revertButton.setEnabled(true);
+            saveProfileButton.setEnabled(true);
             
             // Refresh the table
             resultsTable.updateContent();
         }
         
         progressBar.repaint();
+        repaint(spectrumArea);
+    }
+}
+
+void SoundcheckPanel::drawLiveSpectrum(juce::Graphics& g)
+{
+    if (spectrumArea.isEmpty())
+        return;
+    
+    auto area = spectrumArea.toFloat();
+    
+    // Background
+    g.setColour(juce::Colours::black.withAlpha(0.3f));
+    g.fillRoundedRectangle(area, 6.0f);
+    area = area.reduced(8.0f);
+    
+    // Sequential checks follow the channel being measured; whole-band checks show the selected one
+    const int channel = soundcheckEngine.getMode() == SoundcheckEngine::Mode::AllChannels
+                            ? spectrumChannelBox.getSelectedId() - 1
+                            : currentChannel;
+    soundcheckEngine.getLiveMagnitudes(channel, liveMagnitudes);
+    
+    // Reference lines every 12 dB between -60 and 0 dB
+    g.setColour(juce::Colours::white.withAlpha(0.08f));
+    for (float db = -48.0f; db < 0.0f; db += 12.0f)
+    {
+        const float y = juce::jmap(db, -60.0f, 0.0f, area.getBottom(), area.getY());
+        g.drawHorizontalLine(juce::roundToInt(y), area.getX(), area.getRight());
+    }
+    
+    // One bar per 1/3-octave band
+    const int numBars = liveMagnitudes.size();
+    if (numBars == 0)
+        return;
+    
+    const float barWidth = area.getWidth() / numBars;
+    g.setColour(juce::Colour(0xff2a9c3a));
+    
+    for (int band = 0; band < numBars; ++band)
+    {
+        const float level = juce::jlimit(-60.0f, 0.0f, liveMagnitudes[band]);
+        const float top = juce::jmap(level, -60.0f, 0.0f, area.getBottom(), area.getY());
+        g.fillRect(juce::Rectangle<float>(area.getX() + band * barWidth + 1.0f, top,
+                                          barWidth - 2.0f, area.getBottom() - top));
     }
 }
 
 void SoundcheckPanel::startButtonClicked()
 {
-    // Start the soundcheck
-    soundcheckEngine.startCheck(5);  // 5 seconds per channel
+    // Start the soundcheck - 5 seconds per channel, or 5 seconds for the whole band
+    const bool allChannels = allChannelsToggle.getToggleState();
+    soundcheckEngine.startCheck(5, allChannels ? SoundcheckEngine::Mode::AllChannels
+                                               : SoundcheckEngine::Mode::Sequential);
+    checkInProgress = true;
     
     // Update UI
     statusLabel.setText("Soundcheck in progress...", juce::dontSendNotification);
-    channelLabel.setText("Analyzing Channel: 1", juce::dontSendNotification);
+    channelLabel.setText(allChannels ? "Analyzing All Channels" : "Analyzing Channel: 1", juce::dontSendNotification);
     progress = 0.0;
     
     // Update button state
@@ -436,6 +522,7 @@ void SoundcheckPanel::stopButtonClicked()
 {
     // Stop the soundcheck
     soundcheckEngine.stopCheck();
+    checkInProgress = false;
     
     // Update UI
     statusLabel.setText("Soundcheck canceled", juce::dontSendNotification);
@@ -447,8 +534,8 @@ void SoundcheckPanel::stopButtonClicked()
 
 void SoundcheckPanel::applyButtonClicked()
 {
-    // Apply the corrections
-    soundcheckEngine.applyCorrections();
+    // Apply the corrections, fading so the mix doesn't jump mid-song
+    soundcheckEngine.applyCorrections(correctionFadeSeconds);
     
     // Update UI
     statusLabel.setText("Corrections applied to all channels", juce::dontSendNotification);
@@ -456,12 +543,13 @@ void SoundcheckPanel::applyButtonClicked()
     // Update button state
     applyButton.setEnabled(false);
     revertButton.setEnabled(true);
+    saveProfileButton.setEnabled(false); // The measurement is no longer current
 }
 
 void SoundcheckPanel::revertButtonClicked()
 {
     // Revert the corrections
-    soundcheckEngine.revertCorrections();
+    soundcheckEngine.revertCorrections(correctionFadeSeconds);
     
     // Update UI
     statusLabel.setText("Reverted to original settings", juce::dontSendNotification);
@@ -471,6 +559,40 @@ void SoundcheckPanel::revertButtonClicked()
     revertButton.setEnabled(false);
 }
 
+void SoundcheckPanel::saveProfileButtonClicked()
+{
+    const int channel = resultsTable.getSelectedRow();
+    if (channel < 0)
+    {
+        statusLabel.setText("Select a channel in the table to save its profile", juce::dontSendNotification);
+        return;
+    }
+    
+    auto* dialog = new juce::AlertWindow("Save Tone Profile",
+                                         "Save channel " + juce::String(channel + 1) + " as a reference profile:",
+                                         juce::AlertWindow::NoIcon);
+    dialog->addTextEditor("name", soundcheckEngine.getAnalysis(channel).matchedProfile, "Name:");
+    dialog->addTextEditor("tags", "", "Tags (comma separated):");
+    dialog->addButton("Save", 1, juce::KeyPress(juce::KeyPress::returnKey));
+    dialog->addButton("Cancel", 0, juce::KeyPress(juce::KeyPress::escapeKey));
+    
+    dialog->enterModalState(true, juce::ModalCallbackFunction::create(
+        [this, dialog, channel](int result) {
+            if (result == 1)
+            {
+                const auto name = dialog->getTextEditorContents("name");
+                juce::StringArray tags;
+                tags.addTokens(dialog->getTextEditorContents("tags"), ",", {});
+                
+                if (soundcheckEngine.saveChannelAsProfile(channel, name, tags))
+                    statusLabel.setText("Saved profile \"" + name.trim() + "\"", juce::dontSendNotification);
+                else
+                    statusLabel.setText("Could not save the profile", juce::dontSendNotification);
+            }
+            delete dialog;
+        }));
+}
+
 void SoundcheckPanel::setChannelProcessors(const std::vector<ChannelProcessor*>& processors)
 {
     // Store processors locally
@@ -481,4 +603,9 @@ void SoundcheckPanel::setChannelProcessors(const std::vector<ChannelProcessor*>&
     
     // Update total channels count
     totalChannels = static_cast<int>(processors.size());
+    
+    spectrumChannelBox.clear(juce::dontSendNotification);
+    for (int i = 0; i < totalChannels; ++i)
+        spectrumChannelBox.addItem("Channel " + juce::String(i + 1), i + 1);
+    spectrumChannelBox.setSelectedId(1, juce::dontSendNotification);
 } 
\ No newline at end of file
@@ -41,6 +41,16 @@ private:
     juce::TextButton stopButton { "Stop" };
     juce::TextButton applyButton { "Apply Changes" };
     juce::TextButton revertButton { "Revert Changes" };
+    juce::TextButton saveProfileButton { "Save as Profile" };
+    
+    // Capture every routed input at once instead of one channel at a time
+    juce::ToggleButton allChannelsToggle { "Whole band at once" };
+    
+    // Live spectrum while the check runs
+    juce::ComboBox spectrumChannelBox;
+    juce::Rectangle<int> spectrumArea;
+    juce::Array<float> liveMagnitudes;
+    void drawLiveSpectrum(juce::Graphics& g);
     
     // Progress indicator
     juce::ProgressBar progressBar { progress };
@@ -62,11 +72,15 @@ private:
     // Callback for timer
     void timerCallback() override;
     
+    // Corrections glide in rather than switching
+    static constexpr double correctionFadeSeconds = 1.0;
+    
     // Button click callbacks
     void startButtonClicked();
     void stopButtonClicked();
     void applyButtonClicked();
     void revertButtonClicked();
+    void saveProfileButtonClicked();
     
     // References to the SoundcheckEngine
     SoundcheckEngine& soundcheckEngine;
@@ -75,6 +89,7 @@ private:
     std::vector<ChannelProcessor*> channelProcessors;
     
     // Current analysis state
+    bool checkInProgress { false };
     int currentChannel { 0 };
     int totalChannels { 32 };
     
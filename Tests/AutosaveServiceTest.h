@@ -0,0 +1,115 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Source/Audio/AudioEngine.h"
+#include "../Source/State/AutosaveService.h"
+
+/**
+ * Autosave of a headless engine into a scratch folder, ticked by hand: the
+ * journal replays on top of its generation's snapshot, a torn last record
+ * is dropped without losing the ones before it, and stop() leaves a full
+ * snapshot and a clean-shutdown marker behind.
+ */
+class AutosaveServiceTest : public juce::UnitTest
+{
+public:
+    AutosaveServiceTest() : juce::UnitTest("Autosave service", "State") {}
+
+    void runTest() override
+    {
+        AudioEngine engine(false);
+        auto& autosave = auralis::AutosaveService::getInstance();
+
+        const auto userDirectory = autosave.getDirectory();
+        const auto folder = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                .getNonexistentChildFile("AuralisAutosaveTest", {}, false);
+        autosave.setDirectory(folder);
+
+        // The writer thread does the disk work; give it a few seconds at most
+        const auto waitFor = [](const std::function<bool()>& condition)
+        {
+            for (int i = 0; i < 500 && !condition(); ++i)
+                juce::Thread::sleep(10);
+            return condition();
+        };
+
+        const auto filesMatching = [&](const juce::String& pattern)
+        {
+            return folder.findChildFiles(juce::File::findFiles, false, pattern);
+        };
+
+        auto* first = engine.getChannelProcessor(0);
+        auto* second = engine.getChannelProcessor(1);
+        const float secondBefore = second->getTrimGain();
+
+        juce::File journal;
+        juce::int64 firstRecordEnd = 0;
+
+        beginTest("The journal replays on top of its snapshot");
+        {
+            autosave.start(engine);
+            expect(!autosave.wasShutDownCleanly(), "Running leaves the marker down");
+
+            autosave.tick();
+            expect(waitFor([&] { return filesMatching("*.aur").size() == 1; }), "The first tick writes a full snapshot");
+
+            first->setTrimGain(3.0f);
+            autosave.tick();
+            expect(waitFor([&] { return filesMatching("*.journal").size() == 1; }), "A change is journaled");
+            journal = filesMatching("*.journal").getFirst();
+            firstRecordEnd = journal.getSize();
+
+            second->setTrimGain(-4.0f);
+            autosave.tick();
+            expect(waitFor([&] { return journal.getSize() > firstRecordEnd; }), "The next change is appended");
+
+            expectEquals(filesMatching("*.aur").size(), 1, "Changes don't start a new generation");
+
+            auralis::SessionSnapshot recovered;
+            expect(autosave.recoverLatest(recovered));
+            expectEquals(recovered.channels[0].trimGainDb, first->getTrimGain());
+            expectEquals(recovered.channels[1].trimGainDb, second->getTrimGain());
+        }
+
+        beginTest("A torn last record is dropped and the ones before it still replay");
+        {
+            {
+                juce::FileOutputStream out(journal);
+                expect(out.openedOk());
+                out.setPosition(journal.getSize() - 5);
+                out.truncate();
+            }
+
+            auralis::SessionSnapshot torn;
+            expect(autosave.recoverLatest(torn));
+            expectEquals(torn.channels[0].trimGainDb, first->getTrimGain(), "The whole record before it replays");
+            expectEquals(torn.channels[1].trimGainDb, secondBefore, "The torn one is left out");
+
+            // The same with only part of its header left
+            {
+                juce::FileOutputStream out(journal);
+                out.setPosition(firstRecordEnd + 8);
+                out.truncate();
+            }
+
+            auralis::SessionSnapshot cut;
+            expect(autosave.recoverLatest(cut));
+            expectEquals(cut.channels[0].trimGainDb, first->getTrimGain());
+            expectEquals(cut.channels[1].trimGainDb, secondBefore);
+        }
+
+        beginTest("stop() leaves a full snapshot and a clean shutdown");
+        {
+            autosave.stop();
+            expect(autosave.wasShutDownCleanly());
+            expectEquals(filesMatching("*.aur").size(), 2, "A new generation for the final state");
+
+            auralis::SessionSnapshot recovered;
+            expect(autosave.recoverLatest(recovered));
+            expectEquals(recovered.channels[1].trimGainDb, second->getTrimGain());
+        }
+
+        autosave.setDirectory(userDirectory);
+        folder.deleteRecursively();
+    }
+};
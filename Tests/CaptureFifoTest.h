@@ -0,0 +1,117 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Source/Soundcheck/CaptureFifo.h"
+
+/**
+ * The soundcheck capture FIFO driven from one thread, playing both sides:
+ * a reader asking for a new epoch skips whatever was captured for older
+ * ones, and a block that wraps round the end of the ring comes back whole
+ * and in order.
+ */
+class CaptureFifoTest : public juce::UnitTest
+{
+public:
+    CaptureFifoTest() : juce::UnitTest("Capture FIFO", "DSP") {}
+
+    void runTest() override
+    {
+        const int capacity = 1000;
+
+        CaptureFifo fifo;
+        fifo.prepare(2, capacity);
+
+        // One block on both channels: a ramp from firstValue, negated on the right
+        const auto write = [&](juce::uint32 epoch, int mixerChannel, int numSamples, float firstValue)
+        {
+            std::vector<float> left((size_t) numSamples), right((size_t) numSamples);
+            for (int i = 0; i < numSamples; ++i)
+            {
+                left[(size_t) i] = firstValue + (float) i;
+                right[(size_t) i] = -left[(size_t) i];
+            }
+
+            const auto region = fifo.prepareToWrite(numSamples);
+            fifo.writeChannel(0, region, left.data());
+            fifo.writeChannel(1, region, right.data());
+            fifo.finishedWrite(region, epoch, mixerChannel);
+            return region;
+        };
+
+        // A read region on one channel, both halves in order
+        const auto readChannel = [&](const CaptureFifo::Region& region, int channel)
+        {
+            std::vector<float> samples;
+            for (int i = 0; i < region.size1; ++i)
+                samples.push_back(fifo.getReadPointer(channel, region.start1)[i]);
+            for (int i = 0; i < region.size2; ++i)
+                samples.push_back(fifo.getReadPointer(channel, region.start2)[i]);
+            return samples;
+        };
+
+        // Whether samples is one unbroken ramp starting at firstValue
+        const auto isRamp = [](const std::vector<float>& samples, float firstValue, float direction)
+        {
+            for (size_t i = 0; i < samples.size(); ++i)
+                if (samples[i] != direction * (firstValue + (float) i))
+                    return false;
+            return true;
+        };
+
+        beginTest("Blocks captured for an older epoch are skipped");
+        {
+            write(1, 3, 200, 0.0f);
+            write(1, 3, 100, 200.0f);
+            write(2, 5, 150, 1000.0f);
+            write(2, 5, 50, 1150.0f);
+
+            int mixerChannel = -1;
+            const auto region = fifo.prepareToRead(2, mixerChannel);
+            expectEquals(region.getTotal(), 200, "Only the new epoch's samples");
+            expectEquals(mixerChannel, 5);
+            expect(isRamp(readChannel(region, 0), 1000.0f, 1.0f));
+            expect(isRamp(readChannel(region, 1), 1000.0f, -1.0f));
+            fifo.finishedRead(region);
+
+            // The stale samples were released along with their records
+            int unused = -1;
+            expectEquals(fifo.prepareToRead(1, unused).getTotal(), 0, "Nothing left for the old epoch");
+            expectEquals(fifo.prepareToRead(2, unused).getTotal(), 0, "Nothing read twice");
+        }
+
+        beginTest("A block split across the end of the ring reads back whole");
+        {
+            // The last test left both ends 500 samples in, so 700 more wrap round
+            const auto written = write(3, 7, 700, 5000.0f);
+            expectEquals(written.getTotal(), 700);
+            expectGreaterThan(written.size2, 0, "The write wrapped");
+
+            int mixerChannel = -1;
+            const auto region = fifo.prepareToRead(3, mixerChannel);
+            expectEquals(region.getTotal(), 700);
+            expectEquals(mixerChannel, 7);
+            expectEquals(region.size1, capacity - written.start1, "The read wraps where the write did");
+            expect(isRamp(readChannel(region, 0), 5000.0f, 1.0f));
+            expect(isRamp(readChannel(region, 1), 5000.0f, -1.0f));
+            fifo.finishedRead(region);
+        }
+
+        beginTest("A full ring refuses more than it has room for");
+        {
+            fifo.reset();
+
+            const auto first = write(4, 0, capacity - 100, 0.0f);
+            expectEquals(first.getTotal(), capacity - 100);
+
+            // AbstractFifo keeps one slot free, so 99 more fit, not 100
+            const auto second = write(4, 0, 200, (float) (capacity - 100));
+            expectEquals(second.getTotal(), 99);
+
+            int mixerChannel = -1;
+            const auto region = fifo.prepareToRead(4, mixerChannel);
+            expectEquals(region.getTotal(), capacity - 1);
+            expect(isRamp(readChannel(region, 0), 0.0f, 1.0f), "The short write kept the start of its block");
+            fifo.finishedRead(region);
+        }
+    }
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Source/Soundcheck/ChannelClassifier.h"
+
+/**
+ * The classifier's nearest-neighbour index against a brute-force scan over
+ * the same rows: results come back nearest first with true distances, the
+ * index keeps its rows when it grows, and every built-in tone profile is
+ * its own nearest match and classifies as its own channel type.
+ */
+class ChannelClassifierTest : public juce::UnitTest
+{
+public:
+    ChannelClassifierTest() : juce::UnitTest("Channel classifier", "DSP") {}
+
+    void runTest() override
+    {
+        using ChannelType = ChannelProcessor::ChannelType;
+
+        const auto distanceBetween = [](const ChannelFeatures& a, const ChannelFeatures& b)
+        {
+            double sum = 0.0;
+            for (int i = 0; i < ChannelFeatures::paddedSize; ++i)
+            {
+                const double difference = a.values[(size_t) i] - b.values[(size_t) i];
+                sum += difference * difference;
+            }
+            return static_cast<float>(std::sqrt(sum));
+        };
+
+        beginTest("Nearest rows match a brute-force scan");
+        {
+            auto random = getRandom();
+            const auto randomFeatures = [&]
+            {
+                ChannelFeatures features;
+                for (int i = 0; i < ChannelFeatures::size; ++i)
+                    features.values[(size_t) i] = random.nextFloat() * 4.0f - 2.0f;
+                return features;
+            };
+
+            // More rows than the first reservation, so the index has to grow
+            ChannelClassifier classifier;
+            classifier.clear();
+
+            std::vector<ChannelFeatures> references;
+            for (int i = 0; i < 50; ++i)
+            {
+                references.push_back(randomFeatures());
+                expectEquals(classifier.addProfile(references.back(), ChannelType::Other, "Row " + juce::String(i)), i);
+            }
+
+            expectEquals(classifier.getNumProfiles(), 50);
+
+            for (int trial = 0; trial < 20; ++trial)
+            {
+                const auto query = randomFeatures();
+
+                std::vector<std::pair<float, int>> expected;
+                for (int i = 0; i < (int) references.size(); ++i)
+                    expected.emplace_back(distanceBetween(query, references[(size_t) i]), i);
+                std::sort(expected.begin(), expected.end());
+
+                ChannelClassifier::Match matches[5];
+                expectEquals(classifier.findNearest(query, matches, 5), 5);
+
+                for (int i = 0; i < 5; ++i)
+                {
+                    expectEquals(matches[i].profileIndex, expected[(size_t) i].second);
+                    expectWithinAbsoluteError(matches[i].distance, expected[(size_t) i].first, 1.0e-3f);
+                }
+            }
+
+            // A row's own features are at distance zero, and asking for more than there are returns them all
+            ChannelClassifier::Match all[64];
+            expectEquals(classifier.findNearest(references[17], all, 64), 50);
+            expectEquals(all[0].profileIndex, 17);
+            expectWithinAbsoluteError(all[0].distance, 0.0f, 1.0e-3f);
+
+            for (int i = 1; i < 50; ++i)
+                expectLessOrEqual(all[i - 1].distance, all[i].distance);
+        }
+
+        beginTest("Built-in profiles classify as their own channel type");
+        {
+            ChannelClassifier classifier;
+
+            for (int i = 0; i < classifier.getNumProfiles(); ++i)
+            {
+                const auto* profile = classifier.getReferenceProfile(i);
+                expect(profile != nullptr, "Built-in rows keep their tone profile");
+
+                if (profile == nullptr)
+                    continue;
+
+                ChannelClassifier::Match best;
+                const auto type = classifier.classify(ChannelFeatures::fromProfile(*profile), &best);
+                expectEquals(best.profileIndex, i, classifier.getProfileName(i));
+                expect(type == classifier.getProfileType(i), classifier.getProfileName(i));
+            }
+        }
+
+        beginTest("An empty index classifies as Other");
+        {
+            ChannelClassifier classifier;
+            classifier.clear();
+
+            ChannelClassifier::Match matches[3];
+            expectEquals(classifier.findNearest(ChannelFeatures {}, matches, 3), 0);
+            expect(classifier.classify(ChannelFeatures {}) == ChannelType::Other);
+        }
+    }
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DSPTestHelpers.h"
+#include "../Source/FX/ConvolutionReverbProcessor.h"
+
+/**
+ * A known room IR through the convolution reverb: the wet impulse response
+ * is the IR on both sides of the split between the head convolved in
+ * processBlock() and the tail convolved on the worker thread, and a file
+ * that isn't audio is refused. Blocks are paced a little, since the tail
+ * thread runs in real time, not as fast as the test can call.
+ */
+class ConvolutionReverbTest : public juce::UnitTest
+{
+public:
+    ConvolutionReverbTest() : juce::UnitTest("Convolution reverb", "DSP") {}
+
+    void runTest() override
+    {
+        using namespace DSPTestHelpers;
+
+        const int blockSize = 512;
+        const int irLength = juce::roundToInt(0.75 * sampleRate);
+
+        auto folder = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                          .getNonexistentChildFile("AuralisConvolutionTest", {}, false);
+        expect(folder.createDirectory());
+
+        // Decaying noise that starts and ends well above the trim threshold
+        auto ir = makeNoise(irLength, 0.5f);
+        for (int i = 0; i < irLength; ++i)
+            for (int ch = 0; ch < numChannels; ++ch)
+                ir.setSample(ch, i, ir.getSample(ch, i) * std::exp(-3.0f * static_cast<float>(i / sampleRate)));
+        ir.setSample(0, 0, 0.5f);
+        ir.setSample(1, 0, 0.5f);
+
+        const auto irFile = folder.getChildFile("room.wav");
+        {
+            juce::WavAudioFormat wav;
+            std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(irFile.createOutputStream().release(),
+                                                                                sampleRate, numChannels, 32, {}, 0));
+            expect(writer != nullptr && writer->writeFromAudioSampleBuffer(ir, 0, irLength));
+        }
+
+        ConvolutionReverbProcessor reverb;
+        reverb.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+        reverb.prepareToPlay(sampleRate, blockSize);
+        juce::MidiBuffer midi;
+
+        const auto process = [&](const juce::AudioBuffer<float>& input)
+        {
+            return processInBlocks(input, blockSize, [&](juce::AudioBuffer<float>& block)
+            {
+                reverb.processBlock(block, midi);
+                juce::Thread::sleep(2);
+            });
+        };
+
+        beginTest("A file that isn't audio is refused");
+        {
+            const auto textFile = folder.getChildFile("notes.wav");
+            expect(textFile.replaceWithText("not a room"));
+            expect(!reverb.loadImpulseResponse(textFile));
+            expect(!reverb.hasImpulseResponse(), "Nothing is reported loaded");
+        }
+
+        beginTest("The wet impulse response is the IR across the head/tail split");
+        {
+            expect(reverb.loadImpulseResponse(irFile));
+            expect(reverb.hasImpulseResponse());
+            reverb.setWetLevel(1.0f);
+
+            // Let the head engine build and the wet ramp settle
+            process(makeConstant(100 * blockSize, 0.0f));
+
+            const auto input = makeImpulse(irLength + 4 * blockSize);
+            auto wet = process(input);
+            for (int ch = 0; ch < numChannels; ++ch)
+                wet.addFrom(ch, 0, input, ch, 0, input.getNumSamples(), -1.0f);
+
+            // The reverb normalises the IR: fit that gain on the first partition's worth
+            double cross = 0.0, energy = 0.0;
+            for (int i = 0; i < 2048; ++i)
+            {
+                cross += (double) wet.getSample(0, i) * ir.getSample(0, i);
+                energy += (double) ir.getSample(0, i) * ir.getSample(0, i);
+            }
+            const auto gain = static_cast<float>(cross / energy);
+            expectGreaterThan(gain, 0.0f, "The wet path carries the IR");
+
+            juce::AudioBuffer<float> expected(numChannels, wet.getNumSamples());
+            expected.clear();
+            for (int ch = 0; ch < numChannels; ++ch)
+                expected.addFrom(ch, 0, ir, ch, 0, irLength, gain);
+
+            juce::AudioBuffer<float> wetIR(wet.getArrayOfWritePointers(), numChannels, 0, irLength);
+            juce::AudioBuffer<float> expectedIR(expected.getArrayOfWritePointers(), numChannels, 0, irLength);
+            expectLessThan(nullResidualDb(wetIR, expectedIR), -40.0f, "The whole response, head and tail");
+            expectLessThan(nullResidualDb(wetIR, expectedIR, 8192), -40.0f, "The tail on its own");
+            expectLessThan(rmsDb(wet, 0, irLength + blockSize), -90.0f, "Nothing after the IR ends");
+            expectEquals(reverb.getNumTailUnderruns(), static_cast<juce::int64>(0));
+        }
+
+        reverb.releaseResources();
+        folder.deleteRecursively();
+    }
+};
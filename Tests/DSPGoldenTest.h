@@ -0,0 +1,258 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DSPTestHelpers.h"
+#include "../Source/Audio/ChannelProcessor.h"
+#include "../Source/FX/CompressorProcessor.h"
+#include "../Source/FX/EQProcessor.h"
+#include "../Source/FX/GateProcessor.h"
+#include "../Source/FX/TrimProcessor.h"
+#include "../Source/Audio/TruePeakLimiterProcessor.h"
+
+/**
+ * Impulse and sine responses of the channel and master dynamics, and of a
+ * whole channel strip, against expected outputs. The expectations are
+ * worked out from each processor's transfer function, from an independent
+ * reference filter, or from the strip's stages run on their own, rather
+ * than stored recordings, so they hold at any sample rate and survive a
+ * rewrite of the processing code.
+ */
+class DSPGoldenTest : public juce::UnitTest
+{
+public:
+    DSPGoldenTest() : juce::UnitTest("DSP golden output", "DSP") {}
+
+    void runTest() override
+    {
+        using namespace DSPTestHelpers;
+
+        const int oneSecond = juce::roundToInt(sampleRate);
+        const int settled = oneSecond / 2;   // Envelopes have settled after half a second
+
+        beginTest("EQ: flat is the identity");
+        {
+            auto eq = prepareProcessor<EQProcessor>();
+            const auto input = makeImpulse(4096);
+            const auto output = processInBlocks(input, 512, eq);
+            expectLessThan(nullResidualDb(output, input), -90.0f);
+        }
+
+        beginTest("EQ: impulse response matches four reference biquads");
+        {
+            const std::array<float, 4> gains { 6.0f, -4.0f, 3.0f, -9.0f };
+
+            auto eq = prepareProcessor<EQProcessor>([&](EQProcessor& processor) { processor.setGains(gains); });
+            const auto input = makeImpulse(8192);
+            const auto output = processInBlocks(input, 512, eq);
+
+            using Coefficients = juce::dsp::IIR::Coefficients<float>;
+            const std::array<Coefficients::Ptr, 4> reference {
+                Coefficients::makeLowShelf(sampleRate, EQProcessor::lowShelfFrequency, EQProcessor::midQ, juce::Decibels::decibelsToGain(gains[0])),
+                Coefficients::makePeakFilter(sampleRate, EQProcessor::lowMidFrequency, EQProcessor::midQ, juce::Decibels::decibelsToGain(gains[1])),
+                Coefficients::makePeakFilter(sampleRate, EQProcessor::highMidFrequency, EQProcessor::midQ, juce::Decibels::decibelsToGain(gains[2])),
+                Coefficients::makeHighShelf(sampleRate, EQProcessor::highShelfFrequency, EQProcessor::midQ, juce::Decibels::decibelsToGain(gains[3]))
+            };
+
+            juce::AudioBuffer<float> expected(input);
+            for (int ch = 0; ch < expected.getNumChannels(); ++ch)
+            {
+                for (const auto& coefficients : reference)
+                {
+                    juce::dsp::IIR::Filter<float> filter(coefficients);
+                    filter.reset();
+                    auto* data = expected.getWritePointer(ch);
+                    for (int i = 0; i < expected.getNumSamples(); ++i)
+                        data[i] = filter.processSample(data[i]);
+                }
+            }
+
+            expectLessThan(nullResidualDb(output, expected), -100.0f);
+        }
+
+        beginTest("EQ: peak gain at the band centre");
+        {
+            for (auto gainDb : { 6.0f, -6.0f })
+            {
+                auto eq = prepareProcessor<EQProcessor>([gainDb](EQProcessor& processor) { processor.setGain(EQProcessor::Band::HighMid, gainDb); });
+                const auto input = makeSine(oneSecond, EQProcessor::highMidFrequency, 0.25f);
+                const auto output = processInBlocks(input, 512, eq);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    expectWithinAbsoluteError(rmsDb(output, ch, settled) - rmsDb(input, ch, settled), gainDb, 0.2f);
+            }
+        }
+
+        beginTest("EQ: low shelf gain at DC");
+        {
+            auto eq = prepareProcessor<EQProcessor>([](EQProcessor& processor) { processor.setGain(EQProcessor::Band::LowShelf, 6.0f); });
+            const auto input = makeConstant(oneSecond, 0.1f);
+            const auto output = processInBlocks(input, 512, eq);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                expectWithinAbsoluteError(rmsDb(output, ch, settled) - rmsDb(input, ch, settled), 6.0f, 0.1f);
+        }
+
+        // Defaults: -50 dB threshold, 2:1 downward expansion below it
+        beginTest("Gate: above the threshold passes unchanged");
+        {
+            auto gate = prepareProcessor<GateProcessor>();
+
+            const auto constant = makeConstant(oneSecond, 0.1f);
+            expect(isBitExact(processInBlocks(constant, 512, gate), constant));
+
+            gate = prepareProcessor<GateProcessor>();
+            const auto impulse = makeImpulse(4096, 0.5f);
+            expect(isBitExact(processInBlocks(impulse, 512, gate), impulse));
+
+            // The envelope starts from silence, so the first cycles are expanded
+            gate = prepareProcessor<GateProcessor>();
+            const auto sine = makeSine(oneSecond, 1000.0, 0.1f);
+            expect(isBitExact(processInBlocks(sine, 512, gate), sine, settled));
+        }
+
+        beginTest("Gate: expands by the ratio below the threshold");
+        {
+            // -60 dB is 10 dB under: 2:1 takes another 5 dB off
+            auto gate = prepareProcessor<GateProcessor>();
+            const auto output = processInBlocks(makeConstant(oneSecond, 0.001f), 512, gate);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                expectWithinAbsoluteError(rmsDb(output, ch, settled), -65.0f, 0.1f);
+        }
+
+        auto makeCompressor = [](bool autoMakeup)
+        {
+            return prepareProcessor<CompressorProcessor>([autoMakeup](CompressorProcessor& comp)
+            {
+                comp.setThreshold(-18.0f);
+                comp.setRatio(4.0f);
+                comp.setMakeupGainAuto(autoMakeup);
+                if (!autoMakeup)
+                    comp.setMakeupGain(0.0f);
+            });
+        };
+
+        beginTest("Compressor: static curve above the threshold");
+        {
+            // -6 dB in is 12 dB over a -18 dB threshold: 4:1 leaves 3 dB over
+            const auto output = processInBlocks(makeConstant(oneSecond, 0.5f), 512, makeCompressor(false));
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                expectWithinAbsoluteError(rmsDb(output, ch, settled), -15.0f, 0.1f);
+        }
+
+        beginTest("Compressor: below the threshold passes unchanged");
+        {
+            const auto constant = makeConstant(oneSecond, 0.05f);
+            expect(isBitExact(processInBlocks(constant, 512, makeCompressor(false)), constant));
+
+            // An impulse is gone before the peak detector gets there
+            const auto impulse = makeImpulse(4096, 0.5f);
+            expect(isBitExact(processInBlocks(impulse, 512, makeCompressor(false)), impulse));
+        }
+
+        beginTest("Compressor: auto makeup cancels the reduction at full scale");
+        {
+            // Makeup is 18 * (1 - 1/4) = 13.5 dB on top of -15 dB
+            const auto output = processInBlocks(makeConstant(oneSecond, 0.5f), 512, makeCompressor(true));
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                expectWithinAbsoluteError(rmsDb(output, ch, settled), -1.5f, 0.1f);
+        }
+
+        // A strip with its tuner off, as the channel's constructor sets it up
+        auto makeChannel = [](const std::array<float, 4>& eqGains)
+        {
+            auto channel = std::make_shared<ChannelProcessor>(0, ChannelProcessor::ChannelType::Vocal);
+            channel->prepareToPlay(sampleRate, 512);
+            channel->setTrimGain(-3.0f);
+            channel->setEQGains(eqGains);
+            channel->setTunerEnabled(false);
+
+            auto midi = std::make_shared<juce::MidiBuffer>();
+            return ProcessFunction([channel, midi](juce::AudioBuffer<float>& buffer) { channel->processBlock(buffer, *midi); });
+        };
+
+        beginTest("ChannelProcessor: trim, gate, EQ and compressor in series");
+        {
+            const std::array<float, 4> eqGains { 3.0f, -2.0f, 2.5f, -1.5f };
+            const auto input = makeNoise(oneSecond, 0.5f);
+            const auto output = processInBlocks(input, 512, makeChannel(eqGains));
+
+            // The same four stages on their own, set up as the strip sets them up
+            auto trim = prepareProcessor<TrimProcessor>([](TrimProcessor& processor) { processor.setGainLinear(juce::Decibels::decibelsToGain(-3.0f)); }, 512);
+            auto gate = prepareProcessor<GateProcessor>([](GateProcessor& processor)
+            {
+                processor.setThreshold(-50.0f);
+                processor.setRatio(2.0f);
+                processor.setAttack(5.0f);
+                processor.setRelease(50.0f);
+            }, 512);
+            auto eq = prepareProcessor<EQProcessor>([&](EQProcessor& processor) { processor.setGains(eqGains); }, 512);
+            auto comp = prepareProcessor<CompressorProcessor>([](CompressorProcessor& processor)
+            {
+                processor.setThreshold(-18.0f);
+                processor.setRatio(3.0f);
+                processor.setAttack(10.0f);
+                processor.setRelease(150.0f);
+                processor.setMakeupGainAuto(true);
+            }, 512);
+
+            const auto expected = processInBlocks(input, 512, [&](juce::AudioBuffer<float>& block)
+            {
+                trim(block);
+                gate(block);
+                eq(block);
+                comp(block);
+            });
+
+            expectGreaterThan(rmsDb(output), rmsDb(input) - 40.0f, "The strip makes audio");
+            expectGreaterThan(nullResidualDb(output, input), -20.0f, "The strip changes the audio");
+            expectLessThan(nullResidualDb(output, expected), -100.0f);
+        }
+
+        beginTest("ChannelProcessor: EQ gain reaches the signal");
+        {
+            // -30 dB stays under the compressor, whose auto makeup is a fixed gain down there
+            const auto input = makeSine(oneSecond, EQProcessor::highMidFrequency, juce::Decibels::decibelsToGain(-30.0f));
+            const auto flat = processInBlocks(input, 512, makeChannel({ 0.0f, 0.0f, 0.0f, 0.0f }));
+            const auto boosted = processInBlocks(input, 512, makeChannel({ 0.0f, 0.0f, 6.0f, 0.0f }));
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                expectWithinAbsoluteError(rmsDb(boosted, ch, settled) - rmsDb(flat, ch, settled), 6.0f, 0.2f);
+        }
+
+        // juce::dsp::Limiter scales its output so the ceiling lands on full
+        // scale, then clips there: nothing gets out above 1.0
+        beginTest("Limiter: output never exceeds full scale");
+        {
+            auto limiter = prepareProcessor<auralis::TruePeakLimiterProcessor>();
+            expectLessOrEqual(peak(processInBlocks(makeSine(oneSecond, 1000.0, 2.0f), 512, limiter)), 1.0f);
+
+            limiter = prepareProcessor<auralis::TruePeakLimiterProcessor>();
+            expectLessOrEqual(peak(processInBlocks(makeImpulse(4096, 2.0f), 512, limiter)), 1.0f);
+        }
+
+        beginTest("Limiter: quiet material is a pure gain");
+        {
+            auto limiter = prepareProcessor<auralis::TruePeakLimiterProcessor>();
+            const auto input = makeSine(oneSecond, 1000.0, juce::Decibels::decibelsToGain(-30.0f));
+            const auto output = processInBlocks(input, 512, limiter);
+
+            // Least-squares gain from input to output, then what is left over
+            double correlation = 0.0, energy = 0.0;
+            for (int i = 0; i < input.getNumSamples(); ++i)
+            {
+                correlation += (double) output.getSample(0, i) * input.getSample(0, i);
+                energy += (double) input.getSample(0, i) * input.getSample(0, i);
+            }
+
+            const auto gain = static_cast<float>(correlation / energy);
+            expectGreaterOrEqual(gain, 1.0f);
+
+            juce::AudioBuffer<float> scaled(input);
+            scaled.applyGain(gain);
+            expectLessThan(nullResidualDb(output, scaled), -80.0f);
+        }
+    }
+};
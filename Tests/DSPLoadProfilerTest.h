@@ -0,0 +1,138 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DSPTestHelpers.h"
+#include "../Source/Audio/AudioEngine.h"
+#include "../Source/Audio/DSPLoadProfiler.h"
+
+/**
+ * The load profiler's arithmetic on made-up block timings, then a headless
+ * engine's slots after a second of audio: the strips that ran, the buses and
+ * the master fill in; an unpatched strip and a disabled profiler stay empty.
+ */
+class DSPLoadProfilerTest : public juce::UnitTest
+{
+public:
+    DSPLoadProfilerTest() : juce::UnitTest("DSP load profiler", "DSP") {}
+
+    void runTest() override
+    {
+        using SlotType = DSPLoadProfiler::SlotType;
+        const double sampleRate = DSPTestHelpers::sampleRate;
+        const int blockSize = 480;
+
+        // Ticks for a block of blockSize that takes this share of its budget
+        const auto ticksFor = [&](double load)
+        {
+            return static_cast<juce::int64>(load * blockSize * static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()) / sampleRate);
+        };
+
+        // Half a second of blocks fills exactly one window
+        const int blocksPerWindow = juce::roundToInt(0.5 * sampleRate) / blockSize;
+
+        beginTest("Window statistics");
+        {
+            DSPLoadProfiler profiler;
+            profiler.prepare(sampleRate);
+            auto& slot = profiler.addSlot("Test", SlotType::ChannelStrip, 0);
+
+            for (int i = 0; i < blocksPerWindow - 1; ++i)
+                slot.record(ticksFor(i % 2 == 0 ? 0.1 : 0.3), blockSize);
+
+            expectEquals(slot.getStatistics().averageLoad, 0.0f, "Nothing published before the window is full");
+            expectEquals(slot.getStatistics().numBlocks, static_cast<juce::int64>(blocksPerWindow - 1));
+
+            slot.record(ticksFor(0.3), blockSize);
+
+            const auto statistics = slot.getStatistics();
+            expectWithinAbsoluteError(statistics.averageLoad, 0.2f, 0.001f);
+            expectWithinAbsoluteError(statistics.minLoad, 0.1f, 0.001f);
+            expectWithinAbsoluteError(statistics.maxLoad, 0.3f, 0.001f);
+            expectWithinAbsoluteError(statistics.overallLoad, 0.2f, 0.001f);
+            expectWithinAbsoluteError(statistics.worstLoad, 0.3f, 0.001f);
+        }
+
+        beginTest("A reset clears every figure");
+        {
+            DSPLoadProfiler profiler;
+            profiler.prepare(sampleRate);
+            auto& slot = profiler.addSlot("Test", SlotType::ChannelStrip, 0);
+
+            for (int i = 0; i < blocksPerWindow; ++i)
+                slot.record(ticksFor(0.5), blockSize);
+
+            profiler.reset();
+            expectEquals(slot.getStatistics().numBlocks, static_cast<juce::int64>(0), "Zero straight away, before the slot runs");
+
+            slot.record(ticksFor(0.1), blockSize);
+            expectEquals(slot.getStatistics().numBlocks, static_cast<juce::int64>(1));
+            expectWithinAbsoluteError(slot.getStatistics().worstLoad, 0.1f, 0.001f);
+        }
+
+        beginTest("Engine slots");
+        {
+            AudioEngine engine(false);
+            auto& profiler = engine.getLoadProfiler();
+            engine.prepareToPlay(sampleRate, blockSize);
+
+            auto routing = auralis::RoutingManager::createDefaultTable(engine);
+            for (int i = 0; i < routing.numChannels; ++i)
+                routing.inputForChannel[i] = i == 0 ? 0 : -1;
+
+            const auto input = DSPTestHelpers::makeNoise(blockSize, 0.5f);
+            const float* inputs[] = { input.getReadPointer(0) };
+
+            auto runBlocks = [&](int numBlocks)
+            {
+                for (int block = 0; block < numBlocks; ++block)
+                {
+                    for (int i = 0; i < engine.getNumChannels(); ++i)
+                        engine.processChannel(i, routing, inputs, 1, blockSize);
+                    engine.mixBuses(routing, blockSize);
+                }
+            };
+
+            // Off by default: nothing recorded
+            runBlocks(10);
+            for (int i = 0; i < profiler.getNumSlots(); ++i)
+                expectEquals(profiler.getSlot(i).getStatistics().numBlocks, static_cast<juce::int64>(0));
+
+            profiler.setEnabled(true);
+            profiler.setStagesEnabled(true);
+            runBlocks(blocksPerWindow);
+
+            if (!DSPLoadProfiler::isCompiledIn)
+                return;
+
+            const DSPLoadProfiler::Slot* firstStrip = nullptr;
+            const DSPLoadProfiler::Slot* lastStrip = nullptr;
+            const DSPLoadProfiler::Slot* master = nullptr;
+            int numStages = 0;
+
+            for (int i = 0; i < profiler.getNumSlots(); ++i)
+            {
+                const auto& slot = profiler.getSlot(i);
+
+                if (slot.getType() == SlotType::ChannelStrip && slot.getIndex() == 0)
+                    firstStrip = &slot;
+                else if (slot.getType() == SlotType::ChannelStrip && slot.getIndex() == engine.getNumChannels() - 1)
+                    lastStrip = &slot;
+                else if (slot.getType() == SlotType::MasterBus)
+                    master = &slot;
+                else if (slot.getType() == SlotType::ChannelStage && slot.getIndex() == 0 && slot.getStatistics().numBlocks > 0)
+                    ++numStages;
+                else if (slot.getType() == SlotType::GroupBus || slot.getType() == SlotType::FXBus)
+                    expectEquals(slot.getStatistics().numBlocks, static_cast<juce::int64>(blocksPerWindow), slot.getName());
+            }
+
+            expect(firstStrip != nullptr && lastStrip != nullptr && master != nullptr);
+            expectEquals(firstStrip->getStatistics().numBlocks, static_cast<juce::int64>(blocksPerWindow));
+            expectGreaterThan(firstStrip->getStatistics().averageLoad, 0.0f);
+            expectEquals(lastStrip->getStatistics().numBlocks, static_cast<juce::int64>(0), "An unpatched strip never runs");
+            expectEquals(master->getStatistics().numBlocks, static_cast<juce::int64>(blocksPerWindow));
+            expectEquals(numStages, 5, "Trim, gate, EQ, compressor and tuner each timed");
+
+            engine.releaseResources();
+        }
+    }
+};
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DSPTestHelpers.h"
+#include "../Source/Audio/ChannelProcessor.h"
+#include "../Source/Audio/GroupBusProcessor.h"
+#include "../Source/Audio/MultibandCompressorProcessor.h"
+#include "../Source/Audio/TruePeakLimiterProcessor.h"
+#include "../Source/FX/CompressorProcessor.h"
+#include "../Source/FX/DelayProcessor.h"
+#include "../Source/FX/EQProcessor.h"
+#include "../Source/FX/GateProcessor.h"
+#include "../Source/FX/ReverbProcessor.h"
+#include "../Source/FX/TrimProcessor.h"
+
+/**
+ * Null tests: two ways of producing the same audio must cancel. A rewrite
+ * of a processor (new block handling, vectorised loops, another layout of
+ * its state) has to keep nulling against the paths below.
+ *
+ *  - Block size: one large block against odd-sized small ones
+ *  - Stereo: the same signal on both channels comes out the same on both
+ *
+ * Silence, or the input passed straight through, nulls against anything, so
+ * every case first has to show it made audio and changed it.
+ */
+class DSPNullTest : public juce::UnitTest
+{
+public:
+    DSPNullTest() : juce::UnitTest("DSP null", "DSP") {}
+
+    void runTest() override
+    {
+        using namespace DSPTestHelpers;
+
+        const auto input = makeProgramme();
+
+        for (const auto& testCase : getCases())
+        {
+            beginTest(testCase.name + ": block size");
+            {
+                const auto whole = processInBlocks(input, 2048, testCase.create());
+                const auto small = processInBlocks(input, 37, testCase.create());
+                expectProcessed(whole, input, testCase.name);
+                expectNull(whole, small, testCase.name + " in blocks of 37");
+            }
+
+            if (!testCase.stereoSymmetric)
+                continue;
+
+            beginTest(testCase.name + ": stereo");
+            {
+                const auto output = processInBlocks(input, 512, testCase.create());
+
+                juce::AudioBuffer<float> left(1, output.getNumSamples()), right(1, output.getNumSamples());
+                left.copyFrom(0, 0, output, 0, 0, output.getNumSamples());
+                right.copyFrom(0, 0, output, 1, 0, output.getNumSamples());
+                expectNull(right, left, testCase.name + " right against left");
+            }
+        }
+    }
+
+private:
+    struct Case
+    {
+        juce::String name;
+        std::function<DSPTestHelpers::ProcessFunction()> create;
+        bool stereoSymmetric = true;
+    };
+
+    // Float rounding alone sits far below this
+    static constexpr float nullThresholdDb = -140.0f;
+
+    void expectNull(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b, const juce::String& what)
+    {
+        const auto residual = DSPTestHelpers::nullResidualDb(a, b);
+        expect(residual < nullThresholdDb, what + " leaves a residual of " + juce::String(residual, 1) + " dB");
+    }
+
+    void expectProcessed(const juce::AudioBuffer<float>& output, const juce::AudioBuffer<float>& input, const juce::String& what)
+    {
+        using namespace DSPTestHelpers;
+
+        expectGreaterThan(rmsDb(output), rmsDb(input) - 40.0f, what + " is silent");
+        expectGreaterThan(nullResidualDb(output, input), nullThresholdDb, what + " passes the input through untouched");
+    }
+
+    /** Loud noise, then quiet noise, then silence: opens and closes the dynamics. */
+    static juce::AudioBuffer<float> makeProgramme()
+    {
+        using namespace DSPTestHelpers;
+
+        const int sectionLength = juce::roundToInt(sampleRate / 2.0);
+        juce::AudioBuffer<float> programme(numChannels, sectionLength * 3);
+        programme.clear();
+
+        const auto loud = makeNoise(sectionLength, 0.8f);
+        const auto quiet = makeNoise(sectionLength, 0.002f, 0x5175696574);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            programme.copyFrom(ch, 0, loud, ch, 0, sectionLength);
+            programme.copyFrom(ch, sectionLength, quiet, ch, 0, sectionLength);
+        }
+
+        return programme;
+    }
+
+    static std::vector<Case> getCases()
+    {
+        using namespace DSPTestHelpers;
+
+        std::vector<Case> cases;
+
+        cases.push_back({ "Trim", []
+        {
+            return prepareProcessor<TrimProcessor>([](TrimProcessor& trim) { trim.setGainLinear(0.7f); });
+        } });
+
+        cases.push_back({ "Gate", []
+        {
+            return prepareProcessor<GateProcessor>([](GateProcessor& gate) { gate.setThreshold(-40.0f); });
+        } });
+
+        cases.push_back({ "EQ", []
+        {
+            return prepareProcessor<EQProcessor>([](EQProcessor& eq) { eq.setGains({ 3.0f, -2.0f, 2.5f, -1.5f }); });
+        } });
+
+        cases.push_back({ "Compressor", []
+        {
+            return prepareProcessor<CompressorProcessor>([](CompressorProcessor& comp)
+            {
+                comp.setThreshold(-24.0f);
+                comp.setRatio(4.0f);
+            });
+        } });
+
+        cases.push_back({ "Delay", []
+        {
+            return prepareProcessor<DelayProcessor>([](DelayProcessor& delay) { delay.setFeedback(0.5f); });
+        } });
+
+        // The reverb's left and right tanks are tuned apart on purpose
+        cases.push_back({ "Reverb", []
+        {
+            return prepareProcessor<ReverbProcessor>();
+        }, false });
+
+        cases.push_back({ "BusEQ", []
+        {
+            return prepareProcessor<BusEQProcessor>([](BusEQProcessor& eq) { eq.setGains(2.0f, -1.5f, 1.0f); });
+        } });
+
+        cases.push_back({ "Multiband", []() -> ProcessFunction
+        {
+            auto compressor = std::make_shared<MultibandCompressorProcessor>();
+            compressor->prepare(sampleRate, 2048);
+            return [compressor](juce::AudioBuffer<float>& buffer) { compressor->process(buffer); };
+        } });
+
+        cases.push_back({ "Limiter", []
+        {
+            return prepareProcessor<auralis::TruePeakLimiterProcessor>();
+        } });
+
+        // The tuner estimates pitch once per block, so it is block-size dependent by design
+        cases.push_back({ "ChannelProcessor", []() -> ProcessFunction
+        {
+            auto channel = std::make_shared<ChannelProcessor>(0, ChannelProcessor::ChannelType::Vocal);
+            channel->prepareToPlay(sampleRate, 2048);
+            channel->setEQGains({ 3.0f, -2.0f, 2.5f, -1.5f });
+            channel->setTunerEnabled(false);
+
+            auto midi = std::make_shared<juce::MidiBuffer>();
+            return [channel, midi](juce::AudioBuffer<float>& buffer) { channel->processBlock(buffer, *midi); };
+        } });
+
+        return cases;
+    }
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "HeadlessSupport.h"
+
+/**
+ * DSPTestHelpers - Signals and measurements shared by the DSP tests
+ *
+ * Everything runs at one sample rate in stereo, with the same signal on
+ * both channels unless a test says otherwise.
+ */
+namespace DSPTestHelpers
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numChannels = 2;
+
+    using HeadlessSupport::ProcessFunction;
+
+    inline juce::AudioBuffer<float> makeImpulse(int numSamples, float amplitude = 1.0f)
+    {
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        buffer.clear();
+        for (int ch = 0; ch < numChannels; ++ch)
+            buffer.setSample(ch, 0, amplitude);
+        return buffer;
+    }
+
+    inline juce::AudioBuffer<float> makeSine(int numSamples, double frequency, float amplitude)
+    {
+        return HeadlessSupport::makeSignal(numChannels, numSamples, sampleRate, frequency, amplitude);
+    }
+
+    inline juce::AudioBuffer<float> makeConstant(int numSamples, float value)
+    {
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        for (int ch = 0; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), value, numSamples);
+        return buffer;
+    }
+
+    /** Seeded white noise, so a failure reproduces. */
+    inline juce::AudioBuffer<float> makeNoise(int numSamples, float amplitude, juce::int64 seed = 0x41757261)
+    {
+        return HeadlessSupport::makeSignal(numChannels, numSamples, sampleRate, 0.0, 0.0f, amplitude, seed);
+    }
+
+    /** Process a copy of the input in consecutive blocks of at most blockSize samples. */
+    inline juce::AudioBuffer<float> processInBlocks(const juce::AudioBuffer<float>& input, int blockSize, const ProcessFunction& process)
+    {
+        juce::AudioBuffer<float> output(input);
+
+        for (int start = 0; start < output.getNumSamples(); start += blockSize)
+        {
+            const int numSamples = juce::jmin(blockSize, output.getNumSamples() - start);
+            juce::AudioBuffer<float> block(output.getArrayOfWritePointers(), output.getNumChannels(), start, numSamples);
+            process(block);
+        }
+
+        return output;
+    }
+
+    /** A stereo juce::AudioProcessor, prepared, then configured. */
+    template <typename Processor>
+    ProcessFunction prepareProcessor(std::function<void(Processor&)> configure = nullptr, int maximumBlockSize = 2048)
+    {
+        return HeadlessSupport::prepareProcessor<Processor>(sampleRate, maximumBlockSize, std::move(configure), numChannels);
+    }
+
+    /** RMS of one channel from startSample to the end, in dBFS. */
+    inline float rmsDb(const juce::AudioBuffer<float>& buffer, int channel = 0, int startSample = 0)
+    {
+        const auto rms = buffer.getRMSLevel(channel, startSample, buffer.getNumSamples() - startSample);
+        return juce::Decibels::gainToDecibels(rms, -200.0f);
+    }
+
+    /** Level of (a - b) relative to the level of b, in dB, over every channel. */
+    inline float nullResidualDb(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b, int startSample = 0)
+    {
+        jassert(a.getNumChannels() == b.getNumChannels() && a.getNumSamples() == b.getNumSamples());
+
+        double residualEnergy = 0.0;
+        double referenceEnergy = 0.0;
+
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+        {
+            for (int i = startSample; i < a.getNumSamples(); ++i)
+            {
+                const double difference = (double) a.getSample(ch, i) - (double) b.getSample(ch, i);
+                residualEnergy += difference * difference;
+                referenceEnergy += (double) b.getSample(ch, i) * (double) b.getSample(ch, i);
+            }
+        }
+
+        if (residualEnergy == 0.0)
+            return -200.0f;
+
+        return static_cast<float>(10.0 * std::log10(residualEnergy / juce::jmax(referenceEnergy, 1.0e-30)));
+    }
+
+    /** True if every sample from startSample on is identical. */
+    inline bool isBitExact(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b, int startSample = 0)
+    {
+        return nullResidualDb(a, b, startSample) <= -200.0f;
+    }
+
+    /** Largest absolute sample over every channel. */
+    inline float peak(const juce::AudioBuffer<float>& buffer)
+    {
+        float result = 0.0f;
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            result = juce::jmax(result, buffer.getMagnitude(ch, 0, buffer.getNumSamples()));
+        return result;
+    }
+}
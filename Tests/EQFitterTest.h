@@ -0,0 +1,107 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DSPTestHelpers.h"
+#include "../Source/Soundcheck/EQFitter.h"
+#include "../Source/Soundcheck/ToneProfiles.h"
+
+/**
+ * The soundcheck's least-squares EQ fit, against targets made from the EQ's
+ * own response: gains that produced the target are found again, bands with
+ * no weight don't pull the fit, and a target beyond the EQ's range ends with
+ * the band pinned at its limit rather than past it.
+ */
+class EQFitterTest : public juce::UnitTest
+{
+public:
+    EQFitterTest() : juce::UnitTest("EQ fitter", "DSP") {}
+
+    void runTest() override
+    {
+        constexpr int numBands = EQFitter::numBands;
+
+        EQFitter fitter;
+        fitter.prepare(DSPTestHelpers::sampleRate);
+
+        // Bands near Nyquist are out of the fitter's reach, so they carry no weight here either
+        const auto bandFrequencies = getThirdOctaveBandFrequencies();
+        std::array<float, numBands> weights;
+        for (int i = 0; i < numBands; ++i)
+            weights[(size_t) i] = bandFrequencies[i] < 0.45 * DSPTestHelpers::sampleRate ? 1.0f : 0.0f;
+
+        // Weighted RMS error of some gains against a target, as the fitter measures it
+        const auto residualOf = [&](const std::array<float, EQFitter::numEQBands>& gains, const float* targetDb)
+        {
+            float response[numBands];
+            fitter.getResponseDb(gains, response);
+
+            double sum = 0.0, total = 0.0;
+            for (int i = 0; i < numBands; ++i)
+            {
+                sum += weights[(size_t) i] * (response[i] - targetDb[i]) * (response[i] - targetDb[i]);
+                total += weights[(size_t) i];
+            }
+            return static_cast<float>(std::sqrt(sum / total));
+        };
+
+        beginTest("Gains that made the target are found again");
+        {
+            const std::array<float, EQFitter::numEQBands> gains { 4.5f, -3.0f, 6.0f, -5.0f };
+            float target[numBands];
+            fitter.getResponseDb(gains, target);
+
+            const auto result = fitter.fit(target, weights.data());
+            for (size_t band = 0; band < gains.size(); ++band)
+                expectWithinAbsoluteError(result.gainsDb[band], gains[band], 0.1f);
+
+            expectLessThan(result.residualDb, 0.05f);
+            expectGreaterThan(result.initialResidualDb, 1.0f, "The flat EQ was a poor fit");
+            expectGreaterThan(result.iterations, 0);
+        }
+
+        beginTest("Bands with no weight are ignored");
+        {
+            const std::array<float, EQFitter::numEQBands> gains { -2.0f, 3.0f, -4.0f, 2.0f };
+            float target[numBands];
+            fitter.getResponseDb(gains, target);
+
+            // A wild band the fit must not chase
+            target[20] += 30.0f;
+            weights[20] = 0.0f;
+
+            const auto result = fitter.fit(target, weights.data());
+            for (size_t band = 0; band < gains.size(); ++band)
+                expectWithinAbsoluteError(result.gainsDb[band], gains[band], 0.1f);
+
+            weights[20] = 1.0f;
+        }
+
+        beginTest("A target beyond the EQ's range pins the band at its limit");
+        {
+            float target[numBands];
+            fitter.getResponseDb({ 18.0f, 0.0f, 0.0f, -20.0f }, target);
+
+            const auto result = fitter.fit(target, weights.data());
+            expectWithinAbsoluteError(result.gainsDb[0], EQProcessor::maxGainDb, 0.01f);
+            expectWithinAbsoluteError(result.gainsDb[3], -EQProcessor::maxGainDb, 0.01f);
+
+            for (auto gain : result.gainsDb)
+                expectLessOrEqual(std::abs(gain), EQProcessor::maxGainDb);
+
+            // No worse than just clipping the gains that made the target
+            expectLessOrEqual(result.residualDb, residualOf({ 12.0f, 0.0f, 0.0f, -12.0f }, target) + 0.001f);
+        }
+
+        beginTest("No weight at all leaves the EQ flat");
+        {
+            std::array<float, numBands> target, noWeights;
+            target.fill(6.0f);
+            noWeights.fill(0.0f);
+
+            const auto result = fitter.fit(target.data(), noWeights.data());
+            for (auto gain : result.gainsDb)
+                expectEquals(gain, 0.0f);
+            expectEquals(result.iterations, 0);
+        }
+    }
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+
+/**
+ * HeadlessSupport - What the test runner and the benchmarks both need
+ *
+ * A logger that swallows the processors' own output, the one signal
+ * generator every test and benchmark signal comes from, and a juce
+ * AudioProcessor prepared and wrapped as a block-processing function.
+ */
+namespace HeadlessSupport
+{
+    /** Processes one block in place. */
+    using ProcessFunction = std::function<void(juce::AudioBuffer<float>&)>;
+
+    /** Keeps the processors' log output out of the console. */
+    class SilentLogger : public juce::Logger
+    {
+        void logMessage(const juce::String&) override {}
+    };
+
+    /**
+     * A sine plus seeded white noise, the same on every channel. Either part
+     * can be left out with a zero amplitude; the seed makes the noise repeat
+     * on every run and every machine.
+     */
+    inline juce::AudioBuffer<float> makeSignal(int numChannels, int numSamples, double sampleRate,
+                                               double frequency, float sineAmplitude,
+                                               float noiseAmplitude = 0.0f, juce::int64 seed = 0x41757261)
+    {
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        juce::Random random(seed);
+        const double phaseStep = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto value = static_cast<float>(sineAmplitude * std::sin(phaseStep * i));
+
+            if (noiseAmplitude != 0.0f)
+                value += noiseAmplitude * (random.nextFloat() * 2.0f - 1.0f);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                buffer.setSample(ch, i, value);
+        }
+
+        return buffer;
+    }
+
+    /** A juce::AudioProcessor prepared for this rate and block size, then configured. */
+    template <typename Processor>
+    ProcessFunction prepareProcessor(double sampleRate, int maximumBlockSize,
+                                     std::function<void(Processor&)> configure = nullptr, int numChannels = 2)
+    {
+        auto processor = std::make_shared<Processor>();
+        processor->setPlayConfigDetails(numChannels, numChannels, sampleRate, maximumBlockSize);
+        processor->prepareToPlay(sampleRate, maximumBlockSize);
+
+        if (configure != nullptr)
+            configure(*processor);
+
+        auto midi = std::make_shared<juce::MidiBuffer>();
+        return [processor, midi](juce::AudioBuffer<float>& buffer) { processor->processBlock(buffer, *midi); };
+    }
+}
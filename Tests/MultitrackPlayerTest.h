@@ -0,0 +1,134 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Source/Recording/MultitrackPlayer.h"
+#include "../Source/Recording/MultitrackRecorder.h"
+
+/**
+ * A two-track take played against a made-up patch: each track lands on its
+ * channel's patched input, even one past the device's inputs, other inputs
+ * stay live, and seeking, looping and the end of the take line up to the
+ * sample.
+ */
+class MultitrackPlayerTest : public juce::UnitTest
+{
+public:
+    MultitrackPlayerTest() : juce::UnitTest("Multitrack player", "State") {}
+
+    void runTest() override
+    {
+        const double sampleRate = 48000.0;
+        const int blockSize = 480;
+        const int length = 24000;
+
+        // Channel 1 is a rising ramp, channel 2 the same ramp inverted
+        const auto ramp = [length](juce::int64 position) { return 0.9f * static_cast<float>(position % length + 1) / length; };
+
+        auto folder = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                          .getNonexistentChildFile("AuralisPlayerTest", {}, false);
+        expect(folder.createDirectory());
+
+        juce::WavAudioFormat wav;
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            juce::AudioBuffer<float> samples(1, length);
+            for (int i = 0; i < length; ++i)
+                samples.setSample(0, i, channel == 0 ? ramp(i) : -ramp(i));
+
+            const auto file = MultitrackRecorder::getChannelFile(folder, channel);
+            std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(file.createOutputStream().release(), sampleRate, 1, 24, {}, 0));
+            expect(writer != nullptr && writer->writeFromAudioSampleBuffer(samples, 0, length));
+        }
+
+        // Channel 1 on input 2, channel 2 on input 4 of a two-input device, channel 3 live on input 1
+        auralis::RoutingTable routing;
+        routing.numChannels = 3;
+        routing.inputForChannel.fill(-1);
+        routing.inputForChannel[0] = 1;
+        routing.inputForChannel[1] = 3;
+        routing.inputForChannel[2] = 0;
+
+        juce::AudioBuffer<float> live(2, blockSize);
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < blockSize; ++i)
+                live.setSample(channel, i, 0.5f);
+
+        MultitrackPlayer player(4);
+        player.prepare(sampleRate, blockSize);
+
+        // One block through the player; checks it against the take from position, and returns whether it played
+        const auto playBlock = [&](juce::int64 position, bool channel1Live)
+        {
+            if (!player.beginBlock())
+                return false;
+
+            int numInputs = live.getNumChannels();
+            const auto* inputs = player.substituteInputs(routing, live.getArrayOfReadPointers(), numInputs, blockSize);
+            player.endBlock();
+
+            expectEquals(numInputs, 4);
+            expect(inputs[0] == live.getReadPointer(0), "An input with no track stays live");
+            expect(inputs[2] == nullptr, "An input the device doesn't have, and nothing plays on, is silent");
+
+            for (int i = 0; i < blockSize; i += 37)
+            {
+                const float expected1 = channel1Live ? 0.5f : ramp(position + i);
+                expectWithinAbsoluteError(inputs[1][i], expected1, 1.0e-5f);
+                expectWithinAbsoluteError(inputs[3][i], -ramp(position + i), 1.0e-5f);
+            }
+            return true;
+        };
+
+        beginTest("Tracks replace their channels' patched inputs until the take ends");
+        {
+            expect(player.open(folder));
+            expect(player.hasTrack(0) && player.hasTrack(1) && !player.hasTrack(2));
+            expectWithinAbsoluteError(player.getLengthSeconds(), length / sampleRate, 1.0e-9);
+            expect(!player.beginBlock(), "Nothing plays until asked");
+
+            expect(player.play());
+            for (juce::int64 position = 0; position < length; position += blockSize)
+                expect(playBlock(position, false));
+
+            expect(!player.isPlaying(), "Playback stops at the end of the take");
+            expect(!player.beginBlock());
+            expectEquals(player.getNumUnderruns(), static_cast<juce::int64>(0));
+        }
+
+        beginTest("Seeking, live channels and looping");
+        {
+            player.setChannelLive(0, true);
+            player.setPosition(0.25);
+            const auto start = static_cast<juce::int64>(std::round(player.getPosition() * sampleRate));
+            expectEquals(start, static_cast<juce::int64>(length / 2));
+
+            expect(player.play());
+            expect(playBlock(start, true));
+            player.setChannelLive(0, false);
+            expect(playBlock(start + blockSize, false));
+
+            // Half a block before the end: the loop carries straight on from the top
+            player.setLooping(true);
+            player.setPosition(static_cast<double>(length - blockSize / 2) / sampleRate);
+            const auto nearEnd = static_cast<juce::int64>(std::round(player.getPosition() * sampleRate));
+            expect(player.isPlaying(), "Seeking keeps playing");
+            expect(playBlock(nearEnd, false));
+            expect(player.isPlaying());
+            expectWithinAbsoluteError(player.getPosition(), (nearEnd + blockSize - length) / sampleRate, 1.0e-9);
+            expectEquals(player.getNumUnderruns(), static_cast<juce::int64>(0));
+        }
+
+        beginTest("A take only plays at its own sample rate");
+        {
+            player.stop();
+            player.prepare(44100.0, blockSize);
+            expect(!player.play());
+            player.prepare(sampleRate, blockSize);
+            expect(player.play());
+        }
+
+        player.close();
+        expect(!player.isOpen() && !player.isPlaying());
+        folder.deleteRecursively();
+    }
+};
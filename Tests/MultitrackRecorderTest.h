@@ -0,0 +1,122 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Source/Recording/MultitrackRecorder.h"
+
+/**
+ * A short take pushed far faster than real time into a recorder with a tiny
+ * buffer, so the writer can't keep up: every file still comes out the full
+ * length, each block is either what was pushed or silence in its place, and
+ * unpatched channels are silent.
+ */
+class MultitrackRecorderTest : public juce::UnitTest
+{
+public:
+    MultitrackRecorderTest() : juce::UnitTest("Multitrack recorder", "State") {}
+
+    void runTest() override
+    {
+        const double sampleRate = 48000.0;
+        const int blockSize = 480;
+        const int numBlocks = 50;
+
+        auto folder = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                          .getNonexistentChildFile("AuralisRecorderTest", {}, false);
+
+        // Every block is a constant, different for each block
+        const auto valueFor = [](int block) { return static_cast<float>(block + 1) / 100.0f; };
+
+        beginTest("Dropped blocks become silence and the tracks stay aligned");
+        {
+            MultitrackRecorder recorder(2);
+            recorder.prepare(sampleRate);
+
+            MultitrackRecorder::Settings settings;
+            settings.folder = folder;
+            settings.bufferSeconds = 0.1;
+            expect(recorder.start(settings));
+            expect(recorder.isRecording());
+
+            auralis::RoutingTable routing;
+            routing.numChannels = 2;
+            routing.inputForChannel.fill(-1);
+            routing.inputForChannel[0] = 0;
+
+            juce::AudioBuffer<float> input(1, blockSize);
+            juce::AudioBuffer<float> mix(2, blockSize);
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                input.clear();
+                for (int i = 0; i < blockSize; ++i)
+                    input.setSample(0, i, valueFor(block));
+
+                mix.clear();
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < blockSize; ++i)
+                        mix.setSample(channel, i, -valueFor(block));
+
+                expect(recorder.beginBlock());
+                recorder.pushInputs(routing, input.getArrayOfReadPointers(), 1, blockSize);
+                recorder.pushMaster(mix, blockSize);
+                recorder.endBlock();
+            }
+
+            recorder.stop();
+            expect(!recorder.isRecording());
+            expect(!recorder.beginBlock(), "Nothing is taken once stopped");
+            expect(!recorder.hasWriteError());
+            expectWithinAbsoluteError(recorder.getRecordedSeconds(), numBlocks * blockSize / sampleRate, 1.0e-9);
+
+            juce::WavAudioFormat wav;
+            const auto read = [&](const juce::File& file)
+            {
+                juce::AudioBuffer<float> samples;
+                std::unique_ptr<juce::AudioFormatReader> reader(wav.createReaderFor(file.createInputStream().release(), true));
+                expect(reader != nullptr, "Can't read " + file.getFileName());
+                if (reader == nullptr)
+                    return samples;
+
+                samples.setSize(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+                reader->read(&samples, 0, samples.getNumSamples(), 0, true, true);
+                return samples;
+            };
+
+            const auto channel1 = read(MultitrackRecorder::getChannelFile(folder, 0));
+            const auto channel2 = read(MultitrackRecorder::getChannelFile(folder, 1));
+            const auto master = read(MultitrackRecorder::getMasterFile(folder));
+
+            expectEquals(channel1.getNumSamples(), numBlocks * blockSize);
+            expectEquals(channel2.getNumSamples(), numBlocks * blockSize);
+            expectEquals(master.getNumSamples(), numBlocks * blockSize);
+            expectEquals(master.getNumChannels(), 2);
+
+            // Each block lands where it was pushed, or the whole of it is silence
+            int missing = 0;
+            for (int block = 0; block < numBlocks && channel1.getNumSamples() == numBlocks * blockSize; ++block)
+            {
+                const auto range = channel1.findMinMax(0, block * blockSize, blockSize);
+                const bool present = std::abs(range.getStart() - valueFor(block)) < 1.0e-4f
+                                     && std::abs(range.getEnd() - valueFor(block)) < 1.0e-4f;
+                const bool silent = range.getStart() == 0.0f && range.getEnd() == 0.0f;
+                expect(present || silent, "Block " + juce::String(block) + " is neither its own audio nor silence");
+
+                if (block < 10)
+                    expect(present, "The first buffer's worth always fits");
+                if (!present)
+                    ++missing;
+
+                if (master.getNumSamples() == numBlocks * blockSize)
+                {
+                    const auto left = master.findMinMax(0, block * blockSize, blockSize);
+                    expect(left.getStart() == 0.0f || std::abs(left.getStart() + valueFor(block)) < 1.0e-4f);
+                }
+            }
+
+            expect(missing == 0 || recorder.getNumDroppedBlocks() >= missing, "Every missing block was reported dropped");
+            expectEquals(channel2.getMagnitude(0, channel2.getNumSamples()), 0.0f, "An unpatched channel records silence");
+        }
+
+        folder.deleteRecursively();
+    }
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DSPTestHelpers.h"
+#include "../Source/Audio/OfflineRenderer.h"
+
+/**
+ * A short stem rendered through the whole mixer: the mix and its loudness
+ * report carry the stem at a sensible level rather than silence, and two
+ * renders of the same stem on different thread counts come out identical.
+ */
+class OfflineRendererTest : public juce::UnitTest
+{
+public:
+    OfflineRendererTest() : juce::UnitTest("Offline renderer", "DSP") {}
+
+    void runTest() override
+    {
+        using namespace DSPTestHelpers;
+
+        auto folder = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                          .getNonexistentChildFile("AuralisRenderTest", {}, false);
+        expect(folder.createDirectory());
+
+        // Two seconds of A440 at -20 dBFS: the tuner leaves it where it is
+        const auto stem = makeSine(2 * juce::roundToInt(sampleRate), 440.0, 0.1f);
+        const auto stemFile = folder.getChildFile("stem.wav");
+        {
+            juce::WavAudioFormat wav;
+            std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stemFile.createOutputStream().release(),
+                                                                                sampleRate, 1, 24, {}, 0));
+            expect(writer != nullptr && writer->writeFromAudioSampleBuffer(stem, 0, stem.getNumSamples()));
+        }
+
+        const auto render = [&](const juce::String& name, int numThreads)
+        {
+            OfflineRenderer::Settings settings;
+            settings.stems.add(stemFile);
+            settings.output = folder.getChildFile(name);
+            settings.blockSize = 512;
+            settings.tailSeconds = 0.5;
+            settings.numThreads = numThreads;
+            return OfflineRenderer::render(settings);
+        };
+
+        const auto readMix = [&](const juce::File& file)
+        {
+            juce::AudioBuffer<float> mix;
+            juce::WavAudioFormat wav;
+            std::unique_ptr<juce::AudioFormatReader> reader(wav.createReaderFor(file.createInputStream().release(), true));
+            expect(reader != nullptr, "Can't read " + file.getFileName());
+            if (reader == nullptr)
+                return mix;
+
+            mix.setSize(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+            reader->read(&mix, 0, mix.getNumSamples(), 0, true, true);
+            return mix;
+        };
+
+        beginTest("The stem comes through the mixer at a sensible level");
+        {
+            const auto result = render("mix.wav", 1);
+            expect(result.success, result.errorMessage);
+            expect(result.reportFile.existsAsFile(), "The loudness report is written");
+
+            const auto& loudness = result.loudness;
+            expectWithinAbsoluteError(loudness.durationSeconds, 2.5, 0.05);
+            expectGreaterThan(loudness.integratedLufs, -50.0, "The mix isn't silent");
+            expectLessThan(loudness.integratedLufs, 0.0);
+            expectGreaterThan(loudness.samplePeakDb, -40.0);
+            expectLessOrEqual(loudness.samplePeakDb, loudness.truePeakDb + 0.001);
+            expectLessOrEqual(loudness.integratedLufs, loudness.maxMomentaryLufs + 0.001);
+
+            const auto mix = readMix(folder.getChildFile("mix.wav"));
+            expectEquals(mix.getNumChannels(), 2);
+            expectGreaterThan(rmsDb(mix, 0), -50.0f, "The written mix isn't silent");
+        }
+
+        beginTest("A render on the calling thread alone matches a pooled one");
+        {
+            const auto first = render("first.wav", 1);      // No pool: every channel inline
+            const auto second = render("second.wav", 4);
+            expect(first.success && second.success);
+
+            expectEquals(first.loudness.integratedLufs, second.loudness.integratedLufs);
+            expectEquals(first.loudness.truePeakDb, second.loudness.truePeakDb);
+            expect(isBitExact(readMix(folder.getChildFile("first.wav")), readMix(folder.getChildFile("second.wav"))));
+        }
+
+        folder.deleteRecursively();
+    }
+};
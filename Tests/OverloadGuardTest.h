@@ -0,0 +1,146 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DSPTestHelpers.h"
+#include "../Source/Audio/AudioEngine.h"
+#include "../Source/Audio/OverloadGuard.h"
+
+/**
+ * The overload guard on a headless engine, fed made-up callback timings and
+ * clock readings: near misses and overruns reach the log, steps are taken in
+ * policy order and undone in reverse once the load stays down, and none of
+ * it shows in the channels' own settings.
+ */
+class OverloadGuardTest : public juce::UnitTest
+{
+public:
+    OverloadGuardTest() : juce::UnitTest("Overload guard", "DSP") {}
+
+    void runTest() override
+    {
+        using Step = OverloadGuard::Step;
+        using Type = OverloadGuard::Event::Type;
+        const double sampleRate = DSPTestHelpers::sampleRate;
+        const int blockSize = 480;
+
+        // Ticks for a callback of blockSize that takes this share of its deadline
+        const auto ticksFor = [&](double load)
+        {
+            return static_cast<juce::int64>(load * blockSize * static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()) / sampleRate);
+        };
+
+        beginTest("Steps down under load and back up once it's calm");
+        {
+            AudioEngine engine(false);
+            engine.prepareToPlay(sampleRate, blockSize);
+            auto& guard = engine.getOverloadGuard();
+            auto* lowPriority = engine.getChannelProcessor(0);
+            auto* highPriority = engine.getChannelProcessor(1);
+            lowPriority->setLowPriority(true);
+
+            for (int i = 0; i < 3; ++i)
+                guard.recordBlock(ticksFor(0.9), blockSize);
+            guard.recordBlock(ticksFor(1.2), blockSize);
+            guard.update(0.0);
+
+            auto events = guard.getEvents();
+            expectEquals(guard.getNumOverruns(), 1);
+            expectEquals(static_cast<int>(events.size()), 3);
+            expect(events[0].type == Type::NearMiss, "A run of near misses is logged once");
+            expect(events[1].type == Type::Overrun);
+            expect(events[2].type == Type::Degraded && events[2].detail == static_cast<int>(Step::SuspendLowPriorityTuners));
+            expect(lowPriority->isTunerSuspended() && !highPriority->isTunerSuspended());
+            expect(lowPriority->isTunerEnabled(), "The channel's own tuner setting is untouched");
+
+            // Still overloaded, but the first step gets time to show
+            guard.update(500.0);
+            expectEquals(static_cast<int>(guard.getActiveSteps().size()), 1);
+
+            // No convolution bus to switch, so straight on to the resampling
+            guard.update(1000.0);
+            expectEquals(static_cast<int>(guard.getActiveSteps().size()), 2);
+            expect(guard.getActiveSteps().back() == Step::LinearTunerResampling);
+            expect(highPriority->isTunerReducedQuality() && !lowPriority->isTunerReducedQuality());
+
+            // A second of light blocks lets the recent peak go
+            for (int i = 0; i < juce::roundToInt(sampleRate) / blockSize; ++i)
+                guard.recordBlock(ticksFor(0.1), blockSize);
+            expectLessThan(guard.getRecentLoad(), guard.getPolicy().restoreLoad);
+
+            const double holdMs = guard.getPolicy().restoreHoldSeconds * 1000.0;
+            guard.update(2000.0);
+            guard.update(2000.0 + holdMs - 1.0);
+            expectEquals(static_cast<int>(guard.getActiveSteps().size()), 2, "Not before the hold time");
+
+            guard.update(2000.0 + holdMs);
+            expectEquals(static_cast<int>(guard.getActiveSteps().size()), 1, "The last step goes first");
+            expect(!highPriority->isTunerReducedQuality() && lowPriority->isTunerSuspended());
+
+            guard.update(2000.0 + 2.0 * holdMs);
+            expect(guard.getActiveSteps().empty());
+            expect(!lowPriority->isTunerSuspended());
+            expect(guard.getEvents().back().type == Type::Restored);
+
+            engine.releaseResources();
+        }
+
+        beginTest("Turning the guard off restores full quality");
+        {
+            AudioEngine engine(false);
+            engine.prepareToPlay(sampleRate, blockSize);
+            auto& guard = engine.getOverloadGuard();
+
+            guard.recordBlock(ticksFor(1.5), blockSize);
+            guard.update(0.0);
+            expect(engine.getChannelProcessor(0)->isTunerReducedQuality());
+
+            // The strip's own tuner took the step, and still passes the audio
+            {
+                const auto input = DSPTestHelpers::makeSine(juce::roundToInt(sampleRate), 440.0, 0.1f);
+                juce::MidiBuffer midi;
+                const auto output = DSPTestHelpers::processInBlocks(input, blockSize, [&](juce::AudioBuffer<float>& block)
+                {
+                    engine.getChannelProcessor(0)->processBlock(block, midi);
+                });
+                expectGreaterThan(DSPTestHelpers::rmsDb(output, 0, input.getNumSamples() / 2), DSPTestHelpers::rmsDb(input) - 20.0f);
+            }
+
+            guard.setEnabled(false);
+            expect(guard.getActiveSteps().empty());
+            expect(!engine.getChannelProcessor(0)->isTunerReducedQuality());
+
+            // Still counting while off, but taking no steps
+            guard.recordBlock(ticksFor(1.5), blockSize);
+            guard.update(5000.0);
+            expectEquals(guard.getNumOverruns(), 2);
+            expect(guard.getActiveSteps().empty());
+
+            engine.releaseResources();
+        }
+
+        beginTest("The history keeps the newest events");
+        {
+            AudioEngine engine(false);
+            engine.prepareToPlay(sampleRate, blockSize);
+            auto& guard = engine.getOverloadGuard();
+            guard.setEnabled(false);
+
+            const int numOverruns = 2 * OverloadGuard::historySize;
+            for (int i = 0; i < numOverruns; ++i)
+            {
+                guard.recordBlock(ticksFor(1.01 + i * 0.001), blockSize);
+                if (i % 100 == 99)
+                    guard.update(0.0);
+            }
+            guard.update(0.0);
+
+            const auto events = guard.getEvents();
+            expectEquals(guard.getNumOverruns(), numOverruns);
+            expectEquals(static_cast<int>(events.size()), OverloadGuard::historySize);
+            expectGreaterThan(events.back().load, events.front().load, "Oldest first");
+            expectWithinAbsoluteError(events.back().load, static_cast<float>(1.01 + (numOverruns - 1) * 0.001), 0.01f);
+
+            engine.releaseResources();
+        }
+    }
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../Source/Audio/AudioEngine.h"
+#include "../Source/Routing/RoutingManager.h"
+
+/**
+ * The routing manager's table handoff with the test standing in for the
+ * audio thread: every repatch publishes a new generation, tables are only
+ * freed once a newer generation has been acknowledged, and with no audio
+ * thread running only the current table is kept.
+ */
+class RoutingManagerTest : public juce::UnitTest
+{
+public:
+    RoutingManagerTest() : juce::UnitTest("Routing manager", "State") {}
+
+    void runTest() override
+    {
+        // A headless engine isn't routed until asked
+        AudioEngine engine(false);
+        engine.initializeRouting();
+        auto& routing = auralis::RoutingManager::getInstance();
+
+        beginTest("With no audio thread only the current table is kept");
+        {
+            routing.released();
+
+            routing.setGroupToMaster(0, false);
+            routing.setGroupToMaster(0, true);
+            expectEquals(routing.getNumRetainedTables(), 1);
+        }
+
+        beginTest("A table the audio thread holds outlives newer repatches");
+        {
+            routing.prepare();
+            const auto heldGeneration = routing.acquireTable().generation;
+
+            routing.setGroupToMaster(0, false);
+            routing.setGroupToMaster(0, true);
+            routing.setGroupToMaster(0, false);
+            expectEquals(routing.getNumRetainedTables(), 4, "The held table and every one since");
+
+            // The next block sees the newest generation, and only then can the older ones go
+            const auto& table = routing.acquireTable();
+            expectEquals(table.generation, heldGeneration + 3);
+            expect(!table.groupToMaster[0], "The block sees the last repatch");
+
+            routing.setGroupToMaster(0, true);
+            expectEquals(routing.getNumRetainedTables(), 2, "The acknowledged table and the new current one");
+
+            routing.acquireTable();
+            routing.setGroupToMaster(1, false);
+            expectEquals(routing.getNumRetainedTables(), 2);
+        }
+
+        beginTest("Stopping the audio thread frees everything but the current table");
+        {
+            routing.released();
+            routing.setGroupToMaster(1, true);
+            expectEquals(routing.getNumRetainedTables(), 1);
+            expect(routing.isGroupToMaster(0) && routing.isGroupToMaster(1));
+        }
+    }
+};
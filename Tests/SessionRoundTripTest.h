@@ -2,7 +2,10 @@
 
 #include <JuceHeader.h>
 #include "../Source/Audio/AudioEngine.h"
+#include "../Source/State/ParameterHistory.h"
+#include "../Source/State/ParameterRegistry.h"
 #include "../Source/State/SessionManager.h"
+#include "../Source/State/SessionSnapshot.h"
 #include "../Source/MainApp.h"
 
 class SessionRoundTripTest : public juce::UnitTest
@@ -39,6 +42,67 @@ public:
         expectWithinAbsoluteError(ch0->getTrimGain(), 0.7f, 0.001f);
         expectWithinAbsoluteError(ch0->getFxSendLevel(), 0.5f, 0.001f);
         expect(ch0->isMuted() == true);
+
+        beginTest("Binary snapshot rejects corruption; JSON still loads");
+
+        auralis::SessionSnapshot snapshot;
+        snapshot.capture(engine);
+        auto block = snapshot.toMemoryBlock();
+
+        auralis::SessionSnapshot restored;
+        expect(restored.fromMemory(block.getData(), block.getSize()));
+        expectEquals((int) restored.channels.size(), (int) snapshot.channels.size());
+        expectWithinAbsoluteError(restored.channels[0].trimGainDb, 0.7f, 0.001f);
+
+        auto corrupt = block;
+        static_cast<char*>(corrupt.getData())[corrupt.getSize() - 1] ^= 0x55;
+        expect(!restored.fromMemory(corrupt.getData(), corrupt.getSize()));
+
+        // Sessions saved as JSON still load
+        auto json = tmp.getSiblingFile("roundtrip.json");
+        expect(auralis::SessionManager::getInstance().exportSessionJson(json));
+        ch0->setTrimGain(1.0f);
+        expect(auralis::SessionManager::getInstance().loadSession(json));
+        expectWithinAbsoluteError(ch0->getTrimGain(), 0.7f, 0.001f);
+
+        beginTest("Undo / redo and diff since save");
+
+        using auralis::ParameterId;
+        auto& history = auralis::ParameterHistory::getInstance();
+        const auto trimId = ParameterId::channel(0, ParameterId::Channel::trimGain);
+        const auto muteId = ParameterId::channel(0, ParameterId::Channel::muted);
+
+        expect(!history.canUndo());   // Loading cleared it
+        expect(history.setParameter(trimId, 3.0f));
+        expect(history.setParameter(trimId, 4.0f));   // Coalesces with the last record
+        expect(history.setParameter(muteId, 0.0f));
+        expectEquals(history.getNumRecords(), 2);
+
+        std::vector<auralis::ParameterHistory::Change> changes;
+        expect(history.diffSinceSave(changes));
+        expectEquals((int) changes.size(), 2);
+
+        expect(history.undo());
+        expect(ch0->isMuted());
+        expect(history.undo());
+        expectWithinAbsoluteError(ch0->getTrimGain(), 0.7f, 0.001f);
+        expect(history.diffSinceSave(changes));
+        expect(changes.empty());
+
+        expect(history.redo());
+        expectWithinAbsoluteError(ch0->getTrimGain(), 4.0f, 0.001f);
+
+        beginTest("Parameter registry ids and keys");
+
+        auto& registry = auralis::ParameterRegistry::getInstance();
+        expectWithinAbsoluteError(registry.getValue(trimId), 4.0f, 0.001f);
+        expectEquals(registry.getKey(trimId), juce::String("ch1.trimGain"));
+        expect(auralis::ParameterRegistry::findId("ch1.trimGain") == trimId);
+        expect(auralis::ParameterRegistry::findId("master.targetLufs") == ParameterId::master(ParameterId::Master::targetLufs));
+        expect(registry.getSlot(ParameterId::channel(engine.getNumChannels(), ParameterId::Channel::trimGain)) < 0);
+
+        expect(registry.setValue(trimId, 100.0f));   // Clamped to the range
+        expectWithinAbsoluteError(ch0->getTrimGain(), 24.0f, 0.001f);
     }
 
     static SessionRoundTripTest& getInstance()
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DSPTestHelpers.h"
+#include "../Source/DSP/SimdKernels.h"
+
+/**
+ * Every kernel table this CPU can run against the scalar reference, over a
+ * length no vector width divides so the tails are covered too, and the
+ * true-peak meter against a signal whose true peak is known.
+ *
+ * Gain and peak kernels must match exactly. The rest may differ by the
+ * rounding of a fused multiply-add or of another summation order.
+ */
+class SimdKernelsTest : public juce::UnitTest
+{
+public:
+    SimdKernelsTest() : juce::UnitTest("SIMD kernels", "DSP") {}
+
+    void runTest() override
+    {
+        using namespace auralis::simd;
+        using DSPTestHelpers::nullResidualDb;
+
+        beginTest("Dispatch picks a table this CPU can run");
+        {
+            const auto available = getAvailableKernels();
+            expect(available.front() == &getScalarKernels());
+            expect(std::find(available.begin(), available.end(), &getKernels()) != available.end());
+            logMessage("Dispatched to the " + juce::String(getKernels().name) + " kernels");
+        }
+
+        const auto& scalar = getScalarKernels();
+        const auto input = makeStereoNoise(1031);
+        const int numSamples = input.getNumSamples();
+        const float* left = input.getReadPointer(0);
+        const float* right = input.getReadPointer(1);
+
+        for (const auto* table : getAvailableKernels())
+        {
+            if (table == &scalar)
+                continue;
+
+            const juce::String name(table->name);
+
+            beginTest(name + ": gain");
+            {
+                auto expected = input, actual = input;
+                scalar.applyGain(expected.getWritePointer(0), numSamples, 0.7f);
+                table->applyGain(actual.getWritePointer(0), numSamples, 0.7f);
+                expect(DSPTestHelpers::isBitExact(actual, expected));
+
+                expected = input;
+                actual = input;
+                scalar.addWithGain(expected.getWritePointer(0), right, numSamples, 0.3f);
+                table->addWithGain(actual.getWritePointer(0), right, numSamples, 0.3f);
+                expectLessThan(nullResidualDb(actual, expected), -120.0f);
+            }
+
+            beginTest(name + ": biquad cascade");
+            {
+                const auto stages = makeEqStages();
+
+                for (bool stereo : { true, false })
+                {
+                    auto expected = input, actual = input;
+                    std::array<BiquadState, 8> expectedState {}, actualState {};
+
+                    // Uneven blocks, so the state is carried between calls too
+                    for (int start = 0; start < numSamples; start += 100)
+                    {
+                        const int length = juce::jmin(100, numSamples - start);
+                        scalar.biquadCascadeStereo(expected.getWritePointer(0, start), stereo ? expected.getWritePointer(1, start) : nullptr,
+                                                   length, stages.data(), expectedState.data(), 4);
+                        table->biquadCascadeStereo(actual.getWritePointer(0, start), stereo ? actual.getWritePointer(1, start) : nullptr,
+                                                   length, stages.data(), actualState.data(), 4);
+                    }
+
+                    expectLessThan(nullResidualDb(actual, expected), -120.0f, stereo ? "stereo" : "mono");
+                }
+            }
+
+            beginTest(name + ": envelope follower");
+            {
+                juce::AudioBuffer<float> expected(2, numSamples), actual(2, numSamples);
+                float expectedState[2] = {}, actualState[2] = {};
+
+                scalar.envelopeFollowerStereo(left, right, expected.getWritePointer(0), expected.getWritePointer(1),
+                                              numSamples, 0.99f, 0.999f, expectedState);
+                table->envelopeFollowerStereo(left, right, actual.getWritePointer(0), actual.getWritePointer(1),
+                                              numSamples, 0.99f, 0.999f, actualState);
+
+                expectLessThan(nullResidualDb(actual, expected), -120.0f);
+            }
+
+            beginTest(name + ": metering reductions");
+            {
+                expectEquals(table->findPeak(left, numSamples), scalar.findPeak(left, numSamples));
+
+                const double expected = scalar.sumOfSquares(left, numSamples);
+                expectWithinAbsoluteError(table->sumOfSquares(left, numSamples), expected, expected * 1.0e-12);
+
+                // Every length up to a few vectors, for the tails
+                for (int length = 1; length <= 40; ++length)
+                    expectEquals(table->findPeak(right, length), scalar.findPeak(right, length));
+            }
+
+            beginTest(name + ": oversampled peak");
+            {
+                for (int numOutputs : { 1, 2, 3, 5, 7, 250, numSamples - (truePeakTaps - 1) })
+                {
+                    const float expected = scalar.oversampledPeak(left, numOutputs);
+                    expectWithinAbsoluteError(table->oversampledPeak(left, numOutputs), expected, expected * 1.0e-5f);
+                }
+            }
+        }
+
+        // A sine at a quarter of the sample rate, 45 degrees out: every sample
+        // lands at 0.707 of the amplitude, and the true peak falls between them
+        beginTest("True peak: a quarter-rate sine between its samples");
+        {
+            const int length = 4800;
+            std::vector<float> sine(static_cast<size_t>(length));
+            for (int i = 0; i < length; ++i)
+                sine[static_cast<size_t>(i)] = 0.5f * std::sin(juce::MathConstants<float>::halfPi * i + juce::MathConstants<float>::pi / 4.0f);
+
+            TruePeakDetector detector;
+            float truePeak = 0.0f;
+            for (int start = 0; start < length; start += 300)
+                truePeak = juce::jmax(truePeak, detector.process(sine.data() + start, juce::jmin(300, length - start)));
+
+            expectWithinAbsoluteError(juce::Decibels::gainToDecibels(truePeak), -6.02f, 0.2f);
+            expectWithinAbsoluteError(juce::Decibels::gainToDecibels(getKernels().findPeak(sine.data(), length)), -9.03f, 0.01f);
+        }
+
+        beginTest("True peak: the filter history carries across blocks");
+        {
+            TruePeakDetector whole, pieces;
+            const float expected = whole.process(left, numSamples);
+
+            float actual = 0.0f;
+            for (int start = 0; start < numSamples; start += 37)
+                actual = juce::jmax(actual, pieces.process(left + start, juce::jmin(37, numSamples - start)));
+
+            expectEquals(actual, expected);
+        }
+    }
+
+private:
+    /** Independent noise on each channel, so a lane mix-up shows. */
+    juce::AudioBuffer<float> makeStereoNoise(int numSamples)
+    {
+        juce::AudioBuffer<float> buffer(2, numSamples);
+        auto& random = getRandom();
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample(ch, i, 0.8f * (random.nextFloat() * 2.0f - 1.0f));
+
+        return buffer;
+    }
+
+    /** The channel EQ's four bands, with some gain on each. */
+    static std::array<auralis::simd::BiquadCoefficients, 4> makeEqStages()
+    {
+        using ArrayCoefs = juce::dsp::IIR::ArrayCoefficients<float>;
+        using auralis::simd::makeBiquad;
+        const double sampleRate = DSPTestHelpers::sampleRate;
+
+        return { makeBiquad(ArrayCoefs::makeLowShelf(sampleRate, 80.0, 0.7, juce::Decibels::decibelsToGain(6.0f))),
+                 makeBiquad(ArrayCoefs::makePeakFilter(sampleRate, 300.0, 0.7, juce::Decibels::decibelsToGain(-4.0f))),
+                 makeBiquad(ArrayCoefs::makePeakFilter(sampleRate, 3000.0, 0.7, juce::Decibels::decibelsToGain(3.0f))),
+                 makeBiquad(ArrayCoefs::makeHighShelf(sampleRate, 8000.0, 0.7, juce::Decibels::decibelsToGain(-9.0f))) };
+    }
+};
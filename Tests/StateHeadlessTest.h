@@ -0,0 +1,121 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DSPTestHelpers.h"
+#include "../Source/Audio/AudioEngine.h"
+#include "../Source/FX/EQProcessor.h"
+#include "../Source/State/ParameterId.h"
+#include "../Source/State/SessionSnapshot.h"
+
+/**
+ * Parameter ids and binary snapshots against an engine with no audio
+ * device and no application: what the session code needs from the mixer.
+ */
+class StateHeadlessTest : public juce::UnitTest
+{
+public:
+    StateHeadlessTest() : juce::UnitTest("State headless", "State") {}
+
+    void runTest() override
+    {
+        using auralis::ParameterId;
+
+        AudioEngine engine(false);
+
+        beginTest("Parameter ids set and read back");
+        {
+            const auto trimId = ParameterId::channel(1, ParameterId::Channel::trimGain);
+            const auto muteId = ParameterId::channel(1, ParameterId::Channel::muted);
+            float value = 0.0f;
+
+            expect(ParameterId::setValue(engine, trimId, -6.0f));
+            expect(ParameterId::getValue(engine, trimId, value));
+            expectWithinAbsoluteError(value, -6.0f, 0.001f);
+
+            expect(ParameterId::setValue(engine, muteId, 1.0f));
+            expect(ParameterId::getValue(engine, muteId, value));
+            expectEquals(value, 1.0f);
+
+            const auto outOfRange = ParameterId::channel(engine.getNumChannels(), ParameterId::Channel::trimGain);
+            expect(!ParameterId::setValue(engine, outOfRange, 0.0f));
+            expect(!ParameterId::getValue(engine, outOfRange, value));
+        }
+
+        beginTest("Snapshot restores the engine through memory");
+        {
+            auto* ch0 = engine.getChannelProcessor(0);
+            ch0->setTrimGain(3.5f);
+            ch0->setFxSendLevel(0.25f);
+            ch0->setGateEnabled(false);
+            engine.getGroupBusProcessor(0)->setOutputGain(0.5f);
+
+            auralis::SessionSnapshot snapshot;
+            snapshot.capture(engine);
+            const auto block = snapshot.toMemoryBlock();
+
+            ch0->setTrimGain(0.0f);
+            ch0->setFxSendLevel(0.0f);
+            ch0->setGateEnabled(true);
+            engine.getGroupBusProcessor(0)->setOutputGain(1.0f);
+
+            auralis::SessionSnapshot restored;
+            expect(restored.fromMemory(block.getData(), block.getSize()));
+            restored.apply(engine);
+
+            expectWithinAbsoluteError(ch0->getTrimGain(), 3.5f, 0.001f);
+            expectWithinAbsoluteError(ch0->getFxSendLevel(), 0.25f, 0.001f);
+            expect(!ch0->isGateEnabled());
+            expectWithinAbsoluteError(engine.getGroupBusProcessor(0)->getOutputGain(), 0.5f, 0.001f);
+
+            // A truncated block is refused, not half applied
+            expect(!restored.fromMemory(block.getData(), block.getSize() / 2));
+        }
+
+        beginTest("An unknown reverb mode on disk reads back as the algorithmic reverb");
+        {
+            auralis::SessionSnapshot snapshot;
+            snapshot.capture(engine);
+            snapshot.fxBuses[0].reverbMode = 7;
+            const auto block = snapshot.toMemoryBlock();
+
+            auralis::SessionSnapshot restored;
+            expect(restored.fromMemory(block.getData(), block.getSize()));
+            expectEquals(static_cast<int>(restored.fxBuses[0].reverbMode), static_cast<int>(FXBusProcessor::ReverbMode::Algorithmic));
+
+            restored.apply(engine);
+            expect(engine.getFXBusProcessor(0)->getReverbMode() == FXBusProcessor::ReverbMode::Algorithmic);
+        }
+
+        beginTest("A scene delta's EQ reaches the strip's audio");
+        {
+            using namespace DSPTestHelpers;
+
+            engine.prepareToPlay(sampleRate, 512);
+            auto* channel = engine.getChannelProcessor(2);
+            channel->setTunerEnabled(false);
+
+            // -30 dB stays under the compressor, so only the EQ changes the level
+            const auto input = makeSine(juce::roundToInt(sampleRate), EQProcessor::highMidFrequency, juce::Decibels::decibelsToGain(-30.0f));
+            const int settled = input.getNumSamples() / 2;
+            juce::MidiBuffer midi;
+            const auto process = [&]
+            {
+                return processInBlocks(input, 512, [&](juce::AudioBuffer<float>& block) { channel->processBlock(block, midi); });
+            };
+
+            const auto flat = process();
+
+            // No device running, so the delta lands straight away
+            auto target = ChannelSettings::capture(*channel);
+            target.eqGainsDb = { 0.0f, 0.0f, 6.0f, 0.0f };
+            SceneDelta delta;
+            delta.entries.push_back({ channel, target });
+            engine.getSceneDeltaQueue().publish(std::move(delta));
+
+            const auto boosted = process();
+            expectWithinAbsoluteError(rmsDb(boosted, 0, settled) - rmsDb(flat, 0, settled), 6.0f, 0.2f);
+
+            engine.releaseResources();
+        }
+    }
+};
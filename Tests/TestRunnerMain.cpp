@@ -0,0 +1,101 @@
+#include <JuceHeader.h>
+#include <iostream>
+#include "AutosaveServiceTest.h"
+#include "CaptureFifoTest.h"
+#include "ChannelClassifierTest.h"
+#include "ConvolutionReverbTest.h"
+#include "DSPGoldenTest.h"
+#include "DSPLoadProfilerTest.h"
+#include "DSPNullTest.h"
+#include "EQFitterTest.h"
+#include "HeadlessSupport.h"
+#include "MultitrackPlayerTest.h"
+#include "MultitrackRecorderTest.h"
+#include "OfflineRendererTest.h"
+#include "OverloadGuardTest.h"
+#include "RoutingManagerTest.h"
+#include "SimdKernelsTest.h"
+#include "StateHeadlessTest.h"
+
+/*
+ * AuralisTests [--category=<name>] [--seed=<n>] [--verbose]
+ *
+ *   --category  only run one category: DSP or State (default: both)
+ *   --seed      random seed for the tests that use one
+ *   --verbose   keep the processors' own log output
+ *
+ * Exits with 1 if any expectation fails, so CTest and CI can run it as is.
+ */
+
+namespace
+{
+    /** Reports to stdout instead of the JUCE logger, which is silenced. */
+    class ConsoleTestRunner : public juce::UnitTestRunner
+    {
+        void logMessage(const juce::String& message) override
+        {
+            std::cout << message << std::endl;
+        }
+    };
+
+    // Registered with juce::UnitTest::getAllTests() on construction
+    AutosaveServiceTest autosaveServiceTest;
+    CaptureFifoTest captureFifoTest;
+    ChannelClassifierTest channelClassifierTest;
+    ConvolutionReverbTest convolutionReverbTest;
+    DSPGoldenTest dspGoldenTest;
+    DSPLoadProfilerTest dspLoadProfilerTest;
+    DSPNullTest dspNullTest;
+    EQFitterTest eqFitterTest;
+    MultitrackPlayerTest multitrackPlayerTest;
+    MultitrackRecorderTest multitrackRecorderTest;
+    OfflineRendererTest offlineRendererTest;
+    OverloadGuardTest overloadGuardTest;
+    RoutingManagerTest routingManagerTest;
+    SimdKernelsTest simdKernelsTest;
+    StateHeadlessTest stateHeadlessTest;
+}
+
+int main(int argc, char* argv[])
+{
+    // The channel strip's AudioProcessorGraph expects a message thread
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    HeadlessSupport::SilentLogger silentLogger;
+    if (!args.containsOption("--verbose"))
+        juce::Logger::setCurrentLogger(&silentLogger);
+
+    const auto seed = args.containsOption("--seed") ? args.getValueForOption("--seed").getLargeIntValue()
+                                                    : juce::Random::getSystemRandom().nextInt64();
+
+    ConsoleTestRunner runner;
+    runner.setAssertOnFailure(false);
+
+    // JUCE registers its own module tests too; run only the mixer's
+    juce::StringArray categories { "DSP", "State" };
+    if (args.containsOption("--category"))
+        categories = juce::StringArray(args.getValueForOption("--category"));
+
+    juce::Array<juce::UnitTest*> tests;
+    for (const auto& category : categories)
+        tests.addArray(juce::UnitTest::getTestsInCategory(category));
+
+    runner.runTests(tests, seed);
+
+    juce::Logger::setCurrentLogger(nullptr);
+
+    int numFailures = 0;
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        numFailures += runner.getResult(i)->failures;
+
+    if (runner.getNumResults() == 0)
+    {
+        std::cerr << "No tests ran" << std::endl;
+        return 1;
+    }
+
+    std::cout << runner.getNumResults() << " tests, " << numFailures << " failures" << std::endl;
+    return numFailures > 0 ? 1 : 0;
+}
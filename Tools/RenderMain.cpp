@@ -0,0 +1,100 @@
+#include <JuceHeader.h>
+#include <iostream>
+#include "../Source/Audio/OfflineRenderer.h"
+
+/*
+ * AuralisRender --output=<mix.wav|mix.flac> [--session=<file.aur>] [--block=4096]
+ *               [--tail=2] [--threads=0] [--bits=24] [--profile=<file.json>] [--verbose] <stem> [<stem>...]
+ *
+ *   --output   the stereo mix; a loudness report is written next to it
+ *   --session  mixer state to render with (binary session file); defaults otherwise
+ *   --tail     seconds to let reverbs and delays ring out after the stems end
+ *   --threads  channel strip threads, 0 for one per core
+ *   --profile  write each strip's, bus's and stage's DSP load, as a share of real time
+ *
+ * Stem n feeds channel n, in the order given.
+ */
+
+namespace
+{
+    class SilentLogger : public juce::Logger
+    {
+        void logMessage(const juce::String&) override {}
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    // The channel strip's AudioProcessorGraph expects a message thread
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    SilentLogger silentLogger;
+    if (!args.containsOption("--verbose"))
+        juce::Logger::setCurrentLogger(&silentLogger);
+
+    OfflineRenderer::Settings settings;
+
+    for (const auto& arg : args.arguments)
+        if (!arg.isOption())
+            settings.stems.add(arg.resolveAsFile());
+
+    if (settings.stems.isEmpty() || !args.containsOption("--output"))
+    {
+        std::cerr << "Usage: AuralisRender --output=<mix.wav> [--session=<file.aur>] <stem> [<stem>...]" << std::endl;
+        return 1;
+    }
+
+    settings.output = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--output"));
+    if (!settings.output.hasFileExtension("wav;flac"))
+        settings.output = settings.output.withFileExtension("wav");
+
+    if (args.containsOption("--block"))
+        settings.blockSize = args.getValueForOption("--block").getIntValue();
+    if (args.containsOption("--tail"))
+        settings.tailSeconds = args.getValueForOption("--tail").getDoubleValue();
+    if (args.containsOption("--threads"))
+        settings.numThreads = args.getValueForOption("--threads").getIntValue();
+    if (args.containsOption("--bits"))
+        settings.bitDepth = args.getValueForOption("--bits").getIntValue();
+    if (args.containsOption("--profile"))
+        settings.profileReport = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--profile"));
+
+    if (args.containsOption("--session"))
+    {
+        const auto sessionFile = juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--session"));
+
+        settings.mixerState.emplace();
+        if (!settings.mixerState->readFromFile(sessionFile))
+        {
+            std::cerr << "Can't read session " << sessionFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+
+    int lastPercent = -1;
+    const auto result = OfflineRenderer::render(settings, [&lastPercent](double progress)
+    {
+        const int percent = juce::roundToInt(progress * 100.0);
+        if (percent / 10 != lastPercent / 10)
+            std::cout << percent << "%" << std::endl;
+        lastPercent = percent;
+        return true;
+    });
+
+    juce::Logger::setCurrentLogger(nullptr);
+
+    if (!result.success)
+    {
+        std::cerr << "Render failed: " << result.errorMessage << std::endl;
+        return 1;
+    }
+
+    std::cout << settings.output.getFullPathName() << ": "
+              << juce::String(result.loudness.integratedLufs, 1) << " LUFS integrated, peak "
+              << juce::String(result.loudness.samplePeakDb, 1) << " dBFS, true peak "
+              << juce::String(result.loudness.truePeakDb, 1) << " dBTP, rendered in "
+              << juce::String(result.loudness.renderSeconds, 1) << " s" << std::endl;
+    return 0;
+}